@@ -3,7 +3,7 @@ Algorithm - Abstract base class for visualization algorithms that
 extract visualization elements from data sets.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2005-2024 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -77,6 +77,11 @@ bool Algorithm::hasIncrementalCreator(void) const
 	return false;
 	}
 
+bool Algorithm::hasElementReuse(void) const
+	{
+	return false;
+	}
+
 GLMotif::Widget* Algorithm::createSettingsDialog(GLMotif::WidgetManager* widgetManager)
 	{
 	return 0;
@@ -88,6 +93,11 @@ void Algorithm::setSeedLocator(const DataSet::Locator* seedLocator)
 	throw Misc::makeStdErr(__PRETTY_FUNCTION__,"No seeded element creation method defined");
 	}
 
+void Algorithm::setRegionOfInterest(const DataSet::RegionOfInterest& regionOfInterest)
+	{
+	/* Just don't do anything; elements are extracted from the entire domain */
+	}
+
 Element* Algorithm::createElement(Parameters* extractParameters)
 	{
 	/* Inherit the parameters object: */
@@ -98,6 +108,16 @@ Element* Algorithm::createElement(Parameters* extractParameters)
 	return 0;
 	}
 
+Element* Algorithm::readElement(Parameters* extractParameters,IO::File& geometryFile)
+	{
+	/* Inherit the parameters object: */
+	delete extractParameters;
+	
+	/* Signal an error: */
+	throw Misc::makeStdErr(__PRETTY_FUNCTION__,"No element reading method defined");
+	return 0;
+	}
+
 Element* Algorithm::startElement(Parameters* extractParameters)
 	{
 	/* Inherit the parameters object: */
@@ -119,6 +139,11 @@ void Algorithm::finishElement(void)
 	/* Just don't do anything */
 	}
 
+bool Algorithm::isElementReused(void) const
+	{
+	return false;
+	}
+
 void Algorithm::continueSlaveElement(void)
 	{
 	/* Just don't do anything */
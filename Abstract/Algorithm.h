@@ -3,7 +3,7 @@ Algorithm - Abstract base class for visualization algorithms that
 extract visualization elements from data sets.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -38,6 +38,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 namespace Realtime {
 class AlarmTimer;
 }
+namespace IO {
+class File;
+}
 namespace Cluster {
 class MulticastPipe;
 }
@@ -103,14 +106,18 @@ class Algorithm
 	virtual bool hasGlobalCreator(void) const; // Returns true if the algorithm has a global creation method
 	virtual bool hasSeededCreator(void) const; // Returns true if the algorithm has a seeded creation method
 	virtual bool hasIncrementalCreator(void) const; // Returns true if the algorithm has incremental creation methods
+	virtual bool hasElementReuse(void) const; // Returns true if the algorithm's incremental creation methods can create elements from the previous element instead of extracting them
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager); // Returns a new UI widget to change internal settings of the algorithm
 	virtual void readParameters(ParametersSource& source) =0; // Reads parameters from source and updates algorithm's internal state
 	virtual Parameters* cloneParameters(void) const =0; // Returns a copy of the algorithm's current extraction parameters
 	virtual void setSeedLocator(const DataSet::Locator* seedLocator); // Updates the algorithm's current extraction parameters according to the given seed locator
+	virtual void setRegionOfInterest(const DataSet::RegionOfInterest& regionOfInterest); // Restricts extraction with the algorithm's current extraction parameters to the given region of interest; ignored by algorithms that do not support regions of interest
 	virtual Element* createElement(Parameters* extractParameters); // Creates a complete visualization element using the current extraction settings; inherits parameter object
+	virtual Element* readElement(Parameters* extractParameters,IO::File& geometryFile); // Creates a complete visualization element for the given extraction settings from geometry written by Element::writeGeometry instead of extracting it; inherits parameter object
 	virtual Element* startElement(Parameters* extractParameters); // Starts creating a visualization element using the current extraction settings; inherits parameter object
 	virtual bool continueElement(const Realtime::AlarmTimer& alarm); // Continues creating the current element; returns true if element is complete
 	virtual void finishElement(void); // Cleans up after an element has been created
+	virtual bool isElementReused(void) const; // Returns true if the most recently started element was created from the previous element instead of being extracted
 	virtual Element* startSlaveElement(Parameters* extractParameters) =0; // Starts creating a visualization element on the slave node(s) of a cluster environment; inherits parameter object
 	virtual void continueSlaveElement(void); // Receives a fragment of a visualization element on the slave node(s) of a cluster environment
 	};
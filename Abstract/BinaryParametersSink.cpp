@@ -3,7 +3,7 @@ BinaryParametersSink - Generic class for parameter sinks utilizing the
 pipe I/O abstraction.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2011 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -32,6 +32,13 @@ namespace Visualization {
 
 namespace Abstract {
 
+/*********************************************
+Static elements of class BinaryParametersSink:
+*********************************************/
+
+const unsigned int BinaryParametersSink::formatVersion;
+const char* const BinaryParametersSink::versionTag="3DVisualizer binary parameters";
+
 /*************************************
 Methods of class BinaryParametersSink:
 *************************************/
@@ -3,7 +3,7 @@ BinaryParametersSink - Generic class for parameter sinks utilizing the
 pipe I/O abstraction.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2011 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -40,6 +40,9 @@ namespace Abstract {
 class BinaryParametersSink:public ParametersSink
 	{
 	/* Elements: */
+	public:
+	static const unsigned int formatVersion=2; // Version of the binary parameter format written by binary sinks; version 1 predates all optional values such as regions of interest
+	static const char* const versionTag; // Name written in place of an algorithm name at the beginning of binary element files, followed by the format version as a 32-bit unsigned integer
 	private:
 	IO::File& sink; // The data sink
 	bool raw; // Flag whether the sink writes variable indices (true) or variable names (false)
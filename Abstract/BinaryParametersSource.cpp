@@ -3,7 +3,7 @@ BinaryParametersSource - Generic class for parameter sources utilizing
 the pipe I/O abstraction.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2011 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,9 +25,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/BinaryParametersSource.h>
 
 #include <string>
+#include <Misc/StdError.h>
 #include <Misc/StandardMarshallers.h>
 #include <IO/File.h>
 
+#include <Abstract/BinaryParametersSink.h>
+
 namespace Visualization {
 
 namespace Abstract {
@@ -38,8 +41,22 @@ Methods of class BinaryParametersSource:
 
 BinaryParametersSource::BinaryParametersSource(VariableManager* sVariableManager,IO::File& sSource,bool sRaw)
 	:ParametersSource(sVariableManager),
-	 source(sSource),raw(sRaw)
+	 source(sSource),raw(sRaw),
+	 version(BinaryParametersSink::formatVersion)
+	{
+	}
+
+void BinaryParametersSource::setVersion(unsigned int newVersion)
+	{
+	if(newVersion<1||newVersion>BinaryParametersSink::formatVersion)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unsupported binary parameter format version %u",newVersion);
+	version=newVersion;
+	}
+
+bool BinaryParametersSource::hasValue(const char* name) const
 	{
+	/* Binary sources can not look up values by name; version 1 sources lack all optional values, and later versions contain all of them: */
+	return version>1;
 	}
 
 void BinaryParametersSource::read(const char* name,const ReaderBase& value)
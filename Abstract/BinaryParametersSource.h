@@ -3,7 +3,7 @@ BinaryParametersSource - Class for parameter sources reading from a file
 abstraction.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2011 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -43,12 +43,21 @@ class BinaryParametersSource:public ParametersSource
 	private:
 	IO::File& source; // The data source
 	bool raw; // Flag whether the source reads variable indices (true) or variable names (false)
+	unsigned int version; // Version of the binary parameter format read from the source
 	
 	/* Constructors and destructors: */
 	public:
-	BinaryParametersSource(VariableManager* sVariableManager,IO::File& sSource,bool sRaw);
+	BinaryParametersSource(VariableManager* sVariableManager,IO::File& sSource,bool sRaw); // Creates a source reading the current binary parameter format
+	
+	/* Methods: */
+	unsigned int getVersion(void) const // Returns the version of the binary parameter format read from the source
+		{
+		return version;
+		}
+	void setVersion(unsigned int newVersion); // Sets the version of the binary parameter format read from the source
 	
 	/* Methods from ParametersSource: */
+	virtual bool hasValue(const char* name) const;
 	virtual void read(const char* name,const ReaderBase& value);
 	virtual void readScalarVariable(const char* name,int& scalarVariableIndex);
 	virtual void readVectorVariable(const char* name,int& vectorVariableIndex);
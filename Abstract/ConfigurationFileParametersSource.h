@@ -3,7 +3,7 @@ ConfigurationFileParametersSource - Class for parameter sources reading
 from a configuration file section.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2013 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -48,6 +48,7 @@ class ConfigurationFileParametersSource:public ParametersSource
 	ConfigurationFileParametersSource(VariableManager* sVariableManager,const Misc::ConfigurationFileSection& sCfg);
 	
 	/* Methods from ParametersSource: */
+	virtual bool hasValue(const char* name) const;
 	virtual void read(const char* name,const ReaderBase& value);
 	virtual void readScalarVariable(const char* name,int& scalarVariableIndex);
 	virtual void readVectorVariable(const char* name,int& vectorVariableIndex);
@@ -2,7 +2,7 @@
 DataSet - Abstract base class to represent data sets.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2005-2010 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -31,6 +31,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/LinearUnit.h>
 #include <Abstract/ScalarExtractor.h>
 #include <Abstract/VectorExtractor.h>
+#include <Abstract/ValueStatistics.h>
 
 /* Forward declarations: */
 namespace Visualization {
@@ -38,6 +39,10 @@ namespace Abstract {
 class DataValue;
 class CoordinateTransformer;
 }
+namespace Templatized {
+template <class ScalarParam,int dimensionParam>
+class RegionOfInterest;
+}
 }
 
 namespace Visualization {
@@ -52,6 +57,7 @@ class DataSet
 	typedef Geometry::Point<Scalar,3> Point; // Point type in data set's domain
 	typedef Geometry::Rotation<Scalar,3> Orientation; // Orientation type in data set's domain
 	typedef Geometry::Box<Scalar,3> Box; // Axis-aligned box type in data set's domain
+	typedef Visualization::Templatized::RegionOfInterest<Scalar,3> RegionOfInterest; // Type for regions of the data set's domain to which element extraction is restricted
 	typedef Geometry::LinearUnit Unit; // Type for linear coordinate units
 	typedef ScalarExtractor::Scalar VScalar; // Scalar value type
 	typedef VectorExtractor::Vector VVector; // Vector value type
@@ -113,10 +119,12 @@ class DataSet
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const; // Returns descriptive name of a scalar variable
 	virtual ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const; // Returns scalar extractor for a scalar variable
 	virtual VScalarRange calcScalarValueRange(const ScalarExtractor* scalarExtractor) const =0; // Calculates the range of scalar values extracted by the given extractor
+	virtual ValueStatistics calcScalarValueStatistics(const ScalarExtractor* scalarExtractor,const VScalarRange& histogramRange,unsigned int numBins,const volatile bool* cancel =0) const =0; // Calculates statistics and a histogram over the given value range of scalar values extracted by the given extractor; stops early with partial statistics if the optional cancellation flag is raised
 	virtual int getNumVectorVariables(void) const; // Returns number of vector variables contained in the data set
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const; // Returns descriptive name of a vector variable
 	virtual VectorExtractor* getVectorExtractor(int vectorVariableIndex) const; // Returns vector extractor for a vector variable
 	virtual VScalarRange calcVectorValueMagnitudeRange(const VectorExtractor* vectorExtractor) const =0; // Calculates the magnitude range of vector values extracted by the given extractor
+	virtual ValueStatistics calcVectorValueMagnitudeStatistics(const VectorExtractor* vectorExtractor,const VScalarRange& histogramRange,unsigned int numBins,const volatile bool* cancel =0) const =0; // Calculates statistics and a histogram over the given value range of the magnitudes of vector values extracted by the given extractor; stops early with partial statistics if the optional cancellation flag is raised
 	virtual Locator* getLocator(void) const =0; // Returns an invalid locator for the data set
 	};
 
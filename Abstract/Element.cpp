@@ -4,7 +4,7 @@ data sets. Elements use thread-safe reference counting for automatic
 garbage collection.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2005-2012 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/Element.h>
 
+#include <Misc/StdError.h>
+
 #include <Abstract/Parameters.h>
 
 namespace Visualization {
@@ -41,11 +43,31 @@ Element::~Element(void)
 	delete parameters;
 	}
 
+void Element::notifyRemoved(void)
+	{
+	/* Mark the element as removed and call the removal callbacks: */
+	Threads::Mutex::Lock removedLock(removedMutex);
+	removed=true;
+	CallbackData cbData(this);
+	removedCallbacks.call(&cbData);
+	}
+
 GLMotif::Widget* Element::createSettingsDialog(GLMotif::WidgetManager* widgetManager)
 	{
 	return 0;
 	}
 
+size_t Element::getGeometrySize(void) const
+	{
+	return 0;
+	}
+
+void Element::writeGeometry(IO::File& file) const
+	{
+	/* Signal an error: */
+	throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Element cannot write its geometry");
+	}
+
 }
 
 }
@@ -4,7 +4,7 @@ data sets. Elements use thread-safe reference counting for automatic
 garbage collection.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -29,12 +29,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string>
 #include <Misc/CallbackData.h>
 #include <Misc/CallbackList.h>
+#include <Threads/Mutex.h>
 #include <SceneGraph/GraphNode.h>
 
 /* Forward declarations: */
 namespace Misc {
 class File;
 }
+namespace IO {
+class File;
+}
 namespace GLMotif {
 class WidgetManager;
 class Widget;
@@ -87,10 +91,16 @@ class Element:public SceneGraph::GraphNode
 	Parameters* parameters; // Pointer to the parameters that were used to create this visualization element
 	Misc::CallbackList parametersUpdatedCallbacks; // List of callbacks to be called when the elements parameters are updated
 	
+	private:
+	Threads::Mutex removedMutex; // Mutex serializing removal from the element list with removal callback registration from extractor threads
+	bool removed; // Flag whether the element was removed from the element list
+	Misc::CallbackList removedCallbacks; // List of callbacks to be called when the element is removed from the element list
+	
 	/* Constructors and destructors: */
 	public:
 	Element(VariableManager* sVariableManager,Parameters* sParameters) // Creates an "empty" visualization element that will inherit the given parameter object
-		:variableManager(sVariableManager),parameters(sParameters)
+		:variableManager(sVariableManager),parameters(sParameters),
+		 removed(false)
 		{
 		}
 	private:
@@ -112,9 +122,26 @@ class Element:public SceneGraph::GraphNode
 		{
 		return parametersUpdatedCallbacks;
 		}
+	template <class CalleeParam>
+	bool addRemovedCallback(CalleeParam* callee,void (CalleeParam::*method)(Misc::CallbackData*)) // Adds a callback to be called when the element is removed from the element list; returns false and does not add the callback if the element was already removed
+		{
+		Threads::Mutex::Lock removedLock(removedMutex);
+		if(!removed)
+			removedCallbacks.add(callee,method);
+		return !removed;
+		}
+	template <class CalleeParam>
+	void removeRemovedCallback(CalleeParam* callee,void (CalleeParam::*method)(Misc::CallbackData*)) // Removes a callback added with addRemovedCallback
+		{
+		Threads::Mutex::Lock removedLock(removedMutex);
+		removedCallbacks.remove(callee,method);
+		}
+	void notifyRemoved(void); // Marks the element as removed from the element list and calls the removal callbacks; must be called while the element list still holds a reference to the element
 	virtual std::string getName(void) const =0; // Returns a descriptive name for the visualization element
 	virtual size_t getSize(void) const =0; // Returns some size value for the visualization element to compare it to other elements of the same type (number of triangles, points, etc.)
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager); // Returns a new UI widget to change internal settings of the element
+	virtual size_t getGeometrySize(void) const; // Returns the size of the element's geometry when written to a binary file in bytes, or 0 if the element cannot write its geometry
+	virtual void writeGeometry(IO::File& file) const; // Writes the element's geometry to the given binary file
 	};
 
 }
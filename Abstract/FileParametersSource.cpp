@@ -3,7 +3,7 @@ FileParametersSource - Class for parameter sources reading from text
 files.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2024 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -63,6 +63,12 @@ FileParametersSource::FileParametersSource(VariableManager* sVariableManager,IO:
 		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing closing brace in input file");
 	}
 
+bool FileParametersSource::hasValue(const char* name) const
+	{
+	/* Check if the tag/value map contains the name: */
+	return tagValueMap.isEntry(name);
+	}
+
 void FileParametersSource::read(const char* name,const ReaderBase& value)
 	{
 	/* Retrieve the named string from the tag/value map: */
@@ -5,7 +5,7 @@ visualization algorithm. Mostly used to read/write visualization
 elements to files, and to transmit them over networks.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -26,18 +26,74 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Abstract/Parameters.h>
 
+#include <vector>
+#include <Misc/SizedTypes.h>
+#include <Misc/StdError.h>
+#include <Misc/StandardMarshallers.h>
+#include <Misc/StandardValueCoders.h>
+
+#include <Abstract/ParametersSink.h>
+#include <Abstract/ParametersSource.h>
+#include <Templatized/RegionOfInterest.h>
+
 namespace Visualization {
 
 namespace Abstract {
 
+namespace {
+
+/****************
+Helper constants:
+****************/
+
+const Misc::UInt32 maxRegionOfInterestComponents=1U<<16; // Largest accepted size of a region of interest's encoding, to reject corrupted sources
+
+}
+
 /***************************
 Methods of class Parameters:
 ***************************/
 
+void Parameters::writeRegionOfInterest(ParametersSink& sink,const Parameters::RegionOfInterest& regionOfInterest)
+	{
+	/* Write the region's flat encoding, preceded by its size: */
+	std::vector<double> components;
+	regionOfInterest.getComponents(components);
+	Misc::UInt32 numComponents(components.size());
+	sink.write("regionOfInterestSize",Writer<Misc::UInt32>(numComponents));
+	sink.write("regionOfInterest",ArrayWriter<double>(&components.front(),components.size()));
+	}
+
+void Parameters::readRegionOfInterest(ParametersSource& source,Parameters::RegionOfInterest& regionOfInterest)
+	{
+	if(source.hasValue("regionOfInterestSize"))
+		{
+		/* Read the region's flat encoding, which always contains at least the box flag: */
+		Misc::UInt32 numComponents;
+		source.read("regionOfInterestSize",Reader<Misc::UInt32>(numComponents));
+		if(numComponents<1||numComponents>maxRegionOfInterestComponents)
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Malformed region of interest");
+		std::vector<double> components(numComponents);
+		source.read("regionOfInterest",ArrayReader<double>(&components.front(),components.size()));
+		regionOfInterest.setComponents(components.begin(),components.end());
+		}
+	else
+		{
+		/* Sources written before regions of interest were added extract from the entire domain: */
+		regionOfInterest.clear();
+		}
+	}
+
 Parameters::~Parameters(void)
 	{
 	}
 
+bool Parameters::getSeedPoint(Parameters::SeedPoint& seedPoint) const
+	{
+	/* Elements are unseeded by default: */
+	return false;
+	}
+
 }
 
 }
@@ -5,7 +5,7 @@ visualization algorithm. Mostly used to read/write visualization
 elements to files, and to transmit them over networks.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_ABSTRACT_PARAMETERS_INCLUDED
 
 #include <Config.h>
+#include <Geometry/Point.h>
 
 #if VISUALIZATION_CONFIG_USE_COLLABORATION
 #include <Collaboration2/DataType.h>
@@ -40,6 +41,10 @@ class VariableManager;
 class ParametersSink;
 class ParametersSource;
 }
+namespace Templatized {
+template <class ScalarParam,int dimensionParam>
+class RegionOfInterest;
+}
 }
 
 namespace Visualization {
@@ -48,6 +53,16 @@ namespace Abstract {
 
 class Parameters
 	{
+	/* Embedded classes: */
+	public:
+	typedef Geometry::Point<double,3> SeedPoint; // Type for points from which visualization elements are seeded
+	typedef Visualization::Templatized::RegionOfInterest<double,3> RegionOfInterest; // Type for regions of a data set's domain to which extraction is restricted
+	
+	/* Protected methods: */
+	protected:
+	static void writeRegionOfInterest(ParametersSink& sink,const RegionOfInterest& regionOfInterest); // Writes the given region of interest to a parameter sink
+	static void readRegionOfInterest(ParametersSource& source,RegionOfInterest& regionOfInterest); // Reads a region of interest from a parameter source; resets the region to the entire domain if the source predates regions of interest
+	
 	/* Constructors and destructors: */
 	public:
 	virtual ~Parameters(void); // Destroys the parameters object
@@ -57,6 +72,7 @@ class Parameters
 	virtual Parameters* clone(void) const =0; // Returns an exact copy of the parameters object
 	virtual void write(ParametersSink& sink) const =0; // Writes parameters to a parameter sink
 	virtual void read(ParametersSource& source) =0; // Reads parameters from a parameter source
+	virtual bool getSeedPoint(SeedPoint& seedPoint) const; // Stores the point from which the visualization element is seeded and returns true, or returns false for unseeded elements
 	#if VISUALIZATION_CONFIG_USE_COLLABORATION
 	virtual void write(void* parameters) const =0; // Writes parameters to the given opaque shared parameters structure
 	virtual void read(const void* parameters,VariableManager* variableManager) =0; // Updates parameters from the given opaque shared parameters structure
@@ -3,7 +3,7 @@ ParametersSource - Abstract base class for sources from which
 visualization algorithm parameters can be read.
 Part of the abstract interface to the templatized visualization
 components.
-Copyright (c) 2010-2011 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -137,6 +137,7 @@ class ParametersSource
 		{
 		return variableManager;
 		}
+	virtual bool hasValue(const char* name) const =0; // Returns true if the source contains the named value; sources written before a value was added to its parameters do not
 	virtual void read(const char* name,const ReaderBase& value) =0; // Reads the value from the source
 	virtual void readScalarVariable(const char* name,int& scalarVariableIndex) =0; // Reads a scalar variable from the source
 	virtual void readVectorVariable(const char* name,int& vectorVariableIndex) =0; // Reads a vector variable from the source
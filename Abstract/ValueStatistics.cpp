@@ -0,0 +1,104 @@
+/***********************************************************************
+ValueStatistics - Class to accumulate the number, range, mean, variance,
+and histogram of a stream of scalar values in a single pass.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Abstract/ValueStatistics.h>
+
+#include <Math/Math.h>
+
+namespace Visualization {
+
+namespace Abstract {
+
+/********************************
+Methods of class ValueStatistics:
+********************************/
+
+ValueStatistics::ValueStatistics(void)
+	:numValues(0),valueRange(0.0,0.0),
+	 mean(0.0),sqrDeviation(0.0),
+	 histogramRange(0.0,0.0),binScale(0.0)
+	{
+	}
+
+ValueStatistics::ValueStatistics(const ValueStatistics::ValueRange& sHistogramRange,unsigned int numBins)
+	:numValues(0),valueRange(0.0,0.0),
+	 mean(0.0),sqrDeviation(0.0),
+	 histogramRange(sHistogramRange),binScale(0.0),
+	 bins(numBins,0)
+	{
+	/* Calculate the bin scale factor; an empty histogram range counts all values in the first bin: */
+	if(numBins>0&&histogramRange.second>histogramRange.first)
+		binScale=double(numBins)/(histogramRange.second-histogramRange.first);
+	}
+
+double ValueStatistics::getStdDeviation(void) const
+	{
+	return Math::sqrt(getVariance());
+	}
+
+size_t ValueStatistics::getMaxBin(void) const
+	{
+	size_t result=0;
+	for(std::vector<size_t>::const_iterator bIt=bins.begin();bIt!=bins.end();++bIt)
+		if(result<*bIt)
+			result=*bIt;
+	
+	return result;
+	}
+
+double ValueStatistics::calcPercentile(double percentile) const
+	{
+	/* Clamp the percentile to the valid range: */
+	if(percentile<=0.0||numValues==0)
+		return valueRange.first;
+	if(percentile>=1.0)
+		return valueRange.second;
+	
+	/* Interpolate the value range if there is no histogram: */
+	if(binScale==0.0)
+		return valueRange.first+(valueRange.second-valueRange.first)*percentile;
+	
+	/* Find the histogram bin containing the requested percentile: */
+	double target=double(numValues)*percentile;
+	double before=0.0;
+	unsigned int binIndex=0;
+	while(binIndex<bins.size()-1&&before+double(bins[binIndex])<target)
+		{
+		before+=double(bins[binIndex]);
+		++binIndex;
+		}
+	
+	/* Interpolate linearly inside the bin and clamp the result to the range of accumulated values: */
+	double fraction=bins[binIndex]>0?(target-before)/double(bins[binIndex]):0.0;
+	double result=histogramRange.first+(double(binIndex)+fraction)/binScale;
+	if(result<valueRange.first)
+		result=valueRange.first;
+	else if(result>valueRange.second)
+		result=valueRange.second;
+	
+	return result;
+	}
+
+}
+
+}
@@ -0,0 +1,122 @@
+/***********************************************************************
+ValueStatistics - Class to accumulate the number, range, mean, variance,
+and histogram of a stream of scalar values in a single pass.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef VISUALIZATION_ABSTRACT_VALUESTATISTICS_INCLUDED
+#define VISUALIZATION_ABSTRACT_VALUESTATISTICS_INCLUDED
+
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+namespace Visualization {
+
+namespace Abstract {
+
+class ValueStatistics
+	{
+	/* Embedded classes: */
+	public:
+	typedef std::pair<double,double> ValueRange; // Type for ranges of scalar values
+	
+	/* Elements: */
+	private:
+	size_t numValues; // Number of accumulated values
+	ValueRange valueRange; // Range of accumulated values
+	double mean; // Mean of accumulated values
+	double sqrDeviation; // Sum of squared deviations of accumulated values from their mean
+	ValueRange histogramRange; // Value range covered by the histogram
+	double binScale; // Scale factor from values to fractional histogram bin indices
+	std::vector<size_t> bins; // Histogram of accumulated values; values outside the histogram range are counted in the first or last bin
+	
+	/* Constructors and destructors: */
+	public:
+	ValueStatistics(void); // Creates empty statistics without a histogram
+	ValueStatistics(const ValueRange& sHistogramRange,unsigned int numBins); // Creates empty statistics with a histogram of the given number of bins covering the given value range
+	
+	/* Methods: */
+	void addValue(double value) // Adds a value to the statistics
+		{
+		/* Update the value range: */
+		if(numValues==0)
+			valueRange.first=valueRange.second=value;
+		else if(valueRange.first>value)
+			valueRange.first=value;
+		else if(valueRange.second<value)
+			valueRange.second=value;
+		
+		/* Update the mean and the sum of squared deviations using Welford's method: */
+		++numValues;
+		double delta=value-mean;
+		mean+=delta/double(numValues);
+		sqrDeviation+=delta*(value-mean);
+		
+		/* Update the histogram: */
+		if(!bins.empty())
+			{
+			double binIndex=(value-histogramRange.first)*binScale;
+			if(binIndex>=double(bins.size()))
+				++bins.back();
+			else if(binIndex>0.0)
+				++bins[size_t(binIndex)];
+			else
+				++bins.front();
+			}
+		}
+	size_t getNumValues(void) const // Returns the number of accumulated values
+		{
+		return numValues;
+		}
+	const ValueRange& getValueRange(void) const // Returns the range of accumulated values
+		{
+		return valueRange;
+		}
+	double getMean(void) const // Returns the mean of accumulated values
+		{
+		return mean;
+		}
+	double getVariance(void) const // Returns the population variance of accumulated values
+		{
+		return numValues>0?sqrDeviation/double(numValues):0.0;
+		}
+	double getStdDeviation(void) const; // Returns the population standard deviation of accumulated values
+	const ValueRange& getHistogramRange(void) const // Returns the value range covered by the histogram
+		{
+		return histogramRange;
+		}
+	unsigned int getNumBins(void) const // Returns the number of histogram bins
+		{
+		return (unsigned int)(bins.size());
+		}
+	size_t getBin(unsigned int binIndex) const // Returns the number of values counted in the given histogram bin
+		{
+		return bins[binIndex];
+		}
+	size_t getMaxBin(void) const; // Returns the largest number of values counted in any histogram bin
+	double calcPercentile(double percentile) const; // Returns an estimate of the value below which the given fraction of accumulated values lie, interpolating linearly inside histogram bins
+	};
+
+}
+
+}
+
+#endif
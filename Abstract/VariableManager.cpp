@@ -1,7 +1,7 @@
 /***********************************************************************
 VariableManager - Helper class to manage the scalar and vector variables
 that can be extracted from a data set.
-Copyright (c) 2008-2023 Oliver Kreylos
+Copyright (c) 2008-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,12 +25,19 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string.h>
 #include <stdio.h>
 #include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <Misc/StdError.h>
 #include <Misc/CreateNumberedFileName.h>
+#include <Math/Math.h>
 #include <GL/gl.h>
 #include <GL/GLContextData.h>
 #include <GL/GLColorMap.h>
 #include <GLMotif/StyleSheet.h>
 #include <GLMotif/PopupWindow.h>
+#include <Threads/Thread.h>
+#include <Threads/Mutex.h>
 #include <SceneGraph/GLRenderState.h>
 #include <Vrui/Vrui.h>
 
@@ -39,11 +46,121 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <ColorBar.h>
 #include <ColorMap.h>
+#include <ParallelTasks.h>
 
 namespace Visualization {
 
 namespace Abstract {
 
+namespace {
+
+/**************************************************************
+Helper structures to calculate variable statistics in parallel:
+**************************************************************/
+
+struct StatisticsTask // Structure describing the calculation of one variable's statistics
+	{
+	/* Elements: */
+	public:
+	const DataSet* dataSet; // Data set containing the variable
+	int variableIndex; // Index of the scalar or vector variable
+	ScalarExtractor* scalarExtractor; // Scalar extractor for a scalar variable, or null
+	const VectorExtractor* vectorExtractor; // Vector extractor for a vector variable, or null
+	bool calcValueRange; // Flag whether the variable's value range must be calculated before its statistics
+	DataSet::VScalarRange valueRange; // Value range of the variable, which is covered by the statistics' histogram
+	unsigned int numBins; // Number of histogram bins
+	ValueStatistics* statistics; // The calculated statistics, or null if the calculation failed
+	std::string error; // Error message if the calculation failed
+	};
+
+struct StatisticsTaskQueue // Structure to hand out statistics calculation tasks to a pool of threads
+	{
+	/* Elements: */
+	public:
+	Threads::Mutex mutex; // Mutex serializing access to the queue
+	std::vector<StatisticsTask>& tasks; // List of tasks
+	size_t nextTaskIndex; // Index of the next task to hand out
+	volatile bool cancel; // Flag to stop handing out tasks and to abandon the tasks currently running
+	
+	/* Constructors and destructors: */
+	StatisticsTaskQueue(std::vector<StatisticsTask>& sTasks)
+		:tasks(sTasks),nextTaskIndex(0),cancel(false)
+		{
+		}
+	};
+
+void* statisticsThreadFunction(StatisticsTaskQueue* queue)
+	{
+	while(true)
+		{
+		/* Grab the next task from the queue: */
+		StatisticsTask* task;
+		{
+		Threads::Mutex::Lock queueLock(queue->mutex);
+		if(queue->cancel||queue->nextTaskIndex==queue->tasks.size())
+			break;
+		task=&queue->tasks[queue->nextTaskIndex];
+		++queue->nextTaskIndex;
+		}
+		
+		try
+			{
+			if(task->scalarExtractor!=0)
+				{
+				/* Calculate the scalar variable's value range if it is not known yet and check for and correct an empty range: */
+				if(task->calcValueRange)
+					{
+					task->valueRange=task->dataSet->calcScalarValueRange(task->scalarExtractor);
+					if(task->valueRange.first==task->valueRange.second)
+						{
+						task->valueRange.first-=1.0;
+						task->valueRange.second+=1.0;
+						}
+					}
+				
+				/* Calculate the scalar variable's statistics: */
+				task->statistics=new ValueStatistics(task->dataSet->calcScalarValueStatistics(task->scalarExtractor,task->valueRange,task->numBins,&queue->cancel));
+				}
+			else
+				{
+				/* Calculate the vector variable's magnitude range and statistics: */
+				task->valueRange=task->dataSet->calcVectorValueMagnitudeRange(task->vectorExtractor);
+				task->statistics=new ValueStatistics(task->dataSet->calcVectorValueMagnitudeStatistics(task->vectorExtractor,task->valueRange,task->numBins,&queue->cancel));
+				}
+			}
+		catch(const std::runtime_error& err)
+			{
+			/* Remember the error and carry on with the next task: */
+			task->error=err.what();
+			}
+		}
+	
+	return 0;
+	}
+
+}
+
+/****************************************************
+Declaration of struct VariableManager::StatisticsJob:
+****************************************************/
+
+struct VariableManager::StatisticsJob
+	{
+	/* Elements: */
+	public:
+	std::vector<StatisticsTask> tasks; // The single task calculating a scalar variable's statistics
+	StatisticsTaskQueue queue; // Queue handing the task to the background thread
+	Threads::Mutex doneMutex; // Mutex protecting the completion flag
+	bool done; // Flag whether the background thread finished the task
+	Threads::Thread thread; // The background thread
+	
+	/* Constructors and destructors: */
+	StatisticsJob(const StatisticsTask& task)
+		:tasks(1,task),queue(tasks),done(false)
+		{
+		}
+	};
+
 /************************************************
 Methods of class VariableManager::ScalarVariable:
 ************************************************/
@@ -52,7 +169,8 @@ VariableManager::ScalarVariable::ScalarVariable(void)
 	:scalarExtractor(0),
 	 colorMap(0),
 	 colorMapVersion(0),
-	 palette(0)
+	 palette(0),
+	 statistics(0)
 	{
 	}
 
@@ -61,6 +179,7 @@ VariableManager::ScalarVariable::~ScalarVariable(void)
 	delete scalarExtractor;
 	delete colorMap;
 	delete palette;
+	delete statistics;
 	}
 
 /************************************************
@@ -68,13 +187,15 @@ Methods of class VariableManager::VectorVariable:
 ************************************************/
 
 VariableManager::VectorVariable::VectorVariable(void)
-	:vectorExtractor(0)
+	:vectorExtractor(0),
+	 magnitudeStatistics(0)
 	{
 	}
 
 VariableManager::VectorVariable::~VectorVariable(void)
 	{
 	delete vectorExtractor;
+	delete magnitudeStatistics;
 	}
 
 /******************************************
@@ -104,29 +225,134 @@ VariableManager::DataItem::~DataItem(void)
 Methods of class VariableManager:
 ********************************/
 
-void VariableManager::prepareScalarVariable(int scalarVariableIndex)
+void VariableManager::prepareScalarVariable(int scalarVariableIndex,ScalarExtractor* scalarExtractor,const DataSet::VScalarRange& valueRange)
 	{
 	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
 	
+	/* Store the scalar extractor and its value range: */
+	sv.scalarExtractor=scalarExtractor;
+	sv.valueRange=valueRange;
+	
+	/* Create a 256-entry OpenGL color map for rendering: */
+	sv.colorMap=new GLColorMap(GLColorMap::GREYSCALE|GLColorMap::RAMP_ALPHA,1.0f,1.0f,sv.valueRange.first,sv.valueRange.second);
+	++sv.colorMapVersion;
+	
+	/* Initialize the color map range to the variable's full scalar range: */
+	sv.colorMapRange=sv.valueRange;
+	}
+
+void VariableManager::prepareScalarVariable(int scalarVariableIndex)
+	{
 	/* Get a new scalar extractor: */
-	sv.scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
+	ScalarExtractor* scalarExtractor=dataSet->getScalarExtractor(scalarVariableIndex);
 	
 	/* Calculate the scalar extractor's value range: */
-	sv.valueRange=dataSet->calcScalarValueRange(sv.scalarExtractor);
+	DataSet::VScalarRange valueRange=dataSet->calcScalarValueRange(scalarExtractor);
 	
 	/* Check for and correct an empty value range: */
-	if(sv.valueRange.first==sv.valueRange.second)
+	if(valueRange.first==valueRange.second)
 		{
-		sv.valueRange.first-=1.0;
-		sv.valueRange.second+=1.0;
+		valueRange.first-=1.0;
+		valueRange.second+=1.0;
 		}
 	
-	/* Create a 256-entry OpenGL color map for rendering: */
-	sv.colorMap=new GLColorMap(GLColorMap::GREYSCALE|GLColorMap::RAMP_ALPHA,1.0f,1.0f,sv.valueRange.first,sv.valueRange.second);
-	++sv.colorMapVersion;
+	prepareScalarVariable(scalarVariableIndex,scalarExtractor,valueRange);
+	}
+
+void VariableManager::updateHistogram(void)
+	{
+	ScalarVariable& sv=scalarVariables[currentScalarVariableIndex];
+	if(sv.statistics==0)
+		{
+		/* Clear the histogram until the current scalar variable's statistics are calculated: */
+		paletteEditor->getColorMap()->setHistogram(sv.valueRange,std::vector<GLfloat>());
+		
+		/* Calculate the statistics in the background unless another calculation is still running; frame() will start the calculation once that one finishes: */
+		if(statisticsJob==0)
+			{
+			StatisticsTask task;
+			task.dataSet=dataSet;
+			task.variableIndex=currentScalarVariableIndex;
+			task.scalarExtractor=sv.scalarExtractor;
+			task.vectorExtractor=0;
+			task.calcValueRange=false;
+			task.valueRange=sv.valueRange;
+			task.numBins=numStatisticsBins;
+			task.statistics=0;
+			statisticsJob=new StatisticsJob(task);
+			statisticsJob->thread.start(this,&VariableManager::statisticsJobThreadMethod);
+			}
+		
+		return;
+		}
 	
-	/* Initialize the color map range to the variable's full scalar range: */
-	sv.colorMapRange=sv.valueRange;
+	/* Convert the current scalar variable's histogram to logarithmically scaled relative bin heights: */
+	const ValueStatistics& statistics=*sv.statistics;
+	std::vector<GLfloat> histogram;
+	size_t maxBin=statistics.getMaxBin();
+	if(maxBin>0)
+		{
+		double heightScale=1.0/Math::log(double(maxBin)+1.0);
+		for(unsigned int i=0;i<statistics.getNumBins();++i)
+			histogram.push_back(GLfloat(Math::log(double(statistics.getBin(i))+1.0)*heightScale));
+		}
+	
+	/* Show the histogram behind the palette editor's color map: */
+	paletteEditor->getColorMap()->setHistogram(statistics.getHistogramRange(),histogram);
+	}
+
+void* VariableManager::statisticsJobThreadMethod(void)
+	{
+	/* Run the statistics task: */
+	statisticsThreadFunction(&statisticsJob->queue);
+	
+	/* Notify the main thread: */
+	{
+	Threads::Mutex::Lock doneLock(statisticsJob->doneMutex);
+	statisticsJob->done=true;
+	}
+	Vrui::requestUpdate();
+	
+	return 0;
+	}
+
+void VariableManager::finishStatisticsJob(void)
+	{
+	if(statisticsJob==0)
+		return;
+	
+	/* Wait for the background thread to finish: */
+	statisticsJob->thread.join();
+	
+	/* Store the calculated statistics: */
+	StatisticsTask& task=statisticsJob->tasks.front();
+	ScalarVariable& sv=scalarVariables[task.variableIndex];
+	if(task.error.empty())
+		sv.statistics=task.statistics;
+	else
+		{
+		/* Store empty statistics so that the failed calculation is not repeated: */
+		std::cerr<<"Unable to calculate statistics of scalar variable "<<dataSet->getScalarVariableName(task.variableIndex)<<" due to exception "<<task.error<<std::endl;
+		sv.statistics=new ValueStatistics(task.valueRange,task.numBins);
+		}
+	
+	delete statisticsJob;
+	statisticsJob=0;
+	}
+
+void VariableManager::cancelStatisticsJob(void)
+	{
+	if(statisticsJob==0)
+		return;
+	
+	/* Tell the background thread to abandon its calculation and wait for it to finish: */
+	statisticsJob->queue.cancel=true;
+	statisticsJob->thread.join();
+	
+	/* Discard the partial statistics: */
+	delete statisticsJob->tasks.front().statistics;
+	delete statisticsJob;
+	statisticsJob=0;
 	}
 
 void VariableManager::colorMapChangedCallback(Misc::CallbackData* cbData)
@@ -154,6 +380,23 @@ void VariableManager::savePaletteCallback(Misc::CallbackData* cbData)
 		}
 	}
 
+void VariableManager::initVariables(void)
+	{
+	/* Initialize the scalar variable array: */
+	numScalarVariables=dataSet->getNumScalarVariables();
+	if(numScalarVariables>0)
+		scalarVariables=new ScalarVariable[numScalarVariables];
+	
+	/* Initialize the vector variable array: */
+	numVectorVariables=dataSet->getNumVectorVariables();
+	if(numVectorVariables>0)
+		vectorVariables=new VectorVariable[numVectorVariables];
+	
+	/* Initialize the current variable state: */
+	setCurrentScalarVariable(0);
+	setCurrentVectorVariable(0);
+	}
+
 VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName)
 	:GLObject(false),
 	 dataSet(sDataSet),
@@ -162,7 +405,9 @@ VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultCol
 	 colorBarDialogPopup(0),colorBar(0),
 	 paletteEditor(0),
 	 vectorVariables(0),
-	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1)
+	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1),
+	 numStatisticsBins(256),numStatisticsThreads(ParallelTasks::getNumCpus()),
+	 statisticsJob(0)
 	{
 	if(sDefaultColorMapName!=0)
 		{
@@ -172,11 +417,6 @@ VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultCol
 		memcpy(defaultColorMapName,sDefaultColorMapName,nameLength+1);
 		}
 	
-	/* Initialize the scalar variable array: */
-	numScalarVariables=dataSet->getNumScalarVariables();
-	if(numScalarVariables>0)
-		scalarVariables=new ScalarVariable[numScalarVariables];
-	
 	/* Get the style sheet: */
 	const GLMotif::StyleSheet& ss=*Vrui::getUiStyleSheet();
 	
@@ -191,20 +431,33 @@ VariableManager::VariableManager(const DataSet* sDataSet,const char* sDefaultCol
 	paletteEditor->getColorMapChangedCallbacks().add(this,&VariableManager::colorMapChangedCallback);
 	paletteEditor->getSavePaletteCallbacks().add(this,&VariableManager::savePaletteCallback);
 	
-	/* Initialize the vector variable array: */
-	numVectorVariables=dataSet->getNumVectorVariables();
-	if(numVectorVariables>0)
-		vectorVariables=new VectorVariable[numVectorVariables];
-	
-	/* Initialize the current variable state: */
-	setCurrentScalarVariable(0);
-	setCurrentVectorVariable(0);
+	/* Initialize the scalar and vector variables: */
+	initVariables();
 	
 	GLObject::init();
 	}
 
+VariableManager::VariableManager(const DataSet* sDataSet)
+	:GLObject(false),
+	 dataSet(sDataSet),
+	 defaultColorMapName(0),
+	 scalarVariables(0),
+	 colorBarDialogPopup(0),colorBar(0),
+	 paletteEditor(0),
+	 vectorVariables(0),
+	 currentScalarVariableIndex(-1),currentVectorVariableIndex(-1),
+	 numStatisticsBins(256),numStatisticsThreads(ParallelTasks::getNumCpus()),
+	 statisticsJob(0)
+	{
+	/* Initialize the scalar and vector variables: */
+	initVariables();
+	}
+
 VariableManager::~VariableManager(void)
 	{
+	/* Abandon any background statistics calculation: */
+	cancelStatisticsJob();
+	
 	delete[] defaultColorMapName;
 	delete[] scalarVariables;
 	delete[] vectorVariables;
@@ -263,6 +516,13 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	if(sv.scalarExtractor==0)
 		prepareScalarVariable(newCurrentScalarVariableIndex);
 	
+	/* Bail out if there is no user interface to update: */
+	if(paletteEditor==0)
+		{
+		currentScalarVariableIndex=newCurrentScalarVariableIndex;
+		return;
+		}
+	
 	/* Save the palette editor's current palette: */
 	if(currentScalarVariableIndex>=0)
 		scalarVariables[currentScalarVariableIndex].palette=paletteEditor->getPalette();
@@ -309,6 +569,9 @@ void VariableManager::setCurrentScalarVariable(int newCurrentScalarVariableIndex
 	colorBarDialogPopup->setTitleString(title);
 	colorBar->setColorMap(sv.colorMap);
 	colorBar->setValueRange(sv.valueRange.first,sv.valueRange.second);
+	
+	/* Update the palette editor's histogram: */
+	updateHistogram();
 	}
 
 void VariableManager::setCurrentVectorVariable(int newCurrentVectorVariableIndex)
@@ -404,9 +667,180 @@ int VariableManager::getVectorVariable(const VectorExtractor* vectorExtractor) c
 	return -1;
 	}
 
+void VariableManager::setNumStatisticsBins(unsigned int newNumStatisticsBins)
+	{
+	if(numStatisticsBins==newNumStatisticsBins)
+		return;
+	
+	/* Discard all cached statistics: */
+	cancelStatisticsJob();
+	numStatisticsBins=newNumStatisticsBins;
+	for(int i=0;i<numScalarVariables;++i)
+		{
+		delete scalarVariables[i].statistics;
+		scalarVariables[i].statistics=0;
+		}
+	for(int i=0;i<numVectorVariables;++i)
+		{
+		delete vectorVariables[i].magnitudeStatistics;
+		vectorVariables[i].magnitudeStatistics=0;
+		}
+	
+	/* Recalculate the palette editor's histogram: */
+	if(paletteEditor!=0&&currentScalarVariableIndex>=0)
+		updateHistogram();
+	}
+
+void VariableManager::setNumStatisticsThreads(unsigned int newNumStatisticsThreads)
+	{
+	numStatisticsThreads=newNumStatisticsThreads>0?newNumStatisticsThreads:1;
+	}
+
+const ValueStatistics& VariableManager::getScalarValueStatistics(int scalarVariableIndex)
+	{
+	if(scalarVariableIndex<0||scalarVariableIndex>=numScalarVariables)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid variable index %d",scalarVariableIndex);
+	
+	/* Check if the scalar variable's statistics have not been requested before, including by a background calculation: */
+	finishStatisticsJob();
+	ScalarVariable& sv=scalarVariables[scalarVariableIndex];
+	if(sv.statistics==0)
+		{
+		/* Calculate statistics with a histogram covering the scalar variable's value range: */
+		if(sv.scalarExtractor==0)
+			prepareScalarVariable(scalarVariableIndex);
+		sv.statistics=new ValueStatistics(dataSet->calcScalarValueStatistics(sv.scalarExtractor,sv.valueRange,numStatisticsBins));
+		}
+	
+	return *sv.statistics;
+	}
+
+const ValueStatistics& VariableManager::getVectorValueMagnitudeStatistics(int vectorVariableIndex)
+	{
+	if(vectorVariableIndex<0||vectorVariableIndex>=numVectorVariables)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid variable index %d",vectorVariableIndex);
+	
+	/* Check if the vector variable's statistics have not been requested before: */
+	finishStatisticsJob();
+	VectorVariable& vv=vectorVariables[vectorVariableIndex];
+	if(vv.magnitudeStatistics==0)
+		{
+		/* Calculate statistics with a histogram covering the vector variable's magnitude range: */
+		const VectorExtractor* vectorExtractor=getVectorExtractor(vectorVariableIndex);
+		DataSet::VScalarRange magnitudeRange=dataSet->calcVectorValueMagnitudeRange(vectorExtractor);
+		vv.magnitudeStatistics=new ValueStatistics(dataSet->calcVectorValueMagnitudeStatistics(vectorExtractor,magnitudeRange,numStatisticsBins));
+		}
+	
+	return *vv.magnitudeStatistics;
+	}
+
+void VariableManager::calcStatistics(void)
+	{
+	/* Wait for any background calculation so that no variable's statistics are calculated twice: */
+	finishStatisticsJob();
+	
+	/* Create a task for each scalar variable whose statistics are not cached: */
+	std::vector<StatisticsTask> tasks;
+	for(int i=0;i<numScalarVariables;++i)
+		if(scalarVariables[i].statistics==0)
+			{
+			StatisticsTask task;
+			task.dataSet=dataSet;
+			task.variableIndex=i;
+			task.calcValueRange=scalarVariables[i].scalarExtractor==0;
+			if(task.calcValueRange)
+				{
+				/* Calculate the unprepared scalar variable's value range in the background as well: */
+				task.scalarExtractor=dataSet->getScalarExtractor(i);
+				}
+			else
+				{
+				task.scalarExtractor=scalarVariables[i].scalarExtractor;
+				task.valueRange=scalarVariables[i].valueRange;
+				}
+			task.vectorExtractor=0;
+			task.numBins=numStatisticsBins;
+			task.statistics=0;
+			tasks.push_back(task);
+			}
+	
+	/* Create a task for each vector variable whose statistics are not cached: */
+	for(int i=0;i<numVectorVariables;++i)
+		if(vectorVariables[i].magnitudeStatistics==0)
+			{
+			StatisticsTask task;
+			task.dataSet=dataSet;
+			task.variableIndex=i;
+			task.scalarExtractor=0;
+			task.vectorExtractor=getVectorExtractor(i);
+			task.calcValueRange=true;
+			task.numBins=numStatisticsBins;
+			task.statistics=0;
+			tasks.push_back(task);
+			}
+	if(tasks.empty())
+		return;
+	
+	/* Run the tasks in a pool of background threads and the calling thread: */
+	StatisticsTaskQueue queue(tasks);
+	unsigned int numThreads=numStatisticsThreads;
+	if(numThreads>tasks.size())
+		numThreads=(unsigned int)(tasks.size());
+	ParallelTasks::runSharedTask(&queue,numThreads,statisticsThreadFunction);
+	
+	/* Store the results of all tasks: */
+	std::string error;
+	for(std::vector<StatisticsTask>::iterator tIt=tasks.begin();tIt!=tasks.end();++tIt)
+		{
+		if(tIt->scalarExtractor!=0)
+			{
+			/* Finish preparing a previously unprepared scalar variable: */
+			if(tIt->calcValueRange)
+				{
+				if(tIt->error.empty())
+					prepareScalarVariable(tIt->variableIndex,tIt->scalarExtractor,tIt->valueRange);
+				else
+					delete tIt->scalarExtractor;
+				}
+			scalarVariables[tIt->variableIndex].statistics=tIt->statistics;
+			}
+		else
+			vectorVariables[tIt->variableIndex].magnitudeStatistics=tIt->statistics;
+		
+		/* Remember the first error: */
+		if(error.empty())
+			error=tIt->error;
+		}
+	
+	if(!error.empty())
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unable to calculate variable statistics due to exception %s",error.c_str());
+	}
+
+void VariableManager::frame(void)
+	{
+	/* Check if a background statistics calculation has finished: */
+	if(statisticsJob!=0)
+		{
+		bool done;
+		{
+		Threads::Mutex::Lock doneLock(statisticsJob->doneMutex);
+		done=statisticsJob->done;
+		}
+		if(done)
+			{
+			/* Store the result and show the current scalar variable's histogram, or start calculating it if the finished calculation was for a different variable: */
+			finishStatisticsJob();
+			if(paletteEditor!=0&&currentScalarVariableIndex>=0)
+				updateHistogram();
+			}
+		}
+	}
+
 void VariableManager::showColorBar(bool show)
 	{
 	/* Hide or show color bar dialog based on parameter: */
+	if(colorBarDialogPopup==0)
+		return;
 	if(show)
 		Vrui::popupPrimaryWidget(colorBarDialogPopup);
 	else
@@ -416,6 +850,8 @@ void VariableManager::showColorBar(bool show)
 void VariableManager::showPaletteEditor(bool show)
 	{
 	/* Hide or show color palette editor dialog based on parameter: */
+	if(paletteEditor==0)
+		return;
 	if(show)
 		Vrui::popupPrimaryWidget(paletteEditor);
 	else
@@ -430,6 +866,9 @@ void VariableManager::createPalette(int newPaletteType)
 	typedef ColorMap::ColorMapValue Color;
 	typedef ColorMap::ControlPoint ControlPoint;
 	
+	if(paletteEditor==0)
+		return;
+	
 	/* Get the current color map's value range: */
 	const ValueRange& valueRange=paletteEditor->getColorMap()->getValueRange();
 	double o=valueRange.first;
@@ -540,12 +979,15 @@ void VariableManager::createPalette(int newPaletteType)
 void VariableManager::loadPalette(const char* paletteFileName)
 	{
 	/* Load the given palette file: */
+	if(paletteEditor==0)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Variable manager has no palette editor");
 	paletteEditor->loadPalette(paletteFileName,scalarVariables[currentScalarVariableIndex].valueRange);
 	}
 
 void VariableManager::insertPaletteEditorControlPoint(double newControlPoint)
 	{
-	paletteEditor->getColorMap()->insertControlPoint(newControlPoint);
+	if(paletteEditor!=0)
+		paletteEditor->getColorMap()->insertControlPoint(newControlPoint);
 	}
 
 void VariableManager::bindColorMap(int scalarVariableIndex,SceneGraph::GLRenderState& renderState) const
@@ -1,7 +1,7 @@
 /***********************************************************************
 VariableManager - Helper class to manage the scalar and vector variables
 that can be extracted from a data set.
-Copyright (c) 2008-2023 Oliver Kreylos
+Copyright (c) 2008-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -73,6 +73,7 @@ class VariableManager:public GLObject
 		unsigned int colorMapVersion; // Version number of the color map
 		DataSet::VScalarRange colorMapRange; // Scalar variable range that is mapped to the full extent of the color map
 		PaletteEditor::Storage* palette; // Pointer to palette editor state for the scalar variable
+		ValueStatistics* statistics; // Value statistics of the scalar variable, or null if not yet calculated
 		
 		/* Constructors and destructors: */
 		ScalarVariable(void);
@@ -84,12 +85,15 @@ class VariableManager:public GLObject
 		/* Elements: */
 		public:
 		VectorExtractor* vectorExtractor; // Vector extractor for the vector variable
+		ValueStatistics* magnitudeStatistics; // Statistics of the vector variable's magnitude, or null if not yet calculated
 		
 		/* Constructors and destructors: */
 		VectorVariable(void);
 		~VectorVariable(void);
 		};
 	
+	struct StatisticsJob; // Structure describing a scalar variable's statistics calculation running in a background thread
+	
 	struct DataItem:public GLObject::DataItem // Structure containing the variable manager's per-OpenGL context state
 		{
 		/* Elements: */
@@ -115,21 +119,39 @@ class VariableManager:public GLObject
 	VectorVariable* vectorVariables; // Array of vector variables for the data set; initialized on demand
 	int currentScalarVariableIndex; // The index of the currently selected scalar variable
 	int currentVectorVariableIndex; // The index of the currently selected vector variable
+	unsigned int numStatisticsBins; // Number of histogram bins in variable statistics
+	unsigned int numStatisticsThreads; // Maximum number of threads used to calculate variable statistics in parallel
+	StatisticsJob* statisticsJob; // Statistics calculation for the palette editor's histogram running in the background, or null
 	
 	/* Private methods: */
+	void prepareScalarVariable(int scalarVariableIndex,ScalarExtractor* scalarExtractor,const DataSet::VScalarRange& valueRange); // Prepares the given scalar variable with the given scalar extractor and value range
 	void prepareScalarVariable(int scalarVariableIndex);
+	void updateHistogram(void); // Shows the current scalar variable's histogram in the palette editor, or starts calculating it in the background if it is not cached
+	void* statisticsJobThreadMethod(void); // Thread method running the current background statistics calculation
+	void finishStatisticsJob(void); // Waits for the current background statistics calculation to finish and stores its result
+	void cancelStatisticsJob(void); // Abandons the current background statistics calculation and discards its result
 	void colorMapChangedCallback(Misc::CallbackData* cbData);
 	void savePaletteCallback(Misc::CallbackData* cbData);
+	void initVariables(void); // Initializes the scalar and vector variable arrays and selects the first variables
 	
 	/* Constructors and destructors: */
 	public:
 	VariableManager(const DataSet* sDataSet,const char* sDefaultColorMapName); // Creates variable manager for the given data set
+	VariableManager(const DataSet* sDataSet); // Creates a variable manager without user interface for batch processing outside of a Vrui environment
 	virtual ~VariableManager(void);
 	
 	/* Methods from GLObject: */
 	virtual void initContext(GLContextData& contextData) const;
 	
 	/* New methods: */
+	const DataSet* getDataSet(void) const // Returns the data set containing the scalar and vector variables
+		{
+		return dataSet;
+		}
+	bool hasUserInterface(void) const // Returns true if the variable manager has a color bar and palette editor
+		{
+		return paletteEditor!=0;
+		}
 	int getNumScalarVariables(void) const // Returns the number of scalar variables in the data set
 		{
 		return numScalarVariables;
@@ -167,6 +189,16 @@ class VariableManager:public GLObject
 	const DataSet::VScalarRange& getScalarColorMapRange(int scalarVariableIndex); // Returns the value range of the given scalar variable that is mapped to the full extent of the color map
 	const VectorExtractor* getVectorExtractor(int vectorVariableIndex); // Returns a new vector extractor for the given vector variable
 	int getVectorVariable(const VectorExtractor* vectorExtractor) const; // Returns the index of the given vector extractor
+	unsigned int getNumStatisticsBins(void) const // Returns the number of histogram bins in variable statistics
+		{
+		return numStatisticsBins;
+		}
+	void setNumStatisticsBins(unsigned int newNumStatisticsBins); // Sets the number of histogram bins in variable statistics; invalidates all cached statistics
+	void setNumStatisticsThreads(unsigned int newNumStatisticsThreads); // Sets the maximum number of threads used to calculate variable statistics in parallel
+	const ValueStatistics& getScalarValueStatistics(int scalarVariableIndex); // Returns the value statistics of the given scalar variable, with a histogram covering its value range; calculates them if not cached
+	const ValueStatistics& getVectorValueMagnitudeStatistics(int vectorVariableIndex); // Returns the statistics of the given vector variable's magnitude, with a histogram covering its magnitude range; calculates them if not cached
+	void calcStatistics(void); // Calculates the statistics of all scalar and vector variables that are not cached, in parallel
+	void frame(void); // Shows the palette editor's histogram once its background calculation is finished; must be called once per frame from the main thread
 	const ScalarExtractor* getCurrentScalarExtractor(void) const // Returns the current scalar extractor
 		{
 		return scalarVariables[currentScalarVariableIndex].scalarExtractor;
@@ -0,0 +1,364 @@
+/***********************************************************************
+BrickedVolume - Class to represent a voxel block as a multiresolution
+hierarchy of bricks, and to select view-dependent sets of bricks that
+fit into a fixed-size brick atlas.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <BrickedVolume.h>
+
+#include <algorithm>
+#include <Math/Math.h>
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+const float infiniteError=1.0e30f; // Projected voxel size of bricks containing the eye position
+
+inline unsigned int clampIndex(int index,unsigned int size)
+	{
+	return index<0?0U:(index>=int(size)?size-1:(unsigned int)(index));
+	}
+
+struct BrickError // Structure to prioritize bricks during selection
+	{
+	/* Elements: */
+	public:
+	float error; // Projected voxel size of the brick
+	size_t brickIndex; // Global index of the brick
+	
+	/* Constructors and destructors: */
+	BrickError(float sError,size_t sBrickIndex)
+		:error(sError),brickIndex(sBrickIndex)
+		{
+		}
+	
+	/* Methods: */
+	friend bool operator<(const BrickError& be1,const BrickError& be2)
+		{
+		return be1.error<be2.error;
+		}
+	};
+
+}
+
+/*************************************
+Methods of class BrickedVolume::Cache:
+*************************************/
+
+BrickedVolume::Cache::Cache(const BrickedVolume& volume,const BrickedVolume::Size3& sNumSlots)
+	:numSlots(sNumSlots),
+	 brickSlots(volume.totalNumBricks,-1),
+	 slotBricks(numSlots.volume(),-1),
+	 pageTable(volume.levels[0].numBricks.volume()*4,Scalar(0)),
+	 quantizedPageTable(volume.levels[0].numBricks.volume()*4,0U),
+	 brickStamps(volume.totalNumBricks,0U),stamp(0),
+	 volumeVersion(volume.version),
+	 numSelected(0)
+	{
+	}
+
+/******************************
+Methods of class BrickedVolume:
+******************************/
+
+size_t BrickedVolume::getBrickIndex(const BrickedVolume::BrickID& brick) const
+	{
+	const Level& l=levels[brick.level];
+	return l.brickOffset+(size_t(brick.index[2])*size_t(l.numBricks[1])+size_t(brick.index[1]))*size_t(l.numBricks[0])+size_t(brick.index[0]);
+	}
+
+BrickedVolume::BrickID BrickedVolume::getBrick(size_t brickIndex) const
+	{
+	/* Find the level containing the brick: */
+	BrickID result;
+	result.level=0;
+	while(result.level+1<levels.size()&&levels[result.level+1].brickOffset<=brickIndex)
+		++result.level;
+	const Level& l=levels[result.level];
+	size_t index=brickIndex-l.brickOffset;
+	for(int i=0;i<3;++i)
+		{
+		result.index[i]=(unsigned int)(index%l.numBricks[i]);
+		index/=l.numBricks[i];
+		}
+	return result;
+	}
+
+BrickedVolume::BrickedVolume(const BrickedVolume::Size3& dataSize,unsigned int sBrickSize)
+	:brickSize(sBrickSize),
+	 totalNumBricks(0),
+	 version(0)
+	{
+	/* Create resolution levels until a single brick covers the entire volume: */
+	Size3 size=dataSize;
+	while(true)
+		{
+		Level l;
+		l.size=size;
+		l.data=0;
+		l.ownData=0;
+		ptrdiff_t stride=1;
+		bool single=true;
+		for(int i=0;i<3;++i)
+			{
+			l.strides[i]=stride;
+			stride*=ptrdiff_t(l.size[i]);
+			unsigned int numCells=l.size[i]>1?l.size[i]-1:1;
+			l.numBricks[i]=(numCells+brickSize-1)/brickSize;
+			if(l.numBricks[i]>1)
+				single=false;
+			}
+		l.brickOffset=totalNumBricks;
+		totalNumBricks+=l.numBricks.volume();
+		levels.push_back(l);
+		if(single)
+			break;
+		
+		/* Halve the number of cells for the next level, rounding up: */
+		for(int i=0;i<3;++i)
+			size[i]=size[i]>1?size[i]/2+1:1;
+		}
+	}
+
+BrickedVolume::~BrickedVolume(void)
+	{
+	for(std::vector<Level>::iterator lIt=levels.begin();lIt!=levels.end();++lIt)
+		delete[] lIt->ownData;
+	}
+
+void BrickedVolume::setData(const BrickedVolume::Voxel* data,const ptrdiff_t dataStrides[3])
+	{
+	/* Reference the full-resolution voxel block: */
+	levels[0].data=data;
+	for(int i=0;i<3;++i)
+		levels[0].strides[i]=dataStrides[i];
+	
+	/* Downsample each lower-resolution level from the next-higher one using a separable 1-2-1 tent filter: */
+	for(unsigned int level=1;level<levels.size();++level)
+		{
+		const Level& src=levels[level-1];
+		Level& dest=levels[level];
+		if(dest.ownData==0)
+			dest.ownData=new Voxel[dest.size.volume()];
+		Voxel* dPtr=dest.ownData;
+		for(unsigned int z=0;z<dest.size[2];++z)
+			for(unsigned int y=0;y<dest.size[1];++y)
+				for(unsigned int x=0;x<dest.size[0];++x,++dPtr)
+					{
+					unsigned int sum=0;
+					for(int dz=-1;dz<=1;++dz)
+						{
+						unsigned int wz=dz==0?2:1;
+						const Voxel* szPtr=src.data+clampIndex(int(z*2)+dz,src.size[2])*src.strides[2];
+						for(int dy=-1;dy<=1;++dy)
+							{
+							unsigned int wzy=wz*(dy==0?2:1);
+							const Voxel* syPtr=szPtr+clampIndex(int(y*2)+dy,src.size[1])*src.strides[1];
+							for(int dx=-1;dx<=1;++dx)
+								sum+=wzy*(dx==0?2:1)*(unsigned int)(syPtr[clampIndex(int(x*2)+dx,src.size[0])*src.strides[0]]);
+							}
+						}
+					*dPtr=Voxel((sum+32)/64);
+					}
+		dest.data=dest.ownData;
+		}
+	
+	/* Invalidate all caches: */
+	++version;
+	}
+
+void BrickedVolume::extractBrick(const BrickedVolume::BrickID& brick,BrickedVolume::Voxel* dest) const
+	{
+	const Level& l=levels[brick.level];
+	unsigned int slotSize=brickSize+1;
+	for(unsigned int z=0;z<slotSize;++z)
+		{
+		/* Replicate the volume's boundary voxels for bricks extending past the volume: */
+		const Voxel* zPtr=l.data+clampIndex(int(brick.index[2]*brickSize+z),l.size[2])*l.strides[2];
+		for(unsigned int y=0;y<slotSize;++y)
+			{
+			const Voxel* yPtr=zPtr+clampIndex(int(brick.index[1]*brickSize+y),l.size[1])*l.strides[1];
+			for(unsigned int x=0;x<slotSize;++x,++dest)
+				*dest=yPtr[clampIndex(int(brick.index[0]*brickSize+x),l.size[0])*l.strides[0]];
+			}
+		}
+	}
+
+void BrickedVolume::select(BrickedVolume::Cache& cache,const BrickedVolume::Scalar eyePos[3],BrickedVolume::Scalar lodError,size_t maxNumBricks) const
+	{
+	/* Flush the cache if the volume data changed since the last selection: */
+	if(cache.volumeVersion!=version)
+		{
+		std::fill(cache.brickSlots.begin(),cache.brickSlots.end(),-1);
+		std::fill(cache.slotBricks.begin(),cache.slotBricks.end(),-1);
+		cache.volumeVersion=version;
+		}
+	
+	/* Limit the selection to the number of available atlas slots: */
+	if(maxNumBricks>cache.slotBricks.size())
+		maxNumBricks=cache.slotBricks.size();
+	
+	/* Start with the lowest-resolution level, which consists of a single brick: */
+	std::vector<BrickError> heap;
+	std::vector<size_t> selection;
+	heap.push_back(BrickError(infiniteError,levels.back().brickOffset));
+	const Size3& fullSize=levels[0].size;
+	
+	/* Refine the brick with the largest projected voxel size until all bricks are good enough or the atlas is full: */
+	while(!heap.empty())
+		{
+		std::pop_heap(heap.begin(),heap.end());
+		BrickError be=heap.back();
+		heap.pop_back();
+		BrickID brick=getBrick(be.brickIndex);
+		
+		/* Check if the brick can be refined: */
+		bool refine=be.error>lodError&&brick.level>0;
+		unsigned int childMin[3],childMax[3];
+		size_t numChildren=1;
+		if(refine)
+			{
+			const Level& cl=levels[brick.level-1];
+			for(int i=0;i<3;++i)
+				{
+				childMin[i]=brick.index[i]*2;
+				childMax[i]=std::min(childMin[i]+2,cl.numBricks[i]);
+				numChildren*=childMax[i]-childMin[i];
+				}
+			refine=heap.size()+selection.size()+numChildren<=maxNumBricks;
+			}
+		
+		if(refine)
+			{
+			/* Replace the brick with its children: */
+			BrickID child;
+			child.level=brick.level-1;
+			Scalar childScale=Scalar(1U<<child.level)*Scalar(brickSize);
+			for(child.index[2]=childMin[2];child.index[2]<childMax[2];++child.index[2])
+				for(child.index[1]=childMin[1];child.index[1]<childMax[1];++child.index[1])
+					for(child.index[0]=childMin[0];child.index[0]<childMax[0];++child.index[0])
+						{
+						/* Calculate the distance from the eye to the child's bounding box in full-resolution voxel coordinates: */
+						Scalar dist2(0);
+						for(int i=0;i<3;++i)
+							{
+							Scalar bMin=Scalar(child.index[i])*childScale;
+							Scalar bMax=std::min(bMin+childScale,Scalar(fullSize[i]-1));
+							if(eyePos[i]<bMin)
+								dist2+=Math::sqr(bMin-eyePos[i]);
+							else if(eyePos[i]>bMax)
+								dist2+=Math::sqr(eyePos[i]-bMax);
+							}
+						
+						/* Calculate the child's projected voxel size: */
+						Scalar error=dist2>Scalar(0)?Scalar(1U<<child.level)/Math::sqrt(dist2):Scalar(infiniteError);
+						heap.push_back(BrickError(error,getBrickIndex(child)));
+						std::push_heap(heap.begin(),heap.end());
+						}
+			}
+		else
+			selection.push_back(be.brickIndex);
+		}
+	cache.numSelected=selection.size();
+	
+	/* Mark all selected bricks: */
+	++cache.stamp;
+	for(std::vector<size_t>::iterator sIt=selection.begin();sIt!=selection.end();++sIt)
+		cache.brickStamps[*sIt]=cache.stamp;
+	
+	/* Release the atlas slots of all bricks that are no longer selected: */
+	std::vector<int> freeSlots;
+	for(size_t slot=0;slot<cache.slotBricks.size();++slot)
+		{
+		int brickIndex=cache.slotBricks[slot];
+		if(brickIndex>=0&&cache.brickStamps[brickIndex]!=cache.stamp)
+			{
+			cache.brickSlots[brickIndex]=-1;
+			cache.slotBricks[slot]=-1;
+			brickIndex=-1;
+			}
+		if(brickIndex<0)
+			freeSlots.push_back(int(slot));
+		}
+	
+	/* Assign free slots to all newly selected bricks and update the page table: */
+	cache.uploads.clear();
+	unsigned int slotSize=brickSize+1;
+	const Size3& numBricks0=levels[0].numBricks;
+	for(std::vector<size_t>::iterator sIt=selection.begin();sIt!=selection.end();++sIt)
+		{
+		BrickID brick=getBrick(*sIt);
+		int slot=cache.brickSlots[*sIt];
+		if(slot<0&&!freeSlots.empty())
+			{
+			/* Allocate a slot and schedule the brick for upload: */
+			slot=freeSlots.back();
+			freeSlots.pop_back();
+			cache.brickSlots[*sIt]=slot;
+			cache.slotBricks[slot]=int(*sIt);
+			Upload upload;
+			upload.brick=brick;
+			int s=slot;
+			for(int i=0;i<3;++i)
+				{
+				upload.slot[i]=(unsigned int)(s%int(cache.numSlots[i]));
+				s/=int(cache.numSlots[i]);
+				}
+			cache.uploads.push_back(upload);
+			}
+		if(slot<0)
+			continue;
+		
+		/* Calculate the page table entry mapping full-resolution voxel coordinates to atlas texel coordinates: */
+		Scalar entry[4];
+		unsigned char quantizedEntry[4];
+		entry[3]=Scalar(1)/Scalar(1U<<brick.level);
+		quantizedEntry[3]=(unsigned char)(brick.level);
+		int s=slot;
+		unsigned int pMin[3],pMax[3];
+		for(int i=0;i<3;++i)
+			{
+			unsigned int slotIndex=(unsigned int)(s%int(cache.numSlots[i]));
+			s/=int(cache.numSlots[i]);
+			entry[i]=Scalar(slotIndex*slotSize)-Scalar(brick.index[i]*brickSize)+Scalar(0.5);
+			quantizedEntry[i]=(unsigned char)(slotIndex);
+			pMin[i]=brick.index[i]<<brick.level;
+			pMax[i]=std::min((brick.index[i]+1)<<brick.level,numBricks0[i]);
+			}
+		
+		/* Enter the page table entry for all full-resolution bricks covered by the brick: */
+		for(unsigned int z=pMin[2];z<pMax[2];++z)
+			for(unsigned int y=pMin[1];y<pMax[1];++y)
+				for(unsigned int x=pMin[0];x<pMax[0];++x)
+					{
+					size_t entryIndex=((size_t(z)*numBricks0[1]+y)*numBricks0[0]+x)*4;
+					Scalar* ptPtr=&cache.pageTable[entryIndex];
+					unsigned char* qptPtr=&cache.quantizedPageTable[entryIndex];
+					for(int i=0;i<4;++i)
+						{
+						ptPtr[i]=entry[i];
+						qptPtr[i]=quantizedEntry[i];
+						}
+					}
+		}
+	}
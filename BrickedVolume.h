@@ -0,0 +1,157 @@
+/***********************************************************************
+BrickedVolume - Class to represent a voxel block as a multiresolution
+hierarchy of bricks, and to select view-dependent sets of bricks that
+fit into a fixed-size brick atlas.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef BRICKEDVOLUME_INCLUDED
+#define BRICKEDVOLUME_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Misc/Size.h>
+
+class BrickedVolume
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::Size<3> Size3; // Type for 3D voxel block, brick grid, and atlas sizes
+	typedef unsigned short Voxel; // Type for voxel values
+	typedef float Scalar; // Scalar type for positions and page table entries
+	
+	struct BrickID // Structure identifying a brick in the hierarchy
+		{
+		/* Elements: */
+		public:
+		unsigned int level; // Resolution level, 0 is full resolution
+		unsigned int index[3]; // Brick's position in its level's brick grid
+		};
+	
+	struct Upload // Structure describing a brick that needs to be copied into the brick atlas
+		{
+		/* Elements: */
+		public:
+		BrickID brick; // The brick to upload
+		unsigned int slot[3]; // Position of the brick's atlas slot in units of slots
+		};
+	
+	class Cache // Class to track which bricks are currently resident in a brick atlas, and to select new brick sets
+		{
+		friend class BrickedVolume;
+		
+		/* Elements: */
+		private:
+		Size3 numSlots; // Number of brick slots in the atlas along each dimension
+		std::vector<int> brickSlots; // Slot index assigned to each brick in the hierarchy, or -1; indexed like the hierarchy's brick offsets
+		std::vector<int> slotBricks; // Global brick index stored in each slot, or -1 for free slots
+		std::vector<Scalar> pageTable; // Page table with four entries per full-resolution brick: atlas texel offset and voxel scale factor
+		std::vector<unsigned char> quantizedPageTable; // Page table with four entries per full-resolution brick for renderers without floating-point textures: atlas slot index and resolution level
+		std::vector<Upload> uploads; // List of bricks that must be uploaded into the atlas after the last selection
+		std::vector<unsigned int> brickStamps; // Selection stamp of each brick in the hierarchy, to mark the bricks in the current selection
+		unsigned int stamp; // Stamp value of the current selection
+		unsigned int volumeVersion; // Version number of the bricked volume's data at the time of the last selection
+		size_t numSelected; // Number of bricks in the last selection
+		
+		/* Constructors and destructors: */
+		public:
+		Cache(const BrickedVolume& volume,const Size3& sNumSlots); // Creates an empty brick cache with the given number of atlas slots
+		
+		/* Methods: */
+		const Size3& getNumSlots(void) const // Returns the number of atlas slots along each dimension
+			{
+			return numSlots;
+			}
+		const Scalar* getPageTable(void) const // Returns the current page table
+			{
+			return &pageTable[0];
+			}
+		const unsigned char* getQuantizedPageTable(void) const // Returns the current quantized page table
+			{
+			return &quantizedPageTable[0];
+			}
+		const std::vector<Upload>& getUploads(void) const // Returns the list of bricks that need to be uploaded into the atlas
+			{
+			return uploads;
+			}
+		size_t getNumSelected(void) const // Returns the number of bricks in the last selection
+			{
+			return numSelected;
+			}
+		};
+	
+	private:
+	struct Level // Structure describing one resolution level
+		{
+		/* Elements: */
+		public:
+		Size3 size; // Size of the level's voxel block
+		const Voxel* data; // Pointer to the level's voxel block
+		Voxel* ownData; // Voxel block allocated for lower-resolution levels, or null for the full-resolution level
+		ptrdiff_t strides[3]; // Strides of the level's voxel block
+		Size3 numBricks; // Number of bricks in the level along each dimension
+		size_t brickOffset; // Global index of the level's first brick
+		};
+	
+	/* Elements: */
+	unsigned int brickSize; // Number of voxel cells per brick along each dimension
+	std::vector<Level> levels; // List of resolution levels, from full resolution to one brick
+	size_t totalNumBricks; // Total number of bricks in all levels
+	unsigned int version; // Version number of the voxel data
+	
+	/* Private methods: */
+	size_t getBrickIndex(const BrickID& brick) const; // Returns the global index of the given brick
+	BrickID getBrick(size_t brickIndex) const; // Returns the brick of the given global index
+	
+	/* Constructors and destructors: */
+	public:
+	BrickedVolume(const Size3& dataSize,unsigned int sBrickSize); // Creates a bricked volume for a voxel block of the given size
+	private:
+	BrickedVolume(const BrickedVolume& source); // Prohibit copy constructor
+	BrickedVolume& operator=(const BrickedVolume& source); // Prohibit assignment operator
+	public:
+	~BrickedVolume(void);
+	
+	/* Methods: */
+	unsigned int getBrickSize(void) const // Returns the number of voxel cells per brick
+		{
+		return brickSize;
+		}
+	unsigned int getSlotSize(void) const // Returns the number of voxels per atlas slot along each dimension
+		{
+		return brickSize+1;
+		}
+	unsigned int getNumLevels(void) const // Returns the number of resolution levels
+		{
+		return levels.size();
+		}
+	const Size3& getLevelSize(unsigned int level) const // Returns the voxel block size of the given level
+		{
+		return levels[level].size;
+		}
+	const Size3& getNumBricks(unsigned int level) const // Returns the number of bricks of the given level
+		{
+		return levels[level].numBricks;
+		}
+	void setData(const Voxel* data,const ptrdiff_t dataStrides[3]); // Sets the full-resolution voxel block and recalculates all lower-resolution levels
+	void extractBrick(const BrickID& brick,Voxel* dest) const; // Copies the voxels of the given brick, including its far boundary, into a contiguous x-major array of getSlotSize()^3 voxels
+	void select(Cache& cache,const Scalar eyePos[3],Scalar lodError,size_t maxNumBricks) const; // Selects a set of bricks covering the volume for the given eye position in full-resolution voxel coordinates such that each brick's projected voxel size is below the given error, and updates the cache's page table and upload list
+	};
+
+#endif
@@ -1,7 +1,7 @@
 /***********************************************************************
 ColorMap - A widget to display color maps (one-dimensional transfer
 functions with RGB color and opacity).
-Copyright (c) 2005-2024 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -106,6 +106,7 @@ ColorMap::ColorMap(const char* sName,Container* sParent,bool sManageChild)
 	 selectedControlPointColor(1.0f,0.0f,0.0f),
 	 valueRange(0.0,1.0),
 	 first(0.0,ColorMapValue(0.0f,0.0f,0.0f,0.0f)),last(1.0,ColorMapValue(1.0f,1.0f,1.0f,1.0f)),
+	 histogramRange(0.0,1.0),
 	 selected(0),isDragging(false)
 	{
 	/* Link the first and last control points: */
@@ -201,6 +202,25 @@ void ColorMap::draw(GLContextData& contextData) const
 		glVertex3f(cpPtr->x,y1,z);
 		}
 	glEnd();
+	if(!histogram.empty())
+		{
+		/* Draw the histogram as a step curve clipped to the color map area: */
+		GLfloat x1=colorMapAreaBox.getCorner(0)[0];
+		GLfloat x2=colorMapAreaBox.getCorner(1)[0];
+		double xScale=double(x2-x1)/(valueRange.second-valueRange.first);
+		double binWidth=(histogramRange.second-histogramRange.first)/double(histogram.size());
+		glColor3f(0.5f,0.5f,0.5f);
+		glBegin(GL_LINE_STRIP);
+		for(size_t i=0;i<histogram.size();++i)
+			{
+			GLfloat bx1=Math::clamp(GLfloat((histogramRange.first+binWidth*double(i)-valueRange.first)*xScale)+x1,x1,x2);
+			GLfloat bx2=Math::clamp(GLfloat((histogramRange.first+binWidth*double(i+1)-valueRange.first)*xScale)+x1,x1,x2);
+			GLfloat by=histogram[i]*(y2-y1)+y1;
+			glVertex3f(bx1,by,z+marginWidth*0.125f);
+			glVertex3f(bx2,by,z+marginWidth*0.125f);
+			}
+		glEnd();
+		}
 	GLfloat lineWidth;
 	glGetFloatv(GL_LINE_WIDTH,&lineWidth);
 	glLineWidth(3.0f);
@@ -1034,4 +1054,11 @@ void ColorMap::saveColorMap(const char* colorMapFileName) const
 		fprintf(colorMapFile.getFilePtr(),"%f %f %f %f %f\n",cpPtr->value,cpPtr->color[0],cpPtr->color[1],cpPtr->color[2],cpPtr->color[3]);
 	}
 
+void ColorMap::setHistogram(const ColorMap::ValueRange& newHistogramRange,const std::vector<GLfloat>& newHistogram)
+	{
+	/* Store the new histogram: */
+	histogramRange=newHistogramRange;
+	histogram=newHistogram;
+	}
+
 }
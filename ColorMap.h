@@ -1,7 +1,7 @@
 /***********************************************************************
 ColorMap - A widget to display color maps (one-dimensional transfer
 functions with RGB color and opacity).
-Copyright (c) 2005-2008 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -160,6 +160,8 @@ class ColorMap:public Widget
 	ValueRange valueRange; // Range of color map values
 	ControlPoint first; // First control point
 	ControlPoint last; // Last control point
+	ValueRange histogramRange; // Range of values covered by the histogram
+	std::vector<GLfloat> histogram; // Relative heights of the bins of a histogram drawn behind the color map, or empty
 	Misc::CallbackList selectedControlPointChangedCallbacks; // List of callbacks to be called when the selected control point changes
 	Misc::CallbackList colorMapChangedCallbacks; // List of callbacks to be called when the color map changes
 	ControlPoint* selected; // Pointer to currently selected control point
@@ -227,6 +229,7 @@ class ColorMap:public Widget
 	void createColorMap(const std::vector<ControlPoint>& controlPoints); // Creates color map from the given vector of control points; control point values must be monotonically increasing
 	void loadColorMap(const char* colorMapFileName,const ValueRange& newValueRange); // Loads a color map from the given color map file and adjusts it to the given value range (without changing mappings)
 	void saveColorMap(const char* colorMapFileName) const; // Saves color map to the given file
+	void setHistogram(const ValueRange& newHistogramRange,const std::vector<GLfloat>& newHistogram); // Sets the histogram drawn behind the color map as a list of relative bin heights in [0, 1] covering the given value range
 	};
 
 }
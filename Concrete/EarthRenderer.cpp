@@ -1,7 +1,7 @@
 /***********************************************************************
 EarthRenderer - Class to render a configurable model of Earth using
 transparent surfaces and several interior components.
-Copyright (c) 2005-2025 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,12 +25,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Config.h>
 
 #include <string>
+#include <vector>
 #include <Math/Math.h>
 #include <Math/Constants.h>
+#include <Geometry/Point.h>
 #include <GL/gl.h>
 #include <GL/GLColorTemplates.h>
+#include <GL/GLVertexArrayParts.h>
 #include <GL/GLContextData.h>
-#include <GL/GLModels.h>
+#include <GL/Extensions/GLARBVertexBufferObject.h>
 #include <Images/Config.h>
 #include <Images/BaseImage.h>
 #include <Images/ReadImageFile.h>
@@ -41,20 +44,98 @@ namespace Visualization {
 
 namespace Concrete {
 
+namespace {
+
+/*********************************************************************
+Helper function to tessellate a flattened spheroid into a vertex grid:
+*********************************************************************/
+
+template <class VertexParam,class IndexParam>
+void
+tessellateSpheroid(
+	double radius,
+	double f,
+	int numStrips,
+	int numQuads,
+	std::vector<VertexParam>& vertices,
+	std::vector<IndexParam>& indices)
+	{
+	const double pi=Math::Constants<double>::pi;
+	
+	/* Create a grid of vertices at constant latitudes and longitudes: */
+	IndexParam baseIndex=IndexParam(vertices.size());
+	for(int i=0;i<=numStrips;++i)
+		{
+		float texY=float(i)/float(numStrips);
+		double lat=(pi*double(i))/double(numStrips)-0.5*pi;
+		double s=Math::sin(lat);
+		double c=Math::cos(lat);
+		double r=radius*(1.0-f*s*s);
+		double xy=r*c;
+		double z=r*s;
+		double nxy=(1.0-3.0*f*s*s)*c;
+		double nz=(1.0+3.0*f*c*c-f)*s;
+		double nl=Math::sqrt(nxy*nxy+nz*nz);
+		for(int j=0;j<=numQuads;++j)
+			{
+			double lng=(2.0*pi*double(j))/double(numQuads);
+			double cl=Math::cos(lng);
+			double sl=Math::sin(lng);
+			VertexParam v;
+			v.texCoord=typename VertexParam::TexCoord(float(j)/float(numQuads)+0.5f,texY);
+			v.normal=typename VertexParam::Normal(float(nxy*cl/nl),float(nxy*sl/nl),float(nz/nl));
+			v.position=typename VertexParam::Position(float(xy*cl),float(xy*sl),float(z));
+			vertices.push_back(v);
+			}
+		}
+	
+	/* Connect the vertex grid into counter-clockwise triangles: */
+	IndexParam rowLength=IndexParam(numQuads+1);
+	for(int i=1;i<=numStrips;++i)
+		{
+		IndexParam row0=baseIndex+IndexParam(i-1)*rowLength;
+		IndexParam row1=row0+rowLength;
+		for(int j=0;j<numQuads;++j)
+			{
+			indices.push_back(row1+j);
+			indices.push_back(row0+j);
+			indices.push_back(row0+j+1);
+			indices.push_back(row1+j);
+			indices.push_back(row0+j+1);
+			indices.push_back(row1+j+1);
+			}
+		}
+	}
+
+}
+
 /****************************************
 Methods of class EarthRenderer::DataItem:
 ****************************************/
 
 EarthRenderer::DataItem::DataItem(void)
-	:surfaceTextureObjectId(0),
-	 displayListIdBase(0),
-	 surfaceVersion(0),gridVersion(0),outerCoreVersion(0),innerCoreVersion(0)
+	:surfaceTextureObjectId(0)
 	{
 	/* Generate a texture object for the Earth's surface texture: */
 	glGenTextures(1,&surfaceTextureObjectId);
 	
-	/* Generate display lists for the Earth model components: */
-	displayListIdBase=glGenLists(4);
+	for(int i=0;i<NUMMESHES;++i)
+		{
+		vertexBufferIds[i]=0;
+		indexBufferIds[i]=0;
+		meshVersions[i]=0;
+		}
+	
+	/* Check if the vertex buffer object extension is supported: */
+	if(GLARBVertexBufferObject::isSupported())
+		{
+		/* Initialize the vertex buffer object extension: */
+		GLARBVertexBufferObject::initExtension();
+		
+		/* Create vertex and index buffer objects for the Earth model components: */
+		glGenBuffersARB(NUMMESHES,vertexBufferIds);
+		glGenBuffersARB(NUMMESHES,indexBufferIds);
+		}
 	}
 
 EarthRenderer::DataItem::~DataItem(void)
@@ -62,8 +143,12 @@ EarthRenderer::DataItem::~DataItem(void)
 	/* Delete the Earth surface texture object: */
 	glDeleteTextures(1,&surfaceTextureObjectId);
 	
-	/* Delete the Earth model components display lists: */
-	glDeleteLists(displayListIdBase,4);
+	/* Delete the Earth model components' buffer objects: */
+	if(vertexBufferIds[0]!=0)
+		{
+		glDeleteBuffersARB(NUMMESHES,vertexBufferIds);
+		glDeleteBuffersARB(NUMMESHES,indexBufferIds);
+		}
 	}
 
 /**************************************
@@ -77,120 +162,65 @@ const double EarthRenderer::flatteningFactor=1.0/298.257;
 Methods of class EarthRenderer:
 ******************************/
 
-void EarthRenderer::renderSurface(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem) const
+void EarthRenderer::updateSurface(void)
 	{
-	/* Set up rendering state: */
-	renderState.setFrontFace(GL_CCW);
-	renderState.enableMaterials();
-	renderState.setColorMaterial(false);
-	renderState.setTwoSidedLighting(true);
-	glMaterial(GLMaterialEnums::FRONT_AND_BACK,surfaceMaterial);
-	renderState.enableTexture2D();
-	renderState.bindTexture2D(dataItem->surfaceTextureObjectId);
+	Mesh& mesh=meshes[SURFACE];
+	mesh.primitiveType=GL_TRIANGLES;
+	mesh.partsMask=Vertex::getPartsMask();
+	mesh.radius=a*scaleFactor;
+	mesh.vertices.clear();
+	mesh.indices.clear();
+	mesh.levels.clear();
 	
-	/* Check if the Earth surface display list is up-to-date: */
-	if(dataItem->surfaceVersion==surfaceVersion)
-		{
-		/* Call the Earth surface display list: */
-		glCallList(dataItem->displayListIdBase+0);
-		}
-	else
+	const double pi=Math::Constants<double>::pi;
+	const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
+	const int baseNumQuads=36; // Number of meridians for lowest-detail model
+	
+	/* Tessellate the surface at the requested detail and successively halved details: */
+	for(int detail=Math::max(surfaceDetail,1);;detail=(detail+1)/2)
 		{
-		/* Update the Earth surface display list: */
-		glNewList(dataItem->displayListIdBase+0,GL_COMPILE_AND_EXECUTE);
-		
-		const double pi=Math::Constants<double>::pi;
-		const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
-		const int baseNumQuads=36; // Number of meridians for lowest-detail model
+		Level level;
+		level.firstIndex=mesh.indices.size();
+		tessellateSpheroid(mesh.radius,f,baseNumStrips*detail,baseNumQuads*detail,mesh.vertices,mesh.indices);
+		level.numIndices=mesh.indices.size()-level.firstIndex;
 		
-		int numStrips=baseNumStrips*surfaceDetail;
-		int numQuads=baseNumQuads*surfaceDetail;
-		
-		float texY1=float(0)/float(numStrips);
-		double lat1=(pi*double(0))/double(numStrips)-0.5*pi;
-		double s1=Math::sin(lat1);
-		double c1=Math::cos(lat1);
-		double r1=a*(1.0-f*s1*s1)*scaleFactor;
-		double xy1=r1*c1;
-		double z1=r1*s1;
-		
-		/* Draw latitude quad strips: */
-		for(int i=1;i<numStrips+1;++i)
-			{
-			float texY0=texY1;
-			double s0=s1;
-			double c0=c1;
-			double xy0=xy1;
-			double z0=z1;
-			texY1=float(i)/float(numStrips);
-			lat1=(pi*double(i))/double(numStrips)-0.5*pi;
-			s1=Math::sin(lat1);
-			c1=Math::cos(lat1);
-			r1=a*(1.0-f*s1*s1)*scaleFactor;
-			xy1=r1*c1;
-			z1=r1*s1;
-			
-			glBegin(GL_QUAD_STRIP);
-			for(int j=0;j<=numQuads;++j)
-				{
-				float texX=float(j)/float(numQuads)+0.5f;
-				glTexCoord2f(texX,texY1);
-				double lng=(2.0*pi*double(j))/double(numQuads);
-				double cl=Math::cos(lng);
-				double sl=Math::sin(lng);
-				double nx1=(1.0-3.0*f*s1*s1)*c1*cl;
-				double ny1=(1.0-3.0*f*s1*s1)*c1*sl;
-				double nz1=(1.0+3.0*f*c1*c1-f)*s1;
-				double nl1=Math::sqrt(nx1*nx1+ny1*ny1+nz1*nz1);
-				glNormal3f(float(nx1/nl1),float(ny1/nl1),float(nz1/nl1));
-				double x1=xy1*cl;
-				double y1=xy1*sl;
-				glVertex3f(float(x1),float(y1),float(z1));
-				glTexCoord2f(texX,texY0);
-				double nx0=(1.0-3.0*f*s0*s0)*c0*cl;
-				double ny0=(1.0-3.0*f*s0*s0)*c0*sl;
-				double nz0=(1.0+3.0*f*c0*c0-f)*s0;
-				double nl0=Math::sqrt(nx0*nx0+ny0*ny0+nz0*nz0);
-				glNormal3f(float(nx0/nl0),float(ny0/nl0),float(nz0/nl0));
-				double x0=xy0*cl;
-				double y0=xy0*sl;
-				glVertex3f(float(x0),float(y0),float(z0));
-				}
-			glEnd();
-			}
+		/* The largest deviation occurs in the middle of a grid quad: */
+		level.error=mesh.radius*Math::sqr(Math::sin(0.5*pi/double(baseNumStrips*detail)));
+		mesh.levels.push_back(level);
 		
-		glEndList();
-		dataItem->surfaceVersion=surfaceVersion;
+		if(detail==1)
+			break;
 		}
+	
+	++mesh.version;
 	}
 
-void EarthRenderer::renderGrid(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem) const
+void EarthRenderer::updateGrid(void)
 	{
-	/* Set up rendering state: */
-	renderState.disableMaterials();
-	renderState.disableTextures();
-	glLineWidth(1.0f);
-	renderState.setEmissiveColor(gridColor);
+	Mesh& mesh=meshes[GRID];
+	mesh.primitiveType=GL_LINES;
+	mesh.partsMask=GLVertexArrayParts::Position;
+	mesh.radius=a*scaleFactor;
+	mesh.vertices.clear();
+	mesh.indices.clear();
+	mesh.levels.clear();
 	
-	/* Check if the latitude/longitude grid display list is up-to-date: */
-	if(dataItem->gridVersion==gridVersion)
-		{
-		/* Call the latitude/longitude grid display list: */
-		glCallList(dataItem->displayListIdBase+1);
-		}
-	else
+	const double pi=Math::Constants<double>::pi;
+	const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
+	const int baseNumQuads=36; // Number of meridians for lowest-detail model
+	
+	/* Tessellate the grid at the requested detail and successively halved details: */
+	Vertex v;
+	v.texCoord=Vertex::TexCoord(0.0f,0.0f);
+	v.normal=Vertex::Normal(0.0f,0.0f,0.0f);
+	for(int detail=Math::max(gridDetail,1);;detail=(detail+1)/2)
 		{
-		/* Create the latitude/longitude grid display list: */
-		glNewList(dataItem->displayListIdBase+1,GL_COMPILE_AND_EXECUTE);
+		Level level;
+		level.firstIndex=mesh.indices.size();
+		int numStrips=baseNumStrips*detail;
+		int numQuads=baseNumQuads*detail;
 		
-		const double pi=Math::Constants<double>::pi;
-		const int baseNumStrips=18; // Number of circles of constant latitude for lowest-detail model
-		const int baseNumQuads=36; // Number of meridians for lowest-detail model
-		
-		int numStrips=baseNumStrips*gridDetail;
-		int numQuads=baseNumQuads*gridDetail;
-		
-		/* Draw circles of constant latitude (what are they called?): */
+		/* Create circles of constant latitude (what are they called?): */
 		for(int i=1;i<baseNumStrips;++i)
 			{
 			double lat=(pi*double(i))/double(baseNumStrips)-0.5*pi;
@@ -200,28 +230,33 @@ void EarthRenderer::renderGrid(SceneGraph::GLRenderState& renderState,EarthRende
 			double xy=r*c;
 			double z=r*s;
 			
-			glBegin(GL_LINE_LOOP);
+			Index base=Index(mesh.vertices.size());
 			for(int j=0;j<numQuads;++j)
 				{
 				double lng=(2.0*pi*double(j))/double(numQuads);
-				double cl=Math::cos(lng);
-				double sl=Math::sin(lng);
-				double x=xy*cl;
-				double y=xy*sl;
-				glVertex3f(float(x),float(y),float(z));
+				v.position=Vertex::Position(float(xy*Math::cos(lng)),float(xy*Math::sin(lng)),float(z));
+				mesh.vertices.push_back(v);
+				mesh.indices.push_back(base+Index(j));
+				mesh.indices.push_back(base+Index((j+1)%numQuads));
 				}
-			glEnd();
 			}
 		
-		/* Draw meridians: */
+		/* Create the poles shared by all meridians: */
+		Index southPole=Index(mesh.vertices.size());
+		v.position=Vertex::Position(0.0f,0.0f,float(-a*(1.0-f)*scaleFactor));
+		mesh.vertices.push_back(v);
+		Index northPole=Index(mesh.vertices.size());
+		v.position=Vertex::Position(0.0f,0.0f,float(a*(1.0-f)*scaleFactor));
+		mesh.vertices.push_back(v);
+		
+		/* Create meridians: */
 		for(int i=0;i<baseNumQuads;++i)
 			{
 			double lng=(2.0*pi*double(i))/double(baseNumQuads);
 			double cl=Math::cos(lng);
 			double sl=Math::sin(lng);
 			
-			glBegin(GL_LINE_STRIP);
-			glVertex3f(0.0f,0.0f,-a*(1.0-f)*scaleFactor);
+			Index previous=southPole;
 			for(int j=1;j<numStrips;++j)
 				{
 				double lat=(pi*double(j))/double(numStrips)-0.5*pi;
@@ -229,18 +264,131 @@ void EarthRenderer::renderGrid(SceneGraph::GLRenderState& renderState,EarthRende
 				double c=Math::cos(lat);
 				double r=a*(1.0-f*s*s)*scaleFactor;
 				double xy=r*c;
-				double x=xy*cl;
-				double y=xy*sl;
-				double z=r*s;
-				glVertex3f(float(x),float(y),float(z));
+				v.position=Vertex::Position(float(xy*cl),float(xy*sl),float(r*s));
+				Index current=Index(mesh.vertices.size());
+				mesh.vertices.push_back(v);
+				mesh.indices.push_back(previous);
+				mesh.indices.push_back(current);
+				previous=current;
 				}
-			glVertex3f(0.0f,0.0f,a*(1.0-f)*scaleFactor);
-			glEnd();
+			mesh.indices.push_back(previous);
+			mesh.indices.push_back(northPole);
 			}
 		
-		glEndList();
-		dataItem->gridVersion=gridVersion;
+		level.numIndices=mesh.indices.size()-level.firstIndex;
+		
+		/* The largest deviation occurs in the middle of a line segment: */
+		level.error=mesh.radius*(1.0-Math::cos(0.5*pi/double(numStrips)));
+		mesh.levels.push_back(level);
+		
+		if(detail==1)
+			break;
+		}
+	
+	++mesh.version;
+	}
+
+void EarthRenderer::updateCore(EarthRenderer::MeshIndex meshIndex,double radius,int detail)
+	{
+	Mesh& mesh=meshes[meshIndex];
+	mesh.primitiveType=GL_TRIANGLES;
+	mesh.partsMask=GLVertexArrayParts::Normal|GLVertexArrayParts::Position;
+	mesh.radius=radius*scaleFactor;
+	mesh.vertices.clear();
+	mesh.indices.clear();
+	mesh.levels.clear();
+	
+	const double pi=Math::Constants<double>::pi;
+	const int baseNumStrips=3; // Number of latitude strips per subdivision level, matching the edge length of a subdivided icosahedron
+	
+	/* Tessellate the sphere at the requested detail and successively halved details: */
+	for(detail=Math::max(detail,1);;detail=(detail+1)/2)
+		{
+		Level level;
+		level.firstIndex=mesh.indices.size();
+		tessellateSpheroid(mesh.radius,0.0,baseNumStrips*detail,2*baseNumStrips*detail,mesh.vertices,mesh.indices);
+		level.numIndices=mesh.indices.size()-level.firstIndex;
+		level.error=mesh.radius*Math::sqr(Math::sin(0.5*pi/double(baseNumStrips*detail)));
+		mesh.levels.push_back(level);
+		
+		if(detail==1)
+			break;
+		}
+	
+	++mesh.version;
+	}
+
+void EarthRenderer::renderMesh(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem,EarthRenderer::MeshIndex meshIndex) const
+	{
+	const Mesh& mesh=meshes[meshIndex];
+	
+	/* Select the coarsest level of detail whose error is acceptable from the current eye position: */
+	Geometry::Point<double,3> eye(renderState.getEyePos());
+	double eyeDist=Math::sqrt(Math::sqr(eye[0])+Math::sqr(eye[1])+Math::sqr(eye[2]))-mesh.radius;
+	size_t levelIndex=0;
+	if(eyeDist>0.0)
+		while(levelIndex+1<mesh.levels.size()&&mesh.levels[levelIndex+1].error<=tessellationError*eyeDist)
+			++levelIndex;
+	const Level& level=mesh.levels[levelIndex];
+	
+	/* Check if the vertex buffer object extension is supported: */
+	const Vertex* vertexPtr;
+	const Index* indexPtr;
+	if(dataItem->vertexBufferIds[meshIndex]!=0)
+		{
+		/* Bind the mesh's buffer objects and update them if they are outdated: */
+		bool outdated=dataItem->meshVersions[meshIndex]!=mesh.version;
+		renderState.bindVertexBuffer(dataItem->vertexBufferIds[meshIndex]);
+		if(outdated)
+			glBufferDataARB(GL_ARRAY_BUFFER_ARB,mesh.vertices.size()*sizeof(Vertex),&mesh.vertices[0],GL_STATIC_DRAW_ARB);
+		renderState.bindIndexBuffer(dataItem->indexBufferIds[meshIndex]);
+		if(outdated)
+			glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB,mesh.indices.size()*sizeof(Index),&mesh.indices[0],GL_STATIC_DRAW_ARB);
+		dataItem->meshVersions[meshIndex]=mesh.version;
+		
+		vertexPtr=0;
+		indexPtr=0;
+		}
+	else
+		{
+		/* Render from the shared vertex and index arrays: */
+		renderState.bindVertexBuffer(0);
+		renderState.bindIndexBuffer(0);
+		vertexPtr=&mesh.vertices[0];
+		indexPtr=&mesh.indices[0];
 		}
+	
+	/* Render the selected level of detail: */
+	renderState.enableVertexArrays(mesh.partsMask);
+	glVertexPointer(vertexPtr);
+	glDrawElements(mesh.primitiveType,GLsizei(level.numIndices),GL_UNSIGNED_INT,indexPtr+level.firstIndex);
+	}
+
+void EarthRenderer::renderSurface(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem) const
+	{
+	/* Set up rendering state: */
+	renderState.setFrontFace(GL_CCW);
+	renderState.enableMaterials();
+	renderState.setColorMaterial(false);
+	renderState.setTwoSidedLighting(true);
+	glMaterial(GLMaterialEnums::FRONT_AND_BACK,surfaceMaterial);
+	renderState.enableTexture2D();
+	renderState.bindTexture2D(dataItem->surfaceTextureObjectId);
+	
+	/* Render the Earth's surface: */
+	renderMesh(renderState,dataItem,SURFACE);
+	}
+
+void EarthRenderer::renderGrid(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem) const
+	{
+	/* Set up rendering state: */
+	renderState.disableMaterials();
+	renderState.disableTextures();
+	glLineWidth(1.0f);
+	renderState.setEmissiveColor(gridColor);
+	
+	/* Render the latitude/longitude grid: */
+	renderMesh(renderState,dataItem,GRID);
 	}
 
 void EarthRenderer::renderOuterCore(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem) const
@@ -253,20 +401,8 @@ void EarthRenderer::renderOuterCore(SceneGraph::GLRenderState& renderState,Earth
 	glMaterial(GLMaterialEnums::FRONT_AND_BACK,outerCoreMaterial);
 	renderState.disableTextures();
 	
-	/* Check if the outer core display list is up-to-date: */
-	if(dataItem->outerCoreVersion==outerCoreVersion)
-		{
-		/* Call the outer core display list: */
-		glCallList(dataItem->displayListIdBase+2);
-		}
-	else
-		{
-		/* Create the outer core display list: */
-		glNewList(dataItem->displayListIdBase+2,GL_COMPILE_AND_EXECUTE);
-		glDrawSphereIcosahedron(float(3480.0e3*scaleFactor),outerCoreDetail);
-		glEndList();
-		dataItem->outerCoreVersion=outerCoreVersion;
-		}
+	/* Render the outer core: */
+	renderMesh(renderState,dataItem,OUTERCORE);
 	}
 
 void EarthRenderer::renderInnerCore(SceneGraph::GLRenderState& renderState,EarthRenderer::DataItem* dataItem) const
@@ -279,43 +415,33 @@ void EarthRenderer::renderInnerCore(SceneGraph::GLRenderState& renderState,Earth
 	glMaterial(GLMaterialEnums::FRONT_AND_BACK,innerCoreMaterial);
 	renderState.disableTextures();
 	
-	/* Check if the inner core display list is up-to-date: */
-	if(dataItem->innerCoreVersion==innerCoreVersion)
-		{
-		/* Call the inner core display list: */
-		glCallList(dataItem->displayListIdBase+3);
-		}
-	else
-		{
-		/* Create the inner core display list: */
-		glNewList(dataItem->displayListIdBase+3,GL_COMPILE_AND_EXECUTE);
-		glDrawSphereIcosahedron(float(1221.0e3*scaleFactor),innerCoreDetail);
-		glEndList();
-		dataItem->innerCoreVersion=innerCoreVersion;
-		}
+	/* Render the inner core: */
+	renderMesh(renderState,dataItem,INNERCORE);
 	}
 
 EarthRenderer::EarthRenderer(double sScaleFactor)
 	:scaleFactor(sScaleFactor),
 	 f(flatteningFactor),
+	 tessellationError(0.001),
 	 surfaceDetail(2),
 	 surfaceMaterial(GLMaterial::Color(1.0f,1.0f,1.0f,0.333f),GLMaterial::Color(0.333f,0.333f,0.333f),10.0f),
 	 surfaceOpacity(0.333f),
-	 surfaceVersion(1),
 	 gridDetail(10),
 	 gridLineWidth(1.0f),
 	 gridColor(0.0f,1.0f,0.0f,0.1f),
 	 gridOpacity(0.1f),
-	 gridVersion(1),
 	 outerCoreDetail(8),
 	 outerCoreMaterial(GLMaterial::Color(1.0f,0.5f,0.0f,0.333f),GLMaterial::Color(1.0f,1.0f,1.0f),50.0f),
 	 outerCoreOpacity(0.333f),
-	 outerCoreVersion(1),
 	 innerCoreDetail(8),
 	 innerCoreMaterial(GLMaterial::Color(1.0f,0.0f,0.0f,0.333f),GLMaterial::Color(1.0f,1.0f,1.0f),50.0f),
-	 innerCoreOpacity(0.333f),
-	 innerCoreVersion(1)
+	 innerCoreOpacity(0.333f)
 	{
+	/* Tessellate all Earth model components once, to be shared by all OpenGL contexts: */
+	updateSurface();
+	updateGrid();
+	updateCore(OUTERCORE,3480.0e3,outerCoreDetail);
+	updateCore(INNERCORE,1221.0e3,innerCoreDetail);
 	}
 
 void EarthRenderer::initContext(GLContextData& contextData) const
@@ -354,23 +480,28 @@ void EarthRenderer::initContext(GLContextData& contextData) const
 void EarthRenderer::setScaleFactor(double newScaleFactor)
 	{
 	scaleFactor=newScaleFactor;
-	++surfaceVersion;
-	++gridVersion;
-	++outerCoreVersion;
-	++innerCoreVersion;
+	updateSurface();
+	updateGrid();
+	updateCore(OUTERCORE,3480.0e3,outerCoreDetail);
+	updateCore(INNERCORE,1221.0e3,innerCoreDetail);
 	}
 
 void EarthRenderer::setFlatteningFactor(double newF)
 	{
 	f=newF;
-	++surfaceVersion;
-	++gridVersion;
+	updateSurface();
+	updateGrid();
+	}
+
+void EarthRenderer::setTessellationError(double newTessellationError)
+	{
+	tessellationError=newTessellationError;
 	}
 
 void EarthRenderer::setSurfaceDetail(int newSurfaceDetail)
 	{
 	surfaceDetail=newSurfaceDetail;
-	++surfaceVersion;
+	updateSurface();
 	}
 
 void EarthRenderer::setSurfaceMaterial(const GLMaterial& newSurfaceMaterial)
@@ -388,7 +519,7 @@ void EarthRenderer::setSurfaceOpacity(float newSurfaceOpacity)
 void EarthRenderer::setGridDetail(int newGridDetail)
 	{
 	gridDetail=newGridDetail;
-	++gridVersion;
+	updateGrid();
 	}
 
 void EarthRenderer::setGridLineWidth(float newGridLineWidth)
@@ -411,7 +542,7 @@ void EarthRenderer::setGridOpacity(float newGridOpacity)
 void EarthRenderer::setOuterCoreDetail(int newOuterCoreDetail)
 	{
 	outerCoreDetail=newOuterCoreDetail;
-	++outerCoreVersion;
+	updateCore(OUTERCORE,3480.0e3,outerCoreDetail);
 	}
 
 void EarthRenderer::setOuterCoreMaterial(const GLMaterial& newOuterCoreMaterial)
@@ -429,7 +560,7 @@ void EarthRenderer::setOuterCoreOpacity(float newOuterCoreOpacity)
 void EarthRenderer::setInnerCoreDetail(int newInnerCoreDetail)
 	{
 	innerCoreDetail=newInnerCoreDetail;
-	++innerCoreVersion;
+	updateCore(INNERCORE,1221.0e3,innerCoreDetail);
 	}
 
 void EarthRenderer::setInnerCoreMaterial(const GLMaterial& newInnerCoreMaterial)
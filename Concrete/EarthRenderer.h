@@ -1,7 +1,7 @@
 /***********************************************************************
 EarthRenderer - Class to render a configurable model of Earth using
 transparent surfaces and several interior components.
-Copyright (c) 2005-2025 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,9 +23,11 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_CONCRETE_EARTHRENDERER_INCLUDED
 #define VISUALIZATION_CONCRETE_EARTHRENDERER_INCLUDED
 
+#include <vector>
 #include <GL/gl.h>
 #include <GL/GLColor.h>
 #include <GL/GLMaterial.h>
+#include <GL/GLVertex.h>
 #include <GL/GLObject.h>
 
 /* Forward declarations: */
@@ -44,16 +46,50 @@ class EarthRenderer:public GLObject
 	typedef GLColor<GLfloat,4> Color;
 	
 	private:
+	typedef GLVertex<GLfloat,2,void,0,GLfloat,GLfloat,3> Vertex; // Type for Earth model vertices
+	typedef GLuint Index; // Type for vertex indices
+	
+	enum MeshIndex // Enumerated type for Earth model components
+		{
+		SURFACE=0,GRID,OUTERCORE,INNERCORE,NUMMESHES
+		};
+	
+	struct Level // Structure describing one level of detail of a tessellated Earth model component
+		{
+		/* Elements: */
+		public:
+		size_t firstIndex; // Index of the level's first vertex index in the mesh's index array
+		size_t numIndices; // Number of the level's vertex indices
+		double error; // Maximum distance between the tessellation and the exact surface in model coordinates
+		};
+	
+	struct Mesh // Structure for a tessellated Earth model component, shared between all OpenGL contexts
+		{
+		/* Elements: */
+		public:
+		GLenum primitiveType; // Type of primitives formed by the mesh's vertex indices
+		int partsMask; // Mask of vertex components used during rendering
+		double radius; // Radius of the mesh's bounding sphere around the origin
+		std::vector<Vertex> vertices; // Vertices of all levels of detail
+		std::vector<Index> indices; // Vertex indices of all levels of detail
+		std::vector<Level> levels; // Levels of detail, from finest to coarsest
+		unsigned int version; // Version number of the mesh
+		
+		/* Constructors and destructors: */
+		Mesh(void)
+			:primitiveType(GL_TRIANGLES),partsMask(0),radius(0.0),version(0)
+			{
+			}
+		};
+	
 	struct DataItem:public GLObject::DataItem // Class to store OpenGL-related data needed by the Earth renderer
 		{
 		/* Elements: */
 		public:
 		GLuint surfaceTextureObjectId; // Texture object ID for Earth surface texture
-		GLuint displayListIdBase; // Base ID of set of display lists for Earth model components
-		unsigned int surfaceVersion; // Version number of surface display list
-		unsigned int gridVersion; // Version number of longitude/latitude grid display list
-		unsigned int outerCoreVersion; // Version number of outer core display list
-		unsigned int innerCoreVersion; // Version number of inner core display list
+		GLuint vertexBufferIds[NUMMESHES]; // IDs of vertex buffer objects for Earth model components (0 if extension not supported)
+		GLuint indexBufferIds[NUMMESHES]; // IDs of index buffer objects for Earth model components (0 if extension not supported)
+		unsigned int meshVersions[NUMMESHES]; // Version numbers of the Earth model components in the buffer objects
 		
 		/* Constructors and destructors: */
 		DataItem(void);
@@ -65,25 +101,27 @@ class EarthRenderer:public GLObject
 	static const double flatteningFactor; // Earth's geoid flattening factor
 	double scaleFactor; // Scale factor for Cartesian coordinates
 	double f; // Effective flattening factor used for this Earth renderer
+	double tessellationError; // Maximum ratio of tessellation error to viewing distance when selecting levels of detail
 	int surfaceDetail; // Subdivision level of surface sphere
 	GLMaterial surfaceMaterial; // Material property for surface
 	float surfaceOpacity; // Transparenct for surface (0.0: invisible, 1.0: fully opaque)
-	unsigned int surfaceVersion; // Version number of surface display list
 	int gridDetail; // Subdivision level of longitude/latitude grid
 	float gridLineWidth; // Line width of longitude/latitude grid
 	Color gridColor; // Color of longitude/latitude grid
 	float gridOpacity; // Opacity of longitude/latitude grid (0.0: invisible, 1.0: fully opaque)
-	unsigned int gridVersion; // Version number of longitude/latitude grid display list
 	int outerCoreDetail; // Subdivision level of outer core sphere
 	GLMaterial outerCoreMaterial; // Material property for outer core
 	float outerCoreOpacity; // Transparenct for outer core (0.0: invisible, 1.0: fully opaque)
-	unsigned int outerCoreVersion; // Version number of outer core display list
 	int innerCoreDetail; // Subdivision level of inner core sphere
 	GLMaterial innerCoreMaterial; // Material property for inner core
 	float innerCoreOpacity; // Transparenct for inner core (0.0: invisible, 1.0: fully opaque)
-	unsigned int innerCoreVersion; // Version number of inner core display list
+	Mesh meshes[NUMMESHES]; // Tessellated Earth model components
 	
 	/* Private methods: */
+	void updateSurface(void); // Re-tessellates the Earth's surface
+	void updateGrid(void); // Re-tessellates the longitude/latitude grid
+	void updateCore(MeshIndex meshIndex,double radius,int detail); // Re-tessellates one of the core spheres
+	void renderMesh(SceneGraph::GLRenderState& renderState,DataItem* dataItem,MeshIndex meshIndex) const; // Renders an Earth model component at the level of detail appropriate for the current eye position
 	void renderSurface(SceneGraph::GLRenderState& renderState,DataItem* dataItem) const;
 	void renderGrid(SceneGraph::GLRenderState& renderState,DataItem* dataItem) const;
 	void renderOuterCore(SceneGraph::GLRenderState& renderState,DataItem* dataItem) const;
@@ -107,6 +145,11 @@ class EarthRenderer:public GLObject
 		}
 	void setScaleFactor(double newScaleFactor);
 	void setFlatteningFactor(double newF);
+	double getTessellationError(void) const // Returns the maximum ratio of tessellation error to viewing distance
+		{
+		return tessellationError;
+		}
+	void setTessellationError(double newTessellationError); // Sets the maximum ratio of tessellation error to viewing distance; 0 always selects the finest level of detail
 	void setSurfaceDetail(int newSurfaceDetail);
 	void setSurfaceMaterial(const GLMaterial& newSurfaceMaterial);
 	void setSurfaceOpacity(float newSurfaceOpacity);
@@ -1,6 +1,6 @@
 /***********************************************************************
 HDF5Support - Helper classes to simplify reading data from HDF5 files.
-Copyright (c) 2018-2024 Oliver Kreylos
+Copyright (c) 2018-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -72,6 +72,18 @@ hid_t getNativeType(void)
 	return -1;
 	}
 
+template <>
+hid_t getNativeType<short>(void)
+	{
+	return H5T_NATIVE_SHORT;
+	}
+
+template <>
+hid_t getNativeType<unsigned short>(void)
+	{
+	return H5T_NATIVE_USHORT;
+	}
+
 template <>
 hid_t getNativeType<int>(void)
 	{
@@ -84,6 +96,18 @@ hid_t getNativeType<unsigned int>(void)
 	return H5T_NATIVE_UINT;
 	}
 
+template <>
+hid_t getNativeType<unsigned long>(void)
+	{
+	return H5T_NATIVE_ULONG;
+	}
+
+template <>
+hid_t getNativeType<unsigned long long>(void)
+	{
+	return H5T_NATIVE_ULLONG;
+	}
+
 template <>
 hid_t getNativeType<float>(void)
 	{
@@ -96,8 +120,25 @@ hid_t getNativeType<double>(void)
 	return H5T_NATIVE_DOUBLE;
 	}
 
+bool isNumeric(const HDF5::DataType& dataType)
+	{
+	/* HDF5 converts between all integer and floating-point types on reading: */
+	H5T_class_t dataTypeClass=dataType.getClass();
+	return dataTypeClass==H5T_INTEGER||dataTypeClass==H5T_FLOAT;
+	}
+
 }
 
+std::vector<size_t> DataSet::getDimensions(void)
+	{
+	/* Access the data set's data space and check that it is simple: */
+	HDF5::DataSpace dataSpace(*this);
+	if(!dataSpace.isSimple())
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Data set has non-simple data space");
+	
+	return dataSpace.getDimensions();
+	}
+
 template <class DataParam>
 inline
 size_t
@@ -118,8 +159,8 @@ DataSet::read(
 	/* Create a data type representing the given memory buffer: */
 	HDF5::DataType memDataType(getNativeType<DataParam>());
 	
-	/* Check that the data type and the given memory buffer are compatible: */
-	if(memDataType.getClass()!=dataType.getClass()||(memDataType.isInteger()&&memDataType.isSigned()!=dataType.isSigned()))
+	/* Check that the data type can be converted to the given memory buffer's type: */
+	if(!isNumeric(dataType)||!isNumeric(memDataType))
 		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Data set's type is incompatible with requested memory type");
 	
 	/* Check that the data space is simple: */
@@ -155,6 +196,56 @@ DataSet::read(
 	return dataSize;
 	}
 
+template <class DataParam>
+inline
+void
+DataSet::readHyperslab(
+	const size_t start[],
+	const size_t count[],
+	DataParam* data)
+	{
+	/* Access the data set's data space and data type: */
+	HDF5::DataSpace fileSpace(*this);
+	HDF5::DataType dataType(*this);
+	
+	/* Create a data type representing the given memory buffer: */
+	HDF5::DataType memDataType(getNativeType<DataParam>());
+	
+	/* Check that the data type can be converted to the given memory buffer's type: */
+	if(!isNumeric(dataType)||!isNumeric(memDataType))
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Data set's type is incompatible with requested memory type");
+	
+	/* Check that the data space is simple: */
+	if(!fileSpace.isSimple())
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Data set has non-simple data space");
+	
+	/* Check the hyperslab against the data space's dimensions: */
+	size_t numDimensions=fileSpace.getNumDimensions();
+	std::vector<hsize_t> dims(numDimensions);
+	fileSpace.getDimensions(&dims[0]);
+	std::vector<hsize_t> fileStart(numDimensions);
+	std::vector<hsize_t> fileCount(numDimensions);
+	size_t dataSize=1;
+	for(size_t i=0;i<numDimensions;++i)
+		{
+		if(start[i]>dims[i]||count[i]>dims[i]-start[i])
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Hyperslab exceeds data set's dimensions");
+		fileStart[i]=start[i];
+		fileCount[i]=count[i];
+		dataSize*=count[i];
+		}
+	if(dataSize==0)
+		return;
+	
+	/* Select the hyperslab in the file and create a matching contiguous memory data space: */
+	fileSpace.selectHyperslab(&fileStart[0],&fileCount[0]);
+	HDF5::DataSpace memSpace(numDimensions,&fileCount[0]);
+	
+	/* Read the hyperslab directly into the given buffer: */
+	if(H5Dread(id,memDataType.getId(),memSpace.getId(),fileSpace.getId(),H5P_DEFAULT,data)<0)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Cannot read data set's hyperslab into memory buffer");
+	}
+
 /**************************
 Methods of class DataSpace:
 **************************/
@@ -167,6 +258,14 @@ DataSpace::DataSpace(DataSet& dataSet)
 		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Cannot access data set's data space");
 	}
 
+DataSpace::DataSpace(size_t numDimensions,const hsize_t dimensions[])
+	{
+	/* Create a simple data space and check for errors: */
+	id=H5Screate_simple(int(numDimensions),dimensions,0);
+	if(id<0)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Cannot create data space");
+	}
+
 DataSpace::~DataSpace(void)
 	{
 	H5Sclose(id);
@@ -223,6 +322,13 @@ std::vector<size_t> DataSpace::getDimensions(void) const
 	return result;
 	}
 
+void DataSpace::selectHyperslab(const hsize_t start[],const hsize_t count[])
+	{
+	/* Select the hyperslab and check for errors: */
+	if(H5Sselect_hyperslab(id,H5S_SELECT_SET,start,0,count,0)<0)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Cannot select hyperslab in data space");
+	}
+
 /*************************
 Methods of class DataType:
 *************************/
@@ -282,6 +388,152 @@ H5T_order_t DataType::getByteOrder(void) const
 	return result;
 	}
 
+/****************************
+Methods of class BlockReader:
+****************************/
+
+template <class DataParam>
+inline
+void*
+BlockReader<DataParam>::readerThreadMethod(
+	void)
+	{
+	size_t numRows=dimensions[0];
+	std::vector<size_t> start(dimensions.size(),0);
+	std::vector<size_t> count(dimensions);
+	int buffer=0;
+	try
+		{
+		for(size_t row=0;row<numRows;row+=blockNumRows,buffer=1-buffer)
+			{
+			/* Wait until the caller has released the buffer: */
+			{
+			Threads::MutexCond::Lock bufferLock(bufferCond);
+			while(!cancel&&bufferNumRows[buffer]!=0)
+				bufferCond.wait(bufferLock);
+			if(cancel)
+				break;
+			}
+			
+			/* Read the next block into the buffer: */
+			start[0]=row;
+			count[0]=numRows-row<blockNumRows?numRows-row:blockNumRows;
+			dataSet.readHyperslab(&start[0],&count[0],buffers[buffer]);
+			
+			/* Hand the buffer to the caller: */
+			{
+			Threads::MutexCond::Lock bufferLock(bufferCond);
+			bufferFirstRows[buffer]=row;
+			bufferNumRows[buffer]=count[0];
+			bufferCond.signal();
+			}
+			}
+		}
+	catch(const std::runtime_error& err)
+		{
+		/* Remember the error to throw it from the caller's thread: */
+		Threads::MutexCond::Lock bufferLock(bufferCond);
+		error=err.what();
+		}
+	
+	/* Signal that no more blocks will be read: */
+	{
+	Threads::MutexCond::Lock bufferLock(bufferCond);
+	readerDone=true;
+	bufferCond.signal();
+	}
+	
+	return 0;
+	}
+
+template <class DataParam>
+inline
+BlockReader<DataParam>::BlockReader(
+	DataSet& sDataSet,
+	size_t sBlockNumRows)
+	:dataSet(sDataSet),
+	 dimensions(dataSet.getDimensions()),
+	 rowSize(1),blockNumRows(sBlockNumRows>0?sBlockNumRows:1),
+	 readerDone(false),cancel(false),
+	 processBuffer(-1),nextRow(0)
+	{
+	/* Calculate the size of a row: */
+	if(dimensions.empty())
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Data set has no dimensions");
+	for(size_t i=1;i<dimensions.size();++i)
+		rowSize*=dimensions[i];
+	if(blockNumRows>dimensions[0]&&dimensions[0]>0)
+		blockNumRows=dimensions[0];
+	
+	/* Allocate the double buffer: */
+	for(int i=0;i<2;++i)
+		{
+		buffers[i]=new DataParam[blockNumRows*rowSize];
+		bufferFirstRows[i]=0;
+		bufferNumRows[i]=0;
+		}
+	
+	/* Start reading the first block: */
+	readerThread.start(this,&BlockReader::readerThreadMethod);
+	}
+
+template <class DataParam>
+inline
+BlockReader<DataParam>::~BlockReader(
+	void)
+	{
+	/* Stop the reader thread: */
+	{
+	Threads::MutexCond::Lock bufferLock(bufferCond);
+	cancel=true;
+	bufferCond.signal();
+	}
+	readerThread.join();
+	
+	/* Release the double buffer: */
+	for(int i=0;i<2;++i)
+		delete[] buffers[i];
+	}
+
+template <class DataParam>
+inline
+const DataParam*
+BlockReader<DataParam>::getNextBlock(
+	size_t& firstRow,
+	size_t& numRows)
+	{
+	Threads::MutexCond::Lock bufferLock(bufferCond);
+	
+	/* Release the previously returned block to the reader thread: */
+	int nextBuffer=0;
+	if(processBuffer>=0)
+		{
+		bufferNumRows[processBuffer]=0;
+		bufferCond.signal();
+		nextBuffer=1-processBuffer;
+		processBuffer=-1;
+		}
+	
+	/* Check if all blocks have been returned: */
+	firstRow=nextRow;
+	numRows=0;
+	if(nextRow>=dimensions[0])
+		return 0;
+	
+	/* Wait for the next block to be read: */
+	while(!readerDone&&bufferNumRows[nextBuffer]==0)
+		bufferCond.wait(bufferLock);
+	if(bufferNumRows[nextBuffer]==0)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Cannot read data set due to exception %s",error.c_str());
+	
+	/* Hand the block to the caller: */
+	processBuffer=nextBuffer;
+	firstRow=bufferFirstRows[processBuffer];
+	numRows=bufferNumRows[processBuffer];
+	nextRow=firstRow+numRows;
+	return buffers[processBuffer];
+	}
+
 /*************************************************
 Force instantiations of standard template methods:
 *************************************************/
@@ -290,5 +542,20 @@ template size_t DataSet::read(size_t& numDimensions,size_t*& dimensions,int*& da
 template size_t DataSet::read(size_t& numDimensions,size_t*& dimensions,unsigned int*& data);
 template size_t DataSet::read(size_t& numDimensions,size_t*& dimensions,float*& data);
 template size_t DataSet::read(size_t& numDimensions,size_t*& dimensions,double*& data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],short* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],unsigned short* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],int* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],unsigned int* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],unsigned long* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],unsigned long long* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],float* data);
+template void DataSet::readHyperslab(const size_t start[],const size_t count[],double* data);
+
+template class BlockReader<int>;
+template class BlockReader<unsigned int>;
+template class BlockReader<unsigned long>;
+template class BlockReader<unsigned long long>;
+template class BlockReader<float>;
+template class BlockReader<double>;
 
 }
@@ -22,8 +22,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_CONCRETE_HDF5SUPPORT_INCLUDED
 #define VISUALIZATION_CONCRETE_HDF5SUPPORT_INCLUDED
 
+#include <stddef.h>
 #include <hdf5.h>
+#include <string>
 #include <vector>
+#include <Threads/Thread.h>
+#include <Threads/MutexCond.h>
 
 namespace HDF5 {
 
@@ -61,8 +65,11 @@ class DataSet // Class for HDF5 data sets
 		{
 		return id;
 		}
+	std::vector<size_t> getDimensions(void); // Returns the sizes of the data set's dimensions as a vector
 	template <class DataParam>
 	size_t read(size_t& numDimensions,size_t*& dimensions,DataParam*& data); // Reads a data set's contents into a memory buffer, returning the data set's memory layout and total number of elements
+	template <class DataParam>
+	void readHyperslab(const size_t start[],const size_t count[],DataParam* data); // Reads the hyperslab of the given origin and size into the given caller-provided buffer, converting the data set's values to the buffer's type
 	};
 
 class DataSpace // Class for HDF5 data spaces
@@ -74,6 +81,7 @@ class DataSpace // Class for HDF5 data spaces
 	/* Constructors and destructors: */
 	public:
 	DataSpace(DataSet& dataSet); // Accesses the data space of the given data set
+	DataSpace(size_t numDimensions,const hsize_t dimensions[]); // Creates a simple data space of the given dimensions
 	~DataSpace(void); // Releases the data space
 	
 	/* Methods: */
@@ -85,6 +93,7 @@ class DataSpace // Class for HDF5 data spaces
 	size_t getNumDimensions(void) const; // Returns the number of dimensions (data axes) of the data space
 	void getDimensions(hsize_t dimensions[]) const; // Reads the sizes of the data space's dimensions into the provided array, which is assumed to be of sufficient size
 	std::vector<size_t> getDimensions(void) const; // Returns the sizes of the data space's dimensions as a vector
+	void selectHyperslab(const hsize_t start[],const hsize_t count[]); // Selects the hyperslab of the given origin and size
 	};
 
 class DataType // Class for HDF5 data types
@@ -119,6 +128,46 @@ class DataType // Class for HDF5 data types
 	H5T_order_t getByteOrder(void) const; // Returns the data type's byte order
 	};
 
+template <class DataParam>
+class BlockReader // Class to read a data set in blocks of consecutive rows along its first dimension in a background thread, while the caller processes the previous block
+	{
+	/* Elements: */
+	private:
+	DataSet& dataSet; // The data set being read
+	std::vector<size_t> dimensions; // The sizes of the data set's dimensions
+	size_t rowSize; // Number of values in one row of the data set
+	size_t blockNumRows; // Maximum number of rows in one block
+	DataParam* buffers[2]; // Double buffer of blocks being read or processed
+	size_t bufferFirstRows[2]; // Index of the first row in each buffer
+	size_t bufferNumRows[2]; // Number of rows in each buffer, or 0 if the buffer is empty
+	Threads::MutexCond bufferCond; // Condition variable to signal a change in buffer state
+	bool readerDone; // Flag if the reader thread has read all blocks, failed, or was cancelled
+	bool cancel; // Flag to ask the reader thread to stop reading
+	std::string error; // Error message if the reader thread failed
+	int processBuffer; // Index of the buffer currently handed to the caller, or -1
+	size_t nextRow; // Index of the first row of the next block to be handed to the caller
+	Threads::Thread readerThread; // Thread reading blocks from the data set
+	
+	/* Private methods: */
+	void* readerThreadMethod(void); // Reads blocks into free buffers until the data set is exhausted
+	
+	/* Constructors and destructors: */
+	public:
+	BlockReader(DataSet& sDataSet,size_t sBlockNumRows); // Starts reading the given data set in blocks of the given number of rows; the HDF5 library must not be called from other threads until the last block was retrieved, unless it was built thread-safe
+	~BlockReader(void); // Stops reading and releases all buffers
+	
+	/* Methods: */
+	const std::vector<size_t>& getDimensions(void) const // Returns the sizes of the data set's dimensions
+		{
+		return dimensions;
+		}
+	size_t getRowSize(void) const // Returns the number of values in one row
+		{
+		return rowSize;
+		}
+	const DataParam* getNextBlock(size_t& firstRow,size_t& numRows); // Returns the next block of rows and its row range after waiting for it to be read; invalidates the previously returned block; returns null after the last block
+	};
+
 }
 
 #endif
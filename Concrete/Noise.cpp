@@ -1,6 +1,6 @@
-***********************************************************************
+/***********************************************************************
 Noise - Class for Perlin noise arrays with spline evaluation.
-Copyright (c) 2000-2007 Oliver Kreylos
+Copyright (c) 2000-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -140,6 +140,20 @@ Noise::Noise(int sSizeBits,int sDegree)
 	#endif
 	}
 
+Noise::Noise(int sSizeBits,int sDegree,unsigned int seed)
+	:noiseArray(sSizeBits,sDegree)
+	{
+	/* Fill the array from a linear congruential generator, which produces the same values on all platforms: */
+	int size=1<<sSizeBits;
+	for(int i=0;i<size;i++)
+		for(int j=0;j<size;j++)
+			for(int k=0;k<size;k++)
+				{
+				seed=seed*1103515245U+12345U;
+				noiseArray.set(i,j,k,(unsigned char)((seed>>16)&0xffU));
+				}
+	}
+
 Noise::Noise(const Noise& source)
 	:noiseArray(source.noiseArray)
 	{
@@ -1,6 +1,6 @@
 /***********************************************************************
 Noise - Class for Perlin noise arrays with spline evaluation.
-Copyright (c) 2000-2007 Oliver Kreylos
+Copyright (c) 2000-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -82,6 +82,7 @@ class Noise // Class for Perlin noise
 	/* Constructors and destructors: */
 	public:
 	Noise(int sSizeBits,int sDegree =1); // Erzeugt Zufallsfeld der Gr&ouml;&szlig;e 1<<sSizeBits mit Interpolationsgrad sDegree
+	Noise(int sSizeBits,int sDegree,unsigned int seed); // Ditto, with reproducible random numbers generated from the given seed
 	Noise(const Noise& source); // Copykonstruktor
 	
 	/* Zugriffsfunktionen: */
@@ -1,6 +1,6 @@
 /***********************************************************************
 PointSet - Class to represent and render sets of scattered 3D points.
-Copyright (c) 2005-2024 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -21,19 +21,27 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Concrete/PointSet.h>
 
-#include <ctype.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <math.h>
 #include <stdlib.h>
-#include <stdio.h>
 #include <string>
+#include <stdexcept>
+#include <algorithm>
 #include <iostream>
 #include <Misc/StdError.h>
-#include <Misc/File.h>
+#include <IO/File.h>
+#include <IO/OpenFile.h>
+#include <IO/ValueSource.h>
 #include <Math/Math.h>
 #include <GL/gl.h>
 #include <GL/GLVertexArrayParts.h>
 #include <GL/GLContextData.h>
 #include <GL/Extensions/GLARBVertexBufferObject.h>
+#include <SceneGraph/GLRenderState.h>
 
 namespace Visualization {
 
@@ -41,84 +49,6 @@ namespace Concrete {
 
 namespace {
 
-/*********************************************************
-Helper function to parse spreadsheet files in text format:
-*********************************************************/
-
-int
-getNextValue(
-	Misc::File& file,
-	char* valueBuffer,
-	size_t valueBufferSize)
-	{
-	/* Skip all whitespace: */
-	int nextChar;
-	do
-		{
-		nextChar=file.getc();
-		}
-	while(isspace(nextChar)&&nextChar!='\n'&&nextChar!=EOF);
-	
-	/* Check for end-of-line or end-of-file condition: */
-	if(nextChar=='\n'||nextChar==EOF)
-		return nextChar;
-	
-	/* Read the value: */
-	char* vPtr=valueBuffer;
-	if(nextChar=='"')
-		{
-		/* Read characters until next quotation mark: */
-		while(true)
-			{
-			nextChar=file.getc();
-			if(nextChar!='"')
-				{
-				if(valueBufferSize>1)
-					{
-					*vPtr=char(nextChar);
-					++vPtr;
-					--valueBufferSize;
-					}
-				}
-			else
-				break;
-			}
-		}
-	else
-		{
-		/* Append the first character to the result string: */
-		if(valueBufferSize>1)
-			{
-			*vPtr=char(nextChar);
-			++vPtr;
-			--valueBufferSize;
-			}
-		
-		/* Read characters until next whitespace: */
-		while(true)
-			{
-			nextChar=file.getc();
-			if(!isspace(nextChar))
-				{
-				if(valueBufferSize>1)
-					{
-					*vPtr=char(nextChar);
-					++vPtr;
-					--valueBufferSize;
-					}
-				}
-			else
-				{
-				file.ungetc(nextChar);
-				break;
-				}
-			}
-		}
-	*vPtr='\0';
-	
-	return 0;
-	}
-
 /**********************************************************************
 Helper functions to convert spherical (geoid) to Cartesian coordinates:
 **********************************************************************/
@@ -167,51 +97,87 @@ calcDepthPos(
 	pos[2]=float(r*s0);
 	}
 
-/**********************************************
-Helper classes to upload and render point sets:
-**********************************************/
+/*****************************************************
+Helper function to read a numeric value from a column:
+*****************************************************/
+
+inline
+double
+readValue(
+	IO::ValueSource& reader)
+	{
+	/* Convert the column's text like atof, i.e., read malformed values as zero: */
+	return atof(reader.readString().c_str());
+	}
+
+/*******************************************
+Helper class to split point sets by octants:
+*******************************************/
 
 template <class VertexParam>
-class PointChunkUploader
+class PointOctantSplitter
 	{
 	/* Elements: */
 	private:
-	GLintptrARB offset; // Current offset into the vertex buffer object
+	int dimension; // Coordinate axis along which to split
+	float split; // Position of the splitting plane
 	
 	/* Constructors and destructors: */
 	public:
-	PointChunkUploader(void)
-		:offset(0)
+	PointOctantSplitter(int sDimension,float sSplit)
+		:dimension(sDimension),split(sSplit)
 		{
 		}
 	
 	/* Methods: */
-	void operator()(const VertexParam* chunkVertices,size_t numChunkVertices)
+	bool operator()(const VertexParam& vertex) const
 		{
-		/* Upload the current chunk of vertices: */
-		GLsizeiptrARB size=numChunkVertices*sizeof(VertexParam);
-		glBufferSubDataARB(GL_ARRAY_BUFFER_ARB,offset,size,chunkVertices);
-		
-		/* Prepare to upload the next chunk: */
-		offset+=size;
+		return vertex.position[dimension]<split;
 		}
 	};
 
-template <class VertexParam>
-class PointChunkRenderer
+}
+
+/*****************************************
+Declaration of struct PointSet::DrawBatch:
+*****************************************/
+
+struct PointSet::DrawBatch
 	{
-	/* Methods: */
+	/* Elements: */
 	public:
-	void operator()(const VertexParam* chunkVertices,size_t numChunkVertices)
+	GLint first; // Index of first point in the current batch
+	GLsizei count; // Number of points in the current batch
+	size_t numRenderedPoints; // Total number of points rendered by this batch
+	
+	/* Constructors and destructors: */
+	DrawBatch(void)
+		:first(0),count(0),numRenderedPoints(0)
 		{
-		/* Render the current chunk of vertices: */
-		glVertexPointer(chunkVertices);
-		glDrawArrays(GL_POINTS,0,numChunkVertices);
+		}
+	
+	/* Methods: */
+	void flush(void) // Renders the current batch
+		{
+		if(count>0)
+			{
+			glDrawArrays(GL_POINTS,first,count);
+			numRenderedPoints+=count;
+			count=0;
+			}
+		}
+	void add(GLint rangeFirst,GLsizei rangeCount) // Adds a range of points to the batch
+		{
+		/* Start a new batch if the range does not extend the current one: */
+		if(rangeFirst!=first+count)
+			{
+			flush();
+			first=rangeFirst;
+			}
+		count+=rangeCount;
 		}
 	};
 
-}
-
 /***********************************
 Methods of class PointSet::DataItem:
 ***********************************/
@@ -240,15 +206,27 @@ PointSet::DataItem::~DataItem(void)
 		}
 	}
 
+/*********************************
+Static elements of class PointSet:
+*********************************/
+
+const char PointSet::cacheFileId[32]={'3','D','V','i','s','u','a','l','i','z','e','r',' ','p','o','i','n','t',' ','s','e','t',' ','c','a','c','h','e',' ','1','.','0'};
+const unsigned int PointSet::maxLeafSize;
+const unsigned int PointSet::numLodPoints;
+const int PointSet::maxDepth;
+
 /*************************
 Methods of class PointSet:
 *************************/
 
-PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scaleFactor)
-	:GLObject(false)
+void PointSet::readPointFile(const char* pointFileName,double flatteningFactor,double scaleFactor)
 	{
-	/* Open the point file: */
-	Misc::File pointFile(pointFileName,"rt");
+	/* Open the point file and treat line breaks as separators: */
+	IO::ValueSource reader(IO::openFile(pointFileName));
+	reader.setWhitespace('\n',false);
+	reader.setPunctuation('\n',true);
+	reader.setQuotes("\"");
+	reader.skipWs();
 	
 	/* Read the header line from the point file: */
 	int latIndex=-1;
@@ -259,76 +237,67 @@ PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scal
 		RADIUS,DEPTH,NEGDEPTH
 		} radiusMode=RADIUS;
 	int index=0;
-	while(true)
+	while(!reader.eof()&&reader.peekc()!='\n')
 		{
-		char valueBuffer[40];
-		int terminator=getNextValue(pointFile,valueBuffer,sizeof(valueBuffer));
-		if(terminator=='\n')
-			break;
-		else if(terminator==EOF)
-			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Early end of file in input file \"%s\"",pointFileName);
-		else if(strcasecmp(valueBuffer,"Latitude")==0||strcasecmp(valueBuffer,"Lat")==0)
+		std::string value=reader.readString();
+		if(strcasecmp(value.c_str(),"Latitude")==0||strcasecmp(value.c_str(),"Lat")==0)
 			latIndex=index;
-		else if(strcasecmp(valueBuffer,"Longitude")==0||strcasecmp(valueBuffer,"Long")==0||strcasecmp(valueBuffer,"Lon")==0)
+		else if(strcasecmp(value.c_str(),"Longitude")==0||strcasecmp(value.c_str(),"Long")==0||strcasecmp(value.c_str(),"Lon")==0)
 			lngIndex=index;
-		else if(strcasecmp(valueBuffer,"Radius")==0)
+		else if(strcasecmp(value.c_str(),"Radius")==0)
 			{
 			radiusIndex=index;
 			radiusMode=RADIUS;
 			}
-		else if(strcasecmp(valueBuffer,"Depth")==0)
+		else if(strcasecmp(value.c_str(),"Depth")==0)
 			{
 			radiusIndex=index;
 			radiusMode=DEPTH;
 			}
-		else if(strcasecmp(valueBuffer,"Negative Depth")==0||strcasecmp(valueBuffer,"Neg Depth")==0||strcasecmp(valueBuffer,"NegDepth")==0)
+		else if(strcasecmp(value.c_str(),"Negative Depth")==0||strcasecmp(value.c_str(),"Neg Depth")==0||strcasecmp(value.c_str(),"NegDepth")==0)
 			{
 			radiusIndex=index;
 			radiusMode=NEGDEPTH;
 			}
 		++index;
 		}
+	if(reader.eof())
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Early end of file in input file \"%s\"",pointFileName);
+	reader.skipLine();
+	reader.skipWs();
 	
 	/* Check if all required portions have been detected: */
 	if(latIndex<0||lngIndex<0||radiusIndex<0)
 		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing point components in input file \"%s\"",pointFileName);
 	
 	/* Read all point positions from the point file: */
-	bool finished=false;
-	while(!finished)
+	while(!reader.eof())
 		{
 		/* Read the next line from the input file: */
-		int index=0;
 		float sphericalCoordinates[3]={0.0f,0.0f,0.0f}; // Initialization just to shut up gcc
 		int parsedComponentsMask=0x0;
-		while(true)
+		for(int index=0;!reader.eof()&&reader.peekc()!='\n';++index)
 			{
-			char valueBuffer[40];
-			int terminator=getNextValue(pointFile,valueBuffer,sizeof(valueBuffer));
-			if(terminator=='\n')
-				break;
-			else if(terminator==EOF)
+			if(index==latIndex)
 				{
-				finished=true;
-				break;
-				}
-			else if(index==latIndex)
-				{
-				sphericalCoordinates[0]=Math::rad(float(atof(valueBuffer)));
+				sphericalCoordinates[0]=Math::rad(float(readValue(reader)));
 				parsedComponentsMask|=0x1;
 				}
 			else if(index==lngIndex)
 				{
-				sphericalCoordinates[1]=Math::rad(float(atof(valueBuffer)));
+				sphericalCoordinates[1]=Math::rad(float(readValue(reader)));
 				parsedComponentsMask|=0x2;
 				}
 			else if(index==radiusIndex)
 				{
-				sphericalCoordinates[2]=float(atof(valueBuffer));
+				sphericalCoordinates[2]=float(readValue(reader));
 				parsedComponentsMask|=0x4;
 				}
-			++index;
+			else
+				reader.skipString();
 			}
+		reader.skipLine();
+		reader.skipWs();
 		
 		/* Check if a complete set of coordinates has been parsed: */
 		if(parsedComponentsMask==0x7&&!isnan(sphericalCoordinates[2]))
@@ -355,7 +324,253 @@ PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scal
 			points.push_back(p);
 			}
 		}
-	std::cout<<points.size()<<" points parsed from "<<pointFileName<<std::endl;
+	}
+
+bool PointSet::readCacheFile(const char* cacheFileName,Misc::UInt64 pointFileSize,Misc::SInt64 pointFileTime,double flatteningFactor,double scaleFactor)
+	{
+	/* Get the size of the cache file to validate its point count before allocating memory: */
+	struct stat cacheFileStats;
+	if(stat(cacheFileName,&cacheFileStats)!=0)
+		return false;
+	Misc::UInt64 cacheFileSize=Misc::UInt64(cacheFileStats.st_size);
+	const Misc::UInt64 headerSize=sizeof(cacheFileId)+sizeof(Misc::UInt64)+sizeof(Misc::SInt64)+2*sizeof(Misc::Float64)+sizeof(Misc::UInt64);
+	const Misc::UInt64 pointSize=3*sizeof(GLfloat);
+	
+	try
+		{
+		/* Open the cache file: */
+		IO::FilePtr file(IO::openFile(cacheFileName));
+		file->setEndianness(Misc::LittleEndian);
+		
+		/* Check the file identifier: */
+		char id[sizeof(cacheFileId)];
+		file->read(id,sizeof(cacheFileId));
+		if(memcmp(id,cacheFileId,sizeof(cacheFileId))!=0)
+			return false;
+		
+		/* Check that the cache was created from the same point file using the same conversion parameters: */
+		if(file->read<Misc::UInt64>()!=pointFileSize||file->read<Misc::SInt64>()!=pointFileTime)
+			return false;
+		if(file->read<Misc::Float64>()!=flatteningFactor||file->read<Misc::Float64>()!=scaleFactor)
+			return false;
+		
+		/* Read all point positions: */
+		Misc::UInt64 numPoints=file->read<Misc::UInt64>();
+		if(cacheFileSize<headerSize||numPoints!=(cacheFileSize-headerSize)/pointSize||(cacheFileSize-headerSize)%pointSize!=0)
+			{
+			/* The cache file is corrupted or truncated; ignore it: */
+			return false;
+			}
+		points.resize(size_t(numPoints));
+		for(std::vector<Vertex>::iterator pIt=points.begin();pIt!=points.end();++pIt)
+			file->read(pIt->position.getXyzw(),3);
+		}
+	catch(const std::runtime_error&)
+		{
+		/* Treat unreadable or truncated cache files as missing: */
+		points.clear();
+		return false;
+		}
+	
+	return true;
+	}
+
+void PointSet::writeCacheFile(const char* cacheFileName,Misc::UInt64 pointFileSize,Misc::SInt64 pointFileTime,double flatteningFactor,double scaleFactor) const
+	{
+	/* Write into a temporary file first, so that concurrent readers or writers never see a partial cache file: */
+	std::string tempFileName=cacheFileName;
+	char pidBuffer[32];
+	snprintf(pidBuffer,sizeof(pidBuffer),".%d",int(getpid()));
+	tempFileName.append(pidBuffer);
+	
+	try
+		{
+		{
+		IO::FilePtr file(IO::openFile(tempFileName.c_str(),IO::File::WriteOnly));
+		file->setEndianness(Misc::LittleEndian);
+		
+		/* Write the file header: */
+		file->write(cacheFileId,sizeof(cacheFileId));
+		file->write<Misc::UInt64>(pointFileSize);
+		file->write<Misc::SInt64>(pointFileTime);
+		file->write<Misc::Float64>(flatteningFactor);
+		file->write<Misc::Float64>(scaleFactor);
+		
+		/* Write all point positions: */
+		file->write<Misc::UInt64>(points.size());
+		for(std::vector<Vertex>::const_iterator pIt=points.begin();pIt!=points.end();++pIt)
+			file->write(pIt->position.getXyzw(),3);
+		}
+		
+		/* Replace the cache file: */
+		if(rename(tempFileName.c_str(),cacheFileName)!=0)
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unable to rename temporary file %s",tempFileName.c_str());
+		}
+	catch(const std::runtime_error& err)
+		{
+		/* The cache is optional; just clean up and report the problem: */
+		unlink(tempFileName.c_str());
+		std::cerr<<"Unable to write point cache file "<<cacheFileName<<" due to exception "<<err.what()<<std::endl;
+		}
+	}
+
+unsigned int PointSet::createNode(unsigned int firstPoint,unsigned int lastPoint,int depth)
+	{
+	/* Create a new node: */
+	unsigned int nodeIndex=nodes.size();
+	nodes.push_back(Node());
+	Node& node=nodes.back();
+	for(int i=0;i<8;++i)
+		node.children[i]=0;
+	
+	/* Calculate the bounding box of all points in the node's subtree: */
+	for(int i=0;i<3;++i)
+		{
+		node.box[0][i]=points[firstPoint].position[i];
+		node.box[1][i]=points[firstPoint].position[i];
+		}
+	for(unsigned int pointIndex=firstPoint+1;pointIndex<lastPoint;++pointIndex)
+		for(int i=0;i<3;++i)
+			{
+			Scalar c=points[pointIndex].position[i];
+			if(node.box[0][i]>c)
+				node.box[0][i]=c;
+			if(node.box[1][i]<c)
+				node.box[1][i]=c;
+			}
+	
+	/* Check if the node should be a leaf: */
+	unsigned int numPoints=lastPoint-firstPoint;
+	node.firstPoint=firstPoint;
+	Scalar split[3];
+	bool degenerate=true;
+	for(int i=0;i<3;++i)
+		{
+		split[i]=Math::mid(node.box[0][i],node.box[1][i]);
+		if(node.box[0][i]<split[i]&&split[i]<node.box[1][i])
+			degenerate=false;
+		}
+	if(numPoints<=maxLeafSize||depth>=maxDepth||degenerate)
+		{
+		/* Make the node a leaf containing all its points: */
+		node.numPoints=numPoints;
+		return nodeIndex;
+		}
+	
+	/* Move an evenly-spaced subset of points to the front to represent the node at a low level of detail: */
+	unsigned int stride=numPoints/numLodPoints;
+	for(unsigned int i=1;i<numLodPoints;++i)
+		std::swap(points[firstPoint+i],points[firstPoint+i*stride]);
+	node.numPoints=numLodPoints;
+	
+	/* Partition the remaining points into octants, first along z, then along y, then along x: */
+	unsigned int bounds[9];
+	bounds[0]=firstPoint+numLodPoints;
+	bounds[8]=lastPoint;
+	for(int dim=2;dim>=0;--dim)
+		{
+		int step=2<<dim;
+		for(int i=0;i<8;i+=step)
+			{
+			std::vector<Vertex>::iterator begin=points.begin()+bounds[i];
+			std::vector<Vertex>::iterator end=points.begin()+bounds[i+step];
+			bounds[i+step/2]=std::partition(begin,end,PointOctantSplitter<Vertex>(dim,split[dim]))-points.begin();
+			}
+		}
+	
+	/* Create the node's non-empty children; this invalidates the node reference: */
+	for(int childIndex=0;childIndex<8;++childIndex)
+		if(bounds[childIndex]<bounds[childIndex+1])
+			{
+			unsigned int child=createNode(bounds[childIndex],bounds[childIndex+1],depth+1);
+			nodes[nodeIndex].children[childIndex]=child;
+			}
+	
+	return nodeIndex;
+	}
+
+void PointSet::renderNode(unsigned int nodeIndex,const PointSet::DPlane frustum[6],int planeMask,const PointSet::DPoint& eye,PointSet::DrawBatch& batch) const
+	{
+	const Node& node=nodes[nodeIndex];
+	
+	/* Check the node's bounding box against all frustum planes it straddles: */
+	for(int planeIndex=0;planeIndex<6;++planeIndex)
+		if(planeMask&(1<<planeIndex))
+			{
+			/* Calculate the box' minimum and maximum distances from the plane: */
+			const DPlane::Vector& normal=frustum[planeIndex].getNormal();
+			double minDist=-frustum[planeIndex].getOffset();
+			double maxDist=minDist;
+			for(int i=0;i<3;++i)
+				{
+				if(normal[i]>=0.0)
+					{
+					minDist+=normal[i]*double(node.box[0][i]);
+					maxDist+=normal[i]*double(node.box[1][i]);
+					}
+				else
+					{
+					minDist+=normal[i]*double(node.box[1][i]);
+					maxDist+=normal[i]*double(node.box[0][i]);
+					}
+				}
+			
+			/* Cull the node if it is entirely outside the plane; stop checking the plane if it is entirely inside: */
+			if(maxDist<0.0)
+				return;
+			if(minDist>=0.0)
+				planeMask&=~(1<<planeIndex);
+			}
+	
+	/* Render the node's own points: */
+	batch.add(GLint(node.firstPoint),GLsizei(node.numPoints));
+	
+	/* Calculate the distance from the eye to the node's bounding box and the node's radius: */
+	double dist2=0.0;
+	double radius2=0.0;
+	for(int i=0;i<3;++i)
+		{
+		if(eye[i]<double(node.box[0][i]))
+			dist2+=Math::sqr(double(node.box[0][i])-eye[i]);
+		else if(eye[i]>double(node.box[1][i]))
+			dist2+=Math::sqr(eye[i]-double(node.box[1][i]));
+		radius2+=Math::sqr(double(node.box[1][i])-double(node.box[0][i]));
+		}
+	radius2*=0.25;
+	
+	/* Refine the node if it appears large enough from the eye: */
+	if(radius2>=Math::sqr(double(lodThreshold))*dist2)
+		for(int childIndex=0;childIndex<8;++childIndex)
+			if(node.children[childIndex]!=0)
+				renderNode(node.children[childIndex],frustum,planeMask,eye,batch);
+	}
+
+PointSet::PointSet(const char* pointFileName,double flatteningFactor,double scaleFactor)
+	:GLObject(false),
+	 lodThreshold(0.05f)
+	{
+	/* Identify the point file by its size and modification time to validate its binary cache file: */
+	struct stat pointFileStats;
+	bool havePointFileStats=stat(pointFileName,&pointFileStats)==0;
+	Misc::UInt64 pointFileSize=havePointFileStats?Misc::UInt64(pointFileStats.st_size):0;
+	Misc::SInt64 pointFileTime=havePointFileStats?Misc::SInt64(pointFileStats.st_mtime):0;
+	std::string cacheFileName=pointFileName;
+	cacheFileName.append(".cache");
+	
+	/* Read converted point positions from the cache file if it is current, or parse the point file and create the cache: */
+	if(havePointFileStats&&readCacheFile(cacheFileName.c_str(),pointFileSize,pointFileTime,flatteningFactor,scaleFactor))
+		std::cout<<points.size()<<" points read from "<<cacheFileName<<std::endl;
+	else
+		{
+		readPointFile(pointFileName,flatteningFactor,scaleFactor);
+		std::cout<<points.size()<<" points parsed from "<<pointFileName<<std::endl;
+		if(havePointFileStats)
+			writeCacheFile(cacheFileName.c_str(),pointFileSize,pointFileTime,flatteningFactor,scaleFactor);
+		}
+	
+	/* Create an octree over all points, which reorders the points by octree node: */
+	if(!points.empty())
+		createNode(0,points.size(),0);
 	
 	GLObject::init();
 	}
@@ -372,50 +587,59 @@ void PointSet::initContext(GLContextData& contextData) const
 	contextData.addDataItem(this,dataItem);
 	
 	/* Check if the vertex buffer object extension is supported: */
-	if(dataItem->vertexBufferObjectId>0)
+	if(dataItem->vertexBufferObjectId>0&&!points.empty())
 		{
-		/* Create a vertex buffer object to store the points' coordinates: */
+		/* Create a vertex buffer object to store the points' coordinates in octree order: */
 		glBindBufferARB(GL_ARRAY_BUFFER_ARB,dataItem->vertexBufferObjectId);
-		glBufferDataARB(GL_ARRAY_BUFFER_ARB,points.size()*sizeof(Vertex),0,GL_STATIC_DRAW_ARB);
-		
-		/* Copy all points: */
-		PointChunkUploader<Vertex> pcu;
-		points.forEachChunk(pcu);
+		glBufferDataARB(GL_ARRAY_BUFFER_ARB,points.size()*sizeof(Vertex),&points[0],GL_STATIC_DRAW_ARB);
 		
 		/* Protect the vertex buffer object: */
 		glBindBufferARB(GL_ARRAY_BUFFER_ARB,0);
 		}
 	}
 
-void PointSet::glRenderAction(GLContextData& contextData) const
+void PointSet::setLodThreshold(PointSet::Scalar newLodThreshold)
 	{
+	lodThreshold=newLodThreshold;
+	}
+
+void PointSet::glRenderAction(SceneGraph::GLRenderState& renderState) const
+	{
+	/* Bail out if there are no points: */
+	if(nodes.empty())
+		return;
+	
 	/* Get a pointer to the data item: */
-	DataItem* dataItem=contextData.retrieveDataItem<DataItem>(this);
+	DataItem* dataItem=renderState.contextData.retrieveDataItem<DataItem>(this);
 	
-	GLVertexArrayParts::enable(Vertex::getPartsMask());
+	/* Get the view frustum and eye position in model coordinates: */
+	DPlane frustum[6];
+	for(int i=0;i<6;++i)
+		frustum[i]=renderState.getFrustumPlane(i);
+	DPoint eye(renderState.getEyePos());
 	
-	/* Check if the vertex buffer object extension is supported: */
+	/* Upload the current modelview matrix: */
+	renderState.uploadModelview();
+	
+	/* Set up the point array: */
+	renderState.enableVertexArrays(Vertex::getPartsMask());
 	if(dataItem->vertexBufferObjectId!=0)
 		{
 		/* Bind the point set's vertex buffer object: */
-		glBindBufferARB(GL_ARRAY_BUFFER_ARB,dataItem->vertexBufferObjectId);
-		
-		/* Render the point set as a vertex buffer of points: */
+		renderState.bindVertexBuffer(dataItem->vertexBufferObjectId);
 		glVertexPointer(static_cast<const Vertex*>(0));
-		glDrawArrays(GL_POINTS,0,points.size());
-		
-		/* Protect the vertex buffer object: */
-		glBindBufferARB(GL_ARRAY_BUFFER_ARB,0);
 		}
 	else
 		{
-		/* Render the point set as a set of regular vertex arrays of points: */
-		PointChunkRenderer<Vertex> pcr;
-		points.forEachChunk(pcr);
+		/* Render from a regular vertex array: */
+		renderState.bindVertexBuffer(0);
+		glVertexPointer(&points[0]);
 		}
 	
-	/* Restore OpenGL state: */
-	GLVertexArrayParts::disable(Vertex::getPartsMask());
+	/* Render the visible parts of the octree at the appropriate levels of detail: */
+	DrawBatch batch;
+	renderNode(0,frustum,0x3f,eye,batch);
+	batch.flush();
 	}
 
 }
@@ -1,6 +1,6 @@
 /***********************************************************************
 PointSet - Class to represent and render sets of scattered 3D points.
-Copyright (c) 2005-2013 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -22,7 +22,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_CONCRETE_POINTSET_INCLUDED
 #define VISUALIZATION_CONCRETE_POINTSET_INCLUDED
 
-#include <Misc/ChunkedArray.h>
+#include <vector>
+#include <Misc/SizedTypes.h>
+#include <Geometry/Point.h>
+#include <Geometry/Plane.h>
 #include <GL/gl.h>
 #define GLVERTEX_NONSTANDARD_TEMPLATES
 #include <GL/GLVertex.h>
@@ -34,6 +37,11 @@ template <class T1,int i1,class T2,int i2,class T3,class T4,int i4>
 class GLVertex;
 #endif
 
+/* Forward declarations: */
+namespace SceneGraph {
+class GLRenderState;
+}
+
 namespace Visualization {
 
 namespace Concrete {
@@ -44,6 +52,20 @@ class PointSet:public GLObject
 	private:
 	typedef float Scalar; // Scalar type for point coordinates
 	typedef GLVertex<void,0,void,0,void,GLfloat,3> Vertex; // Vertex type for points (position only)
+	typedef Geometry::Point<double,3> DPoint; // Type for points in model coordinates during rendering
+	typedef Geometry::Plane<double,3> DPlane; // Type for view frustum planes in model coordinates during rendering
+	
+	struct Node // Structure for octree nodes; each node's subtree occupies a contiguous range of the point array in pre-order
+		{
+		/* Elements: */
+		public:
+		Scalar box[2][3]; // Tight bounding box of all points in the node's subtree as minimum and maximum corners
+		unsigned int firstPoint; // Index of the node's first own point in the point array
+		unsigned int numPoints; // Number of the node's own points; a representative subset of the subtree for interior nodes
+		unsigned int children[8]; // Indices of the node's children in the node array, or 0 for empty octants and leaf nodes
+		};
+	
+	struct DrawBatch; // Structure to merge consecutive ranges of points into few draw calls
 	
 	struct DataItem:public GLObject::DataItem
 		{
@@ -57,19 +79,38 @@ class PointSet:public GLObject
 		virtual ~DataItem(void); // Destroys a data item
 		};
 	
+	static const char cacheFileId[32]; // Identifier at the beginning of binary point cache files
+	static const unsigned int maxLeafSize=4096; // Maximum number of points in an octree leaf node
+	static const unsigned int numLodPoints=1024; // Number of representative points kept in each interior octree node
+	static const int maxDepth=24; // Maximum depth of the octree, to stop subdividing clusters of identical points
+	
 	/* Elements: */
-	Misc::ChunkedArray<Vertex> points; // Array of points
+	std::vector<Vertex> points; // Array of points, ordered by octree node
+	std::vector<Node> nodes; // Array of octree nodes; the root node is the first node
+	Scalar lodThreshold; // Ratio of a node's radius to its distance from the eye below which the node is rendered only by its representative points
+	
+	/* Private methods: */
+	void readPointFile(const char* pointFileName,double flatteningFactor,double scaleFactor); // Parses Cartesian point positions from the given text file
+	bool readCacheFile(const char* cacheFileName,Misc::UInt64 pointFileSize,Misc::SInt64 pointFileTime,double flatteningFactor,double scaleFactor); // Reads Cartesian point positions from a binary cache file if it matches the given source file and parameters
+	void writeCacheFile(const char* cacheFileName,Misc::UInt64 pointFileSize,Misc::SInt64 pointFileTime,double flatteningFactor,double scaleFactor) const; // Writes Cartesian point positions to a binary cache file
+	unsigned int createNode(unsigned int firstPoint,unsigned int lastPoint,int depth); // Creates an octree node for the given range of points and reorders them; returns index of new node
+	void renderNode(unsigned int nodeIndex,const DPlane frustum[6],int planeMask,const DPoint& eye,DrawBatch& batch) const; // Renders the given octree node's visible subtree at the appropriate level of detail
 	
 	/* Constructors and destructors: */
 	public:
-	PointSet(const char* pointFileName,double flatteningFactor,double scaleFactor); // Creates a point set by reading a file; applies flattening factor to geoid formula and scale factor to Cartesian coordinates
+	PointSet(const char* pointFileName,double flatteningFactor,double scaleFactor); // Creates a point set by reading a file or its binary cache; applies flattening factor to geoid formula and scale factor to Cartesian coordinates
 	virtual ~PointSet(void);
 	
 	/* Methods from GLObject: */
 	virtual void initContext(GLContextData& contextData) const;
 	
 	/* New methods: */
-	void glRenderAction(GLContextData& contextData) const; // Renders point set into the current OpenGL context
+	Scalar getLodThreshold(void) const // Returns the level-of-detail threshold
+		{
+		return lodThreshold;
+		}
+	void setLodThreshold(Scalar newLodThreshold); // Sets the level-of-detail threshold; 0 renders all points
+	void glRenderAction(SceneGraph::GLRenderState& renderState) const; // Renders the point set's visible parts at the appropriate level of detail into the current OpenGL context
 	};
 
 }
@@ -0,0 +1,175 @@
+/***********************************************************************
+SyntheticCartesian - Class to procedurally generate Cartesian data sets
+of arbitrary size from analytic fields for benchmarking.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Concrete/SyntheticCartesian.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <iostream>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/StdError.h>
+#include <Misc/Timer.h>
+#include <Plugins/FactoryManager.h>
+#include <Cluster/MulticastPipe.h>
+
+#include <Concrete/SyntheticFields.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+class CartesianPositionSource:public SyntheticFields::PositionSource // Class to calculate vertex positions of a Cartesian grid from linear vertex indices
+	{
+	/* Elements: */
+	private:
+	DS::Index numVertices; // Number of vertices of the grid
+	DS::Size cellSize; // Size of the grid's cells
+	
+	/* Constructors and destructors: */
+	public:
+	CartesianPositionSource(const DS::Index& sNumVertices,const DS::Size& sCellSize)
+		:numVertices(sNumVertices),cellSize(sCellSize)
+		{
+		}
+	
+	/* Methods from SyntheticFields::PositionSource: */
+	virtual SyntheticFields::Point getPosition(size_t vertexIndex) const
+		{
+		/* Decompose the linear index; the last grid dimension varies fastest: */
+		SyntheticFields::Point result;
+		for(int i=2;i>=0;--i)
+			{
+			result[i]=Scalar(vertexIndex%size_t(numVertices[i]))*cellSize[i];
+			vertexIndex/=size_t(numVertices[i]);
+			}
+		return result;
+		}
+	};
+
+}
+
+/***********************************
+Methods of class SyntheticCartesian:
+***********************************/
+
+SyntheticCartesian::SyntheticCartesian(void)
+	:BaseModule("SyntheticCartesian")
+	{
+	}
+
+Visualization::Abstract::DataSet* SyntheticCartesian::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	bool master=pipe==0||pipe->isMaster();
+	
+	/* Parse the module arguments: */
+	DS::Index numVertices(128,128,128);
+	SyntheticFields::Parameters fieldParameters;
+	for(std::vector<std::string>::const_iterator argIt=args.begin();argIt!=args.end();++argIt)
+		{
+		if(strcasecmp(argIt->c_str(),"-size")==0)
+			{
+			for(int i=0;i<3;++i)
+				{
+				++argIt;
+				if(argIt==args.end())
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing grid size");
+				numVertices[i]=atoi(argIt->c_str());
+				if(numVertices[i]<2)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid grid size %d",numVertices[i]);
+				}
+			}
+		else if(!fieldParameters.parseArgument(argIt,args.end()))
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unrecognized argument %s",argIt->c_str());
+		}
+	
+	/* Create the result data set with unit-sized largest extent: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	DS& dataSet=result->getDs();
+	int maxNumVertices=numVertices[0];
+	for(int i=1;i<3;++i)
+		if(maxNumVertices<numVertices[i])
+			maxNumVertices=numVertices[i];
+	DS::Size cellSize;
+	for(int i=0;i<3;++i)
+		cellSize[i]=Scalar(1)/Scalar(maxNumVertices-1);
+	dataSet.setData(numVertices,cellSize,0);
+	
+	/* Initialize the result data set's data value: */
+	DataValue& dataValue=result->getDataValue();
+	dataValue.initialize(&dataSet,0);
+	
+	/* Add one slice per generated field component: */
+	float* slices[SyntheticFields::NUM_SLICES];
+	for(int i=0;i<SyntheticFields::NUM_SLICES;++i)
+		slices[i]=dataSet.getSliceArray(dataSet.addSlice());
+	for(int i=0;i<SyntheticFields::VELOCITY_X;++i)
+		dataValue.addScalarVariable(SyntheticFields::getSliceName(i));
+	int vectorVariableIndex=dataValue.addVectorVariable(SyntheticFields::getVectorName());
+	for(int i=0;i<4;++i)
+		{
+		dataValue.addScalarVariable(makeVectorSliceName(SyntheticFields::getVectorName(),i).c_str());
+		if(i<3)
+			dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,SyntheticFields::VELOCITY_X+i);
+		}
+	
+	/* Evaluate the fields at all grid vertices: */
+	if(master)
+		std::cout<<"Generating "<<dataSet.getTotalNumVertices()<<" vertices..."<<std::flush;
+	Misc::Timer generateTimer;
+	SyntheticFields fields(fieldParameters,dataSet.getDomainBox());
+	fields.evaluate(dataSet.getTotalNumVertices(),CartesianPositionSource(numVertices,cellSize),slices);
+	generateTimer.elapse();
+	if(master)
+		std::cout<<" done in "<<generateTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	/* Return the result data set: */
+	return result.releaseTarget();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticCartesian* module=new Visualization::Concrete::SyntheticCartesian();
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,180 @@
+/***********************************************************************
+SyntheticCurvilinear - Class to procedurally generate curvilinear data
+sets shaped as warped boxes or spherical shell sections of arbitrary size
+from analytic fields for benchmarking.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Concrete/SyntheticCurvilinear.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <iostream>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/StdError.h>
+#include <Misc/Timer.h>
+#include <Plugins/FactoryManager.h>
+#include <Cluster/MulticastPipe.h>
+#include <Math/Math.h>
+
+#include <Concrete/SyntheticFields.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/*************************************
+Methods of class SyntheticCurvilinear:
+*************************************/
+
+SyntheticCurvilinear::SyntheticCurvilinear(void)
+	:BaseModule("SyntheticCurvilinear")
+	{
+	}
+
+Visualization::Abstract::DataSet* SyntheticCurvilinear::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	bool master=pipe==0||pipe->isMaster();
+	
+	/* Parse the module arguments: */
+	DS::Index numVertices(64,64,64);
+	bool shell=false;
+	SyntheticFields::Parameters fieldParameters;
+	for(std::vector<std::string>::const_iterator argIt=args.begin();argIt!=args.end();++argIt)
+		{
+		if(strcasecmp(argIt->c_str(),"-size")==0)
+			{
+			for(int i=0;i<3;++i)
+				{
+				++argIt;
+				if(argIt==args.end())
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing grid size");
+				numVertices[i]=atoi(argIt->c_str());
+				if(numVertices[i]<2)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid grid size %d",numVertices[i]);
+				}
+			}
+		else if(strcasecmp(argIt->c_str(),"-shape")==0)
+			{
+			++argIt;
+			if(argIt==args.end())
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing grid shape");
+			if(strcasecmp(argIt->c_str(),"box")==0)
+				shell=false;
+			else if(strcasecmp(argIt->c_str(),"shell")==0)
+				shell=true;
+			else
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unknown grid shape %s",argIt->c_str());
+			}
+		else if(!fieldParameters.parseArgument(argIt,args.end()))
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unrecognized argument %s",argIt->c_str());
+		}
+	
+	/* Create the result data set: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	DS& dataSet=result->getDs();
+	dataSet.setGrid(numVertices);
+	
+	/* Calculate the grid's vertex positions: */
+	int maxNumVertices=numVertices[0];
+	for(int i=1;i<3;++i)
+		if(maxNumVertices<numVertices[i])
+			maxNumVertices=numVertices[i];
+	DS::GridArray& grid=dataSet.getGrid();
+	for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+		{
+		if(shell)
+			{
+			/* Map the vertex index to longitude, latitude, and radius, in that order to create a right-handed grid: */
+			Scalar lng=Math::rad(Scalar(90)*Scalar(index[0])/Scalar(numVertices[0]-1));
+			Scalar lat=Math::rad(Scalar(-45)+Scalar(90)*Scalar(index[1])/Scalar(numVertices[1]-1));
+			Scalar r=Scalar(0.55)+Scalar(0.45)*Scalar(index[2])/Scalar(numVertices[2]-1);
+			grid(index)=SyntheticFields::calcShellPosition(lat,lng,r);
+			}
+		else
+			{
+			/* Map the vertex index to a warped box with unit-sized largest extent: */
+			Scalar uvw[3];
+			for(int i=0;i<3;++i)
+				uvw[i]=Scalar(index[i])/Scalar(maxNumVertices-1);
+			grid(index)=SyntheticFields::calcWarpedBoxPosition(uvw);
+			}
+		}
+	
+	/* Finalize the grid structure: */
+	if(master)
+		std::cout<<"Finalizing grid structure..."<<std::flush;
+	dataSet.finalizeGrid();
+	if(master)
+		std::cout<<" done"<<std::endl;
+	
+	/* Initialize the result data set's data value: */
+	DataValue& dataValue=result->getDataValue();
+	dataValue.initialize(&dataSet,0);
+	
+	/* Add one slice per generated field component: */
+	float* slices[SyntheticFields::NUM_SLICES];
+	for(int i=0;i<SyntheticFields::NUM_SLICES;++i)
+		slices[i]=dataSet.getSliceArray(dataSet.addSlice());
+	for(int i=0;i<SyntheticFields::VELOCITY_X;++i)
+		dataValue.addScalarVariable(SyntheticFields::getSliceName(i));
+	int vectorVariableIndex=dataValue.addVectorVariable(SyntheticFields::getVectorName());
+	for(int i=0;i<4;++i)
+		{
+		dataValue.addScalarVariable(makeVectorSliceName(SyntheticFields::getVectorName(),i).c_str());
+		if(i<3)
+			dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,SyntheticFields::VELOCITY_X+i);
+		}
+	
+	/* Evaluate the fields at all grid vertices: */
+	if(master)
+		std::cout<<"Generating "<<dataSet.getTotalNumVertices()<<" vertices..."<<std::flush;
+	Misc::Timer generateTimer;
+	SyntheticFields fields(fieldParameters,dataSet.getDomainBox());
+	fields.evaluate(dataSet.getTotalNumVertices(),SyntheticFields::PointArrayPositionSource(grid.getArray()),slices);
+	generateTimer.elapse();
+	if(master)
+		std::cout<<" done in "<<generateTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	/* Return the result data set: */
+	return result.releaseTarget();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticCurvilinear* module=new Visualization::Concrete::SyntheticCurvilinear();
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
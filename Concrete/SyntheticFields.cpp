@@ -0,0 +1,354 @@
+/***********************************************************************
+SyntheticFields - Class to evaluate analytic scalar and vector fields on
+procedurally generated grids to create benchmark data sets of arbitrary
+size.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Concrete/SyntheticFields.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <Misc/StdError.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+
+#include <ParallelTasks.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+const char* getOptionValue(std::vector<std::string>::const_iterator& argIt,const std::vector<std::string>::const_iterator& argEnd)
+	{
+	/* Advance to the option's value: */
+	const char* option=argIt->c_str();
+	++argIt;
+	if(argIt==argEnd)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing value for option %s",option);
+	
+	return argIt->c_str();
+	}
+
+class RandomSequence // Simple linear congruential generator producing the same sequence on all platforms
+	{
+	/* Elements: */
+	private:
+	unsigned int state; // Current generator state
+	
+	/* Constructors and destructors: */
+	public:
+	RandomSequence(unsigned int seed)
+		:state(seed)
+		{
+		}
+	
+	/* Methods: */
+	double next(void) // Returns the next pseudo-random number in [0, 1)
+		{
+		state=state*1103515245U+12345U;
+		return double((state>>8)&0xffffffU)/double(0x1000000U);
+		}
+	};
+
+double calcAssociatedLegendre(int l,int m,double x)
+	{
+	/* Calculate P_m^m(x) in closed form: */
+	double pmm=1.0;
+	double somx2=Math::sqrt((1.0-x)*(1.0+x));
+	double fact=1.0;
+	for(int i=0;i<m;++i,fact+=2.0)
+		pmm*=-fact*somx2;
+	if(l==m)
+		return pmm;
+	
+	/* Calculate P_(m+1)^m(x): */
+	double pmmp1=x*double(2*m+1)*pmm;
+	
+	/* Recurse upwards to P_l^m(x): */
+	for(int ll=m+2;ll<=l;++ll)
+		{
+		double pll=(x*double(2*ll-1)*pmmp1-double(ll+m-1)*pmm)/double(ll-m);
+		pmm=pmmp1;
+		pmmp1=pll;
+		}
+	
+	return pmmp1;
+	}
+
+}
+
+/*********************************************
+Methods of struct SyntheticFields::Parameters:
+*********************************************/
+
+SyntheticFields::Parameters::Parameters(void)
+	:seed(1U),numThreads(0),
+	 noiseDegree(3),turbulenceDepth(4),turbulenceFrequency(8),
+	 numVortices(8),
+	 harmonicDegree(6),harmonicOrder(3)
+	{
+	}
+
+bool SyntheticFields::Parameters::parseArgument(std::vector<std::string>::const_iterator& argIt,const std::vector<std::string>::const_iterator& argEnd)
+	{
+	if(strcasecmp(argIt->c_str(),"-seed")==0)
+		seed=(unsigned int)(strtoul(getOptionValue(argIt,argEnd),0,10));
+	else if(strcasecmp(argIt->c_str(),"-numThreads")==0)
+		numThreads=(unsigned int)(atoi(getOptionValue(argIt,argEnd)));
+	else if(strcasecmp(argIt->c_str(),"-noiseDegree")==0)
+		{
+		noiseDegree=atoi(getOptionValue(argIt,argEnd));
+		if(noiseDegree<1||noiseDegree>5)
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid noise degree %d",noiseDegree);
+		}
+	else if(strcasecmp(argIt->c_str(),"-turbulenceDepth")==0)
+		turbulenceDepth=atoi(getOptionValue(argIt,argEnd));
+	else if(strcasecmp(argIt->c_str(),"-turbulenceFrequency")==0)
+		turbulenceFrequency=Scalar(atof(getOptionValue(argIt,argEnd)));
+	else if(strcasecmp(argIt->c_str(),"-numVortices")==0)
+		numVortices=(unsigned int)(atoi(getOptionValue(argIt,argEnd)));
+	else if(strcasecmp(argIt->c_str(),"-harmonic")==0)
+		{
+		harmonicDegree=atoi(getOptionValue(argIt,argEnd));
+		harmonicOrder=atoi(getOptionValue(argIt,argEnd));
+		if(harmonicOrder<0||harmonicOrder>harmonicDegree)
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid spherical harmonic degree %d and order %d",harmonicDegree,harmonicOrder);
+		}
+	else
+		return false;
+	
+	return true;
+	}
+
+/***************************************************
+Declaration of struct SyntheticFields::EvaluateTask:
+***************************************************/
+
+struct SyntheticFields::EvaluateTask
+	{
+	/* Elements: */
+	public:
+	const SyntheticFields* fields; // Fields to evaluate
+	const PositionSource* positions; // Source of vertex positions
+	size_t first,last; // Range of vertex indices to evaluate
+	float* const* slices; // Array of value slices to write
+	};
+
+/********************************
+Methods of class SyntheticFields:
+********************************/
+
+void* SyntheticFields::evaluateThreadFunction(SyntheticFields::EvaluateTask* task)
+	{
+	/* Create a private copy of the noise array, as evaluating noise modifies the array's interpolation buffer: */
+	Noise threadNoise(task->fields->noise);
+	
+	for(size_t vertexIndex=task->first;vertexIndex<task->last;++vertexIndex)
+		{
+		/* Evaluate all fields at the vertex: */
+		Point p=task->positions->getPosition(vertexIndex);
+		task->slices[TURBULENCE][vertexIndex]=task->fields->calcTurbulence(threadNoise,p);
+		task->slices[HARMONIC][vertexIndex]=task->fields->calcHarmonic(p);
+		Vector velocity=task->fields->calcVelocity(p);
+		for(int i=0;i<3;++i)
+			task->slices[VELOCITY_X+i][vertexIndex]=velocity[i];
+		task->slices[VELOCITY_MAGNITUDE][vertexIndex]=Geometry::mag(velocity);
+		}
+	
+	return 0;
+	}
+
+SyntheticFields::SyntheticFields(const SyntheticFields::Parameters& sParameters,const SyntheticFields::Box& sDomain)
+	:parameters(sParameters),
+	 domain(sDomain),
+	 domainCenter(Geometry::mid(domain.min,domain.max)),
+	 domainRadius(Geometry::dist(domainCenter,domain.max)),
+	 noise(5,parameters.noiseDegree,parameters.seed),
+	 harmonicNormalization(1)
+	{
+	/* Scale the noise array to the domain's largest extent: */
+	Scalar maxExtent(0);
+	for(int i=0;i<3;++i)
+		if(maxExtent<domain.getSize(i))
+			maxExtent=domain.getSize(i);
+	if(maxExtent==Scalar(0))
+		maxExtent=Scalar(1);
+	if(domainRadius==Scalar(0))
+		domainRadius=Scalar(1);
+	noiseScale=parameters.turbulenceFrequency/maxExtent;
+	
+	/* Create the vortices from a random sequence independent of the noise array's: */
+	RandomSequence rs(parameters.seed^0x9e3779b9U);
+	vortices.reserve(parameters.numVortices);
+	for(unsigned int vortexIndex=0;vortexIndex<parameters.numVortices;++vortexIndex)
+		{
+		Vortex v;
+		for(int i=0;i<3;++i)
+			v.center[i]=domain.min[i]+Scalar(rs.next())*domain.getSize(i);
+		
+		/* Pick a uniformly distributed axis direction by rejection sampling: */
+		Scalar axisLen2;
+		do
+			{
+			for(int i=0;i<3;++i)
+				v.axis[i]=Scalar(rs.next()*2.0-1.0);
+			axisLen2=Geometry::sqr(v.axis);
+			}
+		while(axisLen2<Scalar(0.01)||axisLen2>Scalar(1));
+		v.axis/=Math::sqrt(axisLen2);
+		
+		v.coreRadius2=Math::sqr(maxExtent*Scalar(0.03+rs.next()*0.07));
+		v.circulation=maxExtent*Scalar(0.5+rs.next());
+		if(rs.next()<0.5)
+			v.circulation=-v.circulation;
+		vortices.push_back(v);
+		}
+	
+	/* Calculate the spherical harmonic's normalization factor: */
+	int l=parameters.harmonicDegree;
+	int m=parameters.harmonicOrder;
+	double factorialRatio=1.0;
+	for(int i=l-m+1;i<=l+m;++i)
+		factorialRatio*=double(i);
+	double norm=Math::sqrt(double(2*l+1)/(4.0*Math::Constants<double>::pi*factorialRatio));
+	if(m>0)
+		norm*=Math::sqrt(2.0);
+	harmonicNormalization=Scalar(norm);
+	}
+
+SyntheticFields::Point SyntheticFields::calcWarpedBoxPosition(const SyntheticFields::Scalar uvw[3])
+	{
+	/* Displace each coordinate by a smooth function of the other two, small enough to keep all cells convex: */
+	const double a=0.04;
+	const double twoPi=2.0*Math::Constants<double>::pi;
+	Point result;
+	for(int i=0;i<3;++i)
+		{
+		double s=twoPi*double(uvw[(i+1)%3]);
+		double t=twoPi*double(uvw[(i+2)%3]);
+		result[i]=Scalar(double(uvw[i])+a*Math::sin(s)*Math::sin(t));
+		}
+	
+	return result;
+	}
+
+SyntheticFields::Point SyntheticFields::calcShellPosition(SyntheticFields::Scalar latitude,SyntheticFields::Scalar longitude,SyntheticFields::Scalar radius)
+	{
+	double xy=Math::cos(double(latitude))*double(radius);
+	return Point(Scalar(Math::cos(double(longitude))*xy),Scalar(Math::sin(double(longitude))*xy),Scalar(Math::sin(double(latitude))*double(radius)));
+	}
+
+const char* SyntheticFields::getSliceName(int sliceIndex)
+	{
+	static const char* sliceNames[VELOCITY_X]=
+		{
+		"Turbulence","Spherical Harmonic"
+		};
+	
+	if(sliceIndex<0||sliceIndex>=VELOCITY_X)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid slice index %d",sliceIndex);
+	
+	return sliceNames[sliceIndex];
+	}
+
+const char* SyntheticFields::getVectorName(void)
+	{
+	return "Velocity";
+	}
+
+SyntheticFields::Scalar SyntheticFields::calcTurbulence(const Noise& threadNoise,const SyntheticFields::Point& p) const
+	{
+	/* Transform the point to noise array coordinates: */
+	Noise::Point np;
+	for(int i=0;i<3;++i)
+		np[i]=(p[i]-domain.min[i])*noiseScale;
+	
+	return threadNoise.calcTurbulence(np,parameters.turbulenceDepth);
+	}
+
+SyntheticFields::Scalar SyntheticFields::calcHarmonic(const SyntheticFields::Point& p) const
+	{
+	/* Convert the point to spherical coordinates around the domain's center: */
+	Vector d=p-domainCenter;
+	double r=Geometry::mag(d);
+	double cosTheta=r>0.0?double(d[2])/r:1.0;
+	double phi=Math::atan2(double(d[1]),double(d[0]));
+	
+	/* Evaluate the real spherical harmonic and modulate it by radius: */
+	double y=calcAssociatedLegendre(parameters.harmonicDegree,parameters.harmonicOrder,cosTheta)*Math::cos(double(parameters.harmonicOrder)*phi);
+	return Scalar(double(harmonicNormalization)*y*Math::cos(2.0*Math::Constants<double>::pi*r/double(domainRadius)));
+	}
+
+SyntheticFields::Vector SyntheticFields::calcVelocity(const SyntheticFields::Point& p) const
+	{
+	Vector result=Vector::zero;
+	for(std::vector<Vortex>::const_iterator vIt=vortices.begin();vIt!=vortices.end();++vIt)
+		{
+		/* Calculate the point's offset from the vortex' axis: */
+		Vector d=p-vIt->center;
+		d-=vIt->axis*(d*vIt->axis);
+		Scalar r2=Geometry::sqr(d);
+		
+		/* Calculate the Lamb-Oseen tangential velocity, using the series expansion near the axis: */
+		Scalar x=r2/vIt->coreRadius2;
+		Scalar f=x>Scalar(1.0e-4)?(Scalar(1)-Math::exp(-x))/r2:(Scalar(1)-Scalar(0.5)*x)/vIt->coreRadius2;
+		result+=Geometry::cross(vIt->axis,d)*(vIt->circulation*f/(Scalar(2)*Math::Constants<Scalar>::pi));
+		}
+	
+	return result;
+	}
+
+void SyntheticFields::evaluate(size_t numVertices,const SyntheticFields::PositionSource& positions,float* const slices[SyntheticFields::NUM_SLICES]) const
+	{
+	/* Determine the number of threads: */
+	unsigned int numThreads=parameters.numThreads;
+	if(numThreads==0)
+		numThreads=ParallelTasks::getNumCpus();
+	if(size_t(numThreads)>numVertices)
+		numThreads=(unsigned int)(numVertices);
+	if(numThreads==0)
+		return;
+	
+	/* Split the vertices into one range per thread; all fields are pure functions of position, so results do not depend on the number of threads: */
+	EvaluateTask* tasks=new EvaluateTask[numThreads];
+	for(unsigned int i=0;i<numThreads;++i)
+		{
+		tasks[i].fields=this;
+		tasks[i].positions=&positions;
+		tasks[i].first=size_t((double(numVertices)*double(i))/double(numThreads));
+		tasks[i].last=size_t((double(numVertices)*double(i+1))/double(numThreads));
+		tasks[i].slices=slices;
+		}
+	
+	/* Evaluate all ranges in parallel: */
+	ParallelTasks::runTasks(tasks,numThreads,evaluateThreadFunction);
+	delete[] tasks;
+	}
+
+}
+
+}
@@ -0,0 +1,156 @@
+/***********************************************************************
+SyntheticFields - Class to evaluate analytic scalar and vector fields on
+procedurally generated grids to create benchmark data sets of arbitrary
+size.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef VISUALIZATION_CONCRETE_SYNTHETICFIELDS_INCLUDED
+#define VISUALIZATION_CONCRETE_SYNTHETICFIELDS_INCLUDED
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#include <Geometry/Box.h>
+
+#include <Concrete/Noise.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+class SyntheticFields
+	{
+	/* Embedded classes: */
+	public:
+	typedef float Scalar; // Scalar type for positions and field values
+	typedef Geometry::Point<Scalar,3> Point; // Type for points
+	typedef Geometry::Vector<Scalar,3> Vector; // Type for vectors
+	typedef Geometry::Box<Scalar,3> Box; // Type for axis-aligned boxes
+	
+	class PositionSource // Abstract base class to return the positions of a grid's vertices in the grid's linear vertex order
+		{
+		/* Constructors and destructors: */
+		public:
+		virtual ~PositionSource(void)
+			{
+			}
+		
+		/* Methods: */
+		virtual Point getPosition(size_t vertexIndex) const =0; // Returns the position of the vertex of the given linear index
+		};
+	
+	class PointArrayPositionSource:public PositionSource // Class to return vertex positions from an array of points
+		{
+		/* Elements: */
+		private:
+		const Point* points; // Array of vertex positions
+		
+		/* Constructors and destructors: */
+		public:
+		PointArrayPositionSource(const Point* sPoints)
+			:points(sPoints)
+			{
+			}
+		
+		/* Methods from PositionSource: */
+		virtual Point getPosition(size_t vertexIndex) const
+			{
+			return points[vertexIndex];
+			}
+		};
+	
+	struct Parameters // Structure holding the parameters controlling the generated fields
+		{
+		/* Elements: */
+		public:
+		unsigned int seed; // Seed for all pseudo-random choices; the same seed generates the same data set on all machines
+		unsigned int numThreads; // Number of threads to evaluate fields, or 0 to use all available CPUs
+		int noiseDegree; // Interpolation degree of the noise array underlying the turbulence field
+		int turbulenceDepth; // Number of octaves summed by the turbulence field
+		Scalar turbulenceFrequency; // Number of noise cells across the largest extent of the domain
+		unsigned int numVortices; // Number of Lamb-Oseen line vortices superimposed into the velocity field
+		int harmonicDegree,harmonicOrder; // Degree and order of the real spherical harmonic field
+		
+		/* Constructors and destructors: */
+		Parameters(void); // Creates default parameters
+		
+		/* Methods: */
+		bool parseArgument(std::vector<std::string>::const_iterator& argIt,const std::vector<std::string>::const_iterator& argEnd); // Parses a field-related command line argument and advances the iterator to its last consumed element; returns false if the argument is not field-related
+		};
+	
+	/* Indices of the value slices filled by the generator: */
+	enum SliceIndex
+		{
+		TURBULENCE=0,HARMONIC,VELOCITY_X,VELOCITY_Y,VELOCITY_Z,VELOCITY_MAGNITUDE,NUM_SLICES
+		};
+	
+	private:
+	struct Vortex // Structure describing a Lamb-Oseen line vortex
+		{
+		/* Elements: */
+		public:
+		Point center; // A point on the vortex' axis
+		Vector axis; // Normalized direction of the vortex' axis
+		Scalar circulation; // Signed circulation of the vortex
+		Scalar coreRadius2; // Squared radius of the vortex' viscous core
+		};
+	
+	struct EvaluateTask; // Structure describing a range of vertices to evaluate in a background thread
+	
+	/* Elements: */
+	Parameters parameters; // Field parameters
+	Box domain; // Bounding box of the generated grid
+	Point domainCenter; // Center point of the generated grid
+	Scalar domainRadius; // Radius of the generated grid's bounding sphere around its center
+	Scalar noiseScale; // Scale factor from domain coordinates to noise array coordinates
+	Noise noise; // Noise array for the turbulence field; each evaluation thread works on a private copy
+	std::vector<Vortex> vortices; // List of vortices defining the velocity field
+	Scalar harmonicNormalization; // Normalization factor for the spherical harmonic field
+	
+	/* Private methods: */
+	static void* evaluateThreadFunction(EvaluateTask* task); // Evaluates all fields for a range of vertices
+	
+	/* Constructors and destructors: */
+	public:
+	SyntheticFields(const Parameters& sParameters,const Box& sDomain); // Creates fields for a grid covering the given domain
+	
+	/* Methods: */
+	static Point calcWarpedBoxPosition(const Scalar uvw[3]); // Returns the position of a point of normalized coordinates in [0, 1]^3 inside a smoothly warped unit cube
+	static Point calcShellPosition(Scalar latitude,Scalar longitude,Scalar radius); // Returns the Cartesian position of a point in spherical coordinates; angles in radians
+	static const char* getSliceName(int sliceIndex); // Returns the name of the scalar variable stored in the given slice before the velocity slices
+	static const char* getVectorName(void); // Returns the name of the vector variable stored in the velocity slices
+	const Parameters& getParameters(void) const // Returns the field parameters
+		{
+		return parameters;
+		}
+	Scalar calcTurbulence(const Noise& threadNoise,const Point& p) const; // Returns the turbulence field at the given point using the given copy of the noise array
+	Scalar calcHarmonic(const Point& p) const; // Returns the spherical harmonic field at the given point
+	Vector calcVelocity(const Point& p) const; // Returns the vortex velocity field at the given point
+	void evaluate(size_t numVertices,const PositionSource& positions,float* const slices[NUM_SLICES]) const; // Evaluates all fields for all vertices of a grid in parallel and writes them into the given value slices
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,174 @@
+/***********************************************************************
+SyntheticMultiBlock - Class to procedurally generate multi-block
+curvilinear data sets shaped as cubed-sphere shells of arbitrary size
+from analytic fields for benchmarking.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Concrete/SyntheticMultiBlock.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <iostream>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/StdError.h>
+#include <Misc/Timer.h>
+#include <Plugins/FactoryManager.h>
+#include <Cluster/MulticastPipe.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+
+#include <Concrete/SyntheticFields.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/************************************
+Methods of class SyntheticMultiBlock:
+************************************/
+
+SyntheticMultiBlock::SyntheticMultiBlock(void)
+	:BaseModule("SyntheticMultiBlock")
+	{
+	}
+
+Visualization::Abstract::DataSet* SyntheticMultiBlock::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	bool master=pipe==0||pipe->isMaster();
+	
+	/* Parse the module arguments: */
+	DS::Index numVertices(64,64,32);
+	SyntheticFields::Parameters fieldParameters;
+	for(std::vector<std::string>::const_iterator argIt=args.begin();argIt!=args.end();++argIt)
+		{
+		if(strcasecmp(argIt->c_str(),"-size")==0)
+			{
+			for(int i=0;i<3;++i)
+				{
+				++argIt;
+				if(argIt==args.end())
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing block size");
+				numVertices[i]=atoi(argIt->c_str());
+				if(numVertices[i]<2)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid block size %d",numVertices[i]);
+				}
+			}
+		else if(!fieldParameters.parseArgument(argIt,args.end()))
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unrecognized argument %s",argIt->c_str());
+		}
+	
+	/* Create the result data set with one block per cube face: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	DS& dataSet=result->getDs();
+	dataSet.setNumGrids(6);
+	for(int gridIndex=0;gridIndex<6;++gridIndex)
+		dataSet.setGrid(gridIndex,numVertices);
+	
+	/* Right-handed frames of the cube faces, as indices of normal, first, and second tangent axes, and signs: */
+	static const int faceAxes[6][3]={{0,1,2},{0,2,1},{1,2,0},{1,0,2},{2,0,1},{2,1,0}};
+	static const Scalar faceSigns[6]={Scalar(1),Scalar(-1),Scalar(1),Scalar(-1),Scalar(1),Scalar(-1)};
+	
+	/* Calculate the vertex positions of all blocks using equiangular cube-sphere projection: */
+	Scalar quarterPi=Math::Constants<Scalar>::pi*Scalar(0.25);
+	for(int gridIndex=0;gridIndex<6;++gridIndex)
+		{
+		DS::GridArray& grid=dataSet.getGrid(gridIndex).getGrid();
+		for(DS::Index index(0);index[0]<numVertices[0];index.preInc(numVertices))
+			{
+			/* Calculate the vertex' direction on the cube face: */
+			DS::Vector dir;
+			dir[faceAxes[gridIndex][0]]=faceSigns[gridIndex];
+			for(int i=0;i<2;++i)
+				dir[faceAxes[gridIndex][1+i]]=Math::tan(Scalar(2*index[i])*quarterPi/Scalar(numVertices[i]-1)-quarterPi);
+			dir.normalize();
+			
+			/* Calculate the vertex' radius: */
+			Scalar r=Scalar(0.55)+Scalar(0.45)*Scalar(index[2])/Scalar(numVertices[2]-1);
+			grid(index)=DS::Point::origin+dir*r;
+			}
+		}
+	
+	/* Finalize the grid structure, which stitches the blocks together: */
+	if(master)
+		std::cout<<"Finalizing grid structure..."<<std::flush;
+	dataSet.finalizeGrid();
+	if(master)
+		std::cout<<" done"<<std::endl;
+	
+	/* Initialize the result data set's data value: */
+	DataValue& dataValue=result->getDataValue();
+	dataValue.initialize(&dataSet,0);
+	
+	/* Add one slice per generated field component: */
+	for(int i=0;i<SyntheticFields::NUM_SLICES;++i)
+		dataSet.addSlice();
+	for(int i=0;i<SyntheticFields::VELOCITY_X;++i)
+		dataValue.addScalarVariable(SyntheticFields::getSliceName(i));
+	int vectorVariableIndex=dataValue.addVectorVariable(SyntheticFields::getVectorName());
+	for(int i=0;i<4;++i)
+		{
+		dataValue.addScalarVariable(makeVectorSliceName(SyntheticFields::getVectorName(),i).c_str());
+		if(i<3)
+			dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,SyntheticFields::VELOCITY_X+i);
+		}
+	
+	/* Evaluate the fields at all vertices of all blocks: */
+	if(master)
+		std::cout<<"Generating "<<dataSet.getTotalNumVertices()<<" vertices..."<<std::flush;
+	Misc::Timer generateTimer;
+	SyntheticFields fields(fieldParameters,dataSet.getDomainBox());
+	for(int gridIndex=0;gridIndex<6;++gridIndex)
+		{
+		float* slices[SyntheticFields::NUM_SLICES];
+		for(int i=0;i<SyntheticFields::NUM_SLICES;++i)
+			slices[i]=dataSet.getSliceArray(i,gridIndex);
+		const DS::GridArray& grid=dataSet.getGrid(gridIndex).getGrid();
+		fields.evaluate(grid.getNumElements(),SyntheticFields::PointArrayPositionSource(grid.getArray()),slices);
+		}
+	generateTimer.elapse();
+	if(master)
+		std::cout<<" done in "<<generateTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	/* Return the result data set: */
+	return result.releaseTarget();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticMultiBlock* module=new Visualization::Concrete::SyntheticMultiBlock();
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,227 @@
+/***********************************************************************
+SyntheticOctreeForest - Class to procedurally generate adaptively refined
+octree forest data sets from analytic fields for benchmarking.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Concrete/SyntheticOctreeForest.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <vector>
+#include <iostream>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/StdError.h>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+#include <Geometry/Point.h>
+#include <Geometry/Vector.h>
+#include <Plugins/FactoryManager.h>
+#include <Cluster/MulticastPipe.h>
+
+#include <Concrete/SyntheticFields.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+class OctreeForestPositionSource:public SyntheticFields::PositionSource // Class to return vertex positions of an octree forest
+	{
+	/* Elements: */
+	private:
+	const DS& dataSet; // The octree forest
+	
+	/* Constructors and destructors: */
+	public:
+	OctreeForestPositionSource(const DS& sDataSet)
+		:dataSet(sDataSet)
+		{
+		}
+	
+	/* Methods from SyntheticFields::PositionSource: */
+	virtual SyntheticFields::Point getPosition(size_t vertexIndex) const
+		{
+		return dataSet.getVertexPosition((unsigned int)(vertexIndex));
+		}
+	};
+
+}
+
+/**************************************
+Methods of class SyntheticOctreeForest:
+**************************************/
+
+SyntheticOctreeForest::SyntheticOctreeForest(void)
+	:BaseModule("SyntheticOctreeForest")
+	{
+	}
+
+Visualization::Abstract::DataSet* SyntheticOctreeForest::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	bool master=pipe==0||pipe->isMaster();
+	
+	/* Parse the module arguments: */
+	DS::Index numRoots(8,8,8);
+	int numLevels=3;
+	SyntheticFields::Parameters fieldParameters;
+	for(std::vector<std::string>::const_iterator argIt=args.begin();argIt!=args.end();++argIt)
+		{
+		if(strcasecmp(argIt->c_str(),"-size")==0)
+			{
+			for(int i=0;i<3;++i)
+				{
+				++argIt;
+				if(argIt==args.end())
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing root grid size");
+				numRoots[i]=atoi(argIt->c_str());
+				if(numRoots[i]<1)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid root grid size %d",numRoots[i]);
+				}
+			}
+		else if(strcasecmp(argIt->c_str(),"-levels")==0)
+			{
+			++argIt;
+			if(argIt==args.end())
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing number of refinement levels");
+			numLevels=atoi(argIt->c_str());
+			if(numLevels<0)
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid number of refinement levels %d",numLevels);
+			}
+		else if(!fieldParameters.parseArgument(argIt,args.end()))
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unrecognized argument %s",argIt->c_str());
+		}
+	
+	/* Create the result data set with unit-sized largest extent: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	DS& dataSet=result->getDs();
+	int maxNumRoots=numRoots[0];
+	for(int i=1;i<3;++i)
+		if(maxNumRoots<numRoots[i])
+			maxNumRoots=numRoots[i];
+	DS::Size rootCellSize;
+	DS::Point domainMax;
+	for(int i=0;i<3;++i)
+		{
+		rootCellSize[i]=Scalar(1)/Scalar(maxNumRoots);
+		domainMax[i]=rootCellSize[i]*Scalar(numRoots[i]);
+		}
+	dataSet.setForest(numRoots,DS::Point::origin,rootCellSize);
+	
+	/* Create the fields over the unrefined domain: */
+	SyntheticFields fields(fieldParameters,DS::Box(DS::Point::origin,domainMax));
+	
+	/* Refine the forest where the vortex velocity is above average, one level at a time: */
+	if(master)
+		std::cout<<"Refining octree forest..."<<std::flush;
+	Misc::Timer refineTimer;
+	for(int level=0;level<numLevels;++level)
+		{
+		/* Evaluate the velocity magnitude at the centers of all cells on the current level: */
+		std::vector<DS::Point> centers;
+		std::vector<Scalar> magnitudes;
+		Scalar magnitudeSum(0);
+		for(DS::CellIterator cIt=dataSet.beginCells();cIt!=dataSet.endCells();++cIt)
+			if(cIt->getLevel()==level)
+				{
+				DS::Point center=Geometry::mid(cIt->getVertexPosition(0),cIt->getVertexPosition(7));
+				centers.push_back(center);
+				magnitudes.push_back(Geometry::mag(fields.calcVelocity(center)));
+				magnitudeSum+=magnitudes.back();
+				}
+		if(centers.empty())
+			break;
+		Scalar magnitudeMean=magnitudeSum/Scalar(centers.size());
+		
+		/* Refine all cells whose velocity magnitude is above the mean: */
+		Scalar levelCellScale=Scalar(1<<level);
+		for(size_t i=0;i<centers.size();++i)
+			if(magnitudes[i]>magnitudeMean)
+				{
+				DS::Index cellIndex;
+				for(int j=0;j<3;++j)
+					cellIndex[j]=int(Math::floor(centers[i][j]*levelCellScale/rootCellSize[j]));
+				dataSet.refineCell(level,cellIndex);
+				}
+		
+		/* Create the refined forest's cells: */
+		dataSet.finalizeGrid();
+		}
+	refineTimer.elapse();
+	if(master)
+		std::cout<<" done in "<<refineTimer.getTime()*1000.0<<" ms, "<<dataSet.getTotalNumCells()<<" cells on "<<dataSet.getMaxLevel()+1<<" levels"<<std::endl;
+	
+	/* Initialize the result data set's data value: */
+	DataValue& dataValue=result->getDataValue();
+	dataValue.initialize(&dataSet,0);
+	
+	/* Add one slice per generated field component: */
+	float* slices[SyntheticFields::NUM_SLICES];
+	for(int i=0;i<SyntheticFields::NUM_SLICES;++i)
+		slices[i]=dataSet.getSliceArray(dataSet.addSlice());
+	for(int i=0;i<SyntheticFields::VELOCITY_X;++i)
+		dataValue.addScalarVariable(SyntheticFields::getSliceName(i));
+	int vectorVariableIndex=dataValue.addVectorVariable(SyntheticFields::getVectorName());
+	for(int i=0;i<4;++i)
+		{
+		dataValue.addScalarVariable(makeVectorSliceName(SyntheticFields::getVectorName(),i).c_str());
+		if(i<3)
+			dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,SyntheticFields::VELOCITY_X+i);
+		}
+	
+	/* Evaluate the fields at all vertices; values of hanging vertices are later interpolated from their constraining faces: */
+	if(master)
+		std::cout<<"Generating "<<dataSet.getTotalNumVertices()<<" vertices..."<<std::flush;
+	Misc::Timer generateTimer;
+	fields.evaluate(dataSet.getTotalNumVertices(),OctreeForestPositionSource(dataSet),slices);
+	generateTimer.elapse();
+	if(master)
+		std::cout<<" done in "<<generateTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	/* Return the result data set: */
+	return result.releaseTarget();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticOctreeForest* module=new Visualization::Concrete::SyntheticOctreeForest();
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -0,0 +1,177 @@
+/***********************************************************************
+SyntheticUnstructured - Class to procedurally generate unstructured
+hexahedral data sets of arbitrary size from analytic fields for
+benchmarking.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Concrete/SyntheticUnstructured.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <iostream>
+#include <Misc/SelfDestructPointer.h>
+#include <Misc/StdError.h>
+#include <Misc/Timer.h>
+#include <Plugins/FactoryManager.h>
+#include <Cluster/MulticastPipe.h>
+
+#include <Concrete/SyntheticFields.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+/**************************************
+Methods of class SyntheticUnstructured:
+**************************************/
+
+SyntheticUnstructured::SyntheticUnstructured(void)
+	:BaseModule("SyntheticUnstructured")
+	{
+	}
+
+Visualization::Abstract::DataSet* SyntheticUnstructured::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	bool master=pipe==0||pipe->isMaster();
+	
+	/* Parse the module arguments: */
+	int numVertices[3]={64,64,64};
+	SyntheticFields::Parameters fieldParameters;
+	for(std::vector<std::string>::const_iterator argIt=args.begin();argIt!=args.end();++argIt)
+		{
+		if(strcasecmp(argIt->c_str(),"-size")==0)
+			{
+			for(int i=0;i<3;++i)
+				{
+				++argIt;
+				if(argIt==args.end())
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Missing grid size");
+				numVertices[i]=atoi(argIt->c_str());
+				if(numVertices[i]<2)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid grid size %d",numVertices[i]);
+				}
+			}
+		else if(!fieldParameters.parseArgument(argIt,args.end()))
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unrecognized argument %s",argIt->c_str());
+		}
+	
+	/* Create the result data set: */
+	Misc::SelfDestructPointer<DataSet> result(new DataSet);
+	DS& dataSet=result->getDs();
+	
+	/* Add the vertices of a warped box with unit-sized largest extent; the last grid dimension varies fastest: */
+	int maxNumVertices=numVertices[0];
+	for(int i=1;i<3;++i)
+		if(maxNumVertices<numVertices[i])
+			maxNumVertices=numVertices[i];
+	dataSet.reserveVertices(size_t(numVertices[0])*size_t(numVertices[1])*size_t(numVertices[2]));
+	int index[3];
+	for(index[0]=0;index[0]<numVertices[0];++index[0])
+		for(index[1]=0;index[1]<numVertices[1];++index[1])
+			for(index[2]=0;index[2]<numVertices[2];++index[2])
+				{
+				Scalar uvw[3];
+				for(int i=0;i<3;++i)
+					uvw[i]=Scalar(index[i])/Scalar(maxNumVertices-1);
+				dataSet.addVertex(SyntheticFields::calcWarpedBoxPosition(uvw));
+				}
+	
+	/* Add the hexahedral cells connecting the vertices: */
+	DS::VertexIndex strides[3]={DS::VertexIndex(numVertices[1]*numVertices[2]),DS::VertexIndex(numVertices[2]),1};
+	dataSet.reserveCells(size_t(numVertices[0]-1)*size_t(numVertices[1]-1)*size_t(numVertices[2]-1));
+	for(index[0]=0;index[0]<numVertices[0]-1;++index[0])
+		for(index[1]=0;index[1]<numVertices[1]-1;++index[1])
+			for(index[2]=0;index[2]<numVertices[2]-1;++index[2])
+				{
+				/* Collect the cell's vertices; bit i of a cell vertex index selects the far side along grid dimension i: */
+				DS::VertexIndex base=DS::VertexIndex(index[0])*strides[0]+DS::VertexIndex(index[1])*strides[1]+DS::VertexIndex(index[2]);
+				DS::VertexID cellVertices[8];
+				for(int v=0;v<8;++v)
+					{
+					DS::VertexIndex vi=base;
+					for(int i=0;i<3;++i)
+						if(v&(1<<i))
+							vi+=strides[i];
+					cellVertices[v]=DS::VertexID(vi);
+					}
+				dataSet.addCell(cellVertices);
+				}
+	
+	/* Finalize the grid structure: */
+	if(master)
+		std::cout<<"Finalizing grid structure..."<<std::flush;
+	dataSet.finalizeGrid();
+	if(master)
+		std::cout<<" done"<<std::endl;
+	
+	/* Initialize the result data set's data value: */
+	DataValue& dataValue=result->getDataValue();
+	dataValue.initialize(&dataSet,0);
+	
+	/* Add one slice per generated field component: */
+	float* slices[SyntheticFields::NUM_SLICES];
+	for(int i=0;i<SyntheticFields::NUM_SLICES;++i)
+		slices[i]=dataSet.getSliceArray(dataSet.addSlice());
+	for(int i=0;i<SyntheticFields::VELOCITY_X;++i)
+		dataValue.addScalarVariable(SyntheticFields::getSliceName(i));
+	int vectorVariableIndex=dataValue.addVectorVariable(SyntheticFields::getVectorName());
+	for(int i=0;i<4;++i)
+		{
+		dataValue.addScalarVariable(makeVectorSliceName(SyntheticFields::getVectorName(),i).c_str());
+		if(i<3)
+			dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,SyntheticFields::VELOCITY_X+i);
+		}
+	
+	/* Evaluate the fields at all grid vertices: */
+	if(master)
+		std::cout<<"Generating "<<dataSet.getTotalNumVertices()<<" vertices..."<<std::flush;
+	Misc::Timer generateTimer;
+	SyntheticFields fields(fieldParameters,dataSet.getDomainBox());
+	fields.evaluate(dataSet.getTotalNumVertices(),SyntheticFields::PointArrayPositionSource(&dataSet.getVertexPosition(0)),slices);
+	generateTimer.elapse();
+	if(master)
+		std::cout<<" done in "<<generateTimer.getTime()*1000.0<<" ms"<<std::endl;
+	
+	/* Return the result data set: */
+	return result.releaseTarget();
+	}
+
+}
+
+}
+
+/***************************
+Plug-in interface functions:
+***************************/
+
+extern "C" Visualization::Abstract::Module* createFactory(Plugins::FactoryManager<Visualization::Abstract::Module>& manager)
+	{
+	/* Create module object and insert it into class hierarchy: */
+	Visualization::Concrete::SyntheticUnstructured* module=new Visualization::Concrete::SyntheticUnstructured();
+	
+	/* Return module object: */
+	return module;
+	}
+
+extern "C" void destroyFactory(Visualization::Abstract::Module* module)
+	{
+	delete module;
+	}
@@ -1,7 +1,7 @@
 /***********************************************************************
 UnstructuredHexahedralXdmf - Class reading unstructured hexahedral data
 sets from files in Xdmf format, with mass data stored in HDF5 format.
-Copyright (c) 2018-2024 Oliver Kreylos
+Copyright (c) 2018-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -22,360 +22,439 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Concrete/UnstructuredHexahedralXdmf.h>
 
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
 #include <string>
 #include <iostream>
 #include <iomanip>
 #include <Misc/SizedTypes.h>
 #include <Misc/SelfDestructPointer.h>
-#include <Misc/SelfDestructArray.h>
 #include <Misc/StdError.h>
-#include <Misc/HashTable.h>
 #include <Plugins/FactoryManager.h>
 
 #include <Concrete/HDF5Support.h>
+#include <Concrete/VertexWelder.h>
 
-namespace Misc {
+namespace Visualization {
+
+namespace Concrete {
 
-/****************************
-Hash functions for 3D points:
-****************************/
+/*******************************************
+Methods of class UnstructuredHexahedralXdmf:
+*******************************************/
 
-template <>
-class StandardHashFunction<Geometry::Point<Misc::Float32,3> >
+UnstructuredHexahedralXdmf::UnstructuredHexahedralXdmf(void)
+	:BaseModule("UnstructuredHexahedralXdmf")
 	{
-	/* Methods: */
+	}
+
+namespace {
+
+/* Number of rows to read from HDF5 data sets in each block while streaming: */
+const size_t blockNumRows=1U<<18;
+
+/* Hard-coded names of mesh and variable data sets; this is where we would parse the main Xdmf file: */
+const char* nodesDsName="nodes";
+const char* cellsDsName="cells";
+const size_t numScalarVariables=5;
+const char* scalarVariableDsNames[]=
+	{
+	"C_1","T","p","strain_rate","viscosity"
+	};
+const size_t numVectorVariables=1;
+const char* vectorVariableDsNames[]=
+	{
+	"velocity"
+	};
+
+/**************
+Helper classes:
+**************/
+
+class VariableStream // Class to open a solution variable and optionally stream its data in blocks in the background
+	{
+	/* Elements: */
+	private:
+	HDF5::DataSet vars; // The variable's data set
+	HDF5::BlockReader<VScalar>* reader; // Reader streaming the variable's data, or null if the variable is read directly
+	
+	/* Constructors and destructors: */
+	public:
+	VariableStream(HDF5::File& file,const char* variableName,size_t numComponents,size_t numVertexIndices,bool streamed,const std::string& inputFileName)
+		:vars(file,variableName),reader(0)
+		{
+		/* Check for data consistency: */
+		std::vector<size_t> varDims=vars.getDimensions();
+		if(varDims.size()!=2||varDims[1]!=numComponents||varDims[0]!=numVertexIndices)
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Variable %s in input file %s has wrong layout",variableName,inputFileName.c_str());
+		
+		/* Start reading the variable's data in the background: */
+		if(streamed)
+			reader=new HDF5::BlockReader<VScalar>(vars,blockNumRows);
+		}
+	private:
+	VariableStream(const VariableStream& source); // Prohibit copy constructor
+	VariableStream& operator=(const VariableStream& source); // Prohibit assignment operator
 	public:
-	static size_t hash(const Geometry::Point<Misc::Float32,3>& source,size_t tableSize)
+	~VariableStream(void)
+		{
+		delete reader;
+		}
+	
+	/* Methods: */
+	HDF5::DataSet& getDataSet(void) // Returns the variable's data set
+		{
+		return vars;
+		}
+	HDF5::BlockReader<VScalar>& getReader(void) // Returns the variable's background reader
+		{
+		return *reader;
+		}
+	void stopReading(void) // Stops the background reader and releases its buffers, but keeps the data set open
 		{
-		/* Re-interpret floating-point coordinates as unsigned integers: */
-		const Misc::UInt32* comps=reinterpret_cast<const Misc::UInt32*>(source.getComponents());
-		size_t result=size_t(comps[0])*71+size_t(comps[1])*37+size_t(comps[2])*19;
-		return result%tableSize;
+		delete reader;
+		reader=0;
 		}
 	};
 
-template <>
-class StandardHashFunction<Geometry::Point<Misc::Float64,3> >
+class VariableStreamList // Class owning all opened variable streams; closes data sets only after all background readers have stopped, as the HDF5 library may not be thread-safe
 	{
-	/* Methods: */
+	/* Elements: */
+	private:
+	std::vector<VariableStream*> streams; // List of opened streams
+	
+	/* Constructors and destructors: */
+	public:
+	VariableStreamList(void)
+		{
+		}
+	private:
+	VariableStreamList(const VariableStreamList& source); // Prohibit copy constructor
+	VariableStreamList& operator=(const VariableStreamList& source); // Prohibit assignment operator
 	public:
-	static size_t hash(const Geometry::Point<Misc::Float64,3>& source,size_t tableSize)
+	~VariableStreamList(void)
 		{
-		/* Re-interpret floating-point coordinates as unsigned integers: */
-		const Misc::UInt64* comps=reinterpret_cast<const Misc::UInt64*>(source.getComponents());
-		size_t result=size_t(comps[0])*71+size_t(comps[1])*37+size_t(comps[2])*19;
-		return result%tableSize;
+		for(std::vector<VariableStream*>::iterator sIt=streams.begin();sIt!=streams.end();++sIt)
+			(*sIt)->stopReading();
+		for(std::vector<VariableStream*>::iterator sIt=streams.begin();sIt!=streams.end();++sIt)
+			delete *sIt;
+		}
+	
+	/* Methods: */
+	VariableStream* open(HDF5::File& file,size_t variable,size_t numVertexIndices,bool streamed,const std::string& inputFileName) // Opens the given scalar variable, or vector variable if the index is offset by the number of scalar variables
+		{
+		streams.reserve(streams.size()+1);
+		VariableStream* stream;
+		if(variable<numScalarVariables)
+			stream=new VariableStream(file,scalarVariableDsNames[variable],1,numVertexIndices,streamed,inputFileName);
+		else
+			stream=new VariableStream(file,vectorVariableDsNames[variable-numScalarVariables],3,numVertexIndices,streamed,inputFileName);
+		streams.push_back(stream);
+		return stream;
 		}
 	};
 
 }
 
-namespace Visualization {
-
-namespace Concrete {
-
-/*******************************************
-Methods of class UnstructuredHexahedralXdmf:
-*******************************************/
-
-UnstructuredHexahedralXdmf::UnstructuredHexahedralXdmf(void)
-	:BaseModule("UnstructuredHexahedralXdmf")
-	{
-	}
-
-Visualization::Abstract::DataSet* UnstructuredHexahedralXdmf::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+template <class DataSetParam>
+inline
+Visualization::Abstract::DataSet*
+UnstructuredHexahedralXdmf::loadDataSet(
+	const std::string& inputFileName,
+	const std::string& baseDir,
+	int timeStepIndex,
+	const bool readScalarVariables[],
+	const bool readVectorVariables[],
+	Cluster::MulticastPipe* pipe) const
 	{
+	typedef DataSetParam DataSet;
+	typedef typename DataSet::DS DS;
+	typedef typename DataSet::DataValue DataValue;
+	typedef typename DS::Index Index;
+	
 	bool master=pipe==0||pipe->isMaster();
+	std::string meshFileName=baseDir+"solution/mesh-00000.h5";
+	char solutionFileName[64];
+	snprintf(solutionFileName,sizeof(solutionFileName),"solution/solution-%05d.h5",timeStepIndex);
 	
 	/* Create the result data set: */
 	Misc::SelfDestructPointer<DataSet> result(new DataSet);
 	DS& dataSet=result->getDs();
 	
-	/* Get the input file name's directory: */
-	std::string::const_iterator fnIt=args[0].begin();
-	for(std::string::const_iterator pIt=args[0].begin();pIt!=args[0].end();++pIt)
-		if(*pIt=='/')
-			fnIt=pIt+1;
-	std::string baseDir(args[0].begin(),fnIt);
-	
-	/* This is where we would parse the main Xdmf file. For now, hard-code stuff: */
-	std::string meshFileName=baseDir+"solution/mesh-00000.h5";
-	std::string nodesDsName="nodes";
-	std::string cellsDsName="cells";
-	std::string solutionFileName=baseDir+"solution/solution-00000.h5";
-	size_t numScalarVariables=5;
-	std::string scalarVariableDsNames[]=
-		{
-		"C_1","T","p","strain_rate","viscosity"
-		};
-	size_t numVectorVariables=1;
-	std::string vectorVariableDsNames[]=
-		{
-		"velocity"
-		};
-	
-	/* Create an array to map vertex indices from the file to non-duplicate vertex indices in the data set: */
+	/* Create a vertex welder to map vertex indices from the file to non-duplicate vertex indices in the data set: */
 	size_t numVertexIndices=0;
-	Misc::SelfDestructArray<DS::VertexIndex> vertexIndices;
-	
-	// DEBUGGING
-	Misc::SelfDestructArray<size_t> svi;
+	VertexWelder<Scalar,Index> welder;
+	bool identityVertexIndices=true;
 	
 	{
 	/* Open the mesh file: */
 	HDF5::File meshFile(meshFileName.c_str());
 	
-	/* Read the mesh vertex data: */
-	size_t nodeNumDims;
-	size_t* nodeDims;
-	Scalar* nodeData;
-	HDF5::DataSet nodes(meshFile,nodesDsName.c_str());
-	nodes.read(nodeNumDims,nodeDims,nodeData);
-	
-	/* Check for data consistency: */
-	if(nodeNumDims!=2||nodeDims[1]!=3)
-		{
-		delete[] nodeDims;
-		delete[] nodeData;
-		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Mesh vertices in input file %s have wrong layout",args[0].c_str());
-		}
-	
-	/* Print suspicious points: */
-	std::cout<<nodeData[33021*3+0]<<", "<<nodeData[33021*3+1]<<", "<<nodeData[33021*3+2]<<std::endl;
-	std::cout<<nodeData[31724*3+0]<<", "<<nodeData[31724*3+1]<<", "<<nodeData[31724*3+2]<<std::endl;
-	
-	/* Use a hash table of point coordinates to find duplicate points and assign them the same indices: */
 	{
+	/* Read the mesh vertex data and check for data consistency: */
+	HDF5::DataSet nodes(meshFile,nodesDsName);
+	std::vector<size_t> nodeDims=nodes.getDimensions();
+	if(nodeDims.size()!=2||nodeDims[1]!=3)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Mesh vertices in input file %s have wrong layout",inputFileName.c_str());
 	numVertexIndices=nodeDims[0];
-	vertexIndices.setTarget(new DS::VertexIndex[numVertexIndices]);
-	Misc::HashTable<DS::Point,DS::VertexIndex> vertexHash(numVertexIndices);
+	std::vector<Scalar> nodeComponents(numVertexIndices*3);
+	size_t start[2]={0,0};
+	size_t count[2]={numVertexIndices,3};
+	if(numVertexIndices>0)
+		nodes.readHyperslab(start,count,&nodeComponents.front());
 	
-	// DEBUGGING
-	svi.setTarget(new size_t[numVertexIndices]);
-	Misc::HashTable<DS::Point,size_t> svim(numVertexIndices);
+	/* Weld duplicate vertices to assign them the same indices: */
+	welder.weld(Index(numVertexIndices),numVertexIndices>0?&nodeComponents.front():0);
+	identityVertexIndices=welder.isIdentity();
 	
-	/* Copy mesh vertex data into the result data set: */
-	Scalar* ndPtr=nodeData;
-	for(size_t vertexIndex=0;vertexIndex<nodeDims[0];++vertexIndex,ndPtr+=3)
-		{
-		/* Create the vertex: */
-		DS::Point vertex(ndPtr);
-		
-		/* Look for an existing vertex with the same position in the hash table: */
-		Misc::HashTable<DS::Point,DS::VertexIndex>::Iterator vhIt=vertexHash.findEntry(vertex);
-		if(vhIt.isFinished())
-			{
-			/* Add the vertex to the data set and enter it into the hash table: */
-			DS::VertexIndex vi=dataSet.addVertex(vertex).getIndex();
-			vertexIndices[vertexIndex]=vi;
-			vertexHash[vertex]=vi;
-			}
-		else
-			{
-			/* Map the index of the existing vertex to the new one: */
-			vertexIndices[vertexIndex]=vhIt->getDest();
-			}
-		
-		// DEBUGGING
-		Misc::HashTable<DS::Point,size_t>::Iterator svimIt=svim.findEntry(vertex);
-		if(svimIt.isFinished())
-			{
-			/* Enter the vertex into the hash table: */
-			svi[vertexIndex]=vertexIndex;
-			svim[vertex]=vertexIndex;
-			}
-		else
-			{
-			/* Map the index of the existing vertex to the new one: */
-			svi[vertexIndex]=svimIt->getDest();
-			}
-		}
+	/* Copy the welded mesh vertices into the result data set: */
+	dataSet.reserveVertices(welder.getNumWeldedVertices());
+	for(Index vi=0;vi<welder.getNumWeldedVertices();++vi)
+		dataSet.addVertex(typename DS::Point(&nodeComponents[size_t(welder.getOriginalVertexIndex(vi))*3]));
 	}
 	
-	/* Clean up mesh vertex data: */
-	delete[] nodeDims;
-	delete[] nodeData;
-	
-	/* Read mesh topology data: */
-	size_t cellNumDims;
-	size_t* cellDims;
-	unsigned int* cellData;
-	HDF5::DataSet cells(meshFile,cellsDsName.c_str());
-	cells.read(cellNumDims,cellDims,cellData);
+	{
+	/* Stream the mesh topology data: */
+	HDF5::DataSet cells(meshFile,cellsDsName);
+	HDF5::BlockReader<Index> cellReader(cells,blockNumRows);
 	
 	/* Check for data consistency: */
-	if(cellNumDims!=2||cellDims[1]!=8)
-		{
-		delete[] cellDims;
-		delete[] cellData;
-		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Mesh cell indices in input file %s have wrong layout",args[0].c_str());
-		}
+	if(cellReader.getDimensions().size()!=2||cellReader.getDimensions()[1]!=8)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Mesh cell indices in input file %s have wrong layout",inputFileName.c_str());
 	
 	/* Create the result data set's cell topology: */
-	dataSet.reserveCells(cellDims[0]);
+	dataSet.reserveCells(cellReader.getDimensions()[0]);
 	static const int vertexOrder[8]={0,1,3,2,4,5,7,6}; // Xdmf's cube vertex counting order
-	unsigned int* cdPtr=cellData;
-	for(size_t cellIndex=0;cellIndex<cellDims[0];++cellIndex,cdPtr+=8)
+	size_t firstRow,numRows;
+	while(const Index* cdPtr=cellReader.getNextBlock(firstRow,numRows))
 		{
-		/* Unswizzle the cell's vertex indices and assign non-duplicate vertex IDs: */
-		DS::VertexID cellVertices[8];
-		for(int i=0;i<8;++i)
-			cellVertices[vertexOrder[i]]=vertexIndices[cdPtr[i]];
-		
-		/* Add the cell to the data set: */
-		dataSet.addCell(cellVertices);
+		for(size_t cellIndex=0;cellIndex<numRows;++cellIndex,cdPtr+=8)
+			{
+			/* Unswizzle the cell's vertex indices and assign non-duplicate vertex IDs: */
+			typename DS::VertexID cellVertices[8];
+			for(int i=0;i<8;++i)
+				{
+				if(cdPtr[i]>=numVertexIndices)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Invalid vertex index in mesh cell %lu in input file %s",(unsigned long)(firstRow+cellIndex),inputFileName.c_str());
+				cellVertices[vertexOrder[i]]=welder.getWeldedVertexIndex(cdPtr[i]);
+				}
+			
+			/* Add the cell to the data set: */
+			dataSet.addCell(cellVertices);
+			}
 		}
+	}
 	
 	/* Finalize the grid structure: */
 	if(master)
 		std::cout<<"Finalizing grid structure..."<<std::flush;
 	dataSet.finalizeGrid();
 	if(master)
+		{
 		std::cout<<" done"<<std::endl;
+		
+		/* Report the grid's memory footprint: */
+		size_t memorySize=dataSet.getMemorySize();
+		size_t numCells=dataSet.getTotalNumCells();
+		std::cout<<"Grid uses "<<sizeof(Index)*8<<"-bit indices, "<<memorySize<<" bytes total";
+		if(numCells>0)
+			std::cout<<", "<<double(memorySize)/double(numCells)<<" bytes per cell";
+		std::cout<<std::endl;
+		}
 	}
 	
 	{
 	/* Open the solution file: */
-	HDF5::File solutionFile(getFullPath(solutionFileName).c_str());
+	HDF5::File solutionFile(getFullPath(baseDir+solutionFileName).c_str());
 	
 	/* Initialize the result data set's data value: */
 	DataValue& dataValue=result->getDataValue();
 	dataValue.initialize(&dataSet,0);
 	
-	/* Read all scalar variables: */
+	/* Collect all selected variables in reading order; vector variables' indices are offset by the number of scalar variables: */
+	std::vector<size_t> variables;
 	for(size_t variableIndex=0;variableIndex<numScalarVariables;++variableIndex)
+		if(readScalarVariables[variableIndex])
+			variables.push_back(variableIndex);
+	for(size_t variableIndex=0;variableIndex<numVectorVariables;++variableIndex)
+		if(readVectorVariables[variableIndex])
+			variables.push_back(numScalarVariables+variableIndex);
+	
+	/* Open the first variable: */
+	VariableStreamList streams;
+	VariableStream* stream=!variables.empty()?streams.open(solutionFile,variables[0],numVertexIndices,!identityVertexIndices,inputFileName):0;
+	
+	/* Read all selected variables: */
+	for(size_t i=0;i<variables.size();++i)
 		{
-		std::cout<<"Reading scalar variable "<<scalarVariableDsNames[variableIndex]<<"..."<<std::flush;
-		
-		/* Add another scalar variable to the data value: */
-		dataValue.addScalarVariable(scalarVariableDsNames[variableIndex].c_str());
+		bool isVector=variables[i]>=numScalarVariables;
+		const char* variableName=isVector?vectorVariableDsNames[variables[i]-numScalarVariables]:scalarVariableDsNames[variables[i]];
+		int numComponents=isVector?3:1;
 		
-		/* Add another slice to the data set: */
-		int sliceIndex=dataSet.getNumSlices();
-		dataSet.addSlice();
+		if(master)
+			std::cout<<"Reading "<<(isVector?"vector":"scalar")<<" variable "<<variableName<<"..."<<std::flush;
 		
-		/* Read the scalar variable's data: */
-		size_t varNumDims;
-		size_t* varDims;
-		VScalar* varData;
-		HDF5::DataSet vars(solutionFile,scalarVariableDsNames[variableIndex].c_str());
-		vars.read(varNumDims,varDims,varData);
-		
-		/* Check for data consistency: */
-		if(varNumDims!=2||varDims[1]!=1||varDims[0]!=numVertexIndices)
+		/* Add the variable's slices to the data set while its first block is being read: */
+		VScalar* slices[4];
+		if(isVector)
 			{
-			delete[] varDims;
-			delete[] varData;
-			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Scalar variable %s in input file %s has wrong layout",scalarVariableDsNames[variableIndex].c_str(),args[0].c_str());
+			/* Add a vector variable and four new slices (three components plus magnitude): */
+			int vectorVariableIndex=dataValue.addVectorVariable(variableName);
+			int sliceIndex=dataSet.getNumSlices();
+			for(int j=0;j<4;++j)
+				{
+				slices[j]=dataSet.getSliceArray(dataSet.addSlice());
+				dataValue.addScalarVariable(makeVectorSliceName(variableName,j).c_str());
+				if(j<3)
+					dataValue.setVectorVariableScalarIndex(vectorVariableIndex,j,sliceIndex+j);
+				}
+			}
+		else
+			{
+			/* Add a scalar variable and its slice: */
+			dataValue.addScalarVariable(variableName);
+			slices[0]=dataSet.getSliceArray(dataSet.addSlice());
 			}
 		
-		/* Copy scalar variable data into the data set using non-duplicate vertex IDs: */
-		VScalar maxMismatch(0);
-		size_t mmi0,mmi1;
-		VScalar* vdPtr=varData;
-		VScalar* slice=dataSet.getSliceArray(sliceIndex);
-		for(size_t vertexIndex=0;vertexIndex<varDims[0];++vertexIndex,++vdPtr)
+		VariableStream* nextStream=0;
+		if(identityVertexIndices)
 			{
-			/* Get the vertex's non-duplicate ID: */
-			DS::VertexIndex vi=vertexIndices[vertexIndex];
+			/* Read the variable's components directly into their slices: */
+			for(int j=0;j<numComponents;++j)
+				{
+				size_t start[2]={0,size_t(j)};
+				size_t count[2]={numVertexIndices,1};
+				stream->getDataSet().readHyperslab(start,count,slices[j]);
+				}
 			
-			// DEBUGGING
-			// if(varData[vertexIndex]!=varData[svi[vertexIndex]])
+			/* Calculate the vector magnitudes: */
+			if(isVector)
+				for(size_t vi=0;vi<numVertexIndices;++vi)
+					slices[3][vi]=Math::sqrt(Math::sqr(slices[0][vi])+Math::sqr(slices[1][vi])+Math::sqr(slices[2][vi]));
+			}
+		else
+			{
+			/* Copy the variable's data into the data set using non-duplicate vertex IDs: */
+			size_t firstRow,numRows;
+			while(const VScalar* vdPtr=stream->getReader().getNextBlock(firstRow,numRows))
 				{
-				VScalar mismatch=Math::abs(varData[vertexIndex]-varData[svi[vertexIndex]]);
-				if(maxMismatch<mismatch)
+				/* Start reading the next variable in the background as soon as this variable's last block has been read: */
+				if(firstRow+numRows==numVertexIndices&&i+1<variables.size())
+					nextStream=streams.open(solutionFile,variables[i+1],numVertexIndices,true,inputFileName);
+				
+				if(isVector)
 					{
-					maxMismatch=mismatch;
-					mmi0=vertexIndex;
-					mmi1=svi[vertexIndex];
+					for(size_t vertexIndex=firstRow;vertexIndex<firstRow+numRows;++vertexIndex,vdPtr+=3)
+						{
+						/* Store the vector's components and magnitude: */
+						Index vi=welder.getWeldedVertexIndex(vertexIndex);
+						VScalar len2(0);
+						for(int j=0;j<3;++j)
+							{
+							slices[j][vi]=vdPtr[j];
+							len2+=Math::sqr(vdPtr[j]);
+							}
+						slices[3][vi]=Math::sqrt(len2);
+						}
+					}
+				else
+					{
+					for(size_t vertexIndex=firstRow;vertexIndex<firstRow+numRows;++vertexIndex,++vdPtr)
+						slices[0][welder.getWeldedVertexIndex(vertexIndex)]=*vdPtr;
 					}
 				}
 			
-			/* Assign the scalar value: */
-			slice[vi]=*vdPtr;
+			/* Release the variable's read buffers: */
+			stream->stopReading();
 			}
 		
-		std::cout<<" done"<<std::endl;
+		/* Open the next variable unless it was already opened during streaming: */
+		if(nextStream==0&&i+1<variables.size())
+			nextStream=streams.open(solutionFile,variables[i+1],numVertexIndices,!identityVertexIndices,inputFileName);
+		stream=nextStream;
 		
-		if(maxMismatch>VScalar(0))
-			{
-			std::cout<<"\tMaximum shared node mismatch: "<<maxMismatch<<" between nodes "<<mmi0<<" and "<<mmi1<<std::endl;
-			std::cout<<"\t"<<varData[mmi0]<<", "<<varData[mmi1]<<std::endl;
-			}
+		if(master)
+			std::cout<<" done"<<std::endl;
 		}
+	}
 	
-	/* Read all vector variables: */
-	for(size_t variableIndex=0;variableIndex<numVectorVariables;++variableIndex)
+	/* Return the result data set: */
+	return result.releaseTarget();
+	}
+
+Visualization::Abstract::DataSet* UnstructuredHexahedralXdmf::load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const
+	{
+	bool master=pipe==0||pipe->isMaster();
+	
+	/* Get the input file name's directory: */
+	std::string::const_iterator fnIt=args[0].begin();
+	for(std::string::const_iterator pIt=args[0].begin();pIt!=args[0].end();++pIt)
+		if(*pIt=='/')
+			fnIt=pIt+1;
+	std::string baseDir(args[0].begin(),fnIt);
+	
+	/* Parse the time step index and the list of variables to read from the command line: */
+	int timeStepIndex=0;
+	bool largeIndices=false;
+	bool readScalarVariables[5]={false,false,false,false,false};
+	bool readVectorVariables[1]={false};
+	bool haveVariableList=false;
+	for(std::vector<std::string>::const_iterator argIt=args.begin()+1;argIt!=args.end();++argIt)
 		{
-		std::cout<<"Reading vector variable "<<vectorVariableDsNames[variableIndex]<<"..."<<std::flush;
-		
-		/* Add another vector variable to the data value: */
-		int vectorVariableIndex=dataValue.addVectorVariable(vectorVariableDsNames[variableIndex].c_str());
-		
-		/* Add four new slices to the data set (three components plus magnitude): */
-		int sliceIndex=dataSet.getNumSlices();
-		for(int i=0;i<4;++i)
+		if(strcasecmp(argIt->c_str(),"-timeStep")==0)
 			{
-			dataSet.addSlice();
-			dataValue.addScalarVariable(makeVectorSliceName(vectorVariableDsNames[variableIndex],i).c_str());
-			if(i<3)
-				dataValue.setVectorVariableScalarIndex(vectorVariableIndex,i,sliceIndex+i);
+			++argIt;
+			if(argIt==args.end())
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"No time step index provided");
+			timeStepIndex=atoi(argIt->c_str());
 			}
-		
-		/* Read the vector variable's data: */
-		size_t varNumDims;
-		size_t* varDims;
-		VScalar* varData;
-		HDF5::DataSet vars(solutionFile,vectorVariableDsNames[variableIndex].c_str());
-		vars.read(varNumDims,varDims,varData);
-		
-		/* Check for data consistency: */
-		if(varNumDims!=2||varDims[1]!=3||varDims[0]!=numVertexIndices)
-			{
-			delete[] varDims;
-			delete[] varData;
-			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Vector variable %s in input file %s has wrong layout",vectorVariableDsNames[variableIndex].c_str(),args[0].c_str());
-			}
-		
-		/* Copy vector variable data into the data set using non-duplicate vertex IDs: */
-		VScalar* vdPtr=varData;
-		VScalar* slices[4];
-		for(int i=0;i<4;++i)
-			slices[i]=dataSet.getSliceArray(sliceIndex+i);
-		for(size_t vertexIndex=0;vertexIndex<varDims[0];++vertexIndex,vdPtr+=3)
+		else if(strcasecmp(argIt->c_str(),"-largeIndices")==0)
+			largeIndices=true;
+		else
 			{
-			/* Get the vertex's non-duplicate ID: */
-			DS::VertexIndex vi=vertexIndices[vertexIndex];
-			
-			/* Store the vector's components and magnitude: */
-			bool mismatch=false;
-			VScalar len2(0);
-			for(int i=0;i<3;++i)
-				{
-				/* Check for mismatching vector component values: */
-				mismatch=mismatch||slices[i][vi]!=vdPtr[i];
-				
-				/* Assign the vector component value: */
-				slices[i][vi]=vdPtr[i];
-				
-				len2+=Math::sqr(vdPtr[i]);
-				}
-			
-			/* Store the vector magnitude: */
-			slices[3][vi]=Math::sqrt(len2);
-			
-			#if 0
-			if(mismatch)
-				std::cout<<'X'<<std::flush;
-			#endif
+			/* Find the variable of the given name: */
+			bool found=false;
+			for(size_t i=0;i<numScalarVariables&&!found;++i)
+				if(*argIt==scalarVariableDsNames[i])
+					found=readScalarVariables[i]=true;
+			for(size_t i=0;i<numVectorVariables&&!found;++i)
+				if(*argIt==vectorVariableDsNames[i])
+					found=readVectorVariables[i]=true;
+			if(!found)
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unknown variable %s",argIt->c_str());
+			haveVariableList=true;
 			}
-		
-		std::cout<<" done"<<std::endl;
 		}
-	}
+	if(!haveVariableList)
+		{
+		/* Read all variables: */
+		for(size_t i=0;i<numScalarVariables;++i)
+			readScalarVariables[i]=true;
+		for(size_t i=0;i<numVectorVariables;++i)
+			readVectorVariables[i]=true;
+		}
 	
-	/* Return the result data set: */
-	return result.releaseTarget();
+	if(!largeIndices)
+		{
+		/* Check whether the mesh's vertex or cell counts exceed the range of compact indices: */
+		HDF5::File meshFile((baseDir+"solution/mesh-00000.h5").c_str());
+		HDF5::DataSet nodes(meshFile,nodesDsName);
+		HDF5::DataSet cells(meshFile,cellsDsName);
+		std::vector<size_t> nodeDims=nodes.getDimensions();
+		std::vector<size_t> cellDims=cells.getDimensions();
+		largeIndices=(!nodeDims.empty()&&nodeDims[0]>=DS::getMaxNumElements())||(!cellDims.empty()&&cellDims[0]>=DS::getMaxNumElements());
+		}
+	
+	/* Load the data set using the appropriate index width: */
+	if(largeIndices)
+		{
+		if(master)
+			std::cout<<"Using 64-bit vertex and cell indices"<<std::endl;
+		return loadDataSet<LargeDataSet>(args[0],baseDir,timeStepIndex,readScalarVariables,readVectorVariables,pipe);
+		}
+	else
+		return loadDataSet<DataSet>(args[0],baseDir,timeStepIndex,readScalarVariables,readVectorVariables,pipe);
 	}
 
 }
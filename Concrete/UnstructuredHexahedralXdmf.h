@@ -1,7 +1,7 @@
 /***********************************************************************
 UnstructuredHexahedralXdmf - Class reading unstructured hexahedral data
 sets from files in Xdmf format, with mass data stored in HDF5 format.
-Copyright (c) 2018 Oliver Kreylos
+Copyright (c) 2018-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -26,7 +26,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Wrappers/SlicedHypercubicIncludes.h>
 #include <Wrappers/SlicedScalarVectorDataValue.h>
 
-#include <Wrappers/Module.h>
+#include <Misc/SizedTypes.h>
+
+#include <Wrappers/IndexWidthModule.h>
 
 namespace Visualization {
 
@@ -39,12 +41,18 @@ typedef float Scalar; // Scalar type of data set domain
 typedef double VScalar; // Scalar type of data set value
 typedef Visualization::Templatized::SlicedHypercubic<Scalar,3,VScalar> DS; // Templatized data set type
 typedef Visualization::Wrappers::SlicedScalarVectorDataValue<DS,VScalar> DataValue; // Type of data value descriptor
-typedef Visualization::Wrappers::Module<DS,DataValue> BaseModule; // Module base class type
+typedef Visualization::Templatized::SlicedHypercubic<Scalar,3,VScalar,Misc::UInt64> LargeDS; // Templatized data set type for meshes exceeding the 32-bit index range
+typedef Visualization::Wrappers::SlicedScalarVectorDataValue<LargeDS,VScalar> LargeDataValue; // Type of data value descriptor for meshes exceeding the 32-bit index range
+typedef Visualization::Wrappers::IndexWidthModule<DS,DataValue,LargeDS,LargeDataValue> BaseModule; // Module base class type
 
 }
 
 class UnstructuredHexahedralXdmf:public BaseModule
 	{
+	/* Private methods: */
+	template <class DataSetParam>
+	Visualization::Abstract::DataSet* loadDataSet(const std::string& inputFileName,const std::string& baseDir,int timeStepIndex,const bool readScalarVariables[],const bool readVectorVariables[],Cluster::MulticastPipe* pipe) const; // Loads a data set using the given data set wrapper type
+	
 	/* Constructors and destructors: */
 	public:
 	UnstructuredHexahedralXdmf(void); // Default constructor
@@ -1,7 +1,7 @@
 /***********************************************************************
 VTKFile - Class to represent an XML-format VTK file containing
 volumetric data.
-Copyright (c) 2019-2020 Oliver Kreylos
+Copyright (c) 2019-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -22,11 +22,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Concrete/VTKFile.h>
 
-#include <Math/Math.h>
-#include <Math/Constants.h>
-
 #include <Concrete/VTKFileReader.h>
-#include <Concrete/VertexClusterer.h>
+#include <Concrete/VertexWelder.h>
 
 namespace Visualization {
 
@@ -70,19 +67,18 @@ void VTKFile::read(IO::DirectoryPtr directory,const char* vtkFileName)
 	/* Read the VTK file: */
 	reader.read();
 	
-	/* Merge close-by vertices to remove redundancy from the saved output and enable cell face matching: */
-	VertexClusterer clusterer(reader.getVertexComponents());
-	
-	/* Calculate a default maximum distance for cluster merging based on domain size and the selected scalar data type's machine epsilon: */
-	const VertexClusterer::Box& bbox=clusterer.getBoundingBox();
-	Scalar maxDim(0);
-	for(int i=0;i<3;++i)
-		maxDim=Math::max(maxDim,Math::max(Math::abs(bbox.min[i]),Math::abs(bbox.max[i])));
-	Scalar maxDist=maxDim*Math::Constants<Scalar>::epsilon;
+	/* Weld close-by vertices to remove redundancy from the saved output and enable cell face matching, using a tolerance based on domain size and the selected scalar data type's machine epsilon: */
+	VertexWelder<Scalar,Index> welder;
+	const std::vector<Scalar>& vertexComponents=reader.getVertexComponents();
+	numVertices=welder.weld(Index(vertexComponents.size()/3),vertexComponents.empty()?0:&vertexComponents.front());
 	
-	/* Create clusters and retrieve the merged vertices: */
-	numVertices=clusterer.createClusters(maxDist);
-	vertices=clusterer.retrieveMergedVertices();
+	/* Retrieve the welded vertices as the centroids of the original vertices welded into them: */
+	std::vector<Scalar> weldedVertexComponents(size_t(numVertices)*3);
+	if(numVertices>0)
+		welder.calcWeldedVertices(&vertexComponents.front(),&weldedVertexComponents.front());
+	vertices=new Point[numVertices];
+	for(Index vi=0;vi<numVertices;++vi)
+		vertices[vi]=Point(&weldedVertexComponents[size_t(vi)*3]);
 	
 	/* Copy the read file's per-vertex properties: */
 	numVertexProperties=reader.getVertexProperties().size();
@@ -120,7 +116,7 @@ void VTKFile::read(IO::DirectoryPtr directory,const char* vtkFileName)
 				for(Index vi=0;vi<numVertices;++vi,++vpsPtr)
 					{
 					/* Get the index of one of the original vertices that were merged into this merged vertex: */
-					Index vertexIndex=clusterer.getOriginalVertexIndex(vi);
+					Index vertexIndex=welder.getOriginalVertexIndex(vi);
 					
 					/* Copy this vertex's vertex property component: */
 					*vpsPtr=originalComponents[vertexIndex*numComponents+componentIndex];
@@ -133,7 +129,7 @@ void VTKFile::read(IO::DirectoryPtr directory,const char* vtkFileName)
 	cellVertexIndices=new Index[reader.getCellVertexIndices().size()];
 	Index* cviPtr=cellVertexIndices;
 	for(std::vector<Index>::const_iterator cviIt=reader.getCellVertexIndices().begin();cviIt!=reader.getCellVertexIndices().end();++cviIt,++cviPtr)
-		*cviPtr=clusterer.getMergedVertexIndex(*cviIt);
+		*cviPtr=welder.getWeldedVertexIndex(*cviIt);
 	
 	/* Copy the read cell types: */
 	cellTypes=new CellType[numCells];
@@ -1,6 +1,6 @@
 /***********************************************************************
 VTKFileReader - Class to read VTK files in XML format.
-Copyright (c) 2019-2024 Oliver Kreylos
+Copyright (c) 2019-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -30,7 +30,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <IO/GzipFilter.h>
 
 #include <Concrete/VTKCDataParser.h>
-#include <Concrete/VertexClusterer.h>
+#include <Concrete/VertexWelder.h>
 
 namespace Visualization {
 
@@ -627,7 +627,7 @@ struct ThreadArgument
 	/* Elements: */
 	public:
 	VTKFileReader* reader; // A reader for a piece file
-	VertexClusterer* clusterer; // A vertex clusterer to merge vertices read from the piece file
+	VertexWelder<VTKFileReader::Scalar,VTKFileReader::Index>* welder; // A vertex welder to merge vertices read from the piece file
 	VTKFileReader::Index numVertices; // Number of merged vertices
 	Threads::Thread thread; // A thread running the reader function
 	bool ok; // A flag if everything was A-OK
@@ -640,18 +640,13 @@ void* readerThreadFunction(ThreadArgument* ta)
 		/* Read the piece file: */
 		ta->reader->read();
 		
-		/* Merge close-by vertices to remove redundancy from the saved output and enable cell face matching: */
-		ta->clusterer=new VertexClusterer(ta->reader->getVertexComponents());
+		/* Weld close-by vertices to remove redundancy from the saved output and enable cell face matching, using a tolerance based on domain size and the selected scalar data type's machine epsilon: */
+		const std::vector<VTKFileReader::Scalar>& vertexComponents=ta->reader->getVertexComponents();
+		ta->welder=new VertexWelder<VTKFileReader::Scalar,VTKFileReader::Index>;
 		
-		/* Calculate a default maximum distance for cluster merging based on domain size and the selected scalar data type's machine epsilon: */
-		const VertexClusterer::Box& bbox=ta->clusterer->getBoundingBox();
-		VertexClusterer::Scalar maxDim(0);
-		for(int i=0;i<3;++i)
-			maxDim=Math::max(maxDim,Math::max(Math::abs(bbox.min[i]),Math::abs(bbox.max[i])));
-		VertexClusterer::Scalar maxDist=maxDim*Math::Constants<VertexClusterer::Scalar>::epsilon;
-		
-		/* Create clusters: */
-		ta->numVertices=ta->clusterer->createClusters(maxDist);
+		/* Piece files are already read in parallel; weld each piece using a single thread: */
+		ta->welder->setNumThreads(1);
+		ta->numVertices=ta->welder->weld(VTKFileReader::Index(vertexComponents.size()/3),vertexComponents.empty()?0:&vertexComponents.front());
 		
 		/* Signal success: */
 		ta->ok=true;
@@ -733,7 +728,7 @@ void VTKFileReader::processParallelUnstructuredGrid(void)
 		for(PropertyList::iterator cpIt=cellProperties.begin();cpIt!=cellProperties.end();++cpIt)
 			taPtr->reader->addCellProperty((*cpIt)->name,(*cpIt)->numComponents);
 		
-		taPtr->clusterer=0;
+		taPtr->welder=0;
 		taPtr->ok=false;
 		}
 	
@@ -771,8 +766,12 @@ void VTKFileReader::processParallelUnstructuredGrid(void)
 			Index numVertices=threadArgs[i].numVertices;
 			Index numCells=threadArgs[i].reader->getCellTypes().size();
 			
-			/* Collect merged vertices from the thread's clusterer: */
-			threadArgs[i].clusterer->retrieveMergedVertices(vertexComponents);
+			/* Collect welded vertices as the centroids of the original vertices welded into them: */
+			const std::vector<Scalar>& pieceVertexComponents=threadArgs[i].reader->getVertexComponents();
+			size_t vertexComponentsBase=vertexComponents.size();
+			vertexComponents.resize(vertexComponentsBase+size_t(numVertices)*3);
+			if(numVertices>0)
+				threadArgs[i].welder->calcWeldedVertices(&pieceVertexComponents.front(),&vertexComponents[vertexComponentsBase]);
 			
 			/* Collect all per-vertex data values for all merged vertices: */
 			PropertyList::const_iterator ovpIt=threadArgs[i].reader->getVertexProperties().begin();
@@ -789,7 +788,7 @@ void VTKFileReader::processParallelUnstructuredGrid(void)
 				for(Index vi=0;vi<numVertices;++vi)
 					{
 					/* Get the index of one of the original vertices that were merged into this merged vertex: */
-					Index vertexIndex=threadArgs[i].clusterer->getOriginalVertexIndex(vi);
+					Index vertexIndex=threadArgs[i].welder->getOriginalVertexIndex(vi);
 					
 					/* Get an iterator to the first vertex property component of the original vertex: */
 					std::vector<VScalar>::const_iterator ocIt=originalComponents.begin()+(vertexIndex*numComponents);
@@ -806,7 +805,7 @@ void VTKFileReader::processParallelUnstructuredGrid(void)
 			/* Convert cell vertex indices into shared vertex space: */
 			const std::vector<Index>& cvis=threadArgs[i].reader->getCellVertexIndices();
 			for(std::vector<Index>::const_iterator cviIt=cvis.begin();cviIt!=cvis.end();++cviIt)
-				cellVertexIndices.push_back(baseIndex+threadArgs[i].clusterer->getMergedVertexIndex(*cviIt));
+				cellVertexIndices.push_back(baseIndex+threadArgs[i].welder->getWeldedVertexIndex(*cviIt));
 			
 			/* Collect all per-cell data values for all cells: */
 			PropertyList::const_iterator ocpIt=threadArgs[i].reader->getCellProperties().begin();
@@ -837,7 +836,7 @@ void VTKFileReader::processParallelUnstructuredGrid(void)
 	for(Index i=0;i<pieceUrls.size();++i)
 		{
 		delete threadArgs[i].reader;
-		delete threadArgs[i].clusterer;
+		delete threadArgs[i].welder;
 		}
 	
 	/* Check if there was an error reading any of the piece files: */
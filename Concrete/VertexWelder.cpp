@@ -0,0 +1,526 @@
+/***********************************************************************
+VertexWelder - Class to merge coincident or near-coincident vertices of
+unstructured grids by sorting quantized vertex positions in Morton order
+using multiple threads.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <Concrete/VertexWelder.h>
+
+#include <algorithm>
+#include <Misc/StdError.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+
+#include <ParallelTasks.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline Misc::UInt64 spreadBits(Misc::UInt32 value)
+	{
+	/* Spread the lower 21 bits of the given value such that there are two zero bits between each pair of adjacent bits: */
+	Misc::UInt64 result=value&0x1fffffU;
+	result=(result|(result<<32))&0x001f00000000ffffULL;
+	result=(result|(result<<16))&0x001f0000ff0000ffULL;
+	result=(result|(result<<8))&0x100f00f00f00f00fULL;
+	result=(result|(result<<4))&0x10c30c30c30c30c3ULL;
+	result=(result|(result<<2))&0x1249249249249249ULL;
+	
+	return result;
+	}
+
+template <class ScalarParam>
+inline bool withinTolerance(const ScalarParam* v0,const ScalarParam* v1,ScalarParam tolerance)
+	{
+	/* Check whether the two vertices differ by at most the tolerance along all axes: */
+	for(int i=0;i<3;++i)
+		if(Math::abs(v0[i]-v1[i])>tolerance)
+			return false;
+	
+	return true;
+	}
+
+template <class IndexParam>
+inline IndexParam findRoot(IndexParam* parents,IndexParam vertexIndex)
+	{
+	/* Follow the parent chain to the root while halving the path; parents always have smaller indices than their children: */
+	while(parents[vertexIndex]!=vertexIndex)
+		{
+		parents[vertexIndex]=parents[parents[vertexIndex]];
+		vertexIndex=parents[vertexIndex];
+		}
+	
+	return vertexIndex;
+	}
+
+template <class IndexParam>
+inline void joinTrees(IndexParam* parents,IndexParam vertexIndex0,IndexParam vertexIndex1)
+	{
+	/* Join the two vertices' trees, keeping the smaller index as the root: */
+	IndexParam root0=findRoot(parents,vertexIndex0);
+	IndexParam root1=findRoot(parents,vertexIndex1);
+	if(root0<root1)
+		parents[root1]=root0;
+	else if(root1<root0)
+		parents[root0]=root1;
+	}
+
+}
+
+/************************************************
+Declaration of struct VertexWelder::QuantizeTask:
+************************************************/
+
+template <class ScalarParam,class IndexParam>
+struct VertexWelder<ScalarParam,IndexParam>::QuantizeTask
+	{
+	/* Elements: */
+	public:
+	const Scalar* vertexComponents; // Array of vertex components
+	Index first,last; // Range of vertex indices to quantize
+	double origin[3]; // Origin of the quantization grid
+	double cellSize; // Cell size of the quantization grid
+	CellEntry* entries; // Array of cell entries, indexed by vertex index
+	};
+
+/********************************************
+Declaration of struct VertexWelder::SortTask:
+********************************************/
+
+template <class ScalarParam,class IndexParam>
+struct VertexWelder<ScalarParam,IndexParam>::SortTask
+	{
+	/* Elements: */
+	public:
+	CellEntry* first; // Beginning of the range of cell entries
+	CellEntry* middle; // End of the first sorted half of the range if merging
+	CellEntry* last; // End of the range of cell entries
+	CellEntry* dest; // Destination of the merged range, or null to sort the range in place
+	};
+
+/******************************************************
+Declaration of struct VertexWelder::PositionComparator:
+******************************************************/
+
+template <class ScalarParam,class IndexParam>
+struct VertexWelder<ScalarParam,IndexParam>::PositionComparator
+	{
+	/* Elements: */
+	public:
+	const Scalar* vertexComponents; // Array of vertex components
+	
+	/* Constructors and destructors: */
+	PositionComparator(const Scalar* sVertexComponents)
+		:vertexComponents(sVertexComponents)
+		{
+		}
+	
+	/* Methods: */
+	bool operator()(const CellEntry& e0,const CellEntry& e1) const // Orders cell entries lexicographically by vertex position
+		{
+		const Scalar* v0=vertexComponents+size_t(e0.vertexIndex)*3;
+		const Scalar* v1=vertexComponents+size_t(e1.vertexIndex)*3;
+		for(int i=0;i<3;++i)
+			if(v0[i]!=v1[i])
+				return v0[i]<v1[i];
+		
+		return false;
+		}
+	};
+
+/*****************************
+Methods of class VertexWelder:
+*****************************/
+
+template <class ScalarParam,class IndexParam>
+void*
+VertexWelder<ScalarParam,IndexParam>::quantizeThreadFunction(
+	typename VertexWelder<ScalarParam,IndexParam>::QuantizeTask* task)
+	{
+	double cellScale=1.0/task->cellSize;
+	const Scalar* vcPtr=task->vertexComponents+size_t(task->first)*3;
+	CellEntry* ePtr=task->entries+task->first;
+	for(Index vi=task->first;vi<task->last;++vi,++ePtr)
+		{
+		/* Calculate the Morton code of the quantization cell containing the vertex: */
+		ePtr->mortonKey=0;
+		for(int i=0;i<3;++i,++vcPtr)
+			ePtr->mortonKey|=spreadBits(Misc::UInt32(Math::floor((double(*vcPtr)-task->origin[i])*cellScale)))<<i;
+		ePtr->vertexIndex=vi;
+		}
+	
+	return 0;
+	}
+
+template <class ScalarParam,class IndexParam>
+void*
+VertexWelder<ScalarParam,IndexParam>::sortThreadFunction(
+	typename VertexWelder<ScalarParam,IndexParam>::SortTask* task)
+	{
+	if(task->dest!=0)
+		{
+		/* Merge the two sorted halves of the range into the destination: */
+		std::merge(task->first,task->middle,task->middle,task->last,task->dest);
+		}
+	else
+		{
+		/* Sort the range in place: */
+		std::sort(task->first,task->last);
+		}
+	
+	return 0;
+	}
+
+template <class ScalarParam,class IndexParam>
+typename VertexWelder<ScalarParam,IndexParam>::CellEntry*
+VertexWelder<ScalarParam,IndexParam>::sortCellEntries(
+	typename VertexWelder<ScalarParam,IndexParam>::CellEntry* entries,
+	typename VertexWelder<ScalarParam,IndexParam>::CellEntry* buffer) const
+	{
+	/* Split the cell entries into one chunk per thread: */
+	unsigned int numChunks=numThreads;
+	if(Index(numChunks)>numVertices)
+		numChunks=(unsigned int)(numVertices);
+	Index* chunkBounds=new Index[numChunks+1];
+	for(unsigned int i=0;i<=numChunks;++i)
+		chunkBounds[i]=Index((double(numVertices)*double(i))/double(numChunks));
+	
+	/* Sort all chunks in parallel: */
+	SortTask* tasks=new SortTask[numChunks];
+	for(unsigned int i=0;i<numChunks;++i)
+		{
+		tasks[i].first=entries+chunkBounds[i];
+		tasks[i].middle=tasks[i].last=entries+chunkBounds[i+1];
+		tasks[i].dest=0;
+		}
+	ParallelTasks::runTasks(tasks,numChunks,sortThreadFunction);
+	
+	/* Merge pairs of adjacent sorted chunks in parallel until only a single chunk remains: */
+	CellEntry* source=entries;
+	CellEntry* dest=buffer;
+	for(unsigned int width=1;width<numChunks;width*=2)
+		{
+		unsigned int numTasks=0;
+		for(unsigned int i=0;i<numChunks;i+=width*2,++numTasks)
+			{
+			tasks[numTasks].first=source+chunkBounds[i];
+			tasks[numTasks].middle=source+chunkBounds[std::min(i+width,numChunks)];
+			tasks[numTasks].last=source+chunkBounds[std::min(i+width*2,numChunks)];
+			tasks[numTasks].dest=dest+chunkBounds[i];
+			}
+		ParallelTasks::runTasks(tasks,numTasks,sortThreadFunction);
+		std::swap(source,dest);
+		}
+	
+	delete[] tasks;
+	delete[] chunkBounds;
+	
+	return source;
+	}
+
+template <class ScalarParam,class IndexParam>
+VertexWelder<ScalarParam,IndexParam>::VertexWelder(
+	void)
+	:numThreads(ParallelTasks::getNumCpus()),
+	 numVertices(0),numWeldedVertices(0),
+	 weldedVertexIndices(0),originalVertexIndices(0)
+	{
+	}
+
+template <class ScalarParam,class IndexParam>
+VertexWelder<ScalarParam,IndexParam>::~VertexWelder(
+	void)
+	{
+	delete[] weldedVertexIndices;
+	delete[] originalVertexIndices;
+	}
+
+template <class ScalarParam,class IndexParam>
+typename VertexWelder<ScalarParam,IndexParam>::Box
+VertexWelder<ScalarParam,IndexParam>::calcBoundingBox(
+	typename VertexWelder<ScalarParam,IndexParam>::Index numVertices,
+	const typename VertexWelder<ScalarParam,IndexParam>::Scalar* vertexComponents)
+	{
+	Box result=Box::empty;
+	const Scalar* vcPtr=vertexComponents;
+	for(Index vi=0;vi<numVertices;++vi,vcPtr+=3)
+		for(int i=0;i<3;++i)
+			{
+			if(result.min[i]>vcPtr[i])
+				result.min[i]=vcPtr[i];
+			if(result.max[i]<vcPtr[i])
+				result.max[i]=vcPtr[i];
+			}
+	
+	return result;
+	}
+
+template <class ScalarParam,class IndexParam>
+typename VertexWelder<ScalarParam,IndexParam>::Scalar
+VertexWelder<ScalarParam,IndexParam>::calcMinTolerance(
+	const typename VertexWelder<ScalarParam,IndexParam>::Box& bbox)
+	{
+	/* Calculate the tolerance for which the largest bounding box extent, plus the three-tolerance grid shift, spans fewer than the maximum number of cells, with some headroom for rounding: */
+	double maxSize=0.0;
+	for(int i=0;i<3;++i)
+		maxSize=Math::max(maxSize,double(bbox.max[i])-double(bbox.min[i]));
+	
+	return Scalar(maxSize/(4.0*double(maxNumCells-4U)));
+	}
+
+template <class ScalarParam,class IndexParam>
+typename VertexWelder<ScalarParam,IndexParam>::Scalar
+VertexWelder<ScalarParam,IndexParam>::calcDefaultTolerance(
+	const typename VertexWelder<ScalarParam,IndexParam>::Box& bbox)
+	{
+	/* Base the tolerance on the largest absolute coordinate and the scalar type's machine epsilon: */
+	Scalar maxDim(0);
+	for(int i=0;i<3;++i)
+		maxDim=Math::max(maxDim,Math::max(Math::abs(bbox.min[i]),Math::abs(bbox.max[i])));
+	if(maxDim==Scalar(0))
+		maxDim=Scalar(1);
+	
+	return Math::max(maxDim*Math::Constants<Scalar>::epsilon,calcMinTolerance(bbox));
+	}
+
+template <class ScalarParam,class IndexParam>
+void
+VertexWelder<ScalarParam,IndexParam>::setNumThreads(
+	unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads>0?newNumThreads:1;
+	}
+
+template <class ScalarParam,class IndexParam>
+typename VertexWelder<ScalarParam,IndexParam>::Index
+VertexWelder<ScalarParam,IndexParam>::weld(
+	typename VertexWelder<ScalarParam,IndexParam>::Index newNumVertices,
+	const typename VertexWelder<ScalarParam,IndexParam>::Scalar* vertexComponents,
+	typename VertexWelder<ScalarParam,IndexParam>::Scalar tolerance)
+	{
+	if(!(tolerance>Scalar(0)))
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Welding tolerance must be positive");
+	
+	/* Calculate the vertices' bounding box: */
+	Box bbox=calcBoundingBox(newNumVertices,vertexComponents);
+	
+	/*********************************************************************
+	Quantize vertices to a grid of cells four times the tolerance wide, in
+	four passes where the grid is shifted by one tolerance along all axes
+	between passes. Along each axis, the cell boundaries of all four grids
+	are exactly one tolerance apart, meaning that two vertices that are no
+	more than one tolerance apart along each of the three axes straddle
+	cell boundaries in at most three of the four grids, and end up in the
+	same cell in the remaining one. Vertices sharing a cell are only
+	joined if they are in fact no more than one tolerance apart along each
+	axis, such that the cell size does not widen the welding distance.
+	*********************************************************************/
+	
+	double cellSize=double(tolerance)*4.0;
+	for(int i=0;i<3;++i)
+		if(newNumVertices>0&&(double(bbox.max[i])-double(bbox.min[i])+double(tolerance)*3.0)/cellSize>=double(maxNumCells))
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Welding tolerance %g is smaller than the smallest supported tolerance %g",double(tolerance),double(calcMinTolerance(bbox)));
+	
+	/* Initialize the welding state: */
+	delete[] weldedVertexIndices;
+	weldedVertexIndices=0;
+	delete[] originalVertexIndices;
+	originalVertexIndices=0;
+	numVertices=newNumVertices;
+	numWeldedVertices=0;
+	
+	/* Initialize a union-find forest where each vertex is its own root, which will later be turned into the vertex index remapping: */
+	weldedVertexIndices=new Index[numVertices];
+	for(Index vi=0;vi<numVertices;++vi)
+		weldedVertexIndices[vi]=vi;
+	
+	if(numVertices>1)
+		{
+		/* Create arrays of cell entries and split the vertices into one range per thread: */
+		CellEntry* entries=new CellEntry[numVertices];
+		CellEntry* buffer=new CellEntry[numVertices];
+		unsigned int numTasks=numThreads;
+		if(Index(numTasks)>numVertices)
+			numTasks=(unsigned int)(numVertices);
+		QuantizeTask* tasks=new QuantizeTask[numTasks];
+		for(unsigned int i=0;i<numTasks;++i)
+			{
+			tasks[i].vertexComponents=vertexComponents;
+			tasks[i].first=Index((double(numVertices)*double(i))/double(numTasks));
+			tasks[i].last=Index((double(numVertices)*double(i+1))/double(numTasks));
+			tasks[i].cellSize=cellSize;
+			tasks[i].entries=entries;
+			}
+		
+		Index* parents=weldedVertexIndices;
+		for(int pass=0;pass<4;++pass)
+			{
+			/* Quantize all vertices to the shifted grid in parallel: */
+			for(unsigned int i=0;i<numTasks;++i)
+				for(int j=0;j<3;++j)
+					tasks[i].origin[j]=double(bbox.min[j])-double(tolerance)*double(pass);
+			ParallelTasks::runTasks(tasks,numTasks,quantizeThreadFunction);
+			
+			/* Sort the cell entries in Morton order to collect vertices in the same cell into runs: */
+			CellEntry* sorted=sortCellEntries(entries,buffer);
+			
+			/* Join all pairs of vertices within each run of identical cells that are within the tolerance of each other: */
+			PositionComparator positionComparator(vertexComponents);
+			CellEntry* sortedEnd=sorted+numVertices;
+			CellEntry* runStart=sorted;
+			while(runStart!=sortedEnd)
+				{
+				/* Find the end of the current run: */
+				CellEntry* runEnd=runStart+1;
+				while(runEnd!=sortedEnd&&runEnd->mortonKey==runStart->mortonKey)
+					++runEnd;
+				
+				if(runEnd-runStart>1)
+					{
+					/* Sort the run by vertex position to group identical vertices and order the rest along the first axis: */
+					std::sort(runStart,runEnd,positionComparator);
+					
+					/* Join identical vertices, and compact one representative of each distinct position to the front of the run: */
+					CellEntry* repEnd=runStart+1;
+					for(CellEntry* ePtr=runStart+1;ePtr!=runEnd;++ePtr)
+						{
+						if(positionComparator(repEnd[-1],*ePtr))
+							{
+							/* Keep the vertex as the representative of a new distinct position: */
+							*repEnd=*ePtr;
+							++repEnd;
+							}
+						else
+							joinTrees(parents,repEnd[-1].vertexIndex,ePtr->vertexIndex);
+						}
+					
+					/* Compare each representative against all previous representatives that are within the tolerance along the first axis: */
+					for(CellEntry* rPtr=runStart+1;rPtr!=repEnd;++rPtr)
+						{
+						const Scalar* v1=vertexComponents+size_t(rPtr->vertexIndex)*3;
+						for(CellEntry* r0Ptr=rPtr;r0Ptr!=runStart&&v1[0]-vertexComponents[size_t(r0Ptr[-1].vertexIndex)*3]<=tolerance;)
+							{
+							--r0Ptr;
+							if(withinTolerance(vertexComponents+size_t(r0Ptr->vertexIndex)*3,v1,tolerance))
+								joinTrees(parents,r0Ptr->vertexIndex,rPtr->vertexIndex);
+							}
+						}
+					}
+				
+				runStart=runEnd;
+				}
+			}
+		
+		delete[] tasks;
+		delete[] entries;
+		delete[] buffer;
+		}
+	
+	/* Count the number of trees in the union-find forest: */
+	for(Index vi=0;vi<numVertices;++vi)
+		if(weldedVertexIndices[vi]==vi)
+			++numWeldedVertices;
+	originalVertexIndices=new Index[numWeldedVertices];
+	
+	/* Replace parent indices with welded vertex indices in order of increasing original vertex index; parents are always processed before their children: */
+	Index nextWeldedIndex=0;
+	for(Index vi=0;vi<numVertices;++vi)
+		{
+		Index parent=weldedVertexIndices[vi];
+		if(parent==vi)
+			{
+			/* Assign a new welded vertex index to the root vertex: */
+			originalVertexIndices[nextWeldedIndex]=vi;
+			weldedVertexIndices[vi]=nextWeldedIndex;
+			++nextWeldedIndex;
+			}
+		else
+			{
+			/* Copy the welded vertex index already assigned to the parent: */
+			weldedVertexIndices[vi]=weldedVertexIndices[parent];
+			}
+		}
+	
+	return numWeldedVertices;
+	}
+
+template <class ScalarParam,class IndexParam>
+typename VertexWelder<ScalarParam,IndexParam>::Index
+VertexWelder<ScalarParam,IndexParam>::weld(
+	typename VertexWelder<ScalarParam,IndexParam>::Index newNumVertices,
+	const typename VertexWelder<ScalarParam,IndexParam>::Scalar* vertexComponents)
+	{
+	/* Weld using the default tolerance for the vertices' bounding box: */
+	return weld(newNumVertices,vertexComponents,calcDefaultTolerance(calcBoundingBox(newNumVertices,vertexComponents)));
+	}
+
+template <class ScalarParam,class IndexParam>
+void
+VertexWelder<ScalarParam,IndexParam>::calcWeldedVertices(
+	const typename VertexWelder<ScalarParam,IndexParam>::Scalar* vertexComponents,
+	typename VertexWelder<ScalarParam,IndexParam>::Scalar* weldedVertexComponents) const
+	{
+	/* Accumulate the positions of all original vertices welded into each welded vertex: */
+	double* centroidAccs=new double[size_t(numWeldedVertices)*3];
+	Index* centroidWeights=new Index[numWeldedVertices];
+	for(size_t i=0;i<size_t(numWeldedVertices)*3;++i)
+		centroidAccs[i]=0.0;
+	for(Index wvi=0;wvi<numWeldedVertices;++wvi)
+		centroidWeights[wvi]=0;
+	const Scalar* vcPtr=vertexComponents;
+	for(Index vi=0;vi<numVertices;++vi,vcPtr+=3)
+		{
+		Index wvi=weldedVertexIndices[vi];
+		double* caPtr=centroidAccs+size_t(wvi)*3;
+		for(int i=0;i<3;++i)
+			caPtr[i]+=double(vcPtr[i]);
+		++centroidWeights[wvi];
+		}
+	
+	/* Calculate the centroids: */
+	const double* caPtr=centroidAccs;
+	Scalar* wvcPtr=weldedVertexComponents;
+	for(Index wvi=0;wvi<numWeldedVertices;++wvi,caPtr+=3,wvcPtr+=3)
+		for(int i=0;i<3;++i)
+			wvcPtr[i]=Scalar(caPtr[i]/double(centroidWeights[wvi]));
+	
+	delete[] centroidAccs;
+	delete[] centroidWeights;
+	}
+
+/*******************************************
+Force instantiation of VertexWelder classes:
+*******************************************/
+
+template class VertexWelder<float,unsigned int>;
+template class VertexWelder<double,unsigned int>;
+template class VertexWelder<float,Misc::UInt64>;
+template class VertexWelder<double,Misc::UInt64>;
+
+}
+
+}
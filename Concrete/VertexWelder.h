@@ -0,0 +1,126 @@
+/***********************************************************************
+VertexWelder - Class to merge coincident or near-coincident vertices of
+unstructured grids by sorting quantized vertex positions in Morton order
+using multiple threads.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_CONCRETE_VERTEXWELDER_INCLUDED
+#define VISUALIZATION_CONCRETE_VERTEXWELDER_INCLUDED
+
+#include <Misc/SizedTypes.h>
+#include <Geometry/Box.h>
+
+namespace Visualization {
+
+namespace Concrete {
+
+template <class ScalarParam,class IndexParam>
+class VertexWelder // Class to merge near-coincident vertices; welds all vertices whose coordinates differ by at most the welding tolerance along every axis, and never welds vertices farther apart than that, except transitively
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarParam Scalar; // Scalar type for vertex positions
+	typedef IndexParam Index; // Type for vertex indices
+	typedef Geometry::Box<Scalar,3> Box; // Type for axis-aligned boxes
+	
+	private:
+	struct CellEntry // Structure associating a vertex with the quantization cell containing it
+		{
+		/* Elements: */
+		public:
+		Misc::UInt64 mortonKey; // Morton code interleaving the bits of the quantization cell's integer coordinates
+		Index vertexIndex; // Original index of the vertex
+		
+		/* Methods: */
+		bool operator<(const CellEntry& other) const // Orders cell entries along the Morton curve
+			{
+			return mortonKey<other.mortonKey;
+			}
+		};
+	
+	struct QuantizeTask; // Structure describing a range of vertices to quantize in a background thread
+	struct SortTask; // Structure describing a range of cell entries to sort or merge in a background thread
+	struct PositionComparator; // Functor ordering cell entries by the positions of their vertices
+	
+	/* Elements: */
+	static const Misc::UInt32 maxNumCells=(1U<<21)-1U; // Maximum number of quantization cells along each axis, such that three cell coordinates fit into a 64-bit Morton code
+	unsigned int numThreads; // Number of threads used to quantize and sort vertices
+	Index numVertices; // Number of original vertices in the most recent welding operation
+	Index numWeldedVertices; // Number of distinct vertices after the most recent welding operation
+	Index* weldedVertexIndices; // Array mapping original vertex indices to welded vertex indices
+	Index* originalVertexIndices; // Array mapping welded vertex indices to the smallest original index of the vertices welded into them
+	
+	/* Private methods: */
+	static void* quantizeThreadFunction(QuantizeTask* task); // Calculates quantization cells for a range of vertices
+	static void* sortThreadFunction(SortTask* task); // Sorts or merges a range of cell entries
+	CellEntry* sortCellEntries(CellEntry* entries,CellEntry* buffer) const; // Sorts the given array of cell entries in Morton order using the given buffer of the same size; returns whichever of the two arrays holds the sorted entries
+	
+	/* Constructors and destructors: */
+	public:
+	VertexWelder(void); // Creates a vertex welder using all available CPUs
+	private:
+	VertexWelder(const VertexWelder& source); // Prohibit copy constructor
+	VertexWelder& operator=(const VertexWelder& source); // Prohibit assignment operator
+	public:
+	~VertexWelder(void);
+	
+	/* Methods: */
+	static Box calcBoundingBox(Index numVertices,const Scalar* vertexComponents); // Returns the bounding box of the given array of vertex components
+	static Scalar calcMinTolerance(const Box& bbox); // Returns the smallest welding tolerance supported for vertices inside the given bounding box
+	static Scalar calcDefaultTolerance(const Box& bbox); // Returns a welding tolerance that merges vertices that are identical up to the scalar type's machine precision, or the smallest supported tolerance if larger
+	unsigned int getNumThreads(void) const // Returns the number of threads used for welding
+		{
+		return numThreads;
+		}
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads used for welding
+	Index weld(Index newNumVertices,const Scalar* vertexComponents,Scalar tolerance); // Welds the given array of vertex components using the given tolerance; returns the number of distinct vertices
+	Index weld(Index newNumVertices,const Scalar* vertexComponents); // Ditto, using the default tolerance for the vertices' bounding box
+	Index getNumVertices(void) const // Returns the number of original vertices
+		{
+		return numVertices;
+		}
+	Index getNumWeldedVertices(void) const // Returns the number of distinct vertices
+		{
+		return numWeldedVertices;
+		}
+	bool isIdentity(void) const // Returns true if no vertices were welded, i.e., the index remapping is the identity
+		{
+		return numWeldedVertices==numVertices;
+		}
+	const Index* getWeldedVertexIndices(void) const // Returns the array mapping original vertex indices to welded vertex indices
+		{
+		return weldedVertexIndices;
+		}
+	Index getWeldedVertexIndex(Index originalVertexIndex) const // Returns the welded vertex index of the original vertex of the given index
+		{
+		return weldedVertexIndices[originalVertexIndex];
+		}
+	Index getOriginalVertexIndex(Index weldedVertexIndex) const // Returns the smallest index of the original vertices welded into the welded vertex of the given index
+		{
+		return originalVertexIndices[weldedVertexIndex];
+		}
+	void calcWeldedVertices(const Scalar* vertexComponents,Scalar* weldedVertexComponents) const; // Writes the centroids of the original vertices welded into each welded vertex, from the array of vertex components passed to the most recent welding operation, into the given array of 3*getNumWeldedVertices() components
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,234 @@
+/***********************************************************************
+CurvilinearLocatorBenchmark - Utility to measure the throughput and
+Newton-Raphson iteration counts of point location in curvilinear grids
+with and without cached per-cell affine approximations.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+#include <vector>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+
+#include <Templatized/ScalarExtractor.h>
+#include <Templatized/Curvilinear.h>
+
+typedef Visualization::Templatized::Curvilinear<float,3,float> DataSet;
+typedef DataSet::Scalar Scalar;
+typedef DataSet::Point Point;
+typedef Visualization::Templatized::ScalarExtractor<float,float> ScalarExtractor;
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline Scalar randomScalar(unsigned int& seed) // Returns a pseudo-random number in [0, 1]
+	{
+	seed=seed*1103515245U+12345U;
+	return Scalar((seed>>8)&0xffffU)/Scalar(65535);
+	}
+
+inline Point warpPoint(const Scalar c[3],Scalar shear,Scalar warp) // Maps a point from grid index space to the domain of a sheared and warped grid
+	{
+	Point result;
+	for(int i=0;i<3;++i)
+		result[i]=c[i]+shear*c[(i+1)%3]+warp*Math::sin(c[(i+1)%3]*Scalar(0.7))*Math::sin(c[(i+2)%3]*Scalar(0.7));
+	return result;
+	}
+
+struct TraceResult // Structure to report the results of a tracing run
+	{
+	/* Elements: */
+	public:
+	unsigned int numLocates; // Number of point location requests
+	unsigned int numFound; // Number of successful point location requests
+	size_t numNewtonRaphsonSteps; // Total number of Newton-Raphson steps performed by all locators
+	double maxDifference; // Maximum difference between interpolated values and those of a reference run
+	double time; // Time spent locating points and evaluating the function in seconds
+	};
+
+TraceResult trace(const DataSet& dataSet,unsigned int numCells,Scalar shear,Scalar warp,unsigned int numPaths,unsigned int numSteps,Scalar stepSize,std::vector<float>& values,bool storeValues)
+	{
+	TraceResult result;
+	result.numLocates=0;
+	result.numFound=0;
+	result.numNewtonRaphsonSteps=0;
+	result.maxDifference=0.0;
+	ScalarExtractor extractor;
+	Scalar domainSize=Scalar(numCells);
+	unsigned int seed=2;
+	std::vector<float>::iterator vIt=values.begin();
+	Misc::Timer timer;
+	for(unsigned int path=0;path<numPaths;++path)
+		{
+		/* Start the path at a random position inside the grid and in a random direction in grid index space: */
+		Scalar c[3],dir[3];
+		for(int i=0;i<3;++i)
+			{
+			c[i]=(randomScalar(seed)*Scalar(0.9)+Scalar(0.05))*domainSize;
+			dir[i]=(randomScalar(seed)-Scalar(0.5))*stepSize;
+			}
+		
+		/* Trace the path through the grid like a streamline, using the previous cell as starting point: */
+		DataSet::Locator locator=dataSet.getLocator();
+		bool traceHint=false;
+		for(unsigned int step=0;step<numSteps;++step,++vIt)
+			{
+			++result.numLocates;
+			float value=-1.0f;
+			if(locator.locatePoint(warpPoint(c,shear,warp),traceHint))
+				{
+				++result.numFound;
+				value=locator.calcValue(extractor);
+				traceHint=true;
+				}
+			else
+				traceHint=false;
+			
+			/* Store the interpolated value, or compare it to the reference run: */
+			if(storeValues)
+				*vIt=value;
+			else
+				{
+				double difference=Math::abs(double(value)-double(*vIt));
+				if(result.maxDifference<difference)
+					result.maxDifference=difference;
+				}
+			
+			/* Advance the path and reflect it off the grid boundaries: */
+			for(int i=0;i<3;++i)
+				{
+				c[i]+=dir[i];
+				if(c[i]<Scalar(0)||c[i]>domainSize)
+					{
+					dir[i]=-dir[i];
+					c[i]+=Scalar(2)*dir[i];
+					}
+				}
+			}
+		result.numNewtonRaphsonSteps+=locator.getNumNewtonRaphsonSteps();
+		}
+	timer.elapse();
+	result.time=timer.getTime();
+	
+	return result;
+	}
+
+}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	unsigned int numCells=64;
+	Scalar shear(0.2);
+	Scalar warp(0.25);
+	unsigned int numPaths=1000;
+	unsigned int numSteps=1000;
+	Scalar stepSize(0.25);
+	for(int i=1;i<argc;++i)
+		{
+		if(strcasecmp(argv[i],"-numCells")==0&&i+1<argc)
+			numCells=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-shear")==0&&i+1<argc)
+			shear=Scalar(atof(argv[++i]));
+		else if(strcasecmp(argv[i],"-warp")==0&&i+1<argc)
+			warp=Scalar(atof(argv[++i]));
+		else if(strcasecmp(argv[i],"-numPaths")==0&&i+1<argc)
+			numPaths=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-numSteps")==0&&i+1<argc)
+			numSteps=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-stepSize")==0&&i+1<argc)
+			stepSize=Scalar(atof(argv[++i]));
+		else
+			{
+			std::cerr<<"Usage: "<<argv[0]<<" [-numCells <cells per axis>] [-shear <factor>] [-warp <cell size fraction>] [-numPaths <num>] [-numSteps <num>] [-stepSize <cell size fraction>]"<<std::endl;
+			return 1;
+			}
+		}
+	if(numCells<1||numPaths<1||numSteps<1||warp<Scalar(0)||warp>=Scalar(0.5)||!(stepSize>Scalar(0)))
+		{
+		std::cerr<<"Invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a sheared and warped grid whose values are a linear function of grid index space: */
+	DataSet::Index numVertices(numCells+1,numCells+1,numCells+1);
+	size_t totalNumVertices=numVertices.calcIncrement(-1);
+	Point* positions=new Point[totalNumVertices];
+	float* vertexValues=new float[totalNumVertices];
+	Point* pPtr=positions;
+	float* valPtr=vertexValues;
+	for(DataSet::Index index(0);index[0]<numVertices[0];index.preInc(numVertices),++pPtr,++valPtr)
+		{
+		Scalar c[3];
+		for(int i=0;i<3;++i)
+			c[i]=Scalar(index[i]);
+		*pPtr=warpPoint(c,shear,warp);
+		*valPtr=float(c[0]+Scalar(2)*c[1]+Scalar(3)*c[2]);
+		}
+	
+	/* Finalize the grid without cached affine approximations, and measure point location: */
+	DataSet dataSet;
+	dataSet.setCacheCellGeometries(false);
+	Misc::Timer finalizeTimer;
+	dataSet.setData(numVertices,positions,vertexValues);
+	finalizeTimer.elapse();
+	delete[] positions;
+	delete[] vertexValues;
+	std::cout<<"Cells: "<<dataSet.getTotalNumCells()<<" hexahedra, paths: "<<numPaths<<", steps per path: "<<numSteps<<std::endl;
+	std::cout<<"Grid finalization: "<<finalizeTimer.getTime()*1000.0<<" ms"<<std::endl;
+	std::vector<float> values(size_t(numPaths)*size_t(numSteps));
+	TraceResult results[2];
+	try
+		{
+		results[0]=trace(dataSet,numCells,shear,warp,numPaths,numSteps,stepSize,values,true);
+		
+		/* Cache the cells' affine approximations, and measure point location again: */
+		Misc::Timer cacheTimer;
+		dataSet.setCacheCellGeometries(true);
+		cacheTimer.elapse();
+		std::cout<<"Cell geometry cache: "<<dataSet.getCellGeometryCacheSize()/1024<<" KB, built in "<<cacheTimer.getTime()*1000.0<<" ms"<<std::endl;
+		results[1]=trace(dataSet,numCells,shear,warp,numPaths,numSteps,stepSize,values,false);
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"Unable to locate points due to exception "<<err.what()<<std::endl;
+		return 1;
+		}
+	
+	/* Print the benchmark results: */
+	static const char* runNames[2]={"Without cache","With cache"};
+	for(int run=0;run<2;++run)
+		{
+		const TraceResult& r=results[run];
+		std::cout<<runNames[run]<<": "<<r.numFound<<'/'<<r.numLocates<<" points located in "<<r.time*1000.0<<" ms, ";
+		std::cout<<double(r.numLocates)/r.time*1.0e-6<<" Mlocates/s, ";
+		std::cout<<double(r.numNewtonRaphsonSteps)/double(r.numLocates)<<" Newton-Raphson steps per locate"<<std::endl;
+		}
+	std::cout<<"Max. value difference with cache: "<<results[1].maxDifference<<std::endl;
+	std::cout<<"Speed-up: "<<results[0].time/results[1].time<<std::endl;
+	
+	return 0;
+	}
@@ -0,0 +1,118 @@
+/***********************************************************************
+ElementArchive - Class to read and write element archive files, which
+store the extraction parameters and extracted geometry of visualization
+elements in chunks that can be located and loaded individually.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include "ElementArchive.h"
+
+#include <string.h>
+#include <Misc/StdError.h>
+#include <IO/OpenFile.h>
+
+/***************************************
+Static elements of class ElementArchive:
+***************************************/
+
+const char ElementArchive::fileId[32]={'3','D','V','i','s','u','a','l','i','z','e','r',' ','e','l','e','m','e','n','t',' ','a','r','c','h','i','v','e',' ','1','.','0'};
+const ElementArchive::Offset ElementArchive::chunkAlignment;
+
+/*******************************
+Methods of class ElementArchive:
+*******************************/
+
+ElementArchive::ElementArchive(const char* archiveFileName)
+	:file(IO::openSeekableFile(archiveFileName))
+	{
+	file->setEndianness(Misc::LittleEndian);
+	
+	/* Check the file identifier: */
+	char id[sizeof(fileId)];
+	file->read(id,sizeof(fileId));
+	if(memcmp(id,fileId,sizeof(fileId))!=0)
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"File %s is not an element archive",archiveFileName);
+	
+	/* Read the number of elements and the parameter format version; archives written before the version was recorded have a zero there and use the first version: */
+	unsigned int numElements=file->read<Misc::UInt32>();
+	parametersVersion=file->read<Misc::UInt32>();
+	if(parametersVersion==0)
+		parametersVersion=1;
+	
+	/* Read the element directory: */
+	elements.reserve(numElements);
+	Offset fileSize=file->getSize();
+	for(unsigned int i=0;i<numElements;++i)
+		{
+		ElementEntry entry;
+		entry.offset=file->read<Misc::UInt64>();
+		entry.geometryOffset=file->read<Misc::UInt64>();
+		entry.geometrySize=file->read<Misc::UInt64>();
+		
+		/* Check the element's chunk against the file size to detect truncated archives: */
+		if(entry.offset==0||Offset(entry.offset)>=fileSize||Offset(entry.geometryOffset+entry.geometrySize)>fileSize)
+			throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Element archive %s is truncated or corrupted",archiveFileName);
+		
+		elements.push_back(entry);
+		}
+	}
+
+void ElementArchive::writeHeader(IO::SeekableFile& archive,unsigned int numElements,unsigned int parametersVersion)
+	{
+	/* Write the file identifier, the number of elements, and the parameter format version: */
+	archive.write(fileId,sizeof(fileId));
+	archive.write<Misc::UInt32>(numElements);
+	archive.write<Misc::UInt32>(parametersVersion);
+	
+	/* Write an empty element directory: */
+	for(unsigned int i=0;i<numElements*3;++i)
+		archive.write<Misc::UInt64>(0);
+	}
+
+void ElementArchive::alignChunk(IO::SeekableFile& archive)
+	{
+	/* Write zero bytes up to the next multiple of the chunk alignment: */
+	for(Offset pos=archive.getWritePos();pos%chunkAlignment!=0;++pos)
+		archive.write<Misc::UInt8>(0);
+	}
+
+void ElementArchive::writeDirectory(IO::SeekableFile& archive,const std::vector<ElementArchive::ElementEntry>& elements)
+	{
+	/* Overwrite the element directory following the file header: */
+	archive.setWritePosAbs(sizeof(fileId)+2*sizeof(Misc::UInt32));
+	for(std::vector<ElementEntry>::const_iterator eIt=elements.begin();eIt!=elements.end();++eIt)
+		{
+		archive.write<Misc::UInt64>(eIt->offset);
+		archive.write<Misc::UInt64>(eIt->geometryOffset);
+		archive.write<Misc::UInt64>(eIt->geometrySize);
+		}
+	}
+
+IO::File& ElementArchive::seekElement(unsigned int elementIndex)
+	{
+	file->setReadPosAbs(elements[elementIndex].offset);
+	return *file;
+	}
+
+IO::File& ElementArchive::seekGeometry(unsigned int elementIndex)
+	{
+	file->setReadPosAbs(elements[elementIndex].geometryOffset);
+	return *file;
+	}
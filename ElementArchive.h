@@ -0,0 +1,93 @@
+/***********************************************************************
+ElementArchive - Class to read and write element archive files, which
+store the extraction parameters and extracted geometry of visualization
+elements in chunks that can be located and loaded individually.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef ELEMENTARCHIVE_INCLUDED
+#define ELEMENTARCHIVE_INCLUDED
+
+#include <vector>
+#include <Misc/SizedTypes.h>
+#include <IO/SeekableFile.h>
+
+class ElementArchive
+	{
+	/* Embedded classes: */
+	public:
+	typedef IO::SeekableFile::Offset Offset; // Type for file positions
+	
+	struct ElementEntry // Structure describing an element's chunk in the archive's element directory
+		{
+		/* Elements: */
+		public:
+		Misc::UInt64 offset; // File position of the element's chunk containing its algorithm name and extraction parameters
+		Misc::UInt64 geometryOffset; // File position of the element's geometry, or 0 if the element has to be extracted from its parameters
+		Misc::UInt64 geometrySize; // Size of the element's geometry in bytes
+		
+		/* Constructors and destructors: */
+		ElementEntry(void)
+			:offset(0),geometryOffset(0),geometrySize(0)
+			{
+			}
+		};
+	
+	/* Elements: */
+	static const char fileId[32]; // Identifier at the beginning of element archive files
+	static const Offset chunkAlignment=16; // Alignment of element chunks and geometry blocks in bytes
+	private:
+	IO::SeekableFilePtr file; // The archive file
+	unsigned int parametersVersion; // Version of the binary parameter format of the archive's element chunks
+	std::vector<ElementEntry> elements; // The archive's element directory
+	
+	/* Constructors and destructors: */
+	public:
+	ElementArchive(const char* archiveFileName); // Opens the element archive of the given name and reads its element directory
+	
+	/* Methods: */
+	static void writeHeader(IO::SeekableFile& archive,unsigned int numElements,unsigned int parametersVersion); // Writes an archive header for element chunks using the given binary parameter format version, and an empty element directory for the given number of elements, to the given file
+	static void alignChunk(IO::SeekableFile& archive); // Pads the given file to the beginning of the next chunk
+	static void writeDirectory(IO::SeekableFile& archive,const std::vector<ElementEntry>& elements); // Overwrites the element directory written by writeHeader with the given element entries
+	unsigned int getParametersVersion(void) const // Returns the version of the binary parameter format of the archive's element chunks
+		{
+		return parametersVersion;
+		}
+	unsigned int getNumElements(void) const // Returns the number of elements in the archive
+		{
+		return (unsigned int)(elements.size());
+		}
+	const ElementEntry& getElement(unsigned int elementIndex) const // Returns the directory entry of the given element
+		{
+		return elements[elementIndex];
+		}
+	bool hasGeometry(unsigned int elementIndex) const // Returns true if the archive contains the given element's geometry
+		{
+		return elements[elementIndex].geometryOffset!=0;
+		}
+	IO::File& getFile(void) // Returns the archive file
+		{
+		return *file;
+		}
+	IO::File& seekElement(unsigned int elementIndex); // Positions the archive file at the beginning of the given element's chunk and returns it
+	IO::File& seekGeometry(unsigned int elementIndex); // Positions the archive file at the beginning of the given element's geometry and returns it
+	};
+
+#endif
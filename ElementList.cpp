@@ -1,7 +1,7 @@
 /***********************************************************************
 ElementList - Class to manage a list of previously extracted
 visualization elements.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -27,6 +27,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/File.h>
 #include <IO/File.h>
 #include <IO/OpenFile.h>
+#include <IO/SeekableFile.h>
 #include <GLMotif/PopupWindow.h>
 #include <GLMotif/RowColumn.h>
 #include <GLMotif/Margin.h>
@@ -41,6 +42,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/FileParametersSink.h>
 #include <Abstract/Element.h>
 
+#include "ElementArchive.h"
+
 #if VISUALIZATION_CONFIG_USE_COLLABORATION
 #include "SharedVisualizationClient.h"
 #endif
@@ -189,6 +192,9 @@ void ElementList::deleteElementSelectedCallback(Misc::CallbackData* cbData)
 		
 		#endif
 		
+		/* Notify the visualization element's creators that it is being deleted: */
+		elements[selectedElementIndex].element->notifyRemoved();
+		
 		/* Remove the visualization element from Vrui's scene graph if it was visible: */
 		if(elements[selectedElementIndex].show)
 			Vrui::getSceneGraphManager()->removeNavigationalNode(*elements[selectedElementIndex].element);
@@ -289,6 +295,9 @@ void ElementList::clear(void)
 		
 		#endif
 		
+		/* Notify the visualization element's creators that it is being deleted: */
+		eIt->element->notifyRemoved();
+		
 		/* Remove the visualization element from Vrui's scene graph if it was visible: */
 		if(eIt->show)
 			Vrui::getSceneGraphManager()->removeNavigationalNode(*eIt->element);
@@ -387,6 +396,9 @@ void ElementList::deleteElement(ElementList::Element* element,bool fromSharedVis
 		
 		#endif
 		
+		/* Notify the visualization element's creators that it is being deleted: */
+		element->notifyRemoved();
+		
 		/* Remove the visualization element from Vrui's scene graph if it was visible: */
 		if(elements[elementIndex].show)
 			Vrui::getSceneGraphManager()->removeNavigationalNode(*element);
@@ -432,6 +444,10 @@ void ElementList::saveElements(const char* elementFileName,bool ascii,const Visu
 		elementFile->setEndianness(Misc::LittleEndian);
 		Visualization::Abstract::BinaryParametersSink sink(variableManager,*elementFile,false);
 		
+		/* Write the binary parameter format version in place of an algorithm name: */
+		Misc::Marshaller<std::string>::write(Visualization::Abstract::BinaryParametersSink::versionTag,*elementFile);
+		elementFile->write<Misc::UInt32>(Visualization::Abstract::BinaryParametersSink::formatVersion);
+		
 		/* Save all visible visualization elements: */
 		for(ListElementList::const_iterator veIt=elements.begin();veIt!=elements.end();++veIt)
 			if(veIt->show)
@@ -444,3 +460,45 @@ void ElementList::saveElements(const char* elementFileName,bool ascii,const Visu
 				}
 		}
 	}
+
+void ElementList::saveElementArchive(const char* archiveFileName,const Visualization::Abstract::VariableManager* variableManager) const
+	{
+	/* Collect all visible visualization elements: */
+	std::vector<const ListElement*> savedElements;
+	for(ListElementList::const_iterator veIt=elements.begin();veIt!=elements.end();++veIt)
+		if(veIt->show)
+			savedElements.push_back(&*veIt);
+	
+	/* Create an element archive and write its header: */
+	IO::SeekableFilePtr archive(IO::openSeekableFile(archiveFileName,IO::File::WriteOnly));
+	archive->setEndianness(Misc::LittleEndian);
+	ElementArchive::writeHeader(*archive,(unsigned int)(savedElements.size()),Visualization::Abstract::BinaryParametersSink::formatVersion);
+	Visualization::Abstract::BinaryParametersSink sink(variableManager,*archive,false);
+	
+	/* Write each element into its own chunk: */
+	std::vector<ElementArchive::ElementEntry> entries;
+	for(std::vector<const ListElement*>::iterator seIt=savedElements.begin();seIt!=savedElements.end();++seIt)
+		{
+		ElementArchive::ElementEntry entry;
+		
+		/* Write the element's name and parameters: */
+		ElementArchive::alignChunk(*archive);
+		entry.offset=archive->getWritePos();
+		Misc::Marshaller<std::string>::write((*seIt)->name,*archive);
+		(*seIt)->element->getParameters()->write(sink);
+		
+		/* Write the element's geometry if it can be written: */
+		if((*seIt)->element->getGeometrySize()>0)
+			{
+			ElementArchive::alignChunk(*archive);
+			entry.geometryOffset=archive->getWritePos();
+			(*seIt)->element->writeGeometry(*archive);
+			entry.geometrySize=archive->getWritePos()-ElementArchive::Offset(entry.geometryOffset);
+			}
+		
+		entries.push_back(entry);
+		}
+	
+	/* Write the final element directory: */
+	ElementArchive::writeDirectory(*archive,entries);
+	}
@@ -1,7 +1,7 @@
 /***********************************************************************
 ElementList - Class to manage a list of previously extracted
 visualization elements.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -112,6 +112,7 @@ class ElementList
 	void setElementVisible(Element* element,bool newVisible,bool fromSharedVisualizationClient =false); // Shows or hides the given visualization element
 	void deleteElement(Element* element,bool fromSharedVisualizationClient =false); // Deletes the given visualization element
 	void saveElements(const char* elementFileName,bool ascii,const Visualization::Abstract::VariableManager* variableManager) const; // Saves all visible visualization elements to the given file
+	void saveElementArchive(const char* archiveFileName,const Visualization::Abstract::VariableManager* variableManager) const; // Saves all visible visualization elements and the geometry of those that support it to the given element archive
 	GLMotif::PopupWindow* getElementListDialog(void) // Returns the element list dialog
 		{
 		return elementListDialogPopup;
@@ -0,0 +1,419 @@
+/***********************************************************************
+ElementLoader - Class to load visualization elements from element files
+by extracting independent elements concurrently in background jobs,
+while adding them to the element list in file order on all nodes of a
+cluster.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include "ElementLoader.h"
+
+#include <stdexcept>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Misc/StandardMarshallers.h>
+#include <IO/File.h>
+#include <IO/SeekableFile.h>
+#include <IO/OpenFile.h>
+#include <IO/ValueSource.h>
+#include <Threads/FunctionCalls.h>
+#include <Cluster/MulticastPipe.h>
+#include <Vrui/Vrui.h>
+
+#include <Abstract/Parameters.h>
+#include <Abstract/FileParametersSource.h>
+#include <Abstract/BinaryParametersSink.h>
+#include <Abstract/BinaryParametersSource.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+#include <Abstract/Module.h>
+
+#include "ElementList.h"
+
+/***************************************
+Methods of class ElementLoader::LoadJob:
+***************************************/
+
+ElementLoader::LoadJob::~LoadJob(void)
+	{
+	/* Delete the extraction parameters if the job never ran, and the algorithm: */
+	delete parameters;
+	delete algorithm;
+	}
+
+void ElementLoader::LoadJob::run(int)
+	{
+	/* Bail out if the job was cancelled before it started: */
+	{
+	Threads::MutexCond::Lock runStateLock(runStateCond);
+	if(runState==CANCELLED)
+		return;
+	runState=RUNNING;
+	}
+	
+	Misc::Timer loadTimer;
+	
+	/* The algorithm inherits the extraction parameters: */
+	Parameters* extractParameters=parameters;
+	parameters=0;
+	try
+		{
+		if(algorithm->isMaster())
+			{
+			if(!archiveFileName.empty())
+				{
+				/* Open a private view of the element archive and read the element's geometry: */
+				IO::SeekableFilePtr archive(IO::openSeekableFile(archiveFileName.c_str()));
+				archive->setEndianness(Misc::LittleEndian);
+				archive->setReadPosAbs(geometryOffset);
+				element=algorithm->readElement(extractParameters,*archive);
+				}
+			else
+				{
+				/* Extract the element: */
+				element=algorithm->createElement(extractParameters);
+				}
+			}
+		else
+			{
+			/* Receive the element from the master through the algorithm's pipe: */
+			element=algorithm->startSlaveElement(extractParameters);
+			algorithm->continueSlaveElement();
+			}
+		}
+	catch(const std::runtime_error& err)
+		{
+		/* Remember the error to report it from the main thread: */
+		error=err.what();
+		}
+	
+	loadTimer.elapse();
+	loadTime=loadTimer.getTime();
+	
+	/* Wake up a loader waiting for the job in its destructor: */
+	Threads::MutexCond::Lock runStateLock(runStateCond);
+	runState=DONE;
+	runStateCond.broadcast();
+	}
+
+void ElementLoader::LoadJob::complete(Threads::WorkerPool::JobFunction* job)
+	{
+	if(loader!=0)
+		{
+		/* Add the element to the element list once all preceding jobs have finished: */
+		finished=true;
+		loader->addFinishedElements();
+		}
+	else
+		{
+		/* The loader was destroyed while the job was outstanding; discard the job: */
+		delete this;
+		}
+	}
+
+/******************************
+Methods of class ElementLoader:
+******************************/
+
+ElementLoader::Algorithm* ElementLoader::createAlgorithm(const std::string& algorithmName,Cluster::MulticastPipe* pipe)
+	{
+	if(pipe!=0)
+		{
+		/* Send the algorithm name to the cluster: */
+		Misc::Marshaller<std::string>::write(algorithmName,*pipe);
+		}
+	
+	/* Create an extractor for the given name with its own pipe, so that elements can be sent to the cluster concurrently: */
+	Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
+	Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
+	if(algorithm==0)
+		{
+		std::cout<<"Ignoring unknown algorithm "<<algorithmName<<std::endl;
+		delete algorithmPipe;
+		}
+	
+	return algorithm;
+	}
+
+void ElementLoader::submitElement(const std::string& algorithmName,ElementLoader::Algorithm* algorithm,Visualization::Abstract::ParametersSource& source,Cluster::MulticastPipe* pipe,Visualization::Abstract::ParametersSink& sink,const char* archiveFileName,ElementArchive::Offset geometryOffset)
+	{
+	/* Read the element's extraction parameters: */
+	Parameters* parameters=algorithm->cloneParameters();
+	try
+		{
+		parameters->read(source);
+		}
+	catch(const std::runtime_error& err)
+		{
+		if(pipe!=0)
+			{
+			/* Tell the cluster there was a problem: */
+			pipe->write<int>(0);
+			pipe->flush();
+			}
+		
+		std::cout<<"Ignoring "<<algorithmName<<" due to exception "<<err.what()<<std::endl;
+		delete parameters;
+		delete algorithm;
+		return;
+		}
+	
+	if(pipe!=0)
+		{
+		/* Send the extraction parameters to the cluster: */
+		pipe->write<int>(1);
+		parameters->write(sink);
+		pipe->flush();
+		}
+	
+	/* Submit a job to load the element: */
+	LoadJob* job=new LoadJob(this,algorithmName,algorithm,parameters);
+	if(archiveFileName!=0)
+		{
+		job->archiveFileName=archiveFileName;
+		job->geometryOffset=geometryOffset;
+		}
+	submitJob(job);
+	}
+
+void ElementLoader::submitJob(ElementLoader::LoadJob* job)
+	{
+	/* Queue the job to add its element in order, and submit it to Vrui's worker pool: */
+	jobs.push_back(job);
+	Vrui::submitJob(*Threads::createFunctionCall(job,&LoadJob::run),*Threads::createFunctionCall(job,&LoadJob::complete));
+	}
+
+void ElementLoader::addFinishedElements(void)
+	{
+	/* Add the elements of all finished jobs at the front of the queue to the element list, to keep the element list's order identical on all cluster nodes: */
+	while(!jobs.empty()&&jobs.front()->finished)
+		{
+		LoadJob* lj=jobs.front();
+		jobs.pop_front();
+		
+		if(lj->element!=0)
+			elementList->addElement(lj->algorithm,lj->element.getPointer());
+		
+		if(lj->algorithm->isMaster())
+			{
+			if(lj->element!=0)
+				std::cout<<(lj->archiveFileName.empty()?"Created ":"Read ")<<lj->algorithmName<<" in "<<lj->loadTime*1000.0<<" ms"<<std::endl;
+			else
+				std::cout<<"Cancelled "<<lj->algorithmName<<" due to exception "<<lj->error<<std::endl;
+			}
+		
+		delete lj;
+		}
+	}
+
+ElementLoader::ElementLoader(ElementLoader::Module* sModule,ElementLoader::VariableManager* sVariableManager,ElementList* sElementList)
+	:module(sModule),variableManager(sVariableManager),elementList(sElementList)
+	{
+	}
+
+ElementLoader::~ElementLoader(void)
+	{
+	for(std::deque<LoadJob*>::iterator jIt=jobs.begin();jIt!=jobs.end();++jIt)
+		{
+		LoadJob* job=*jIt;
+		if(job->finished)
+			{
+			/* Delete the finished job, whose element was not yet added: */
+			delete job;
+			}
+		else
+			{
+			{
+			Threads::MutexCond::Lock runStateLock(job->runStateCond);
+			
+			/* Cancel the job if it has not started yet, unless it is part of a cluster where all nodes must load the same elements: */
+			if(job->runState==LoadJob::QUEUED&&job->algorithm->getPipe()==0)
+				job->runState=LoadJob::CANCELLED;
+			
+			/* Wait for the job if it is still loading its element: */
+			while(job->runState==LoadJob::QUEUED||job->runState==LoadJob::RUNNING)
+				job->runStateCond.wait(runStateLock);
+			}
+			
+			/* Release the job's results and resources now, as its completion function is not called for jobs still queued when Vrui shuts down: */
+			job->element=0;
+			delete job->parameters;
+			job->parameters=0;
+			delete job->algorithm;
+			job->algorithm=0;
+			
+			/* Hand the remaining job structure to its completion function, which will delete it: */
+			job->loader=0;
+			}
+		}
+	}
+
+void ElementLoader::loadElements(const char* elementFileName,ElementLoader::FileFormat format)
+	{
+	/* Open a pipe for cluster communication: */
+	Cluster::MulticastPipe* pipe=Vrui::openPipe();
+	
+	if(pipe==0||pipe->isMaster())
+		{
+		try
+			{
+			/* Create a data sink to send element parameters to the cluster: */
+			Visualization::Abstract::BinaryParametersSink sink(variableManager,*pipe,true);
+			
+			if(format==ASCII_ELEMENTS)
+				{
+				/* Open the element file: */
+				IO::ValueSource elementFile(IO::openFile(elementFileName));
+				elementFile.setPunctuation("");
+				elementFile.setQuotes("\"");
+				elementFile.skipWs();
+				
+				/* Read all elements from the file: */
+				while(!elementFile.eof())
+					{
+					/* Read the next algorithm name and create an extractor for it: */
+					std::string algorithmName=elementFile.readLine();
+					elementFile.skipWs();
+					Algorithm* algorithm=createAlgorithm(algorithmName,pipe);
+					
+					/* Read the element's extraction parameters from the file and load the element: */
+					if(algorithm!=0)
+						{
+						Visualization::Abstract::FileParametersSource source(variableManager,elementFile);
+						submitElement(algorithmName,algorithm,source,pipe,sink,0,0);
+						}
+					}
+				}
+			else if(format==BINARY_ELEMENTS)
+				{
+				/* Open the element file and create a data source to read from it: */
+				IO::FilePtr elementFile(IO::openFile(elementFileName));
+				elementFile->setEndianness(Misc::LittleEndian);
+				Visualization::Abstract::BinaryParametersSource source(variableManager,*elementFile,false);
+				
+				/* Read files without a version tag using the first binary parameter format: */
+				source.setVersion(1);
+				
+				/* Read all elements from the file: */
+				while(!elementFile->eof())
+					{
+					/* Read the next algorithm name: */
+					std::string algorithmName=Misc::Marshaller<std::string>::read(*elementFile);
+					if(algorithmName==Visualization::Abstract::BinaryParametersSink::versionTag)
+						{
+						/* Read the file's binary parameter format version: */
+						source.setVersion(elementFile->read<Misc::UInt32>());
+						}
+					else
+						{
+						/* Create an extractor for the algorithm, read the element's extraction parameters from the file, and load the element: */
+						Algorithm* algorithm=createAlgorithm(algorithmName,pipe);
+						if(algorithm!=0)
+							submitElement(algorithmName,algorithm,source,pipe,sink,0,0);
+						}
+					}
+				}
+			else
+				{
+				/* Open the element archive and create a data source to read from it: */
+				ElementArchive archive(elementFileName);
+				Visualization::Abstract::BinaryParametersSource source(variableManager,archive.getFile(),false);
+				source.setVersion(archive.getParametersVersion());
+				
+				/* Read all elements from the archive: */
+				for(unsigned int elementIndex=0;elementIndex<archive.getNumElements();++elementIndex)
+					{
+					/* Read the next algorithm name from the element's chunk and create an extractor for it: */
+					std::string algorithmName=Misc::Marshaller<std::string>::read(archive.seekElement(elementIndex));
+					Algorithm* algorithm=createAlgorithm(algorithmName,pipe);
+					
+					/* Read the element's extraction parameters from the archive and read the element's geometry, or extract the element if the archive doesn't contain its geometry: */
+					if(algorithm!=0)
+						{
+						if(archive.hasGeometry(elementIndex))
+							submitElement(algorithmName,algorithm,source,pipe,sink,elementFileName,ElementArchive::Offset(archive.getElement(elementIndex).geometryOffset));
+						else
+							submitElement(algorithmName,algorithm,source,pipe,sink,0,0);
+						}
+					}
+				}
+			}
+		catch(const std::runtime_error& err)
+			{
+			if(pipe!=0)
+				{
+				/* Signal end-of-file to the cluster and close the communication pipe: */
+				Misc::Marshaller<std::string>::write("",*pipe);
+				pipe->flush();
+				delete pipe;
+				}
+			
+			throw;
+			}
+		
+		if(pipe!=0)
+			{
+			/* Send an empty algorithm name to signal end-of-file to the cluster: */
+			Misc::Marshaller<std::string>::write("",*pipe);
+			pipe->flush();
+			}
+		}
+	else
+		{
+		/* Create a data source to read elements' parameters: */
+		Visualization::Abstract::BinaryParametersSource source(variableManager,*pipe,true);
+		
+		/* Receive all visualization elements' parameters from the head node: */
+		while(true)
+			{
+			/* Receive the algorithm name from the head node: */
+			std::string algorithmName=Misc::Marshaller<std::string>::read(*pipe);
+			if(algorithmName.empty()) // Check for end-of-file indicator
+				break;
+			
+			/* Create an extractor for the given name: */
+			Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
+			Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
+			if(algorithm!=0)
+				{
+				/* Check if there are valid parameters: */
+				if(pipe->read<int>()!=0)
+					{
+					/* Receive the extraction parameters: */
+					Parameters* parameters=algorithm->cloneParameters();
+					parameters->read(source);
+					
+					/* Submit a job to receive the element: */
+					submitJob(new LoadJob(this,algorithmName,algorithm,parameters));
+					}
+				else
+					delete algorithm;
+				}
+			else
+				delete algorithmPipe;
+			}
+		}
+	
+	if(pipe!=0)
+		{
+		/* Close the communication pipe: */
+		delete pipe;
+		}
+	}
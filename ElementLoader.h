@@ -0,0 +1,141 @@
+/***********************************************************************
+ElementLoader - Class to load visualization elements from element files
+by extracting independent elements concurrently in background jobs,
+while adding them to the element list in file order on all nodes of a
+cluster.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef ELEMENTLOADER_INCLUDED
+#define ELEMENTLOADER_INCLUDED
+
+#include <string>
+#include <deque>
+#include <Misc/Autopointer.h>
+#include <Threads/MutexCond.h>
+#include <Threads/WorkerPool.h>
+
+#include "ElementArchive.h"
+
+/* Forward declarations: */
+namespace Cluster {
+class MulticastPipe;
+}
+namespace Visualization {
+namespace Abstract {
+class VariableManager;
+class ParametersSink;
+class ParametersSource;
+class Parameters;
+class Algorithm;
+class Element;
+class Module;
+}
+}
+class ElementList;
+
+class ElementLoader
+	{
+	/* Embedded classes: */
+	public:
+	typedef Visualization::Abstract::VariableManager VariableManager;
+	typedef Visualization::Abstract::Parameters Parameters;
+	typedef Visualization::Abstract::Algorithm Algorithm;
+	typedef Visualization::Abstract::Element Element;
+	typedef Visualization::Abstract::Module Module;
+	
+	enum FileFormat // Enumerated type for element file formats
+		{
+		ASCII_ELEMENTS, // Text file of algorithm names and extraction parameters
+		BINARY_ELEMENTS, // Binary file of algorithm names and extraction parameters
+		ELEMENT_ARCHIVE // Element archive of algorithm names, extraction parameters, and extracted geometry
+		};
+	
+	private:
+	struct LoadJob // Structure describing a visualization element loaded in a background job
+		{
+		/* Embedded classes: */
+		public:
+		enum RunState // Enumerated type for states of the job function
+			{
+			QUEUED, // The job function has not started yet
+			RUNNING, // The job function is loading the element
+			DONE, // The job function returned after loading the element
+			CANCELLED // The job was cancelled before its job function started
+			};
+		
+		/* Elements: */
+		ElementLoader* loader; // Loader that submitted the job, or null if the loader was destroyed before the job completed
+		std::string algorithmName; // Name of the algorithm creating the element
+		Algorithm* algorithm; // Algorithm creating the element, with its own cluster pipe
+		Parameters* parameters; // Element's extraction parameters; inherited by the algorithm when the job runs
+		std::string archiveFileName; // Name of the element archive containing the element's geometry, or empty if the element is extracted
+		ElementArchive::Offset geometryOffset; // Position of the element's geometry in the element archive
+		Threads::MutexCond runStateCond; // Condition variable protecting the job function's state
+		RunState runState; // State of the job function
+		bool finished; // Flag whether the job completed in the main thread
+		Misc::Autopointer<Element> element; // The loaded element, or null if loading failed
+		std::string error; // Error message if loading failed
+		double loadTime; // Time spent loading the element in seconds
+		
+		/* Constructors and destructors: */
+		LoadJob(ElementLoader* sLoader,const std::string& sAlgorithmName,Algorithm* sAlgorithm,Parameters* sParameters)
+			:loader(sLoader),algorithmName(sAlgorithmName),algorithm(sAlgorithm),parameters(sParameters),
+			 geometryOffset(0),
+			 runState(QUEUED),finished(false),loadTime(0.0)
+			{
+			}
+		~LoadJob(void);
+		
+		/* Methods: */
+		void run(int); // Job function to extract, read, or receive the element, called from a background worker thread
+		void complete(Threads::WorkerPool::JobFunction* job); // Called from the main thread when the job function returned
+		};
+	
+	/* Elements: */
+	Module* module; // Visualization module creating algorithms
+	VariableManager* variableManager; // Manager for the data set's variables
+	ElementList* elementList; // List receiving loaded visualization elements
+	std::deque<LoadJob*> jobs; // Queue of submitted load jobs in file order; finished jobs are removed from the front once all preceding jobs finished
+	
+	/* Private methods: */
+	Algorithm* createAlgorithm(const std::string& algorithmName,Cluster::MulticastPipe* pipe); // Sends the given algorithm name to the cluster and creates the algorithm with its own cluster pipe; returns null if the algorithm is unknown
+	void submitElement(const std::string& algorithmName,Algorithm* algorithm,Visualization::Abstract::ParametersSource& source,Cluster::MulticastPipe* pipe,Visualization::Abstract::ParametersSink& sink,const char* archiveFileName,ElementArchive::Offset geometryOffset); // Reads an element's parameters from the given source, sends them to the cluster, and submits a job to load the element; inherits algorithm
+	void submitJob(LoadJob* job); // Queues the given job and submits it to the background worker pool
+	void addFinishedElements(void); // Adds the elements of all finished jobs at the front of the queue to the element list
+	
+	/* Constructors and destructors: */
+	public:
+	ElementLoader(Module* sModule,VariableManager* sVariableManager,ElementList* sElementList); // Creates an element loader for the given module and element list
+	private:
+	ElementLoader(const ElementLoader& source); // Prohibit copy constructor
+	ElementLoader& operator=(const ElementLoader& source); // Prohibit assignment operator
+	public:
+	~ElementLoader(void);
+	
+	/* Methods: */
+	void loadElements(const char* elementFileName,FileFormat format); // Starts loading all visualization elements defined in the given file of the given format; must be called on all nodes of a cluster
+	unsigned int getNumPendingElements(void) const // Returns the number of elements that have not yet been added to the element list
+		{
+		return (unsigned int)(jobs.size());
+		}
+	};
+
+#endif
@@ -0,0 +1,676 @@
+/***********************************************************************
+ExtractionBenchmark - Utility to measure data set loading and
+visualization element extraction performance of visualization modules
+outside of a Vrui environment, and to report results in machine-readable
+form to track performance across releases.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Config.h>
+
+#include <string.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <Misc/StdError.h>
+#include <Misc/Autopointer.h>
+#include <Misc/Time.h>
+#include <Misc/Timer.h>
+#include <Misc/StandardMarshallers.h>
+#include <Misc/FileNameExtensions.h>
+#include <IO/File.h>
+#include <IO/Directory.h>
+#include <IO/OpenFile.h>
+#include <IO/ValueSource.h>
+#include <Realtime/AlarmTimer.h>
+#include <Geometry/Point.h>
+#include <Plugins/FactoryManager.h>
+
+#include <Abstract/DataSet.h>
+#include <Abstract/VariableManager.h>
+#include <Abstract/ValueStatistics.h>
+#include <Abstract/Parameters.h>
+#include <Abstract/FileParametersSource.h>
+#include <Abstract/BinaryParametersSink.h>
+#include <Abstract/BinaryParametersSource.h>
+#include <Abstract/Algorithm.h>
+#include <Abstract/Element.h>
+#include <Abstract/Module.h>
+
+typedef Visualization::Abstract::DataSet DataSet;
+typedef DataSet::Scalar Scalar;
+typedef DataSet::Point Point;
+typedef Visualization::Abstract::VariableManager VariableManager;
+typedef Visualization::Abstract::ValueStatistics ValueStatistics;
+typedef Visualization::Abstract::Parameters Parameters;
+typedef Visualization::Abstract::Algorithm Algorithm;
+typedef Visualization::Abstract::Element Element;
+typedef Misc::Autopointer<Element> ElementPointer;
+typedef Visualization::Abstract::Module Module;
+typedef Plugins::FactoryManager<Module> ModuleManager;
+
+long getPeakRss(void) // Returns the process's peak resident set size in KB
+	{
+	struct rusage usage;
+	if(getrusage(RUSAGE_SELF,&usage)!=0)
+		return 0;
+	#ifdef __APPLE__
+	return long(usage.ru_maxrss/1024);
+	#else
+	return long(usage.ru_maxrss);
+	#endif
+	}
+
+void writeString(const char* string) // Writes the given string to stdout as a quoted and escaped JSON string
+	{
+	std::cout<<'"';
+	for(const char* sPtr=string;*sPtr!='\0';++sPtr)
+		{
+		if(*sPtr=='"'||*sPtr=='\\')
+			std::cout<<'\\'<<*sPtr;
+		else if((unsigned char)(*sPtr)<0x20U)
+			std::cout<<' ';
+		else
+			std::cout<<*sPtr;
+		}
+	std::cout<<'"';
+	}
+
+void writePoint(const Point& p) // Writes the given point to stdout as a JSON array
+	{
+	std::cout<<'['<<p[0]<<','<<p[1]<<','<<p[2]<<']';
+	}
+
+void writeStatistics(const char* type,const char* variableName,const ValueStatistics& statistics) // Writes the given variable statistics to stdout as a JSON record
+	{
+	std::cout<<"{\"record\":\"variableStatistics\",\"type\":\""<<type<<"\",\"variable\":";
+	writeString(variableName);
+	std::cout<<",\"numValues\":"<<statistics.getNumValues();
+	std::cout<<",\"min\":"<<statistics.getValueRange().first<<",\"max\":"<<statistics.getValueRange().second;
+	std::cout<<",\"mean\":"<<statistics.getMean()<<",\"stdDeviation\":"<<statistics.getStdDeviation();
+	
+	/* Write a set of commonly used percentiles: */
+	static const int percentiles[]={1,5,25,50,75,95,99};
+	std::cout<<",\"percentiles\":{";
+	for(int i=0;i<7;++i)
+		{
+		if(i>0)
+			std::cout<<',';
+		std::cout<<'"'<<percentiles[i]<<"\":"<<statistics.calcPercentile(double(percentiles[i])*0.01);
+		}
+	std::cout<<'}';
+	
+	/* Write the histogram: */
+	std::cout<<",\"histogramMin\":"<<statistics.getHistogramRange().first<<",\"histogramMax\":"<<statistics.getHistogramRange().second;
+	std::cout<<",\"histogram\":[";
+	for(unsigned int i=0;i<statistics.getNumBins();++i)
+		{
+		if(i>0)
+			std::cout<<',';
+		std::cout<<statistics.getBin(i);
+		}
+	std::cout<<"]}"<<std::endl;
+	}
+
+bool benchmarkElement(const char* source,Algorithm* algorithm,const char* variableName,const Point* seedPoint,double setupTime,double parameterTime,Parameters* parameters,unsigned int numRuns)
+	{
+	/* Repeatedly extract visualization elements from the given parameters: */
+	const char* status="ok";
+	std::string error;
+	unsigned int numExtractions=0;
+	double totalTime=0.0;
+	double minTime=0.0;
+	double maxTime=0.0;
+	size_t size=0;
+	if(parameters==0)
+		status="outside";
+	else if(!parameters->isValid())
+		status="invalid";
+	else
+		{
+		try
+			{
+			for(unsigned int run=0;run<numRuns;++run)
+				{
+				/* Extract an element from a copy of the parameters, which the algorithm inherits: */
+				Misc::Timer extractionTimer;
+				ElementPointer element(algorithm->createElement(parameters->clone()));
+				extractionTimer.elapse();
+				
+				/* Update the timing statistics: */
+				double time=extractionTimer.getTime();
+				totalTime+=time;
+				if(numExtractions==0||minTime>time)
+					minTime=time;
+				if(numExtractions==0||maxTime<time)
+					maxTime=time;
+				size=element->getSize();
+				++numExtractions;
+				}
+			}
+		catch(const std::runtime_error& err)
+			{
+			status="error";
+			error=err.what();
+			}
+		}
+	delete parameters;
+	
+	/* Write the element's benchmark record: */
+	std::cout<<"{\"record\":\"element\",\"source\":\""<<source<<"\",\"algorithm\":";
+	writeString(algorithm->getName());
+	if(variableName!=0)
+		{
+		std::cout<<",\"variable\":";
+		writeString(variableName);
+		}
+	if(seedPoint!=0)
+		{
+		std::cout<<",\"seed\":";
+		writePoint(*seedPoint);
+		}
+	std::cout<<",\"status\":\""<<status<<'"';
+	if(!error.empty())
+		{
+		std::cout<<",\"error\":";
+		writeString(error.c_str());
+		}
+	std::cout<<",\"runs\":"<<numExtractions;
+	std::cout<<",\"setupTime\":"<<setupTime*1000.0<<",\"parameterTime\":"<<parameterTime*1000.0;
+	if(numExtractions>0)
+		std::cout<<",\"extractTime\":"<<totalTime*1000.0/double(numExtractions)<<",\"minExtractTime\":"<<minTime*1000.0<<",\"maxExtractTime\":"<<maxTime*1000.0;
+	std::cout<<",\"size\":"<<size<<",\"peakRss\":"<<getPeakRss()<<'}'<<std::endl;
+	
+	/* Report progress on the console: */
+	std::cerr<<algorithm->getName()<<": "<<status;
+	if(numExtractions>0)
+		std::cerr<<", "<<size<<" in "<<totalTime*1000.0/double(numExtractions)<<" ms";
+	if(!error.empty())
+		std::cerr<<" ("<<error<<')';
+	std::cerr<<std::endl;
+	
+	return strcmp(status,"error")!=0;
+	}
+
+bool checkElementReuse(Algorithm* algorithm,const char* variableName,DataSet::Locator* locator,const Point& seedPoint,Scalar nudge)
+	{
+	/* Incrementally extract an element from the seed point, and then from a slightly moved seed point, which should reuse the first element: */
+	const char* status="ok";
+	std::string error;
+	bool reused=false;
+	double reuseTime=0.0;
+	try
+		{
+		for(int pass=0;pass<2&&strcmp(status,"ok")==0;++pass)
+			{
+			Point p=seedPoint;
+			if(pass==1)
+				p[0]+=nudge;
+			locator->setPosition(p);
+			if(locator->isValid())
+				{
+				/* Run the algorithm's incremental creation methods to completion: */
+				Misc::Timer extractionTimer;
+				algorithm->setSeedLocator(locator);
+				ElementPointer element(algorithm->startElement(algorithm->cloneParameters()));
+				Realtime::AlarmTimer alarm;
+				alarm.armTimer(Misc::Time(3600.0));
+				while(!algorithm->continueElement(alarm))
+					;
+				bool elementReused=algorithm->isElementReused();
+				algorithm->finishElement();
+				extractionTimer.elapse();
+				
+				if(pass==1)
+					{
+					reused=elementReused;
+					reuseTime=extractionTimer.getTime();
+					}
+				}
+			else
+				status="outside";
+			}
+		}
+	catch(const std::runtime_error& err)
+		{
+		status="error";
+		error=err.what();
+		}
+	
+	/* Write the reuse check's record: */
+	std::cout<<"{\"record\":\"reuse\",\"algorithm\":";
+	writeString(algorithm->getName());
+	std::cout<<",\"variable\":";
+	writeString(variableName);
+	std::cout<<",\"seed\":";
+	writePoint(seedPoint);
+	std::cout<<",\"status\":\""<<status<<'"';
+	if(!error.empty())
+		{
+		std::cout<<",\"error\":";
+		writeString(error.c_str());
+		}
+	std::cout<<",\"reused\":"<<(reused?"true":"false")<<",\"reuseTime\":"<<reuseTime*1000.0<<'}'<<std::endl;
+	
+	/* Report the check's result on the console: */
+	std::cerr<<algorithm->getName()<<" reuse: "<<status;
+	if(strcmp(status,"ok")==0)
+		std::cerr<<", "<<(reused?"reused":"not reused")<<" in "<<reuseTime*1000.0<<" ms";
+	if(!error.empty())
+		std::cerr<<" ("<<error<<')';
+	std::cerr<<std::endl;
+	
+	return strcmp(status,"error")!=0&&(strcmp(status,"ok")!=0||reused);
+	}
+
+bool benchmarkAlgorithm(Algorithm* algorithm,double setupTime,const char* variableName,DataSet::Locator* locator,const std::vector<Point>& seedPoints,Scalar seedNudge,unsigned int numRuns)
+	{
+	bool ok=true;
+	if(algorithm->hasSeededCreator())
+		{
+		/* Extract one element from each seed point: */
+		for(std::vector<Point>::const_iterator spIt=seedPoints.begin();spIt!=seedPoints.end();++spIt)
+			{
+			/* Seed the algorithm's parameters: */
+			Misc::Timer parameterTimer;
+			Parameters* parameters=0;
+			locator->setPosition(*spIt);
+			if(locator->isValid())
+				{
+				algorithm->setSeedLocator(locator);
+				parameters=algorithm->cloneParameters();
+				}
+			parameterTimer.elapse();
+			
+			ok=benchmarkElement("seed",algorithm,variableName,&*spIt,setupTime,parameterTimer.getTime(),parameters,numRuns)&&ok;
+			}
+		
+		/* Check that algorithms reusing elements actually reuse them for nearby seed points: */
+		if(algorithm->hasIncrementalCreator()&&algorithm->hasElementReuse())
+			ok=checkElementReuse(algorithm,variableName,locator,seedPoints.front(),seedNudge)&&ok;
+		}
+	else
+		{
+		/* Extract one element from the algorithm's default parameters: */
+		Misc::Timer parameterTimer;
+		Parameters* parameters=algorithm->cloneParameters();
+		parameterTimer.elapse();
+		
+		ok=benchmarkElement("global",algorithm,variableName,0,setupTime,parameterTimer.getTime(),parameters,numRuns);
+		}
+	
+	return ok;
+	}
+
+bool benchmarkElementFile(const char* elementFileName,const Module* module,VariableManager* variableManager,unsigned int numRuns)
+	{
+	bool ok=true;
+	if(Misc::hasCaseExtension(elementFileName,".asciielem"))
+		{
+		/* Open the element file: */
+		IO::ValueSource elementFile(IO::openFile(elementFileName));
+		elementFile.setPunctuation("");
+		elementFile.setQuotes("\"");
+		elementFile.skipWs();
+		
+		/* Read all elements from the file: */
+		while(!elementFile.eof())
+			{
+			/* Read the next algorithm name: */
+			std::string algorithmName=elementFile.readLine();
+			elementFile.skipWs();
+			
+			/* Create an extractor for the given name: */
+			Misc::Timer setupTimer;
+			Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,0);
+			setupTimer.elapse();
+			if(algorithm==0)
+				throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unknown algorithm %s in element file %s",algorithmName.c_str(),elementFileName);
+			
+			/* Read the element's extraction parameters from the file: */
+			Misc::Timer parameterTimer;
+			Visualization::Abstract::FileParametersSource source(variableManager,elementFile);
+			Parameters* parameters=algorithm->cloneParameters();
+			parameters->read(source);
+			parameterTimer.elapse();
+			
+			ok=benchmarkElement("file",algorithm,0,0,setupTimer.getTime(),parameterTimer.getTime(),parameters,numRuns)&&ok;
+			delete algorithm;
+			}
+		}
+	else if(Misc::hasCaseExtension(elementFileName,".binelem"))
+		{
+		/* Open the element file and create a data source to read from it: */
+		IO::FilePtr elementFile(IO::openFile(elementFileName));
+		elementFile->setEndianness(Misc::LittleEndian);
+		Visualization::Abstract::BinaryParametersSource source(variableManager,*elementFile,false);
+		
+		/* Read files without a version tag using the first binary parameter format: */
+		source.setVersion(1);
+		
+		/* Read all elements from the file: */
+		while(!elementFile->eof())
+			{
+			/* Read the next algorithm name, or the file's binary parameter format version: */
+			std::string algorithmName=Misc::Marshaller<std::string>::read(*elementFile);
+			if(algorithmName==Visualization::Abstract::BinaryParametersSink::versionTag)
+				source.setVersion(elementFile->read<Misc::UInt32>());
+			else
+				{
+				/* Create an extractor for the given name: */
+				Misc::Timer setupTimer;
+				Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,0);
+				setupTimer.elapse();
+				if(algorithm==0)
+					throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Unknown algorithm %s in element file %s",algorithmName.c_str(),elementFileName);
+				
+				/* Read the element's extraction parameters from the file: */
+				Misc::Timer parameterTimer;
+				Parameters* parameters=algorithm->cloneParameters();
+				parameters->read(source);
+				parameterTimer.elapse();
+				
+				ok=benchmarkElement("file",algorithm,0,0,setupTimer.getTime(),parameterTimer.getTime(),parameters,numRuns)&&ok;
+				delete algorithm;
+				}
+			}
+		}
+	else
+		throw Misc::makeStdErr(__PRETTY_FUNCTION__,"Element file %s has unknown type",elementFileName);
+	
+	return ok;
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	IO::DirectoryPtr baseDirectory=IO::Directory::getCurrent();
+	std::string moduleClassName;
+	std::vector<std::string> dataSetArgs;
+	unsigned int numRuns=1;
+	std::vector<Point> seedPoints;
+	const char* scalarVariableName=0;
+	const char* vectorVariableName=0;
+	std::vector<const char*> loadFileNames;
+	bool runAlgorithms=true;
+	bool calcStatistics=false;
+	unsigned int numStatisticsBins=0;
+	bool printUsage=false;
+	for(int i=1;i<argc&&!printUsage;++i)
+		{
+		if(argv[i][0]=='-')
+			{
+			if(strcasecmp(argv[i]+1,"class")==0&&i+1<argc)
+				{
+				/* Get visualization module class name and data set arguments from command line: */
+				++i;
+				moduleClassName=argv[i];
+				++i;
+				while(i<argc&&strcmp(argv[i],";")!=0)
+					{
+					dataSetArgs.push_back(argv[i]);
+					++i;
+					}
+				}
+			else if(strcasecmp(argv[i]+1,"numRuns")==0&&i+1<argc)
+				numRuns=atoi(argv[++i]);
+			else if(strcasecmp(argv[i]+1,"seed")==0&&i+3<argc)
+				{
+				Point seedPoint;
+				for(int j=0;j<3;++j)
+					seedPoint[j]=Scalar(atof(argv[i+1+j]));
+				seedPoints.push_back(seedPoint);
+				i+=3;
+				}
+			else if(strcasecmp(argv[i]+1,"scalarVariable")==0&&i+1<argc)
+				scalarVariableName=argv[++i];
+			else if(strcasecmp(argv[i]+1,"vectorVariable")==0&&i+1<argc)
+				vectorVariableName=argv[++i];
+			else if(strcasecmp(argv[i]+1,"load")==0&&i+1<argc)
+				loadFileNames.push_back(argv[++i]);
+			else if(strcasecmp(argv[i]+1,"noAlgorithms")==0)
+				runAlgorithms=false;
+			else if(strcasecmp(argv[i]+1,"statistics")==0)
+				calcStatistics=true;
+			else if(strcasecmp(argv[i]+1,"statisticsBins")==0&&i+1<argc)
+				{
+				calcStatistics=true;
+				numStatisticsBins=atoi(argv[++i]);
+				}
+			else
+				printUsage=true;
+			}
+		else
+			{
+			try
+				{
+				/* Set the base directory to the directory containing the meta-input file: */
+				baseDirectory=baseDirectory->openFileDirectory(argv[i]);
+				
+				/* Read the meta-input file of the given name: */
+				IO::ValueSource metaInputFile(IO::openFile(argv[i]));
+				metaInputFile.setPunctuation("#");
+				metaInputFile.skipWs();
+				
+				/* Read the module class name while skipping any comments: */
+				while((moduleClassName=metaInputFile.readString())=="#")
+					{
+					/* Skip the rest of the line: */
+					metaInputFile.skipLine();
+					metaInputFile.skipWs();
+					}
+				
+				/* Read the data set arguments: */
+				dataSetArgs.clear();
+				while(!metaInputFile.eof())
+					{
+					/* Read the next module argument: */
+					std::string argument=metaInputFile.readString();
+					
+					/* Check for comments: */
+					if(argument=="#")
+						{
+						/* Skip the rest of the line: */
+						metaInputFile.skipLine();
+						metaInputFile.skipWs();
+						}
+					else
+						{
+						/* Store the argument: */
+						dataSetArgs.push_back(argument);
+						}
+					}
+				}
+			catch(const std::runtime_error& err)
+				{
+				std::cerr<<"Unable to read meta-input file "<<argv[i]<<" due to exception "<<err.what()<<std::endl;
+				return 1;
+				}
+			}
+		}
+	if(printUsage||moduleClassName.empty()||dataSetArgs.empty()||numRuns<1)
+		{
+		std::cerr<<"Usage: "<<argv[0]<<" [-numRuns <num>] [-seed <x> <y> <z>]* [-scalarVariable <name>] [-vectorVariable <name>] [-load <element file>]* [-noAlgorithms] [-statistics] [-statisticsBins <num>] ( -class <module class name> <data set arguments> ; | <meta-input file name> )"<<std::endl;
+		return 1;
+		}
+	
+	Misc::Timer totalTimer;
+	
+	/* Load the visualization module and the data set: */
+	ModuleManager moduleManager(VISUALIZATION_CONFIG_MODULENAMETEMPLATE);
+	Module* module=0;
+	DataSet* dataSet=0;
+	Misc::Timer loadTimer;
+	try
+		{
+		/* Load the appropriate visualization module: */
+		module=moduleManager.loadClass(moduleClassName.c_str());
+		module->setBaseDirectory(baseDirectory);
+		
+		/* Load a data set without a cluster communication pipe: */
+		dataSet=module->load(dataSetArgs,0);
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"Could not load data set due to exception "<<err.what()<<std::endl;
+		return 1;
+		}
+	loadTimer.elapse();
+	
+	/* Write the load record: */
+	std::cout<<"{\"record\":\"load\",\"module\":";
+	writeString(moduleClassName.c_str());
+	DataSet::Box domain=dataSet->getDomainBox();
+	std::cout<<",\"domainMin\":";
+	writePoint(domain.min);
+	std::cout<<",\"domainMax\":";
+	writePoint(domain.max);
+	std::cout<<",\"loadTime\":"<<loadTimer.getTime()*1000.0<<",\"peakRss\":"<<getPeakRss()<<'}'<<std::endl;
+	
+	/* Create a variable manager without user interface and select the requested variables: */
+	Misc::Timer variableTimer;
+	VariableManager* variableManager=new VariableManager(dataSet);
+	if(scalarVariableName!=0)
+		{
+		int scalarVariableIndex=variableManager->getScalarVariable(scalarVariableName);
+		if(scalarVariableIndex<0)
+			{
+			std::cerr<<"Unknown scalar variable "<<scalarVariableName<<std::endl;
+			delete variableManager;
+			delete dataSet;
+			return 1;
+			}
+		variableManager->setCurrentScalarVariable(scalarVariableIndex);
+		}
+	if(vectorVariableName!=0)
+		{
+		int vectorVariableIndex=variableManager->getVectorVariable(vectorVariableName);
+		if(vectorVariableIndex<0)
+			{
+			std::cerr<<"Unknown vector variable "<<vectorVariableName<<std::endl;
+			delete variableManager;
+			delete dataSet;
+			return 1;
+			}
+		variableManager->setCurrentVectorVariable(vectorVariableIndex);
+		}
+	variableTimer.elapse();
+	
+	/* Write the variable record: */
+	int numScalarVariables=variableManager->getNumScalarVariables();
+	int numVectorVariables=variableManager->getNumVectorVariables();
+	std::cout<<"{\"record\":\"variables\",\"numScalarVariables\":"<<numScalarVariables<<",\"numVectorVariables\":"<<numVectorVariables;
+	if(numScalarVariables>0)
+		{
+		std::cout<<",\"scalarVariable\":";
+		writeString(variableManager->getScalarVariableName(variableManager->getCurrentScalarVariable()));
+		}
+	if(numVectorVariables>0)
+		{
+		std::cout<<",\"vectorVariable\":";
+		writeString(variableManager->getVectorVariableName(variableManager->getCurrentVectorVariable()));
+		}
+	std::cout<<",\"prepareTime\":"<<variableTimer.getTime()*1000.0<<",\"peakRss\":"<<getPeakRss()<<'}'<<std::endl;
+	
+	bool ok=true;
+	try
+		{
+		if(calcStatistics)
+			{
+			/* Calculate the statistics of all scalar and vector variables in parallel: */
+			Misc::Timer statisticsTimer;
+			if(numStatisticsBins>0)
+				variableManager->setNumStatisticsBins(numStatisticsBins);
+			variableManager->calcStatistics();
+			statisticsTimer.elapse();
+			
+			/* Write a statistics record for each variable and a summary record: */
+			for(int i=0;i<numScalarVariables;++i)
+				writeStatistics("scalar",variableManager->getScalarVariableName(i),variableManager->getScalarValueStatistics(i));
+			for(int i=0;i<numVectorVariables;++i)
+				writeStatistics("vectorMagnitude",variableManager->getVectorVariableName(i),variableManager->getVectorValueMagnitudeStatistics(i));
+			std::cout<<"{\"record\":\"statistics\",\"numBins\":"<<variableManager->getNumStatisticsBins()<<",\"statisticsTime\":"<<statisticsTimer.getTime()*1000.0<<",\"peakRss\":"<<getPeakRss()<<'}'<<std::endl;
+			}
+		
+		if(runAlgorithms)
+			{
+			/* Seed elements from the center of the data set's domain if no seed points were given: */
+			if(seedPoints.empty())
+				seedPoints.push_back(Geometry::mid(domain.min,domain.max));
+			DataSet::Locator* locator=dataSet->getLocator();
+			
+			/* Move seed points by a tiny fraction of the domain's size to check element reuse: */
+			Scalar seedNudge=Scalar(Geometry::dist(domain.min,domain.max)*1.0e-7);
+			
+			/* Run all scalar algorithms on the current scalar variable: */
+			if(numScalarVariables>0)
+				{
+				const char* variableName=variableManager->getScalarVariableName(variableManager->getCurrentScalarVariable());
+				for(int i=0;i<module->getNumScalarAlgorithms();++i)
+					{
+					Misc::Timer setupTimer;
+					Algorithm* algorithm=module->getScalarAlgorithm(i,variableManager,0);
+					setupTimer.elapse();
+					ok=benchmarkAlgorithm(algorithm,setupTimer.getTime(),variableName,locator,seedPoints,seedNudge,numRuns)&&ok;
+					delete algorithm;
+					}
+				}
+			
+			/* Run all vector algorithms on the current vector variable: */
+			if(numVectorVariables>0)
+				{
+				const char* variableName=variableManager->getVectorVariableName(variableManager->getCurrentVectorVariable());
+				for(int i=0;i<module->getNumVectorAlgorithms();++i)
+					{
+					Misc::Timer setupTimer;
+					Algorithm* algorithm=module->getVectorAlgorithm(i,variableManager,0);
+					setupTimer.elapse();
+					ok=benchmarkAlgorithm(algorithm,setupTimer.getTime(),variableName,locator,seedPoints,seedNudge,numRuns)&&ok;
+					delete algorithm;
+					}
+				}
+			
+			delete locator;
+			}
+		
+		/* Replay all requested element files: */
+		for(std::vector<const char*>::iterator lfnIt=loadFileNames.begin();lfnIt!=loadFileNames.end();++lfnIt)
+			ok=benchmarkElementFile(*lfnIt,module,variableManager,numRuns)&&ok;
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"Benchmark cancelled due to exception "<<err.what()<<std::endl;
+		ok=false;
+		}
+	
+	/* Clean up: */
+	delete variableManager;
+	delete dataSet;
+	totalTimer.elapse();
+	
+	/* Write the summary record: */
+	std::cout<<"{\"record\":\"summary\",\"status\":\""<<(ok?"ok":"error")<<"\",\"totalTime\":"<<totalTimer.getTime()*1000.0<<",\"peakRss\":"<<getPeakRss()<<'}'<<std::endl;
+	
+	return ok?0:1;
+	}
@@ -1,7 +1,7 @@
 /***********************************************************************
 Extractor - Helper class to drive multithreaded incremental or immediate
 extraction of visualization elements from a data set.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -35,6 +35,34 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 
+#include "Tracer.h"
+
+/********************************************
+Methods of class Extractor::LatencyHistogram:
+********************************************/
+
+Extractor::LatencyHistogram::LatencyHistogram(void)
+	:numSamples(0),latencySum(0.0),maxLatency(0.0)
+	{
+	for(unsigned int i=0;i<numBins;++i)
+		bins[i]=0;
+	}
+
+void Extractor::LatencyHistogram::add(double latency)
+	{
+	/* Find the bin containing the latency: */
+	unsigned int binIndex=0;
+	while(binIndex<numBins-1&&latency>=getBinMax(binIndex))
+		++binIndex;
+	++bins[binIndex];
+	
+	/* Update the summary statistics: */
+	++numSamples;
+	latencySum+=latency;
+	if(maxLatency<latency)
+		maxLatency=latency;
+	}
+
 /**************************
 Methods of class Extractor:
 **************************/
@@ -45,6 +73,9 @@ void* Extractor::masterExtractorThreadMethod(void)
 	Threads::Thread::setCancelState(Threads::Thread::CANCEL_ENABLE);
 	// Threads::Thread::setCancelType(Threads::Thread::CANCEL_ASYNCHRONOUS);
 	
+	/* Name this thread in exported timeline traces: */
+	VISUALIZATION_TRACE_THREAD_NAME("Master extractor");
+	
 	/* Create a data sink for the multicast pipe: */
 	Visualization::Abstract::BinaryParametersSink sink(extractor->getVariableManager(),*extractor->getPipe(),true);
 	
@@ -56,6 +87,7 @@ void* Extractor::masterExtractorThreadMethod(void)
 		/* Wait until there is a seed request: */
 		Parameters* parameters;
 		unsigned int requestID;
+		double requestTime;
 		{
 		Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
 		#if !THREADS_CONFIG_CAN_CANCEL
@@ -72,9 +104,14 @@ void* Extractor::masterExtractorThreadMethod(void)
 		parameters=seedParameters;
 		seedParameters=0;
 		
-		/* Grab the seed request ID: */
+		/* Grab the seed request ID and posting time: */
 		requestID=seedRequestID;
+		requestTime=seedRequestTime;
 		}
+		double startTime=latencyClock.peekTime();
+		
+		/* Time the handling of the seed request: */
+		VISUALIZATION_TRACE_ZONE("Extractor::handleSeedRequest");
 		
 		/* Start a new visualization element: */
 		std::pair<ElementPointer,unsigned int>& element=trackedElements.startNewValue();
@@ -97,13 +134,29 @@ void* Extractor::masterExtractorThreadMethod(void)
 				element.first=extractor->startElement(parameters);
 				element.second=requestID;
 				bool notPosted=true; // Flag whether the element has not been posted to the triple buffer
+				double setupEndTime=latencyClock.peekTime();
 				
 				/* Continue extracting the visualization element until it is done: */
 				bool keepGrowing;
 				do
 					{
 					/* Grow the visualization element by a little bit: */
-					alarm.armTimer(expirationTime);
+					if(notPosted)
+						{
+						/* Shorten the first growth step such that the initial piece arrives within the latency bound: */
+						double firstStepTime;
+						{
+						Threads::Mutex::Lock latencyLock(latencyMutex);
+						firstStepTime=maxSeedLatency-(setupEndTime-requestTime);
+						}
+						if(firstStepTime>0.1)
+							firstStepTime=0.1;
+						if(firstStepTime<0.002)
+							firstStepTime=0.002;
+						alarm.armTimer(Misc::Time(firstStepTime));
+						}
+					else
+						alarm.armTimer(expirationTime);
 					keepGrowing=!extractor->continueElement(alarm);
 					
 					/* Push this visualization element to the main thread: */
@@ -112,6 +165,7 @@ void* Extractor::masterExtractorThreadMethod(void)
 						/* Post the initial piece of the visualization element to the triple buffer: */
 						trackedElements.postNewValue();
 						notPosted=false;
+						updateLatency(requestTime,startTime,setupEndTime,latencyClock.peekTime());
 						}
 					updateExtractor();
 					
@@ -149,6 +203,8 @@ void* Extractor::masterExtractorThreadMethod(void)
 				
 				/* Push this visualization element to the main thread: */
 				trackedElements.postNewValue();
+				double postTime=latencyClock.peekTime();
+				updateLatency(requestTime,startTime,postTime,postTime);
 				updateExtractor();
 				}
 			}
@@ -184,6 +240,9 @@ void* Extractor::slaveExtractorThreadMethod(void)
 	Threads::Thread::setCancelState(Threads::Thread::CANCEL_ENABLE);
 	// Threads::Thread::setCancelType(Threads::Thread::CANCEL_ASYNCHRONOUS);
 	
+	/* Name this thread in exported timeline traces: */
+	VISUALIZATION_TRACE_THREAD_NAME("Slave extractor");
+	
 	/* Create a data source for the multicast pipe: */
 	Visualization::Abstract::BinaryParametersSource source(extractor->getVariableManager(),*extractor->getPipe(),true);
 	
@@ -201,6 +260,9 @@ void* Extractor::slaveExtractorThreadMethod(void)
 			return 0;
 		#endif
 		
+		/* Time the reception of the visualization element: */
+		VISUALIZATION_TRACE_ZONE("Extractor::receiveElement");
+		
 		/* Start a new visualization element: */
 		std::pair<ElementPointer,unsigned int>& element=trackedElements.startNewValue();
 		if(requestID!=0)
@@ -242,6 +304,19 @@ void* Extractor::slaveExtractorThreadMethod(void)
 	return 0;
 	}
 
+void Extractor::updateLatency(double requestTime,double startTime,double setupEndTime,double postTime)
+	{
+	Threads::Mutex::Lock latencyLock(latencyMutex);
+	
+	/* Update the running estimates with exponential smoothing: */
+	const double weight=0.25;
+	setupTime+=(setupEndTime-startTime-setupTime)*weight;
+	seedLatency+=(postTime-requestTime-seedLatency)*weight;
+	
+	/* Accumulate the end-to-end latency: */
+	seedLatencyHistogram.add(postTime-requestTime);
+	}
+
 Extractor::Extractor(Extractor::Algorithm* sExtractor)
 	:extractor(sExtractor),
 	 #if !THREADS_CONFIG_CAN_CANCEL
@@ -249,7 +324,9 @@ Extractor::Extractor(Extractor::Algorithm* sExtractor)
 	 #endif
 	 finalElementPending(false),finalSeedRequestID(0),
 	 seedParameters(0),
-	 seedRequestID(0)
+	 seedRequestID(0),
+	 seedRequestTime(0.0),maxSeedLatency(0.05),
+	 setupTime(0.0),seedLatency(0.0),numDroppedSeedRequests(0)
 	{
 	/* Initialize the extraction thread communications: */
 	for(int i=0;i<3;++i)
@@ -299,6 +376,10 @@ Extractor::~Extractor(void)
 	#endif
 	extractorThread.join();
 	
+	/* Remove a still-displayed tracked visualization element from Vrui's scene graph: */
+	if(trackedElements.getLockedValue().first!=0)
+		Vrui::getSceneGraphManager()->removeNavigationalNode(*trackedElements.getLockedValue().first);
+	
 	/* Clear the extractor thread communication: */
 	delete seedParameters;
 	
@@ -310,9 +391,16 @@ void Extractor::seedRequest(unsigned int newSeedRequestID,Extractor::Parameters*
 	{
 	/* Request another visualization element extraction: */
 	Threads::Mutex::Lock seedRequestLock(seedRequestMutex);
-	delete seedParameters;
+	if(seedParameters!=0)
+		{
+		/* Drop the previous seed request, which the extractor thread has not yet picked up: */
+		delete seedParameters;
+		Threads::Mutex::Lock latencyLock(latencyMutex);
+		++numDroppedSeedRequests;
+		}
 	seedParameters=newSeedParameters;
 	seedRequestID=newSeedRequestID;
+	seedRequestTime=latencyClock.peekTime();
 	
 	seedRequestCond.signal();
 	}
@@ -323,8 +411,34 @@ void Extractor::finalize(unsigned int newFinalSeedRequestID)
 	finalSeedRequestID=newFinalSeedRequestID;
 	}
 
+void Extractor::setMaxSeedLatency(double newMaxSeedLatency)
+	{
+	Threads::Mutex::Lock latencyLock(latencyMutex);
+	maxSeedLatency=newMaxSeedLatency;
+	}
+
+double Extractor::getSeedLatency(void) const
+	{
+	Threads::Mutex::Lock latencyLock(latencyMutex);
+	return seedLatency;
+	}
+
+unsigned int Extractor::getNumDroppedSeedRequests(void) const
+	{
+	Threads::Mutex::Lock latencyLock(latencyMutex);
+	return numDroppedSeedRequests;
+	}
+
+Extractor::LatencyHistogram Extractor::getSeedLatencyHistogram(void) const
+	{
+	Threads::Mutex::Lock latencyLock(latencyMutex);
+	return seedLatencyHistogram;
+	}
+
 Extractor::ElementPointer Extractor::checkUpdates(void)
 	{
+	VISUALIZATION_TRACE_ZONE("Extractor::checkUpdates");
+	
 	/* Get the most recent visualization element from the extractor thread: */
 	if(trackedElements.hasNewValue())
 		{
@@ -1,7 +1,7 @@
 /***********************************************************************
 Extractor - Helper class to drive multithreaded incremental or immediate
 extraction of visualization elements from a data set.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,6 +25,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <utility>
 #include <Misc/Autopointer.h>
+#include <Misc/Timer.h>
 #include <Threads/Config.h>
 #include <Threads/Mutex.h>
 #include <Threads/Cond.h>
@@ -49,6 +50,45 @@ class Extractor
 	typedef Visualization::Abstract::Element Element;
 	typedef Misc::Autopointer<Element> ElementPointer;
 	
+	class LatencyHistogram // Class to accumulate latencies in logarithmically-spaced bins
+		{
+		/* Elements: */
+		public:
+		static const unsigned int numBins=12; // Number of histogram bins; bin 0 counts latencies below 1ms, bin i>0 latencies in [2^(i-1), 2^i) ms, and the last bin all larger latencies
+		private:
+		unsigned int bins[numBins]; // Number of latencies accumulated in each bin
+		unsigned int numSamples; // Total number of accumulated latencies
+		double latencySum; // Sum of all accumulated latencies in seconds
+		double maxLatency; // Largest accumulated latency in seconds
+		
+		/* Constructors and destructors: */
+		public:
+		LatencyHistogram(void); // Creates an empty histogram
+		
+		/* Methods: */
+		void add(double latency); // Adds the given latency in seconds to the histogram
+		unsigned int getBin(unsigned int binIndex) const // Returns the number of latencies in the given bin
+			{
+			return bins[binIndex];
+			}
+		static double getBinMax(unsigned int binIndex) // Returns the exclusive upper bound of the given bin in seconds
+			{
+			return double(1U<<binIndex)*0.001;
+			}
+		unsigned int getNumSamples(void) const // Returns the total number of accumulated latencies
+			{
+			return numSamples;
+			}
+		double getAverageLatency(void) const // Returns the average accumulated latency in seconds
+			{
+			return numSamples>0?latencySum/double(numSamples):0.0;
+			}
+		double getMaxLatency(void) const // Returns the largest accumulated latency in seconds
+			{
+			return maxLatency;
+			}
+		};
+	
 	/* Elements: */
 	protected:
 	
@@ -75,10 +115,21 @@ class Extractor
 	/* Extractor thread communication output: */
 	Threads::TripleBuffer<std::pair<ElementPointer,unsigned int> > trackedElements; // Triple-buffer of currently tracked visualization elements and their IDs
 	
+	/* Latency measurement state: */
+	Misc::Timer latencyClock; // Free-running clock to time seed requests
+	double seedRequestTime; // Clock time at which the most recent seed request was posted; protected by the seed request mutex
+	double maxSeedLatency; // Desired upper bound for the time from posting a seed request to displaying its first preview in seconds
+	mutable Threads::Mutex latencyMutex; // Mutex protecting the latency estimates and histogram
+	double setupTime; // Running estimate of the time to start a new visualization element in seconds
+	double seedLatency; // Running estimate of the time from posting a seed request to displaying its first preview in seconds
+	unsigned int numDroppedSeedRequests; // Number of seed requests replaced by newer requests before the extractor thread picked them up
+	LatencyHistogram seedLatencyHistogram; // Histogram of times from posting seed requests to displaying their first previews
+	
 	/* Private methods: */
 	private:
 	void* masterExtractorThreadMethod(void); // The extractor thread method for single computers or masters in a cluster environment
 	void* slaveExtractorThreadMethod(void); // The extractor thread method for slaves in a cluster environment
+	void updateLatency(double requestTime,double startTime,double setupEndTime,double postTime); // Updates the latency estimates and histogram after posting the first preview of a seed request
 	
 	/* Constructors and destructors: */
 	public:
@@ -96,6 +147,18 @@ class Extractor
 		{
 		return finalElementPending;
 		}
+	double getMaxSeedLatency(void) const // Returns the desired upper bound for seed request latency
+		{
+		return maxSeedLatency;
+		}
+	void setMaxSeedLatency(double newMaxSeedLatency); // Sets the desired upper bound for the time from posting a seed request to displaying its first preview; incremental extractors shorten the first growth step to meet it
+	double getSeedLatency(void) const; // Returns the running estimate of the time from posting a seed request to displaying its first preview
+	unsigned int getNumDroppedSeedRequests(void) const; // Returns the number of seed requests that were replaced before being picked up
+	LatencyHistogram getSeedLatencyHistogram(void) const; // Returns a copy of the seed request latency histogram
+	unsigned int getTrackedElementID(void) const // Returns the seed request ID of the tracked visualization element currently locked by the main thread
+		{
+		return trackedElements.getLockedValue().second;
+		}
 	virtual ElementPointer checkUpdates(void); // Method to synchronize the extraction thread's state back to the main thread; returns pointer to new finished element or 0
 	virtual void updateExtractor(void); // Hook method called asynchronously when the visual state of the extractor changes
 	};
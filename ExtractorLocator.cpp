@@ -1,7 +1,7 @@
 /***********************************************************************
 ExtractorLocator - Class for locators applying visualization algorithms
 to data sets.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Misc/FunctionCalls.h>
 #include <Misc/ConfigurationFile.h>
+#include <Geometry/Rotation.h>
 #include <Geometry/OrthogonalTransformation.h>
 #include <Geometry/OutputOperators.h>
 #include <GLMotif/WidgetManager.h>
@@ -39,8 +40,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 
+#include "Tracer.h"
 #include "Visualizer.h"
 #include "ElementList.h"
+#if VISUALIZATION_CONFIG_USE_COLLABORATION
+#include "SharedVisualizationClient.h"
+#endif
 
 /*********************************
 Methods of class ExtractorLocator:
@@ -74,26 +79,46 @@ void ExtractorLocator::busyFunction(float newCompletionPercentage)
 	Vrui::requestUpdate();
 	}
 
+void ExtractorLocator::postSeedRequest(const ExtractorLocator::Locator* seedLocator)
+	{
+	/* Bump up the seed request ID: */
+	if((++lastSeedRequestID)==0) // 0 is an invalid ID
+		++lastSeedRequestID;
+	
+	if(extractor->isMaster())
+		{
+		/* Get extraction parameters for the given locator state from the extractor: */
+		if(extractor->hasSeededCreator())
+			extractor->setSeedLocator(seedLocator);
+		application->setRegionOfInterest(extractor);
+		
+		#if VISUALIZATION_CONFIG_USE_COLLABORATION
+		if(application->sharedVisualizationClient!=0&&extractor->hasSeededCreator()&&extractor->hasIncrementalCreator())
+			{
+			/* Share the seed request of a dragging operation with other clients through the shared visualization server; other elements are only shared once finished: */
+			application->sharedVisualizationClient->postSeedRequest(this,lastSeedRequestID,extractor->cloneParameters());
+			}
+		#endif
+		
+		/* Post a seed request: */
+		seedRequest(lastSeedRequestID,extractor->cloneParameters());
+		}
+	}
+
 ExtractorLocator::ExtractorLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* sApplication,Extractor::Algorithm* sExtractor,const Misc::ConfigurationFileSection* cfg)
 	:BaseLocator(sLocatorTool,sApplication),Extractor(sExtractor),
 	 settingsDialog(extractor->createSettingsDialog(Vrui::getWidgetManager())),
 	 busyDialog(createBusyDialog(extractor->getName())),
 	 locator(application->dataSet->getLocator()),
+	 predictionLocator(application->dataSet->getLocator()),
 	 dragging(false),
-	 lastSeedRequestID(0),
+	 lastSeedRequestID(0),lastSeedPredicted(false),
+	 haveLastMotion(false),lastMotionTime(0.0),
 	 completionPercentage(0.0f),completionPercentageUpdated(false)
 	{
 	/* Set the algorithm's busy function: */
 	extractor->setBusyFunction(Misc::createFunctionCall(this,&ExtractorLocator::busyFunction));
 	
-	#if 0 && VISUALIZATION_CONFIG_USE_COLLABORATION
-	if(application->sharedVisualizationClient!=0)
-		{
-		/* Register this locator with the shared visualization client: */
-		application->sharedVisualizationClient->createLocator(this);
-		}
-	#endif
-	
 	if(settingsDialog!=0)
 		{
 		/* Show the algorithm's settings dialog if it has one: */
@@ -106,22 +131,26 @@ ExtractorLocator::ExtractorLocator(Vrui::LocatorTool* sLocatorTool,Visualizer* s
 			}
 		}
 	
+	/* Set the extraction latency bound: */
+	setMaxSeedLatency(application->maxSeedLatency);
+	
 	/* Set the render pass mask: */
 	passMask=SceneGraph::GraphNode::GLRenderPass;
 	}
 
 ExtractorLocator::~ExtractorLocator(void)
 	{
-	#if 0 && VISUALIZATION_CONFIG_USE_COLLABORATION
+	#if VISUALIZATION_CONFIG_USE_COLLABORATION
 	if(application->sharedVisualizationClient!=0)
 		{
-		/* Unregister this locator with the shared visualization client: */
+		/* Stop sharing this locator's interaction with the shared visualization client: */
 		application->sharedVisualizationClient->destroyLocator(this);
 		}
 	#endif
 	
-	/* Delete the locator: */
+	/* Delete the locators: */
 	delete locator;
+	delete predictionLocator;
 	
 	/* Delete the busy dialog: */
 	delete busyDialog;
@@ -156,36 +185,47 @@ void ExtractorLocator::getName(std::string& name) const
 
 void ExtractorLocator::motionCallback(Vrui::LocatorTool::MotionCallbackData* cbData)
 	{
+	VISUALIZATION_TRACE_ZONE("ExtractorLocator::motionCallback");
+	
 	/* Update the locator: */
 	bool positionChanged=locator->setPosition(cbData->currentTransformation.getOrigin());
 	positionChanged=locator->setOrientation(cbData->currentTransformation.getRotation())||positionChanged;
 	
 	/* Post a seed request if the locator has moved since the last frame: */
+	double motionTime=Vrui::getApplicationTime();
 	if(dragging&&positionChanged)
 		{
-		/* Bump up the seed request ID: */
-		if((++lastSeedRequestID)==0) // 0 is an invalid ID
-			++lastSeedRequestID;
-		
-		if(extractor->isMaster())
+		/* Check if the locator's motion can be extrapolated to where it will be when the seed request's first preview arrives; the flag only depends on state shared by all cluster nodes, so that all nodes post the same seed requests on button release: */
+		const Locator* seedLocator=locator;
+		lastSeedPredicted=application->predictSeeds&&haveLastMotion&&motionTime>lastMotionTime;
+		if(lastSeedPredicted&&extractor->isMaster())
 			{
-			/* Get extraction parameters for the current locator state from the extractor: */
-			if(extractor->hasSeededCreator())
-				extractor->setSeedLocator(locator);
-			
-			#if 0 && VISUALIZATION_CONFIG_USE_COLLABORATION
-			if(application->sharedVisualizationClient!=0)
-				{
-				/* Send a seed request to the shared visualization server: */
-				application->sharedVisualizationClient->postSeedRequest(this,lastSeedRequestID,extractor->cloneParameters());
-				}
-			#endif
+			/* Extrapolate the locator's linear and angular velocity over the estimated extraction latency: */
+			double lookahead=getSeedLatency();
+			if(lookahead>getMaxSeedLatency()*2.0)
+				lookahead=getMaxSeedLatency()*2.0;
+			double scale=lookahead/(motionTime-lastMotionTime);
+			const DataSet::Point& position=locator->getPosition();
+			const DataSet::Orientation& orientation=locator->getOrientation();
+			predictionLocator->setPosition(position+(position-lastPosition)*scale);
+			DataSet::Orientation delta=orientation*Geometry::invert(lastOrientation);
+			predictionLocator->setOrientation(DataSet::Orientation::rotateScaledAxis(delta.getScaledAxis()*scale)*orientation);
 			
-			/* Post a seed request: */
-			seedRequest(lastSeedRequestID,extractor->cloneParameters());
+			/* Fall back to the current locator state if the extrapolated position left the data set's domain: */
+			if(predictionLocator->isValid())
+				seedLocator=predictionLocator;
 			}
+		
+		/* Request a visualization element for the current or extrapolated locator state: */
+		postSeedRequest(seedLocator);
 		}
 	
+	/* Remember the locator state to estimate its velocity in the next frame: */
+	lastPosition=locator->getPosition();
+	lastOrientation=locator->getOrientation();
+	lastMotionTime=motionTime;
+	haveLastMotion=true;
+	
 	/* Check for updates from the extraction thread: */
 	ElementPointer newElement=checkUpdates();
 	if(newElement!=0)
@@ -223,29 +263,8 @@ void ExtractorLocator::buttonPressCallback(Vrui::LocatorTool::ButtonPressCallbac
 	
 	/* Request a visualization element if it's appropriate: */
 	if(!extractor->hasSeededCreator()||extractor->hasIncrementalCreator()||locator->isValid())
-		{
-		/* Bump up the seed request ID: */
-		if((++lastSeedRequestID)==0) // 0 is an invalid ID
-			++lastSeedRequestID;
-		
-		if(extractor->isMaster())
-			{
-			/* Get extraction parameters for the current locator state from the extractor: */
-			if(extractor->hasSeededCreator())
-				extractor->setSeedLocator(locator);
-			
-			#if 0 && VISUALIZATION_CONFIG_USE_COLLABORATION
-			if(application->sharedVisualizationClient!=0)
-				{
-				/* Send a seed request to the shared visualization server: */
-				application->sharedVisualizationClient->postSeedRequest(this,lastSeedRequestID,extractor->cloneParameters());
-				}
-			#endif
-			
-			/* Post a seed request: */
-			seedRequest(lastSeedRequestID,extractor->cloneParameters());
-			}
-		}
+		postSeedRequest(locator);
+	lastSeedPredicted=false;
 	
 	if(extractor->hasSeededCreator()&&extractor->hasIncrementalCreator())
 		{
@@ -254,14 +273,6 @@ void ExtractorLocator::buttonPressCallback(Vrui::LocatorTool::ButtonPressCallbac
 		}
 	else
 		{
-		#if 0 && VISUALIZATION_CONFIG_USE_COLLABORATION
-		if(application->sharedVisualizationClient!=0)
-			{
-			/* Send a finalization request to the shared visualization server: */
-			application->sharedVisualizationClient->postFinalizationRequest(this,lastSeedRequestID);
-			}
-		#endif
-		
 		/* Wait for the only visualization element: */
 		finalize(lastSeedRequestID);
 		
@@ -275,7 +286,14 @@ void ExtractorLocator::buttonReleaseCallback(Vrui::LocatorTool::ButtonReleaseCal
 	{
 	if(dragging)
 		{
-		#if 0 && VISUALIZATION_CONFIG_USE_COLLABORATION
+		/* Replace a potentially extrapolated last seed request with one for the locator's actual final state: */
+		if(lastSeedPredicted)
+			{
+			postSeedRequest(locator);
+			lastSeedPredicted=false;
+			}
+		
+		#if VISUALIZATION_CONFIG_USE_COLLABORATION
 		if(application->sharedVisualizationClient!=0)
 			{
 			/* Send a finalization request to the shared visualization server: */
@@ -298,6 +316,8 @@ const char* ExtractorLocator::getClassName(void) const
 
 void ExtractorLocator::glRenderAction(SceneGraph::GLRenderState& renderState) const
 	{
+	VISUALIZATION_TRACE_ZONE("ExtractorLocator::glRenderAction");
+	
 	/* Highlight the locator: */
 	if(locator->isValid())
 		application->dataSetRenderer->highlightLocator(locator,renderState);
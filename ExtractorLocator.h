@@ -1,7 +1,7 @@
 /***********************************************************************
 ExtractorLocator - Class for locators applying visualization algorithms
 to data sets.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -51,14 +51,21 @@ class ExtractorLocator:public BaseLocator,public Extractor
 	GLMotif::PopupWindow* busyDialog; // Dialog window to show while a non-incremental extractor is busy
 	GLMotif::Label* percentageLabel; // Label to display completion percentage in the busy dialog
 	Locator* locator; // A locator for the visualization algorithm
+	Locator* predictionLocator; // A locator placed where the tool is expected to be once a seed request's first preview arrives
 	bool dragging; // Flag if the tool's button is currently pressed
 	unsigned int lastSeedRequestID; // ID used to identify the last issued seed request
+	bool lastSeedPredicted; // Flag whether the last seed request may have been issued from an extrapolated locator position; identical on all cluster nodes
+	bool haveLastMotion; // Flag whether the previous locator state is valid
+	double lastMotionTime; // Application time of the previous locator state
+	DataSet::Point lastPosition; // Previous locator position
+	DataSet::Orientation lastOrientation; // Previous locator orientation
 	volatile float completionPercentage; // Completion percentage of long-running operations
 	volatile bool completionPercentageUpdated; // Flag if the completion percentage has been updated
 	
 	/* Private methods: */
 	GLMotif::PopupWindow* createBusyDialog(const char* algorithmName); // Creates the busy dialog
 	void busyFunction(float newCompletionPercentage); // Called during long-running operations
+	void postSeedRequest(const Locator* seedLocator); // Posts a seed request for the given locator state
 	
 	/* Constructors and destructors: */
 	public:
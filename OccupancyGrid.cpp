@@ -0,0 +1,253 @@
+/***********************************************************************
+OccupancyGrid - Class to classify bricks of a voxel block as empty or
+occupied under a set of transfer functions, to allow raycasters to skip
+empty space.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <OccupancyGrid.h>
+
+#include <string.h>
+
+/**********************************************
+Methods of class OccupancyGrid::Classification:
+**********************************************/
+
+OccupancyGrid::Classification::Classification(const OccupancyGrid& grid)
+	:numChannels(grid.numChannels),
+	 gridVersion(grid.version),
+	 nonZeros(new bool[numChannels*numValues]),
+	 nonZeroCounts(new unsigned int[numChannels*(numValues+1)]),
+	 changedRanges(new int[numChannels*2]),
+	 numBricks(grid.numBricks.volume()),
+	 occupancy(new unsigned char[numBricks]),
+	 version(0)
+	{
+	/* Pretend that all transfer function entries are opaque, which is consistent with all bricks being occupied: */
+	for(int i=0;i<numChannels*numValues;++i)
+		nonZeros[i]=true;
+	for(int channel=0;channel<numChannels;++channel)
+		{
+		unsigned int* nzc=nonZeroCounts+channel*(numValues+1);
+		for(int i=0;i<=numValues;++i)
+			nzc[i]=i;
+		}
+	memset(occupancy,255,numBricks);
+	}
+
+OccupancyGrid::Classification::~Classification(void)
+	{
+	delete[] nonZeros;
+	delete[] nonZeroCounts;
+	delete[] changedRanges;
+	delete[] occupancy;
+	}
+
+size_t OccupancyGrid::Classification::getNumOccupied(void) const
+	{
+	size_t result=0;
+	for(size_t i=0;i<numBricks;++i)
+		if(occupancy[i]!=0)
+			++result;
+	return result;
+	}
+
+/******************************
+Methods of class OccupancyGrid:
+******************************/
+
+OccupancyGrid::OccupancyGrid(const OccupancyGrid::Size3& sDataSize,unsigned int sBrickSize,int sNumChannels)
+	:dataSize(sDataSize),brickSize(sBrickSize),
+	 numChannels(sNumChannels),
+	 ranges(0),
+	 version(0)
+	{
+	/* Calculate the number of bricks required to cover all cells of the voxel block: */
+	for(int i=0;i<3;++i)
+		{
+		unsigned int numCells=dataSize[i]>1?dataSize[i]-1:1;
+		numBricks[i]=(numCells+brickSize-1)/brickSize;
+		}
+	
+	/* Initialize all brick ranges to the full value range: */
+	size_t numRanges=size_t(numChannels)*numBricks.volume();
+	ranges=new Range[numRanges];
+	for(size_t i=0;i<numRanges;++i)
+		{
+		ranges[i].min=Value(0);
+		ranges[i].max=Value(numValues-1);
+		}
+	}
+
+OccupancyGrid::~OccupancyGrid(void)
+	{
+	delete[] ranges;
+	}
+
+template <class VoxelParam>
+void OccupancyGrid::calcRanges(int channel,const VoxelParam* data,const ptrdiff_t dataStrides[3],int valueShift)
+	{
+	Range* rPtr=ranges+size_t(channel)*numBricks.volume();
+	for(unsigned int bz=0;bz<numBricks[2];++bz)
+		{
+		/* Samples inside a brick are interpolated from the voxels on the brick's boundary as well: */
+		unsigned int z0=bz*brickSize;
+		unsigned int z1=z0+brickSize<dataSize[2]-1?z0+brickSize:dataSize[2]-1;
+		for(unsigned int by=0;by<numBricks[1];++by)
+			{
+			unsigned int y0=by*brickSize;
+			unsigned int y1=y0+brickSize<dataSize[1]-1?y0+brickSize:dataSize[1]-1;
+			for(unsigned int bx=0;bx<numBricks[0];++bx,++rPtr)
+				{
+				unsigned int x0=bx*brickSize;
+				unsigned int x1=x0+brickSize<dataSize[0]-1?x0+brickSize:dataSize[0]-1;
+				
+				/* Find the range of voxel values inside the brick: */
+				VoxelParam min=VoxelParam(~VoxelParam(0));
+				VoxelParam max=VoxelParam(0);
+				const VoxelParam* zPtr=data+z0*dataStrides[2];
+				for(unsigned int z=z0;z<=z1;++z,zPtr+=dataStrides[2])
+					{
+					const VoxelParam* yPtr=zPtr+y0*dataStrides[1];
+					for(unsigned int y=y0;y<=y1;++y,yPtr+=dataStrides[1])
+						{
+						const VoxelParam* xPtr=yPtr+x0*dataStrides[0];
+						for(unsigned int x=x0;x<=x1;++x,xPtr+=dataStrides[0])
+							{
+							if(min>*xPtr)
+								min=*xPtr;
+							if(max<*xPtr)
+								max=*xPtr;
+							}
+						}
+					}
+				rPtr->min=Value(min>>valueShift);
+				rPtr->max=Value(max>>valueShift);
+				}
+			}
+		}
+	}
+
+void OccupancyGrid::updateRanges(int channel,const OccupancyGrid::Value* data,const ptrdiff_t dataStrides[3])
+	{
+	calcRanges(channel,data,dataStrides,0);
+	
+	/* Invalidate all classifications: */
+	++version;
+	}
+
+void OccupancyGrid::updateRanges(int channel,const unsigned short* data,const ptrdiff_t dataStrides[3])
+	{
+	/* Map 16-bit voxel values to transfer function entries: */
+	calcRanges(channel,data,dataStrides,8);
+	
+	/* Invalidate all classifications: */
+	++version;
+	}
+
+bool OccupancyGrid::classify(OccupancyGrid::Classification& classification,const float* const channelOpacities[],const int channelNumOpacities[],ptrdiff_t opacityStride) const
+	{
+	/* Update the per-channel opacity state and find the range of changed transfer function entries in each channel: */
+	int* changedRanges=classification.changedRanges;
+	bool anyChanged=classification.gridVersion!=version;
+	for(int channel=0;channel<numChannels;++channel)
+		{
+		bool* nz=classification.nonZeros+channel*numValues;
+		changedRanges[channel*2+0]=numValues;
+		changedRanges[channel*2+1]=-1;
+		const float* oPtr=channelOpacities[channel];
+		int numOpacities=channelNumOpacities[channel];
+		for(int i=0;i<numValues;++i)
+			{
+			/* Disabled channels are transparent everywhere: */
+			bool newNonZero=false;
+			if(oPtr!=0&&numOpacities>0)
+				{
+				/* Find the table entries covering the value, plus one entry on either side to account for interpolation between entries: */
+				int first=(i*numOpacities)/numValues-1;
+				if(first<0)
+					first=0;
+				int last=((i+1)*numOpacities-1)/numValues+1;
+				if(last>numOpacities-1)
+					last=numOpacities-1;
+				for(int j=first;j<=last&&!newNonZero;++j)
+					newNonZero=oPtr[j*opacityStride]>0.0f;
+				}
+			if(nz[i]!=newNonZero)
+				{
+				nz[i]=newNonZero;
+				if(changedRanges[channel*2+0]>i)
+					changedRanges[channel*2+0]=i;
+				changedRanges[channel*2+1]=i;
+				}
+			}
+		
+		if(changedRanges[channel*2+0]<=changedRanges[channel*2+1])
+			{
+			/* Recalculate the channel's prefix sums: */
+			unsigned int* nzc=classification.nonZeroCounts+channel*(numValues+1);
+			nzc[0]=0;
+			for(int i=0;i<numValues;++i)
+				nzc[i+1]=nzc[i]+(nz[i]?1U:0U);
+			anyChanged=true;
+			}
+		}
+	if(!anyChanged)
+		return false;
+	
+	/* Reclassify all bricks whose value ranges overlap any changed transfer function entries: */
+	bool fullUpdate=classification.gridVersion!=version;
+	size_t nb=numBricks.volume();
+	bool result=false;
+	for(size_t brickIndex=0;brickIndex<nb;++brickIndex)
+		{
+		bool reclassify=fullUpdate;
+		bool occupied=false;
+		for(int channel=0;channel<numChannels&&!occupied;++channel)
+			{
+			/* Extend the brick's value range by one entry on either side to account for transfer function interpolation: */
+			const Range& r=ranges[size_t(channel)*nb+brickIndex];
+			int min=r.min>0?int(r.min)-1:0;
+			int max=r.max<numValues-1?int(r.max)+1:numValues-1;
+			if(min<=changedRanges[channel*2+1]&&changedRanges[channel*2+0]<=max)
+				reclassify=true;
+			
+			/* Check if any transfer function entry inside the extended range is non-transparent: */
+			const unsigned int* nzc=classification.nonZeroCounts+channel*(numValues+1);
+			occupied=nzc[max+1]!=nzc[min];
+			}
+		
+		if(reclassify)
+			{
+			unsigned char newOccupancy=occupied?255U:0U;
+			if(classification.occupancy[brickIndex]!=newOccupancy)
+				{
+				classification.occupancy[brickIndex]=newOccupancy;
+				result=true;
+				}
+			}
+		}
+	
+	/* Mark the classification as up-to-date: */
+	classification.gridVersion=version;
+	if(result)
+		++classification.version;
+	
+	return result;
+	}
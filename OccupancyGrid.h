@@ -0,0 +1,137 @@
+/***********************************************************************
+OccupancyGrid - Class to classify bricks of a voxel block as empty or
+occupied under a set of transfer functions, to allow raycasters to skip
+empty space.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef OCCUPANCYGRID_INCLUDED
+#define OCCUPANCYGRID_INCLUDED
+
+#include <stddef.h>
+#include <Misc/Size.h>
+
+class OccupancyGrid
+	{
+	/* Embedded classes: */
+	public:
+	typedef Misc::Size<3> Size3; // Type for 3D voxel block and brick grid sizes
+	typedef unsigned char Value; // Type for voxel values
+	static const int numValues=256; // Number of distinct voxel values, and number of entries in transfer function opacity tables
+	
+	struct Range // Structure for value ranges of a single brick in a single channel
+		{
+		/* Elements: */
+		public:
+		Value min,max; // Closed range of voxel values touched by samples inside the brick
+		};
+	
+	class Classification // Class holding the result of classifying an occupancy grid against a set of transfer functions
+		{
+		friend class OccupancyGrid;
+		
+		/* Elements: */
+		private:
+		int numChannels; // Number of channels for which opacity state is tracked
+		unsigned int gridVersion; // Version number of the occupancy grid's brick ranges at the time of last classification
+		bool* nonZeros; // Array of flags whether each transfer function entry in each channel has non-zero opacity
+		unsigned int* nonZeroCounts; // Prefix sums over the non-zero flags of each channel, with numValues+1 entries per channel
+		int* changedRanges; // Scratch array holding the closed range of transfer function entries changed during the last classification for each channel
+		size_t numBricks; // Total number of bricks in the classified occupancy grid
+		unsigned char* occupancy; // Array of per-brick occupancy flags, 255 for occupied and 0 for empty bricks
+		unsigned int version; // Version number of the occupancy flag array, incremented whenever a brick changes state
+		
+		/* Constructors and destructors: */
+		public:
+		Classification(const OccupancyGrid& grid); // Creates a classification for the given grid with all bricks marked as occupied
+		private:
+		Classification(const Classification& source); // Prohibit copy constructor
+		Classification& operator=(const Classification& source); // Prohibit assignment operator
+		public:
+		~Classification(void);
+		
+		/* Methods: */
+		const unsigned char* getOccupancy(void) const // Returns the per-brick occupancy flag array in x-major order
+			{
+			return occupancy;
+			}
+		bool isOccupied(size_t brickIndex) const // Returns true if the given brick is occupied
+			{
+			return occupancy[brickIndex]!=0;
+			}
+		size_t getNumOccupied(void) const; // Returns the number of occupied bricks
+		unsigned int getVersion(void) const // Returns the occupancy flag array's version number
+			{
+			return version;
+			}
+		};
+	
+	/* Elements: */
+	private:
+	Size3 dataSize; // Size of the underlying voxel block
+	unsigned int brickSize; // Number of voxel cells per brick along each dimension
+	Size3 numBricks; // Number of bricks along each dimension
+	int numChannels; // Number of independent channels in the voxel block
+	Range* ranges; // Array of per-brick value ranges for each channel, channel-major
+	unsigned int version; // Version number of the brick ranges
+	
+	/* Private methods: */
+	template <class VoxelParam>
+	void calcRanges(int channel,const VoxelParam* data,const ptrdiff_t dataStrides[3],int valueShift); // Calculates brick value ranges from a voxel block whose values map to transfer function entries after shifting right by the given number of bits
+	
+	/* Constructors and destructors: */
+	public:
+	OccupancyGrid(const Size3& sDataSize,unsigned int sBrickSize,int sNumChannels); // Creates an occupancy grid for a voxel block of the given size, with all brick ranges covering all values
+	private:
+	OccupancyGrid(const OccupancyGrid& source); // Prohibit copy constructor
+	OccupancyGrid& operator=(const OccupancyGrid& source); // Prohibit assignment operator
+	public:
+	~OccupancyGrid(void);
+	
+	/* Methods: */
+	const Size3& getDataSize(void) const // Returns the size of the underlying voxel block
+		{
+		return dataSize;
+		}
+	unsigned int getBrickSize(void) const // Returns the number of voxel cells per brick along each dimension
+		{
+		return brickSize;
+		}
+	const Size3& getNumBricks(void) const // Returns the number of bricks along each dimension
+		{
+		return numBricks;
+		}
+	int getNumChannels(void) const // Returns the number of channels
+		{
+		return numChannels;
+		}
+	const Range& getRange(int channel,size_t brickIndex) const // Returns the value range of the given brick in the given channel
+		{
+		return ranges[size_t(channel)*numBricks.volume()+brickIndex];
+		}
+	unsigned int getVersion(void) const // Returns the version number of the brick ranges
+		{
+		return version;
+		}
+	void updateRanges(int channel,const Value* data,const ptrdiff_t dataStrides[3]); // Recalculates the value ranges of all bricks for the given channel from the given 8-bit voxel block
+	void updateRanges(int channel,const unsigned short* data,const ptrdiff_t dataStrides[3]); // Ditto, from the given 16-bit voxel block
+	bool classify(Classification& classification,const float* const channelOpacities[],const int channelNumOpacities[],ptrdiff_t opacityStride) const; // Updates the given classification against per-channel opacity tables of the given numbers of entries with the given stride, resampled to numValues entries; null table pointers disable channels; returns true if any brick changed state
+	};
+
+#endif
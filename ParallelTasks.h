@@ -0,0 +1,54 @@
+/***********************************************************************
+ParallelTasks - Helper class to run arrays of independent tasks, or one
+shared task, in parallel in background threads and the calling thread.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef PARALLELTASKS_INCLUDED
+#define PARALLELTASKS_INCLUDED
+
+#include <stddef.h>
+
+class ParallelTasks // Helper class to run tasks in parallel; all methods return after all tasks have finished
+	{
+	/* Private methods: */
+	private:
+	template <class TaskParam>
+	static void run(TaskParam* tasks,size_t taskStride,unsigned int numTasks,void* (*taskFunction)(TaskParam*)); // Runs the task function on the given number of tasks spaced by the given stride
+	
+	/* Methods: */
+	public:
+	static unsigned int getNumCpus(void); // Returns the number of CPUs available to run tasks in parallel
+	template <class TaskParam>
+	static void runTasks(TaskParam* tasks,unsigned int numTasks,void* (*taskFunction)(TaskParam*)) // Runs the task function on each task in the given array in a separate thread
+		{
+		run(tasks,1,numTasks,taskFunction);
+		}
+	template <class TaskParam>
+	static void runSharedTask(TaskParam* task,unsigned int numThreads,void* (*taskFunction)(TaskParam*)) // Runs the task function on the same task in the given number of threads, e.g., to process a shared work queue
+		{
+		run(task,0,numThreads,taskFunction);
+		}
+	};
+
+#ifndef PARALLELTASKS_IMPLEMENTATION
+#include <ParallelTasks.icpp>
+#endif
+
+#endif
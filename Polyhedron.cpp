@@ -1,7 +1,7 @@
 /***********************************************************************
 Polyhedron - Class to represent convex polyhedra resulting from
 intersections of half spaces.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -438,6 +438,52 @@ Polyhedron<ScalarParam>::calcVolume(void) const
 	return volume/Scalar(6);
 	}
 
+template <class ScalarParam>
+inline
+void
+Polyhedron<ScalarParam>::getFacePlanes(std::vector<typename Polyhedron<ScalarParam>::Plane>& planes) const
+	{
+	typedef Geometry::Vector<Scalar,3> Vector;
+	
+	/* Calculate the centroid of all polyhedron vertices to orient the face planes: */
+	typename Point::AffineCombiner cc;
+	for(typename EdgeList::const_iterator eIt=edges.begin();eIt!=edges.end();++eIt)
+		cc.addPoint(eIt->start);
+	Point center=cc.getPoint();
+	
+	Card numEdges(edges.size());
+	bool* edgeFlags=new bool[numEdges];
+	for(Card i=0;i<numEdges;++i)
+		edgeFlags[i]=false;
+	for(Card e0=0;e0<numEdges;++e0)
+		if(!edgeFlags[e0])
+			{
+			/* Calculate the area-weighted normal vector of the face defined by the current edge's face loop: */
+			Vector normal=Vector::zero;
+			Card e=e0;
+			do
+				{
+				edgeFlags[e]=true;
+				Card next=edges[e].next;
+				normal+=(edges[e].start-center)^(edges[next].start-center);
+				e=next;
+				}
+			while(e!=e0);
+			
+			/* Skip degenerate faces: */
+			if(normal.sqr()==Scalar(0))
+				continue;
+			
+			/* Orient the face plane such that the polyhedron is on its negative side: */
+			Plane plane(normal,edges[e0].start);
+			if(plane.calcDistance(center)>Scalar(0))
+				plane=Plane(-normal,edges[e0].start);
+			plane.normalize();
+			planes.push_back(plane);
+			}
+	delete[] edgeFlags;
+	}
+
 /*****************************************************
 Force instantiation of all default Polyhedron classes:
 *****************************************************/
@@ -1,7 +1,7 @@
 /***********************************************************************
 Polyhedron - Class to represent convex polyhedra resulting from
 intersections of half spaces.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -82,6 +82,7 @@ class Polyhedron
 	void drawFaces(void) const; // Draws the polyhedron's faces
 	void drawIntersection(const Plane& plane) const; // Draws the intersection polygon of the given plane and the polyhedron
 	Scalar calcVolume(void) const; // Calculates the volume of the polyhedron
+	void getFacePlanes(std::vector<Plane>& planes) const; // Appends the planes of all faces, with normal vectors pointing outwards, to the given list
 	};
 
 #endif
@@ -1,7 +1,7 @@
 /***********************************************************************
 Raycaster - Base class for volume renderers for Cartesian gridded data
 using GLSL shaders.
-Copyright (c) 2007-2024 Oliver Kreylos
+Copyright (c) 2007-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -45,13 +45,17 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 Methods of class Raycaster::DataItem:
 ************************************/
 
-Raycaster::DataItem::DataItem(void)
+Raycaster::DataItem::DataItem(const OccupancyGrid& occupancyGrid)
 	:hasNPOTDTextures(GLARBTextureNonPowerOfTwo::isSupported()),
 	 textureSize(0,0,0),
 	 depthTextureID(0),depthFramebufferID(0),depthTextureSize(1,1),
 	 mcScaleLoc(-1),mcOffsetLoc(-1),
 	 depthSamplerLoc(-1),depthMatrixLoc(-1),depthSizeLoc(-1),
-	 eyePositionLoc(-1),stepSizeLoc(-1)
+	 eyePositionLoc(-1),stepSizeLoc(-1),
+	 occupancy(occupancyGrid),
+	 occupancyTextureID(0),occupancyTextureSize(0,0,0),occupancyTextureVersion(0),
+	 bcScaleLoc(-1),bcOffsetLoc(-1),
+	 occupancySamplerLoc(-1),occupancySizeLoc(-1),occupancyTextureSizeLoc(-1)
 	{
 	/* Check for the required OpenGL extensions: */
 	if(!GLShader::isSupported())
@@ -90,6 +94,9 @@ Raycaster::DataItem::DataItem(void)
 	glDrawBuffer(GL_NONE);
 	glReadBuffer(GL_NONE);
 	glBindFramebufferEXT(GL_FRAMEBUFFER_EXT,currentFramebuffer);
+	
+	/* Create the brick occupancy texture object: */
+	glGenTextures(1,&occupancyTextureID);
 	}
 
 Raycaster::DataItem::~DataItem(void)
@@ -97,6 +104,9 @@ Raycaster::DataItem::~DataItem(void)
 	/* Destroy the depth texture and framebuffer: */
 	glDeleteFramebuffersEXT(1,&depthFramebufferID);
 	glDeleteTextures(1,&depthTextureID);
+	
+	/* Destroy the brick occupancy texture object: */
+	glDeleteTextures(1,&occupancyTextureID);
 	}
 
 void Raycaster::DataItem::initDepthBuffer(const Size2& maxFrameSize,SceneGraph::GLRenderState& renderState)
@@ -165,6 +175,42 @@ void Raycaster::initDataItem(Raycaster::DataItem* dataItem) const
 		dataItem->mcOffset[i]=GLfloat(tcMin[i]-domain.min[i]*scale);
 		}
 	dataItem->texCoords=Box(tcMin,tcMax);
+	
+	/* Calculate the transformation from data space to brick space: */
+	for(int i=0;i<3;++i)
+		{
+		Scalar brickSize(occupancyGrid.getBrickSize());
+		dataItem->bcScale[i]=Scalar(dataItem->textureSize[i])/brickSize;
+		dataItem->bcOffset[i]=Scalar(-0.5)/brickSize;
+		}
+	
+	/* Calculate the brick occupancy texture's size: */
+	const OccupancyGrid::Size3& numBricks=occupancyGrid.getNumBricks();
+	if(dataItem->hasNPOTDTextures)
+		{
+		/* Use the number of bricks directly: */
+		dataItem->occupancyTextureSize=numBricks;
+		}
+	else
+		{
+		/* Pad to the next power of two: */
+		for(int i=0;i<3;++i)
+			for(dataItem->occupancyTextureSize[i]=1;dataItem->occupancyTextureSize[i]<numBricks[i];dataItem->occupancyTextureSize[i]<<=1)
+				;
+		}
+	
+	/* Create the brick occupancy texture and upload the initial classification: */
+	glBindTexture(GL_TEXTURE_3D_EXT,dataItem->occupancyTextureID);
+	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_R_EXT,GL_CLAMP_TO_EDGE);
+	glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+	glTexImage3DEXT(GL_TEXTURE_3D_EXT,0,GL_INTENSITY,dataItem->occupancyTextureSize,0,GL_LUMINANCE,GL_UNSIGNED_BYTE,0);
+	glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,numBricks,GL_LUMINANCE,GL_UNSIGNED_BYTE,dataItem->occupancy.getOccupancy());
+	glBindTexture(GL_TEXTURE_3D_EXT,0);
+	dataItem->occupancyTextureVersion=dataItem->occupancy.getVersion();
 	}
 
 void Raycaster::initShader(Raycaster::DataItem* dataItem) const
@@ -179,6 +225,12 @@ void Raycaster::initShader(Raycaster::DataItem* dataItem) const
 	
 	dataItem->eyePositionLoc=dataItem->shader.getUniformLocation("eyePosition");
 	dataItem->stepSizeLoc=dataItem->shader.getUniformLocation("stepSize");
+	
+	dataItem->bcScaleLoc=dataItem->shader.getUniformLocation("bcScale");
+	dataItem->bcOffsetLoc=dataItem->shader.getUniformLocation("bcOffset");
+	dataItem->occupancySamplerLoc=dataItem->shader.getUniformLocation("occupancySampler");
+	dataItem->occupancySizeLoc=dataItem->shader.getUniformLocation("occupancySize");
+	dataItem->occupancyTextureSizeLoc=dataItem->shader.getUniformLocation("occupancyTextureSize");
 	}
 
 void Raycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::PTransform& mv,SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const
@@ -204,14 +256,49 @@ void Raycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::PTr
 	
 	/* Set the sampling step size: */
 	glUniform1fARB(dataItem->stepSizeLoc,stepSize*cellSize);
+	
+	/* Set up the brick space transformation: */
+	glUniform3fvARB(dataItem->bcScaleLoc,1,dataItem->bcScale);
+	glUniform3fvARB(dataItem->bcOffsetLoc,1,dataItem->bcOffset);
+	
+	/* Bind the brick occupancy texture: */
+	glActiveTextureARB(GL_TEXTURE1_ARB);
+	glBindTexture(GL_TEXTURE_3D_EXT,dataItem->occupancyTextureID);
+	glUniform1iARB(dataItem->occupancySamplerLoc,1);
+	const OccupancyGrid::Size3& numBricks=occupancyGrid.getNumBricks();
+	glUniform3fARB(dataItem->occupancySizeLoc,float(numBricks[0]),float(numBricks[1]),float(numBricks[2]));
+	const Size3& ots=dataItem->occupancyTextureSize;
+	glUniform3fARB(dataItem->occupancyTextureSizeLoc,float(ots[0]),float(ots[1]),float(ots[2]));
+	
+	/* Check if the occupancy texture needs to be updated: */
+	classifyOccupancy(dataItem);
+	if(dataItem->occupancyTextureVersion!=dataItem->occupancy.getVersion())
+		{
+		/* Upload the new brick classification: */
+		glPixelStorei(GL_UNPACK_ALIGNMENT,1);
+		glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,numBricks,GL_LUMINANCE,GL_UNSIGNED_BYTE,dataItem->occupancy.getOccupancy());
+		
+		/* Mark the occupancy texture as up-to-date: */
+		dataItem->occupancyTextureVersion=dataItem->occupancy.getVersion();
+		}
 	}
 
 void Raycaster::unbindShader(SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const
 	{
+	/* Unbind the brick occupancy texture: */
+	glActiveTextureARB(GL_TEXTURE1_ARB);
+	glBindTexture(GL_TEXTURE_3D_EXT,0);
+	
 	/* Reset the active texture unit: */
 	glActiveTextureARB(GL_TEXTURE0_ARB);
 	}
 
+bool Raycaster::classifyOccupancy(Raycaster::DataItem* dataItem) const
+	{
+	/* Without transfer functions, all bricks remain occupied: */
+	return false;
+	}
+
 Polyhedron<Raycaster::Scalar>* Raycaster::clipDomain(const Raycaster::PTransform& mv,SceneGraph::GLRenderState& renderState) const
 	{
 	typedef Polyhedron<Scalar> PH;
@@ -243,11 +330,12 @@ Polyhedron<Raycaster::Scalar>* Raycaster::clipDomain(const Raycaster::PTransform
 	return clippedDomain;
 	}
 
-Raycaster::Raycaster(const Raycaster::Size3& sDataSize,const Raycaster::Box& sDomain)
+Raycaster::Raycaster(const Raycaster::Size3& sDataSize,const Raycaster::Box& sDomain,int numChannels)
 	:GLObject(false),
 	 dataSize(sDataSize),
 	 domain(sDomain),domainExtent(0),cellSize(0),
 	 renderDomain(Polyhedron<Scalar>::Point(domain.min),Polyhedron<Scalar>::Point(domain.max)),
+	 occupancyGrid(dataSize,8,numChannels),
 	 stepSize(1)
 	{
 	/* Calculate the data strides and cell size: */
@@ -1,7 +1,7 @@
 /***********************************************************************
 Raycaster - Base class for volume renderers for Cartesian gridded data
 using GLSL shaders.
-Copyright (c) 2007-2023 Oliver Kreylos
+Copyright (c) 2007-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -33,6 +33,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLShader.h>
 
 #include <Polyhedron.h>
+#include <OccupancyGrid.h>
 
 /* Forward declarations: */
 namespace SceneGraph {
@@ -78,8 +79,19 @@ class Raycaster:public GLObject
 		int eyePositionLoc; // Location of the eye position uniform variable
 		int stepSizeLoc; // Location of the step size uniform variable
 		
+		OccupancyGrid::Classification occupancy; // Classification of the volume's bricks against the current transfer functions
+		GLuint occupancyTextureID; // Texture object ID of the brick occupancy texture used for empty-space skipping
+		Size3 occupancyTextureSize; // Size of the brick occupancy texture, padded to powers of two if non-power of two textures are not supported
+		unsigned int occupancyTextureVersion; // Version number of the occupancy classification in the occupancy texture
+		Scalar bcScale[3],bcOffset[3]; // Scale factors and offsets from data space to brick space
+		int bcScaleLoc; // Location of the scale factors from data coordinates to brick coordinates
+		int bcOffsetLoc; // Location of the offset from data coordinates to brick coordinates
+		int occupancySamplerLoc; // Location of the occupancy texture sampler uniform variable
+		int occupancySizeLoc; // Location of the occupancy grid size uniform variable
+		int occupancyTextureSizeLoc; // Location of the occupancy texture size uniform variable
+		
 		/* Constructors and destructors: */
-		DataItem(void);
+		DataItem(const OccupancyGrid& occupancyGrid); // Creates a data item for a raycaster with the given occupancy grid
 		virtual ~DataItem(void);
 		
 		/* Methods: */
@@ -94,6 +106,7 @@ class Raycaster:public GLObject
 	Scalar domainExtent; // Length of longest ray through domain
 	Scalar cellSize; // The data set's cell size
 	Polyhedron<Scalar> renderDomain; // Polyhedron used to render the clipped data set
+	OccupancyGrid occupancyGrid; // Per-brick value ranges of the volume data for empty-space skipping
 	
 	Scalar stepSize; // The ray casting step size in cell size units
 	
@@ -103,11 +116,12 @@ class Raycaster:public GLObject
 	virtual void initShader(DataItem* dataItem) const; // Initializes the GLSL raycasting shader
 	virtual void bindShader(const PTransform& pmv,const PTransform& mv,SceneGraph::GLRenderState& renderState,DataItem* dataItem) const; // Prepares the GLSL raycasting shader for rendering
 	virtual void unbindShader(SceneGraph::GLRenderState& renderState,DataItem* dataItem) const; // Unbinds the GLSL raycasting shader after rendering
+	virtual bool classifyOccupancy(DataItem* dataItem) const; // Classifies the volume's bricks against the current transfer functions; returns true if the occupancy texture needs to be updated
 	Polyhedron<Scalar>* clipDomain(const PTransform& mv,SceneGraph::GLRenderState& renderState) const; // Clips the domain against the view frustum and all clipping planes and returns the resulting polyhedron
 	
 	/* Constructors and destructors: */
 	public:
-	Raycaster(const Size3& sDataSize,const Box& sDomain); // Creates a raycaster for the given data and domain sizes
+	Raycaster(const Size3& sDataSize,const Box& sDomain,int numChannels); // Creates a raycaster for the given data and domain sizes and number of interleaved data channels
 	virtual ~Raycaster(void); // Destroys the raycaster
 	
 	/* New methods: */
@@ -135,6 +149,10 @@ class Raycaster:public GLObject
 		{
 		return cellSize;
 		}
+	const OccupancyGrid& getOccupancyGrid(void) const // Returns the raycaster's brick occupancy grid
+		{
+		return occupancyGrid;
+		}
 	Scalar getStepSize(void) const // Returns the raycaster's step size in cell size units
 		{
 		return stepSize;
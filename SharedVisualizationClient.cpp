@@ -2,7 +2,7 @@
 SharedVisualizationClient - Client for collaborative data exploration in
 spatially distributed VR environments, implemented as a plug-in of the
 Vrui remote collaboration infrastructure.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,19 +25,28 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <stdexcept>
 #include <Misc/SizedTypes.h>
+#include <Misc/MessageLogger.h>
+#include <IO/FixedMemoryFile.h>
 #include <Threads/FunctionCalls.h>
+#include <Geometry/Point.h>
+#include <Geometry/Box.h>
+#include <Geometry/OrthogonalTransformation.h>
 #include <Vrui/Vrui.h>
+#include <Vrui/Viewer.h>
 #include <Collaboration2/MessageWriter.h>
 #include <Collaboration2/DataType.icpp>
 #include <Collaboration2/MessageContinuation.h>
 #include <Collaboration2/NonBlockSocket.h>
 #include <Collaboration2/Client.h>
 
+#include <Abstract/DataSet.h>
 #include <Abstract/VariableManager.h>
 #include <Abstract/Parameters.h>
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 
+#include "Extractor.h"
+#include "ExtractorLocator.h"
 #include "ElementList.h"
 
 // DEBUGGING
@@ -51,20 +60,56 @@ namespace Plugins {
 Methods of class SharedVisualizationClient:
 ******************************************/
 
+/**************************************************************
+Declaration of class SharedVisualizationClient::TrackerPreview:
+**************************************************************/
+
+class SharedVisualizationClient::TrackerPreview:public Extractor
+	{
+	/* Constructors and destructors: */
+	public:
+	TrackerPreview(Algorithm* sExtractor) // Creates a preview extractor for the given algorithm; inherits algorithm
+		:Extractor(sExtractor)
+		{
+		}
+	
+	/* Methods from class Extractor: */
+	virtual void updateExtractor(void)
+		{
+		/* Wake up the main thread to display the new preview: */
+		Vrui::requestUpdate();
+		}
+	};
+
 /*********************************************************
 Methods of class SharedVisualizationClient::SharedElement:
 *********************************************************/
 
 SharedVisualizationClient::SharedElement::~SharedElement(void)
 	{
-	/* Destroy the algorithm used to create the element: */
-	delete algorithm;
+	/* Destroy the extraction parameters and downloaded geometry if the element was never extracted: */
+	delete extractionParameters;
+	delete geometry;
 	
 	/* Destroy the shared parameters structure: */
 	if(parameters!=0)
 		elementTypes.destroyObject(parametersType,parameters);
 	}
 
+/*********************************************************
+Methods of class SharedVisualizationClient::SharedTracker:
+*********************************************************/
+
+SharedVisualizationClient::SharedTracker::~SharedTracker(void)
+	{
+	/* Stop a remote tracker's preview extractor, which also removes its current preview from Vrui's scene graph: */
+	delete preview;
+	
+	/* Destroy the shared parameters structure: */
+	if(parameters!=0)
+		trackerTypes.destroyObject(parametersType,parameters);
+	}
+
 MessageContinuation* SharedVisualizationClient::connectRejectCallback(unsigned int messageId,MessageContinuation* continuation)
 	{
 	/* Signal a bad connection: */
@@ -144,6 +189,142 @@ MessageContinuation* SharedVisualizationClient::colorMapUpdatedNotificationCallb
 	return continuation;
 	}
 
+MessageContinuation* SharedVisualizationClient::downloadGeometryReplyCallback(unsigned int messageId,MessageContinuation* continuation)
+	{
+	/* Check if this is the start of a new message: */
+	if(continuation==0)
+		{
+		/* Prepare to read the download geometry reply message: */
+		continuation=protocolTypes.prepareReading(serverMessageTypes[DownloadGeometryReply],new DownloadGeometryReplyMsg);
+		}
+	
+	/* Continue reading the download geometry reply message and check whether it's complete: */
+	if(protocolTypes.continueReading(client->getSocket(),continuation))
+		{
+		/* Hand the download geometry reply message to the main thread: */
+		{
+		Threads::Mutex::Lock receivedGeometryLock(receivedGeometryMutex);
+		receivedGeometry.push_back(protocolTypes.getReadObject<DownloadGeometryReplyMsg>(continuation));
+		}
+		Vrui::requestUpdate();
+		
+		/* Delete the continuation object: */
+		delete continuation;
+		continuation=0;
+		}
+	
+	return continuation;
+	}
+
+double SharedVisualizationClient::estimateExtractionCost(const Visualization::Abstract::Element* element) const
+	{
+	/* Seeded elements visit roughly one data set cell per extracted primitive: */
+	Visualization::Abstract::Parameters::SeedPoint seedPoint;
+	if(element->getParameters()->getSeedPoint(seedPoint))
+		return double(element->getSize());
+	
+	/* Global elements visit all data set cells: */
+	return numDataSetCells;
+	}
+
+void SharedVisualizationClient::uploadGeometry(SharedVisualizationClient::SharedElement* sharedElement)
+	{
+	/* Write the element's geometry into a memory buffer: */
+	size_t geometrySize=sharedElement->element->getGeometrySize();
+	IO::FixedMemoryFile geometryFile(geometrySize);
+	sharedElement->element->writeGeometry(geometryFile);
+	geometryFile.flush();
+	
+	/* Send the element's geometry to the server: */
+	UploadGeometryRequestMsg uploadGeometryRequest;
+	uploadGeometryRequest.elementId=ElementID(sharedElement->objectId);
+	const Misc::UInt8* gPtr=static_cast<const Misc::UInt8*>(geometryFile.getMemory());
+	for(size_t i=0;i<geometrySize;++i,++gPtr)
+		uploadGeometryRequest.geometry.push_back(*gPtr);
+	sendServerMessage(UploadGeometryRequest,&uploadGeometryRequest,false);
+	}
+
+Visualization::Abstract::Algorithm* SharedVisualizationClient::getAlgorithm(unsigned int algorithmIndex)
+	{
+	/* Check if the algorithm has not been requested before: */
+	if(algorithms[algorithmIndex]==0)
+		{
+		/* Create the algorithm and retrieve its default parameters: */
+		if(algorithmIndex<numScalarAlgorithms)
+			algorithms[algorithmIndex]=module->getScalarAlgorithm(algorithmIndex,variableManager,Vrui::openPipe());
+		else
+			algorithms[algorithmIndex]=module->getVectorAlgorithm(algorithmIndex-numScalarAlgorithms,variableManager,Vrui::openPipe());
+		algorithmParameters[algorithmIndex]=algorithms[algorithmIndex]->cloneParameters();
+		}
+	
+	return algorithms[algorithmIndex];
+	}
+
+void SharedVisualizationClient::readExtractionParameters(SharedVisualizationClient::SharedElement* sharedElement)
+	{
+	/* Create extraction parameters from the algorithm's default parameters if the element doesn't have them yet: */
+	if(sharedElement->extractionParameters==0)
+		{
+		getAlgorithm(sharedElement->algorithmIndex);
+		sharedElement->extractionParameters=algorithmParameters[sharedElement->algorithmIndex]->clone();
+		}
+	
+	/* Read the extraction parameters from the shared parameters structure: */
+	sharedElement->extractionParameters->read(sharedElement->parameters,variableManager);
+	
+	/* Retrieve the element's seed point to prioritize its extraction: */
+	sharedElement->haveSeedPoint=sharedElement->extractionParameters->getSeedPoint(sharedElement->seedPoint);
+	}
+
+void SharedVisualizationClient::scheduleExtractions(void)
+	{
+	/* Get the viewer's position in navigational coordinates to prioritize elements close to the viewer: */
+	Visualization::Abstract::Parameters::SeedPoint viewerPos(Vrui::getInverseNavigationTransformation().transform(Vrui::getMainViewer()->getHeadPosition()));
+	
+	/* Start extraction jobs until the job limit is reached or no more elements can be extracted: */
+	while(numExtractingElements<maxNumExtractingElements)
+		{
+		/* Find the highest-priority waiting element whose algorithm is idle; visible before hidden, downloaded before extracted, seeded before global, close before distant, and early before late: */
+		std::vector<SharedElement*>::iterator bestIt=pendingElements.end();
+		int bestRank=0;
+		double bestDist2=0.0;
+		for(std::vector<SharedElement*>::iterator peIt=pendingElements.begin();peIt!=pendingElements.end();++peIt)
+			{
+			SharedElement* se=*peIt;
+			if(algorithmBusy[se->algorithmIndex])
+				continue;
+			
+			int rank=(se->visible?0:4)+(se->geometry!=0?0:2)+(se->haveSeedPoint?0:1);
+			double dist2=se->haveSeedPoint?Geometry::sqrDist(se->seedPoint,viewerPos):0.0;
+			if(bestIt==pendingElements.end()||bestRank>rank||(bestRank==rank&&bestDist2>dist2))
+				{
+				bestIt=peIt;
+				bestRank=rank;
+				bestDist2=dist2;
+				}
+			}
+		if(bestIt==pendingElements.end())
+			break;
+		
+		/* Remove the element from the waiting list: */
+		SharedElement* sharedElement=*bestIt;
+		pendingElements.erase(bestIt);
+		
+		/* Submit a background job to read or extract the element using its algorithm: */
+		sharedElement->extracting=true;
+		algorithmBusy[sharedElement->algorithmIndex]=true;
+		++numExtractingElements;
+		if(sharedElement->geometry!=0)
+			Vrui::submitJob(*Threads::createFunctionCall(this,&SharedVisualizationClient::readElementJob,sharedElement),*Threads::createFunctionCall(this,&SharedVisualizationClient::extractElementJobComplete,sharedElement));
+		else
+			Vrui::submitJob(*Threads::createFunctionCall(this,&SharedVisualizationClient::extractElementJob,sharedElement),*Threads::createFunctionCall(this,&SharedVisualizationClient::extractElementJobComplete,sharedElement));
+		}
+	
+	/* Notify interested parties of the current extraction progress: */
+	ReplayProgressCallbackData cbData(this,(unsigned int)(pendingElements.size()),numExtractingElements,numExtractedElements);
+	replayProgressCallbacks.call(&cbData);
+	}
+
 void* SharedVisualizationClient::createElementFunction(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,DataType::TypeID type,void* userData)
 	{
 	SharedVisualizationClient* thisPtr=static_cast<SharedVisualizationClient*>(userData);
@@ -154,18 +335,35 @@ void* SharedVisualizationClient::createElementFunction(KoinoniaClient* client,Ko
 
 void SharedVisualizationClient::extractElementJobComplete(Threads::WorkerPool::JobFunction* job,SharedVisualizationClient::SharedElement* sharedElement)
 	{
+	/* Release the element's algorithm and job slot: */
+	sharedElement->extracting=false;
+	algorithmBusy[sharedElement->algorithmIndex]=false;
+	--numExtractingElements;
+	
 	/* Check whether the element hasn't been destroyed already: */
 	if(!sharedElement->destroyed)
 		{
-		/* Add the shared element to the secondary map: */
-		sharedElementsByElement.setEntry(SharedElementByElementMap::Entry(sharedElement->element,sharedElement));
-		
-		/* Add the extracted element to the element list and set its visibility: */
-		elementList->addElement(sharedElement->algorithm,sharedElement->element,true);
-		elementList->setElementVisible(sharedElement->element,sharedElement->visible,true);
-		
-		/* Register a parameters updated callback with the new element: */
-		sharedElement->element->getParametersUpdatedCallbacks().add(this,&SharedVisualizationClient::elementParametersUpdatedCallback);
+		if(sharedElement->element!=0)
+			{
+			/* Update the element's parameters if they were replaced during extraction: */
+			if(sharedElement->replaced)
+				{
+				sharedElement->element->getParameters()->read(sharedElement->parameters,variableManager);
+				sharedElement->replaced=false;
+				}
+			
+			/* Add the shared element to the secondary map: */
+			sharedElementsByElement.setEntry(SharedElementByElementMap::Entry(sharedElement->element,sharedElement));
+			
+			/* Add the extracted element to the element list and set its visibility: */
+			elementList->addElement(algorithms[sharedElement->algorithmIndex],sharedElement->element,true);
+			elementList->setElementVisible(sharedElement->element,sharedElement->visible,true);
+			
+			/* Register a parameters updated callback with the new element: */
+			sharedElement->element->getParametersUpdatedCallbacks().add(this,&SharedVisualizationClient::elementParametersUpdatedCallback);
+			
+			++numExtractedElements;
+			}
 		}
 	else
 		{
@@ -173,20 +371,53 @@ void SharedVisualizationClient::extractElementJobComplete(Threads::WorkerPool::J
 		sharedElementsById.removeEntry(sharedElement->objectId);
 		delete sharedElement;
 		}
+	
+	/* Start extracting the next waiting elements: */
+	scheduleExtractions();
 	}
 
 void SharedVisualizationClient::extractElementJob(int,SharedVisualizationClient::SharedElement* sharedElement)
 	{
-	/* Get an algorithm to create the new element: */
-	if(sharedElement->algorithmIndex<numScalarAlgorithms)
-		sharedElement->algorithm=module->getScalarAlgorithm(sharedElement->algorithmIndex,variableManager,Vrui::openPipe());
-	else
-		sharedElement->algorithm=module->getVectorAlgorithm(sharedElement->algorithmIndex-numScalarAlgorithms,variableManager,Vrui::openPipe());
+	/* Extract the element using its algorithm, which inherits the extraction parameters: */
+	Visualization::Abstract::Parameters* parameters=sharedElement->extractionParameters;
+	sharedElement->extractionParameters=0;
+	try
+		{
+		sharedElement->element=algorithms[sharedElement->algorithmIndex]->createElement(parameters);
+		}
+	catch(const std::runtime_error& err)
+		{
+		/* Leave the shared element without a visualization element: */
+		Misc::formattedUserError("SharedVisualizationClient: Unable to extract shared element due to exception %s",err.what());
+		}
+	}
+
+void SharedVisualizationClient::readElementJob(int,SharedVisualizationClient::SharedElement* sharedElement)
+	{
+	/* Create the element from its downloaded geometry using its algorithm, which inherits the extraction parameters: */
+	Visualization::Abstract::Parameters* parameters=sharedElement->extractionParameters;
+	sharedElement->extractionParameters=0;
+	try
+		{
+		/* Copy the downloaded geometry into a memory buffer: */
+		const Geometry& geometry=sharedElement->geometry->geometry;
+		size_t geometrySize=geometry.size();
+		IO::FixedMemoryFile geometryFile(geometrySize);
+		Misc::UInt8* gPtr=static_cast<Misc::UInt8*>(geometryFile.getMemory());
+		for(size_t i=0;i<geometrySize;++i,++gPtr)
+			*gPtr=geometry[i];
+		
+		sharedElement->element=algorithms[sharedElement->algorithmIndex]->readElement(parameters,geometryFile);
+		}
+	catch(const std::runtime_error& err)
+		{
+		/* Leave the shared element without a visualization element: */
+		Misc::formattedUserError("SharedVisualizationClient: Unable to read shared element due to exception %s",err.what());
+		}
 	
-	/* Extract the element using the received extraction parameters: */
-	Visualization::Abstract::Parameters* parameters=sharedElement->algorithm->cloneParameters();
-	parameters->read(sharedElement->parameters,variableManager);
-	sharedElement->element=sharedElement->algorithm->createElement(parameters);
+	/* Release the downloaded geometry: */
+	delete sharedElement->geometry;
+	sharedElement->geometry=0;
 	}
 
 void SharedVisualizationClient::elementCreatedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData)
@@ -199,8 +430,24 @@ void SharedVisualizationClient::elementCreatedCallback(KoinoniaClient* client,Ko
 	sharedElement->parametersType=thisPtr->algorithmParameterTypes[sharedElement->algorithmIndex];
 	thisPtr->sharedElementsById.setEntry(SharedElementByIDMap::Entry(sharedElement->objectId,sharedElement));
 	
-	/* Submit a background job to extract the new element: */
-	Vrui::submitJob(*Threads::createFunctionCall(thisPtr,&SharedVisualizationClient::extractElementJob,sharedElement),*Threads::createFunctionCall(thisPtr,&SharedVisualizationClient::extractElementJobComplete,sharedElement));
+	/* Read the new element's extraction parameters: */
+	thisPtr->readExtractionParameters(sharedElement);
+	
+	/* Check if the client that extracted the element shared its geometry: */
+	if(sharedElement->sharedGeometry)
+		{
+		/* Request the element's geometry from the server instead of extracting it: */
+		sharedElement->downloading=true;
+		DownloadGeometryRequestMsg downloadGeometryRequest;
+		downloadGeometryRequest.elementId=ElementID(objectId);
+		thisPtr->sendServerMessage(DownloadGeometryRequest,&downloadGeometryRequest,false);
+		}
+	else
+		{
+		/* Queue the element for extraction: */
+		thisPtr->pendingElements.push_back(sharedElement);
+		thisPtr->scheduleExtractions();
+		}
 	}
 
 void SharedVisualizationClient::elementReplacedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,KoinoniaProtocol::VersionNumber newVersion,void* object,void* userData)
@@ -210,15 +457,23 @@ void SharedVisualizationClient::elementReplacedCallback(KoinoniaClient* client,K
 	/* Access the shared element: */
 	SharedElement* sharedElement=thisPtr->sharedElementsById.getEntry(objectId).getDest();
 	
-	/* Update the shared element's parameters: */
-	sharedElement->element->getParameters()->read(sharedElement->parameters,thisPtr->variableManager);
-	
 	/* Check if the element has already been added to the element list: */
 	if(sharedElement->element!=0)
 		{
-		/* Update the element's visibility in the element list: */
+		/* Update the element's parameters and its visibility in the element list: */
+		sharedElement->element->getParameters()->read(sharedElement->parameters,thisPtr->variableManager);
 		thisPtr->elementList->setElementVisible(sharedElement->element,sharedElement->visible,true);
 		}
+	else if(sharedElement->extracting)
+		{
+		/* Update the element's parameters once it is done extracting: */
+		sharedElement->replaced=true;
+		}
+	else if(sharedElement->extractionParameters!=0)
+		{
+		/* Update the waiting element's extraction parameters and priority: */
+		thisPtr->readExtractionParameters(sharedElement);
+		}
 	}
 
 void SharedVisualizationClient::elementDestroyedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData)
@@ -239,11 +494,25 @@ void SharedVisualizationClient::elementDestroyedCallback(KoinoniaClient* client,
 		thisPtr->sharedElementsByElement.removeEntry(sharedElement->element);
 		delete sharedElement;
 		}
-	else
+	else if(sharedElement->extracting||sharedElement->downloading)
 		{
-		/* Mark the element for deletion once it's done extracting: */
+		/* Mark the element for deletion once it's done extracting or its geometry arrives: */
 		sharedElement->destroyed=true;
 		}
+	else
+		{
+		/* Remove the element from the waiting list if it is still there to skip its extraction: */
+		for(std::vector<SharedElement*>::iterator peIt=thisPtr->pendingElements.begin();peIt!=thisPtr->pendingElements.end();++peIt)
+			if(*peIt==sharedElement)
+				{
+				thisPtr->pendingElements.erase(peIt);
+				break;
+				}
+		
+		/* Remove the shared element from the primary hash table and delete it: */
+		thisPtr->sharedElementsById.removeEntry(sharedElement->objectId);
+		delete sharedElement;
+		}
 	}
 
 void SharedVisualizationClient::elementParametersUpdatedCallback(Visualization::Abstract::Element::ParametersUpdatedCallbackData* cbData)
@@ -256,6 +525,116 @@ void SharedVisualizationClient::elementParametersUpdatedCallback(Visualization::
 	koinonia->replaceNsObject(elementNamespaceId,sharedElement->objectId);
 	}
 
+void SharedVisualizationClient::sendTrackingUpdate(SharedVisualizationClient::SharedTracker* tracker,double now)
+	{
+	/* Send the tracker's most recent extraction parameters to the server: */
+	koinonia->replaceNsObject(trackerNamespaceId,tracker->objectId);
+	tracker->updatePending=false;
+	tracker->lastSendTime=now;
+	
+	/* Update the bandwidth counters: */
+	++trackingStatistics.numUpdatesSent;
+	trackingStatistics.numBytesSent+=trackerTypeDictionary.calcSize(trackerTypes[tracker->algorithmIndex],tracker);
+	}
+
+void SharedVisualizationClient::postTrackingUpdate(SharedVisualizationClient::SharedTracker* tracker)
+	{
+	/* Update the bandwidth counters: */
+	++trackingStatistics.numUpdatesReceived;
+	trackingStatistics.numBytesReceived+=trackerTypeDictionary.calcSize(trackerTypes[tracker->algorithmIndex],tracker);
+	
+	/* Drop the update if a newer update of the same tool interaction was already posted, accounting for sequence number wrap-around: */
+	if(tracker->lastSequenceNumber!=0&&Misc::SInt32(tracker->sequenceNumber-tracker->lastSequenceNumber)<=0)
+		{
+		++trackingStatistics.numStaleUpdates;
+		return;
+		}
+	
+	/* Read the update's extraction parameters and post them to the preview extractor, which drops them if a newer update arrives before it gets to them: */
+	Visualization::Abstract::Parameters* parameters=tracker->preview->getExtractor()->cloneParameters();
+	parameters->read(tracker->parameters,variableManager);
+	tracker->preview->seedRequest(tracker->sequenceNumber,parameters);
+	
+	/* Remember when the update was received to measure the preview's latency: */
+	tracker->lastSequenceNumber=tracker->sequenceNumber;
+	tracker->lastReceiveTime=Vrui::getApplicationTime();
+	tracker->latencyMeasured=false;
+	}
+
+void SharedVisualizationClient::updateTrackerPreview(SharedVisualizationClient::SharedTracker* tracker,double now)
+	{
+	/* Display the most recent preview; the final element of a finished interaction arrives through the element namespace: */
+	unsigned int oldPreviewId=tracker->preview->getTrackedElementID();
+	tracker->preview->checkUpdates();
+	unsigned int previewId=tracker->preview->getTrackedElementID();
+	if(previewId!=oldPreviewId)
+		{
+		++trackingStatistics.numPreviewsDisplayed;
+		
+		/* Measure the latency of the most recent update if its preview is now displayed: */
+		if(!tracker->latencyMeasured&&previewId==tracker->lastSequenceNumber)
+			{
+			double latency=now-tracker->lastReceiveTime;
+			++trackingStatistics.numLatencySamples;
+			trackingStatistics.latencySum+=latency;
+			if(trackingStatistics.maxLatency<latency)
+				trackingStatistics.maxLatency=latency;
+			tracker->latencyMeasured=true;
+			}
+		}
+	}
+
+void* SharedVisualizationClient::createTrackerFunction(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,DataType::TypeID type,void* userData)
+	{
+	SharedVisualizationClient* thisPtr=static_cast<SharedVisualizationClient*>(userData);
+	
+	/* Return a new shared tracker structure: */
+	return new SharedTracker(thisPtr->trackerTypeDictionary);
+	}
+
+void SharedVisualizationClient::trackerCreatedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData)
+	{
+	SharedVisualizationClient* thisPtr=static_cast<SharedVisualizationClient*>(userData);
+	
+	/* Add the new remote tracker to the map: */
+	SharedTracker* tracker=static_cast<SharedTracker*>(object);
+	tracker->objectId=objectId;
+	tracker->parametersType=thisPtr->trackerParameterTypes[tracker->algorithmIndex];
+	thisPtr->remoteTrackers.setEntry(RemoteTrackerMap::Entry(tracker->objectId,tracker));
+	
+	/* Create a preview extractor with its own instance of the tracker's algorithm: */
+	Visualization::Abstract::Algorithm* algorithm;
+	if(tracker->algorithmIndex<thisPtr->numScalarAlgorithms)
+		algorithm=thisPtr->module->getScalarAlgorithm(tracker->algorithmIndex,thisPtr->variableManager,Vrui::openPipe());
+	else
+		algorithm=thisPtr->module->getVectorAlgorithm(tracker->algorithmIndex-thisPtr->numScalarAlgorithms,thisPtr->variableManager,Vrui::openPipe());
+	tracker->preview=new TrackerPreview(algorithm);
+	
+	/* Start extracting the first preview: */
+	thisPtr->postTrackingUpdate(tracker);
+	}
+
+void SharedVisualizationClient::trackerReplacedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,KoinoniaProtocol::VersionNumber newVersion,void* object,void* userData)
+	{
+	SharedVisualizationClient* thisPtr=static_cast<SharedVisualizationClient*>(userData);
+	
+	/* Post the remote tracker's new update to its preview extractor: */
+	thisPtr->postTrackingUpdate(static_cast<SharedTracker*>(object));
+	}
+
+void SharedVisualizationClient::trackerDestroyedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData)
+	{
+	SharedVisualizationClient* thisPtr=static_cast<SharedVisualizationClient*>(userData);
+	
+	/* Remove the remote tracker from the map: */
+	SharedTracker* tracker=static_cast<SharedTracker*>(object);
+	thisPtr->remoteTrackers.removeEntry(tracker->objectId);
+	
+	/* Retire the tracker once its preview extractor finishes the most recent update: */
+	tracker->preview->finalize(tracker->lastSequenceNumber);
+	thisPtr->retiringTrackers.push_back(tracker);
+	}
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Winvalid-offsetof"
 
@@ -266,8 +645,33 @@ SharedVisualizationClient::SharedVisualizationClient(Client* sClient,Visualizati
 	 receivedReply(false),connected(false),
 	 numScalarAlgorithms(module->getNumScalarAlgorithms()),numVectorAlgorithms(variableManager->getNumVectorVariables()>0?module->getNumVectorAlgorithms():0),
 	 algorithmParameterTypes(new DataType::TypeID[numScalarAlgorithms+numVectorAlgorithms]),elementTypes(new DataType::TypeID[numScalarAlgorithms+numVectorAlgorithms]),
-	 sharedElementsById(17),sharedElementsByElement(17)
+	 sharedElementsById(17),sharedElementsByElement(17),
+	 algorithms(new Visualization::Abstract::Algorithm*[numScalarAlgorithms+numVectorAlgorithms]),
+	 algorithmParameters(new Visualization::Abstract::Parameters*[numScalarAlgorithms+numVectorAlgorithms]),
+	 algorithmBusy(new bool[numScalarAlgorithms+numVectorAlgorithms]),
+	 maxNumExtractingElements(2),numExtractingElements(0),numExtractedElements(0),
+	 geometrySharingMode(NEVER_SHARE),geometryBytesPerCell(4.0),maxGeometrySize(size_t(256)<<20),
+	 numDataSetCells(0.0),
+	 trackerParameterTypes(new DataType::TypeID[numScalarAlgorithms+numVectorAlgorithms]),trackerTypes(new DataType::TypeID[numScalarAlgorithms+numVectorAlgorithms]),
+	 localTrackers(17),remoteTrackers(17),
+	 minTrackingInterval(1.0/30.0)
 	{
+	/* Estimate the number of cells in the data set from its domain size and average cell size: */
+	const Visualization::Abstract::DataSet* dataSet=variableManager->getDataSet();
+	Visualization::Abstract::DataSet::Box domain=dataSet->getDomainBox();
+	double cellSize=double(dataSet->calcAverageCellSize());
+	numDataSetCells=1.0;
+	for(int i=0;i<3;++i)
+		numDataSetCells*=double(domain.getSize(i))/cellSize;
+	
+	/* Initialize the algorithm arrays; algorithms are created on first use: */
+	for(unsigned int i=0;i<numScalarAlgorithms+numVectorAlgorithms;++i)
+		{
+		algorithms[i]=0;
+		algorithmParameters[i]=0;
+		algorithmBusy[i]=false;
+		}
+	
 	/* Register all scalar algorithms: */
 	for(unsigned int i=0;i<numScalarAlgorithms;++i)
 		{
@@ -291,8 +695,9 @@ SharedVisualizationClient::SharedVisualizationClient(Client* sClient,Visualizati
 			{DataType::getAtomicType<Misc::UInt8>(),offsetof(SharedElement,algorithmIndex)},
 			{pointerType,offsetof(SharedElement,parameters)},
 			{DataType::getAtomicType<bool>(),offsetof(SharedElement,visible)},
+			{DataType::getAtomicType<bool>(),offsetof(SharedElement,sharedGeometry)},
 			};
-		elementTypes[i]=elementTypeDictionary.createStructure(3,sharedElementElements,sizeof(SharedElement));
+		elementTypes[i]=elementTypeDictionary.createStructure(4,sharedElementElements,sizeof(SharedElement));
 		}
 	
 	/* Create a Koinonia namespace for extracted visualization elements: */
@@ -301,6 +706,30 @@ SharedVisualizationClient::SharedVisualizationClient(Client* sClient,Visualizati
 	                                            elementCreatedCallback,this,
 	                                            elementReplacedCallback,this,
 	                                            elementDestroyedCallback,this);
+	
+	/* Register tracker types for all algorithms: */
+	for(unsigned int i=0;i<numScalarAlgorithms;++i)
+		trackerParameterTypes[i]=module->createScalarAlgorithmParametersType(i,trackerTypeDictionary);
+	for(unsigned int i=0;i<numVectorAlgorithms;++i)
+		trackerParameterTypes[numScalarAlgorithms+i]=module->createVectorAlgorithmParametersType(i,trackerTypeDictionary);
+	for(unsigned int i=0;i<numScalarAlgorithms+numVectorAlgorithms;++i)
+		{
+		DataType::TypeID pointerType=trackerTypeDictionary.createPointer(trackerParameterTypes[i]);
+		DataType::StructureElement sharedTrackerElements[]=
+			{
+			{DataType::getAtomicType<Misc::UInt8>(),offsetof(SharedTracker,algorithmIndex)},
+			{DataType::getAtomicType<Misc::UInt32>(),offsetof(SharedTracker,sequenceNumber)},
+			{pointerType,offsetof(SharedTracker,parameters)}
+			};
+		trackerTypes[i]=trackerTypeDictionary.createStructure(3,sharedTrackerElements,sizeof(SharedTracker));
+		}
+	
+	/* Create a Koinonia namespace for in-progress tool interactions: */
+	trackerNamespaceId=koinonia->shareNamespace("SharedVisualization::Trackers",protocolVersion,trackerTypeDictionary,
+	                                            createTrackerFunction,this,
+	                                            trackerCreatedCallback,this,
+	                                            trackerReplacedCallback,this,
+	                                            trackerDestroyedCallback,this);
 	}
 
 #pragma GCC diagnostic pop
@@ -311,8 +740,32 @@ SharedVisualizationClient::~SharedVisualizationClient(void)
 	for(SharedElementByIDMap::Iterator seIt=sharedElementsById.begin();!seIt.isFinished();++seIt)
 		delete seIt->getDest();
 	
+	/* Destroy all local, remote, and retiring trackers: */
+	for(LocalTrackerMap::Iterator ltIt=localTrackers.begin();!ltIt.isFinished();++ltIt)
+		delete ltIt->getDest();
+	for(RemoteTrackerMap::Iterator rtIt=remoteTrackers.begin();!rtIt.isFinished();++rtIt)
+		delete rtIt->getDest();
+	for(std::vector<SharedTracker*>::iterator rtIt=retiringTrackers.begin();rtIt!=retiringTrackers.end();++rtIt)
+		delete *rtIt;
+	
+	/* Destroy all algorithms and their default parameters: */
+	for(unsigned int i=0;i<numScalarAlgorithms+numVectorAlgorithms;++i)
+		{
+		delete algorithmParameters[i];
+		delete algorithms[i];
+		}
+	delete[] algorithms;
+	delete[] algorithmParameters;
+	delete[] algorithmBusy;
+	
+	/* Destroy all unprocessed received element geometry: */
+	for(std::vector<GeometryMsg*>::iterator rgIt=receivedGeometry.begin();rgIt!=receivedGeometry.end();++rgIt)
+		delete *rgIt;
+	
 	delete[] algorithmParameterTypes;
 	delete[] elementTypes;
+	delete[] trackerParameterTypes;
+	delete[] trackerTypes;
 	}
 
 const char* SharedVisualizationClient::getName(void) const
@@ -344,6 +797,7 @@ void SharedVisualizationClient::setMessageBases(unsigned int newClientMessageBas
 	client->setTCPMessageHandler(serverMessageBase+ConnectReject,Client::wrapMethod<SharedVisualizationClient,&SharedVisualizationClient::connectRejectCallback>,this,0);
 	client->setTCPMessageHandler(serverMessageBase+ConnectReply,Client::wrapMethod<SharedVisualizationClient,&SharedVisualizationClient::connectReplyCallback>,this,getServerMsgSize(ConnectReply));
 	client->setTCPMessageHandler(serverMessageBase+ColorMapUpdatedNotification,Client::wrapMethod<SharedVisualizationClient,&SharedVisualizationClient::colorMapUpdatedNotificationCallback>,this,getServerMsgSize(ColorMapUpdatedNotification));
+	client->setTCPMessageHandler(serverMessageBase+DownloadGeometryReply,Client::wrapMethod<SharedVisualizationClient,&SharedVisualizationClient::downloadGeometryReplyCallback>,this,getServerMsgSize(DownloadGeometryReply));
 	}
 
 void SharedVisualizationClient::start(void)
@@ -367,6 +821,77 @@ bool SharedVisualizationClient::waitForConnection(void)
 	return connected;
 	}
 
+void SharedVisualizationClient::frame(void)
+	{
+	double now=Vrui::getApplicationTime();
+	
+	/* Send coalesced tracking updates of local trackers whose rate limit interval expired: */
+	for(LocalTrackerMap::Iterator ltIt=localTrackers.begin();!ltIt.isFinished();++ltIt)
+		if(ltIt->getDest()->updatePending&&now-ltIt->getDest()->lastSendTime>=minTrackingInterval)
+			sendTrackingUpdate(ltIt->getDest(),now);
+	
+	/* Display the most recent previews of remote trackers: */
+	for(RemoteTrackerMap::Iterator rtIt=remoteTrackers.begin();!rtIt.isFinished();++rtIt)
+		updateTrackerPreview(rtIt->getDest(),now);
+	
+	/* Delete retiring trackers whose preview extractors finished their most recent updates: */
+	for(std::vector<SharedTracker*>::iterator rtIt=retiringTrackers.begin();rtIt!=retiringTrackers.end();)
+		{
+		updateTrackerPreview(*rtIt,now);
+		if(!(*rtIt)->preview->isFinalizationPending())
+			{
+			delete *rtIt;
+			rtIt=retiringTrackers.erase(rtIt);
+			}
+		else
+			++rtIt;
+		}
+	
+	/* Grab the list of element geometry received from the server: */
+	std::vector<GeometryMsg*> geometries;
+	{
+	Threads::Mutex::Lock receivedGeometryLock(receivedGeometryMutex);
+	geometries.swap(receivedGeometry);
+	}
+	if(geometries.empty())
+		return;
+	
+	/* Process all received element geometry: */
+	for(std::vector<GeometryMsg*>::iterator gIt=geometries.begin();gIt!=geometries.end();++gIt)
+		{
+		/* Find the shared element waiting for the geometry: */
+		SharedElementByIDMap::Iterator seIt=sharedElementsById.findEntry(KoinoniaProtocol::ObjectID((*gIt)->elementId));
+		if(seIt.isFinished()||!seIt->getDest()->downloading)
+			{
+			/* Ignore the geometry: */
+			delete *gIt;
+			continue;
+			}
+		SharedElement* sharedElement=seIt->getDest();
+		sharedElement->downloading=false;
+		
+		if(sharedElement->destroyed)
+			{
+			/* Remove the shared element from the primary map and delete it: */
+			sharedElementsById.removeEntry(sharedElement->objectId);
+			delete sharedElement;
+			delete *gIt;
+			}
+		else
+			{
+			/* Queue the element for reading, or for extraction if its geometry was dropped before it was uploaded: */
+			if((*gIt)->geometry.size()>0)
+				sharedElement->geometry=*gIt;
+			else
+				delete *gIt;
+			pendingElements.push_back(sharedElement);
+			}
+		}
+	
+	/* Start reading or extracting the newly queued elements: */
+	scheduleExtractions();
+	}
+
 void SharedVisualizationClient::addElement(Visualization::Abstract::Algorithm* algorithm,Visualization::Abstract::Element* newElement)
 	{
 	/* Create a new shared element: */
@@ -377,9 +902,18 @@ void SharedVisualizationClient::addElement(Visualization::Abstract::Algorithm* a
 	newElement->getParameters()->write(sharedElement->parameters);
 	sharedElement->element=newElement;
 	
+	/* Check whether to share the new element's geometry with other clients instead of letting them extract it: */
+	size_t geometrySize=geometrySharingMode!=NEVER_SHARE?newElement->getGeometrySize():0;
+	if(geometrySize>0&&geometrySize<=maxGeometrySize)
+		sharedElement->sharedGeometry=geometrySharingMode==ALWAYS_SHARE||double(geometrySize)<=estimateExtractionCost(newElement)*geometryBytesPerCell;
+	
 	/* Create a new object in the visualization element namespace: */
 	sharedElement->objectId=koinonia->createNsObject(elementNamespaceId,elementTypes[sharedElement->algorithmIndex],sharedElement);
 	
+	/* Upload the new element's geometry to the server: */
+	if(sharedElement->sharedGeometry)
+		uploadGeometry(sharedElement);
+	
 	/* Add the new shared element to both maps: */
 	sharedElementsById.setEntry(SharedElementByIDMap::Entry(sharedElement->objectId,sharedElement));
 	sharedElementsByElement.setEntry(SharedElementByElementMap::Entry(sharedElement->element,sharedElement));
@@ -388,6 +922,115 @@ void SharedVisualizationClient::addElement(Visualization::Abstract::Algorithm* a
 	sharedElement->element->getParametersUpdatedCallbacks().add(this,&SharedVisualizationClient::elementParametersUpdatedCallback);
 	}
 
+void SharedVisualizationClient::setMaxNumExtractingElements(unsigned int newMaxNumExtractingElements)
+	{
+	maxNumExtractingElements=newMaxNumExtractingElements>0?newMaxNumExtractingElements:1;
+	
+	/* Start additional extraction jobs if the limit was raised: */
+	scheduleExtractions();
+	}
+
+void SharedVisualizationClient::setGeometrySharingMode(SharedVisualizationClient::GeometrySharingMode newGeometrySharingMode)
+	{
+	geometrySharingMode=newGeometrySharingMode;
+	}
+
+void SharedVisualizationClient::setGeometryBytesPerCell(double newGeometryBytesPerCell)
+	{
+	geometryBytesPerCell=newGeometryBytesPerCell;
+	}
+
+void SharedVisualizationClient::setMaxGeometrySize(size_t newMaxGeometrySize)
+	{
+	maxGeometrySize=newMaxGeometrySize;
+	}
+
+void SharedVisualizationClient::postSeedRequest(const ExtractorLocator* locator,unsigned int seedRequestID,Visualization::Abstract::Parameters* seedParameters)
+	{
+	double now=Vrui::getApplicationTime();
+	
+	/* Check if the locator already started sharing its interaction: */
+	LocalTrackerMap::Iterator ltIt=localTrackers.findEntry(locator);
+	if(ltIt.isFinished())
+		{
+		/* Create a new tracker: */
+		SharedTracker* tracker=new SharedTracker(trackerTypeDictionary);
+		tracker->algorithmIndex=algorithmIndices.getEntry(locator->getExtractor()->getName()).getDest();
+		tracker->sequenceNumber=seedRequestID;
+		tracker->parametersType=trackerParameterTypes[tracker->algorithmIndex];
+		tracker->parameters=trackerTypeDictionary.createObject(tracker->parametersType);
+		seedParameters->write(tracker->parameters);
+		tracker->locator=locator;
+		
+		/* Create a new object in the tracker namespace, which sends the first update: */
+		tracker->objectId=koinonia->createNsObject(trackerNamespaceId,trackerTypes[tracker->algorithmIndex],tracker);
+		tracker->lastSendTime=now;
+		++trackingStatistics.numUpdatesSent;
+		trackingStatistics.numBytesSent+=trackerTypeDictionary.calcSize(trackerTypes[tracker->algorithmIndex],tracker);
+		
+		localTrackers.setEntry(LocalTrackerMap::Entry(locator,tracker));
+		}
+	else
+		{
+		/* Coalesce the seed request with any update that has not been sent yet: */
+		SharedTracker* tracker=ltIt->getDest();
+		if(tracker->updatePending)
+			++trackingStatistics.numUpdatesCoalesced;
+		tracker->sequenceNumber=seedRequestID;
+		seedParameters->write(tracker->parameters);
+		tracker->updatePending=true;
+		
+		/* Send the update immediately if the rate limit allows it: */
+		if(now-tracker->lastSendTime>=minTrackingInterval)
+			sendTrackingUpdate(tracker,now);
+		}
+	
+	/* Delete the seed parameters: */
+	delete seedParameters;
+	}
+
+void SharedVisualizationClient::postFinalizationRequest(const ExtractorLocator* locator,unsigned int finalSeedRequestID)
+	{
+	/* Check if the locator shared its interaction: */
+	LocalTrackerMap::Iterator ltIt=localTrackers.findEntry(locator);
+	if(!ltIt.isFinished())
+		{
+		/* Send the final seed request if it is still waiting for the rate limit so that other clients' previews converge: */
+		SharedTracker* tracker=ltIt->getDest();
+		if(tracker->updatePending&&tracker->sequenceNumber==finalSeedRequestID)
+			sendTrackingUpdate(tracker,Vrui::getApplicationTime());
+		
+		/* End the interaction; the final element is shared through the element namespace: */
+		destroyLocator(locator);
+		}
+	}
+
+void SharedVisualizationClient::destroyLocator(const ExtractorLocator* locator)
+	{
+	/* Check if the locator shared its interaction: */
+	LocalTrackerMap::Iterator ltIt=localTrackers.findEntry(locator);
+	if(!ltIt.isFinished())
+		{
+		/* Delete the tracker in the tracker namespace: */
+		SharedTracker* tracker=ltIt->getDest();
+		koinonia->destroyNsObject(trackerNamespaceId,tracker->objectId);
+		
+		/* Remove the tracker from the map and delete it: */
+		localTrackers.removeEntry(ltIt);
+		delete tracker;
+		}
+	}
+
+void SharedVisualizationClient::setMaxTrackingRate(double newMaxTrackingRate)
+	{
+	minTrackingInterval=newMaxTrackingRate>0.0?1.0/newMaxTrackingRate:0.0;
+	}
+
+void SharedVisualizationClient::resetTrackingStatistics(void)
+	{
+	trackingStatistics=TrackingStatistics();
+	}
+
 void SharedVisualizationClient::setElementVisible(Visualization::Abstract::Element* element,bool newVisible)
 	{
 	/* Find the shared element associated with the given visualization element: */
@@ -409,6 +1052,14 @@ void SharedVisualizationClient::deleteElement(Visualization::Abstract::Element*
 	/* Delete the shared element in the visualization element namespace: */
 	koinonia->destroyNsObject(elementNamespaceId,sharedElement->objectId);
 	
+	/* Release the element's geometry on the server: */
+	if(sharedElement->sharedGeometry)
+		{
+		DropGeometryRequestMsg dropGeometryRequest;
+		dropGeometryRequest.elementId=ElementID(sharedElement->objectId);
+		sendServerMessage(DropGeometryRequest,&dropGeometryRequest,false);
+		}
+	
 	/* Remove the shared element from both hash tables and delete it: */
 	sharedElementsById.removeEntry(sharedElement->objectId);
 	sharedElementsByElement.removeEntry(sharedElement->element);
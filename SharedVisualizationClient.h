@@ -2,7 +2,7 @@
 SharedVisualizationClient - Client for collaborative data exploration in
 spatially distributed VR environments, implemented as a plug-in of the
 Vrui remote collaboration infrastructure.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -24,8 +24,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef SHAREDVISUALIZATIONCLIENT_INCLUDED
 #define SHAREDVISUALIZATIONCLIENT_INCLUDED
 
+#include <vector>
 #include <Misc/StandardHashFunction.h>
 #include <Misc/HashTable.h>
+#include <Misc/CallbackData.h>
+#include <Misc/CallbackList.h>
+#include <Threads/Mutex.h>
 #include <Threads/MutexCond.h>
 #include <Threads/WorkerPool.h>
 #include <Collaboration2/MessageBuffer.h>
@@ -36,6 +40,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Collaboration2/Plugins/KoinoniaClient.h>
 
 #include <Abstract/Module.h>
+#include <Abstract/Parameters.h>
 #include <Abstract/Element.h>
 
 #include "SharedVisualizationProtocol.h"
@@ -54,6 +59,7 @@ class Algorithm;
 }
 }
 class ElementList;
+class ExtractorLocator;
 
 namespace Collab {
 
@@ -62,29 +68,133 @@ namespace Plugins {
 class SharedVisualizationClient:public PluginClient,public SharedVisualizationProtocol
 	{
 	/* Embedded classes: */
+	public:
+	enum GeometrySharingMode // Enumerated type for policies to share the geometry of locally extracted visualization elements
+		{
+		NEVER_SHARE, // Other clients always extract elements from their parameters
+		ALWAYS_SHARE, // Other clients download the geometry of all elements that support it
+		AUTO_SHARE // Other clients download the geometry of elements whose estimated extraction cost exceeds the cost of transferring their geometry
+		};
+	
+	struct ReplayProgressCallbackData:public Misc::CallbackData // Callback data sent when the progress of extracting shared elements changes
+		{
+		/* Elements: */
+		public:
+		SharedVisualizationClient* client; // Pointer to the client that sent the callback
+		unsigned int numPendingElements; // Number of shared elements waiting to be extracted
+		unsigned int numExtractingElements; // Number of shared elements currently being extracted
+		unsigned int numExtractedElements; // Total number of shared elements extracted so far
+		
+		/* Constructors and destructors: */
+		ReplayProgressCallbackData(SharedVisualizationClient* sClient,unsigned int sNumPendingElements,unsigned int sNumExtractingElements,unsigned int sNumExtractedElements)
+			:client(sClient),
+			 numPendingElements(sNumPendingElements),numExtractingElements(sNumExtractingElements),numExtractedElements(sNumExtractedElements)
+			{
+			}
+		};
+	
+	struct TrackingStatistics // Structure to collect bandwidth and latency counters for in-progress tool interactions
+		{
+		/* Elements: */
+		public:
+		unsigned int numUpdatesSent; // Number of tracking updates sent to the server
+		unsigned int numUpdatesCoalesced; // Number of local seed requests merged into later tracking updates due to the rate limit
+		size_t numBytesSent; // Total size of sent tracking updates in bytes
+		unsigned int numUpdatesReceived; // Number of tracking updates received from the server
+		unsigned int numStaleUpdates; // Number of received tracking updates dropped because a newer update had already been received
+		size_t numBytesReceived; // Total size of received tracking updates in bytes
+		unsigned int numPreviewsDisplayed; // Number of extraction previews displayed for received tracking updates
+		unsigned int numLatencySamples; // Number of received tracking updates whose previews were displayed before being superseded
+		double latencySum; // Sum of times from receiving a tracking update to displaying its preview in seconds
+		double maxLatency; // Maximum time from receiving a tracking update to displaying its preview in seconds
+		
+		/* Constructors and destructors: */
+		TrackingStatistics(void) // Creates zeroed counters
+			:numUpdatesSent(0),numUpdatesCoalesced(0),numBytesSent(0),
+			 numUpdatesReceived(0),numStaleUpdates(0),numBytesReceived(0),
+			 numPreviewsDisplayed(0),numLatencySamples(0),latencySum(0.0),maxLatency(0.0)
+			{
+			}
+		
+		/* Methods: */
+		double getAverageLatency(void) const // Returns the average time from receiving a tracking update to displaying its preview in seconds
+			{
+			return numLatencySamples>0?latencySum/double(numLatencySamples):0.0;
+			}
+		};
+	
 	private:
 	typedef Misc::HashTable<const char*,unsigned int> AlgorithmNameMap; // Type for hash tables to map static algorithm names to algorithm indices
 	
+	class TrackerPreview; // Class to extract previews of a remote client's in-progress tool interaction in a background thread
+	
+	struct SharedTracker // Structure to represent an in-progress tool interaction on the server
+		{
+		/* Elements: */
+		public:
+		KoinoniaProtocol::ObjectID objectId; // Tracker's object ID within the tracker namespace
+		Misc::UInt8 algorithmIndex; // Index of the algorithm used by the tool
+		Misc::UInt32 sequenceNumber; // Seed request ID of the most recent tracking update, increasing over the tool interaction
+		DataType& trackerTypes; // Reference to the tracker type dictionary
+		DataType::TypeID parametersType; // Type of the parameters structure
+		void* parameters; // Opaque pointer to the extraction parameters of the most recent tracking update
+		const ExtractorLocator* locator; // Pointer to the local locator performing the tool interaction, or null for remote trackers
+		bool updatePending; // Flag whether a local tracker has a coalesced update that has not been sent yet due to the rate limit
+		double lastSendTime; // Application time at which the last update of a local tracker was sent
+		TrackerPreview* preview; // Preview extractor of a remote tracker
+		Misc::UInt32 lastSequenceNumber; // Sequence number of the most recent update posted to a remote tracker's preview extractor
+		double lastReceiveTime; // Application time at which the most recent update of a remote tracker was received
+		bool latencyMeasured; // Flag whether the preview of a remote tracker's most recent update was displayed
+		
+		/* Constructors and destructors: */
+		SharedTracker(DataType& sTrackerTypes)
+			:objectId(0),
+			 algorithmIndex(-1),sequenceNumber(0),
+			 trackerTypes(sTrackerTypes),parametersType(-1),parameters(0),
+			 locator(0),updatePending(false),lastSendTime(0.0),
+			 preview(0),lastSequenceNumber(0),lastReceiveTime(0.0),latencyMeasured(true)
+			{
+			}
+		private:
+		SharedTracker(const SharedTracker& source); // Prohibit copy constructor
+		SharedTracker& operator=(const SharedTracker& source); // Prohibit assignment operator
+		public:
+		~SharedTracker(void);
+		};
+	
+	typedef Misc::HashTable<const ExtractorLocator*,SharedTracker*> LocalTrackerMap; // Type for hash tables mapping local locators to their trackers
+	typedef Misc::HashTable<Collab::Plugins::KoinoniaProtocol::ObjectID,SharedTracker*> RemoteTrackerMap; // Type for hash tables mapping object IDs to remote trackers
+	
 	struct SharedElement // Structure to represent a visualization element on the server
 		{
 		/* Elements: */
 		public:
 		KoinoniaProtocol::ObjectID objectId; // Element's object ID within the sharing namespace
 		Misc::UInt8 algorithmIndex; // Index of the algorithm used to create the element
-		Visualization::Abstract::Algorithm* algorithm; // Algorithm used to extract the visualization element
 		DataType& elementTypes; // Reference to the element type dictionary
 		DataType::TypeID parametersType; // Type of the parameters structure
 		void* parameters; // Opaque pointer to the parameters used by the algorithm to create the element
 		bool visible; // Flag whether the element is currently being rendered
+		bool sharedGeometry; // Flag whether the client that extracted the element uploaded its geometry to the server
+		Visualization::Abstract::Parameters* extractionParameters; // Extraction parameters of an element waiting to be extracted, or null
+		bool haveSeedPoint; // Flag whether the element was seeded from a point
+		Visualization::Abstract::Parameters::SeedPoint seedPoint; // Point from which the element was seeded, used to prioritize its extraction
+		bool extracting; // Flag whether the element is currently being extracted by a background job
+		bool replaced; // Flag whether the element's parameters were replaced while it was being extracted
+		bool downloading; // Flag whether the element's geometry has been requested from the server
+		GeometryMsg* geometry; // Downloaded geometry of an element waiting to be read, or null
 		Visualization::Abstract::Element* element; // Pointer to the visualization element
 		bool destroyed; // Flag if the visualization element has been destroyed before it finished extracting
 		
 		/* Constructors and destructors: */
 		SharedElement(DataType& sElementTypes)
 			:objectId(0),
-			 algorithmIndex(-1),algorithm(0),
+			 algorithmIndex(-1),
 			 elementTypes(sElementTypes),parametersType(-1),parameters(0),
-			 visible(true),element(0),destroyed(false)
+			 visible(true),sharedGeometry(false),
+			 extractionParameters(0),haveSeedPoint(false),extracting(false),replaced(false),
+			 downloading(false),geometry(0),
+			 element(0),destroyed(false)
 			{
 			}
 		private:
@@ -114,6 +224,29 @@ class SharedVisualizationClient:public PluginClient,public SharedVisualizationPr
 	DataType::TypeID* elementTypes; // Array of visualization element types for each algorithm
 	SharedElementByIDMap sharedElementsById; // Hash table mapping object IDs to shared elements
 	SharedElementByElementMap sharedElementsByElement; // Hash table mapping element pointers to shared elements
+	Visualization::Abstract::Algorithm** algorithms; // Array of algorithms extracting shared elements, created on first use and reused for all elements of the same algorithm
+	Visualization::Abstract::Parameters** algorithmParameters; // Array of default parameters of each algorithm, from which shared elements' extraction parameters are cloned
+	bool* algorithmBusy; // Array of flags whether each algorithm is currently extracting an element in a background job
+	std::vector<SharedElement*> pendingElements; // List of received shared elements waiting to be extracted, in order of arrival
+	unsigned int maxNumExtractingElements; // Maximum number of shared elements extracted concurrently
+	unsigned int numExtractingElements; // Number of shared elements currently being extracted
+	unsigned int numExtractedElements; // Total number of shared elements extracted so far
+	Misc::CallbackList replayProgressCallbacks; // List of callbacks called when the progress of extracting shared elements changes
+	GeometrySharingMode geometrySharingMode; // Policy to share the geometry of locally extracted elements
+	double geometryBytesPerCell; // Size of element geometry in bytes that is as expensive to download as extracting a visualization element from one data set cell
+	size_t maxGeometrySize; // Maximum size of element geometry to upload in bytes
+	double numDataSetCells; // Estimated number of cells in the data set, to estimate the cost of extracting global visualization elements
+	Threads::Mutex receivedGeometryMutex; // Mutex serializing access to the list of received element geometry
+	std::vector<GeometryMsg*> receivedGeometry; // List of element geometry received from the server and not yet processed by the main thread
+	DataType trackerTypeDictionary; // Type dictionary for shared in-progress tool interactions
+	DataType::TypeID* trackerParameterTypes; // Array of parameter types for each algorithm in the tracker type dictionary
+	DataType::TypeID* trackerTypes; // Array of tracker types for each algorithm
+	KoinoniaClient::NamespaceID trackerNamespaceId; // ID for the Koinonia namespace to share in-progress tool interactions
+	LocalTrackerMap localTrackers; // Hash table mapping local locators to the trackers sharing their in-progress interactions
+	RemoteTrackerMap remoteTrackers; // Hash table mapping object IDs to remote clients' trackers
+	std::vector<SharedTracker*> retiringTrackers; // List of remote trackers whose interactions ended, waiting for their previews to finish
+	double minTrackingInterval; // Minimum time between tracking updates sent for the same local tool interaction in seconds
+	TrackingStatistics trackingStatistics; // Bandwidth and latency counters for in-progress tool interactions
 	
 	/* Private methods: */
 	private:
@@ -138,13 +271,27 @@ class SharedVisualizationClient:public PluginClient,public SharedVisualizationPr
 	MessageContinuation* connectRejectCallback(unsigned int messageId,MessageContinuation* continuation);
 	MessageContinuation* connectReplyCallback(unsigned int messageId,MessageContinuation* continuation);
 	MessageContinuation* colorMapUpdatedNotificationCallback(unsigned int messageId,MessageContinuation* continuation);
+	MessageContinuation* downloadGeometryReplyCallback(unsigned int messageId,MessageContinuation* continuation);
+	double estimateExtractionCost(const Visualization::Abstract::Element* element) const; // Returns the estimated number of data set cells visited when extracting the given element
+	void uploadGeometry(SharedElement* sharedElement); // Uploads the given locally extracted shared element's geometry to the server
+	Visualization::Abstract::Algorithm* getAlgorithm(unsigned int algorithmIndex); // Returns the algorithm of the given index, creating it on first use
+	void readExtractionParameters(SharedElement* sharedElement); // Reads a waiting shared element's extraction parameters and seed point from its shared parameters structure
+	void scheduleExtractions(void); // Starts background extraction jobs for the highest-priority waiting shared elements
 	static void* createElementFunction(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,DataType::TypeID type,void* userData);
 	void extractElementJobComplete(Threads::WorkerPool::JobFunction* job,SharedElement* sharedElement); // Called from main thread when an element extraction job is finished
 	void extractElementJob(int,SharedElement* sharedElement); // Job function to create a newly-arrived element, called from a background worker thread
+	void readElementJob(int,SharedElement* sharedElement); // Job function to create a newly-arrived element from downloaded geometry, called from a background worker thread
 	static void elementCreatedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData);
 	static void elementReplacedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,KoinoniaProtocol::VersionNumber newVersion,void* object,void* userData);
 	static void elementDestroyedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData);
 	void elementParametersUpdatedCallback(Visualization::Abstract::Element::ParametersUpdatedCallbackData* cbData);
+	void sendTrackingUpdate(SharedTracker* tracker,double now); // Sends the most recent coalesced update of the given local tracker to the server
+	void postTrackingUpdate(SharedTracker* tracker); // Posts a remote tracker's most recent update to its preview extractor unless it is stale
+	void updateTrackerPreview(SharedTracker* tracker,double now); // Displays a remote tracker's most recent preview and measures its latency
+	static void* createTrackerFunction(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,DataType::TypeID type,void* userData);
+	static void trackerCreatedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData);
+	static void trackerReplacedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,KoinoniaProtocol::VersionNumber newVersion,void* object,void* userData);
+	static void trackerDestroyedCallback(KoinoniaClient* client,KoinoniaProtocol::NamespaceID namespaceId,KoinoniaProtocol::ObjectID objectId,void* object,void* userData);
 	
 	/* Constructors and destructors: */
 	public:
@@ -161,9 +308,51 @@ class SharedVisualizationClient:public PluginClient,public SharedVisualizationPr
 	
 	/* New method: */
 	bool waitForConnection(void); // Blocks the caller until the server replies to the connect request message; returns true if connection is valid
+	void frame(void); // Processes element geometry received from the server, sends coalesced tracking updates, and updates tracking previews; must be called from the main thread once per frame
 	void addElement(Visualization::Abstract::Algorithm* algorithm,Visualization::Abstract::Element* newElement); // Notifies the client that a new visualization element has been added to the element list
 	void setElementVisible(Visualization::Abstract::Element* element,bool newVisible); // Notifies the client that a visualization element has changed visibility
 	void deleteElement(Visualization::Abstract::Element* element); // Notifies the client that the given visualization element is being deleted
+	unsigned int getMaxNumExtractingElements(void) const // Returns the maximum number of shared elements extracted concurrently
+		{
+		return maxNumExtractingElements;
+		}
+	void setMaxNumExtractingElements(unsigned int newMaxNumExtractingElements); // Sets the maximum number of shared elements extracted concurrently
+	unsigned int getNumPendingElements(void) const // Returns the number of shared elements waiting to be extracted
+		{
+		return (unsigned int)(pendingElements.size());
+		}
+	unsigned int getNumExtractingElements(void) const // Returns the number of shared elements currently being extracted
+		{
+		return numExtractingElements;
+		}
+	unsigned int getNumExtractedElements(void) const // Returns the total number of shared elements extracted so far
+		{
+		return numExtractedElements;
+		}
+	Misc::CallbackList& getReplayProgressCallbacks(void) // Returns the list of callbacks called when the progress of extracting shared elements changes
+		{
+		return replayProgressCallbacks;
+		}
+	GeometrySharingMode getGeometrySharingMode(void) const // Returns the policy to share the geometry of locally extracted elements
+		{
+		return geometrySharingMode;
+		}
+	void setGeometrySharingMode(GeometrySharingMode newGeometrySharingMode); // Sets the policy to share the geometry of locally extracted elements
+	void setGeometryBytesPerCell(double newGeometryBytesPerCell); // Sets the geometry size that is as expensive to download as extracting from one data set cell for the automatic sharing policy
+	void setMaxGeometrySize(size_t newMaxGeometrySize); // Sets the maximum size of element geometry to upload
+	void postSeedRequest(const ExtractorLocator* locator,unsigned int seedRequestID,Visualization::Abstract::Parameters* seedParameters); // Shares a seed request of the given locator's in-progress interaction with other clients; inherits parameters
+	void postFinalizationRequest(const ExtractorLocator* locator,unsigned int finalSeedRequestID); // Notifies other clients that the given locator's interaction ended with the given seed request
+	void destroyLocator(const ExtractorLocator* locator); // Notifies the client that the given locator is being destroyed
+	double getMaxTrackingRate(void) const // Returns the maximum number of tracking updates sent per second for each tool interaction
+		{
+		return 1.0/minTrackingInterval;
+		}
+	void setMaxTrackingRate(double newMaxTrackingRate); // Sets the maximum number of tracking updates sent per second for each tool interaction
+	const TrackingStatistics& getTrackingStatistics(void) const // Returns the bandwidth and latency counters for in-progress tool interactions
+		{
+		return trackingStatistics;
+		}
+	void resetTrackingStatistics(void); // Resets the bandwidth and latency counters for in-progress tool interactions
 	};
 
 }
@@ -1,7 +1,7 @@
 /***********************************************************************
 SharedVisualizationProtocol - Common interface between a shared
 visualization server and a shared visualization client.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -55,6 +55,15 @@ SharedVisualizationProtocol::SharedVisualizationProtocol(void)
 	DataType::TypeID colorMapEntryType=protocolTypes.createStructure(2,colorMapEntryElements,sizeof(ColorMapEntry));
 	DataType::TypeID colorMapType=protocolTypes.createVector(colorMapEntryType);
 	
+	/* GeometryMsg: */
+	DataType::TypeID geometryType=protocolTypes.createVector(DataType::getAtomicType<Misc::UInt8>());
+	DataType::StructureElement geometryMsgElements[]=
+		{
+		{DataType::getAtomicType<ElementID>(),offsetof(GeometryMsg,elementId)},
+		{geometryType,offsetof(GeometryMsg,geometry)}
+		};
+	DataType::TypeID geometryMsgType=protocolTypes.createStructure(2,geometryMsgElements,sizeof(GeometryMsg));
+	
 	/*********************************************************************
 	Create data types for client protocol messages:
 	*********************************************************************/
@@ -67,6 +76,23 @@ SharedVisualizationProtocol::SharedVisualizationProtocol(void)
 		};
 	clientMessageTypes[ConnectRequest]=protocolTypes.createStructure(2,connectRequestMsgElements,sizeof(ConnectRequestMsg));
 	
+	/* UploadGeometryRequestMsg: */
+	clientMessageTypes[UploadGeometryRequest]=geometryMsgType;
+	
+	/* DownloadGeometryRequestMsg: */
+	DataType::StructureElement downloadGeometryRequestMsgElements[]=
+		{
+		{DataType::getAtomicType<ElementID>(),offsetof(DownloadGeometryRequestMsg,elementId)}
+		};
+	clientMessageTypes[DownloadGeometryRequest]=protocolTypes.createStructure(1,downloadGeometryRequestMsgElements,sizeof(DownloadGeometryRequestMsg));
+	
+	/* DropGeometryRequestMsg: */
+	DataType::StructureElement dropGeometryRequestMsgElements[]=
+		{
+		{DataType::getAtomicType<ElementID>(),offsetof(DropGeometryRequestMsg,elementId)}
+		};
+	clientMessageTypes[DropGeometryRequest]=protocolTypes.createStructure(1,dropGeometryRequestMsgElements,sizeof(DropGeometryRequestMsg));
+	
 	/*********************************************************************
 	Create data types for server protocol messages:
 	*********************************************************************/
@@ -95,6 +121,9 @@ SharedVisualizationProtocol::SharedVisualizationProtocol(void)
 		{colorMapType,offsetof(ColorMapUpdatedNotificationMsg,colorMap)}
 		};
 	serverMessageTypes[ColorMapUpdatedNotification]=protocolTypes.createStructure(2,colorMapUpdatedNotificationMsgElements,sizeof(ColorMapUpdatedNotificationMsg));
+	
+	/* DownloadGeometryReplyMsg: */
+	serverMessageTypes[DownloadGeometryReply]=geometryMsgType;
 	}
 
 }
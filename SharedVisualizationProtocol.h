@@ -1,7 +1,7 @@
 /***********************************************************************
 SharedVisualizationProtocol - Common interface between a shared
 visualization server and a shared visualization client.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -42,6 +42,9 @@ class SharedVisualizationProtocol
 	enum ClientMessages // Enumerated type for protocol message IDs sent by clients
 		{
 		ConnectRequest=0,
+		UploadGeometryRequest,
+		DownloadGeometryRequest,
+		DropGeometryRequest,
 		
 		NumClientMessages
 		};
@@ -51,6 +54,7 @@ class SharedVisualizationProtocol
 		ConnectReject=0,
 		ConnectReply,
 		ColorMapUpdatedNotification,
+		DownloadGeometryReply,
 		
 		NumServerMessages
 		};
@@ -70,6 +74,9 @@ class SharedVisualizationProtocol
 	
 	typedef Misc::Vector<ColorMapEntry> ColorMap; // Type for color maps
 	
+	typedef Misc::UInt32 ElementID; // Type for IDs of shared visualization elements, identical to their object IDs in the shared element namespace
+	typedef Misc::Vector<Misc::UInt8> Geometry; // Type for compactly-encoded visualization element geometry
+	
 	/* Protocol message data structure declarations: */
 	struct ConnectRequestMsg
 		{
@@ -78,6 +85,30 @@ class SharedVisualizationProtocol
 		VariableIndex numScalarVariables,numVectorVariables; // Client's dataset variable layout, to check compatibility with dataset currently represented by server
 		};
 	
+	struct GeometryMsg // Message structure to upload or download a visualization element's geometry
+		{
+		/* Elements: */
+		public:
+		ElementID elementId; // ID of the visualization element
+		Geometry geometry; // The visualization element's geometry, or empty if the geometry was dropped before it was uploaded
+		};
+	
+	typedef GeometryMsg UploadGeometryRequestMsg;
+	
+	struct DownloadGeometryRequestMsg
+		{
+		/* Elements: */
+		public:
+		ElementID elementId; // ID of the visualization element whose geometry is requested
+		};
+	
+	struct DropGeometryRequestMsg
+		{
+		/* Elements: */
+		public:
+		ElementID elementId; // ID of the visualization element whose geometry is no longer needed
+		};
+	
 	struct ConnectReplyMsg
 		{
 		/* Embedded classes: */
@@ -109,9 +140,11 @@ class SharedVisualizationProtocol
 		ColorMap colorMap; // The new color map
 		};
 	
+	typedef GeometryMsg DownloadGeometryReplyMsg;
+	
 	/* Elements: */
 	static const char* protocolName;
-	static const unsigned int protocolVersion=(5U<<16)+0U;
+	static const unsigned int protocolVersion=(7U<<16)+0U;
 	
 	/* Protocol data type declarations: */
 	DataType protocolTypes; // Definitions of data types used by the shared visualization protocol
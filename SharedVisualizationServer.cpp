@@ -2,7 +2,7 @@
 SharedVisualizationServer - Server for collaborative data exploration in
 spatially distributed VR environments, implemented as a plug-in of the
 Vrui remote collaboration infrastructure.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,10 +23,18 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include "SharedVisualizationServer.h"
 
+#include <algorithm>
+
 namespace Collab {
 
 namespace Plugins {
 
+/**************************************************
+Static elements of class SharedVisualizationServer:
+**************************************************/
+
+const double SharedVisualizationServer::orphanTimeout=600.0;
+
 /******************************************
 Methods of class SharedVisualizationServer:
 ******************************************/
@@ -85,10 +93,194 @@ MessageContinuation* SharedVisualizationServer::connectRequestCallback(unsigned
 	return 0;
 	}
 
+void SharedVisualizationServer::sendPendingDownloads(SharedVisualizationProtocol::ElementID elementId,const SharedVisualizationProtocol::GeometryMsg& geometry)
+	{
+	/* Check if any clients are waiting for the element's geometry: */
+	PendingDownloadMap::Iterator pdIt=pendingDownloads.findEntry(elementId);
+	if(!pdIt.isFinished())
+		{
+		/* Send the element's geometry to all waiting clients: */
+		for(ClientIDList::iterator cIt=pdIt->getDest().begin();cIt!=pdIt->getDest().end();++cIt)
+			sendClientMessage(DownloadGeometryReply,&geometry,server->getClient(*cIt));
+		
+		pendingDownloads.removeEntry(pdIt);
+		}
+	}
+
+void SharedVisualizationServer::orphanElement(SharedVisualizationProtocol::ElementID elementId,unsigned int ownerId)
+	{
+	/* Find the clients that are already waiting for the element's geometry: */
+	ClientIDList waitingClients;
+	PendingDownloadMap::Iterator pdIt=pendingDownloads.findEntry(elementId);
+	if(!pdIt.isFinished())
+		waitingClients=pdIt->getDest();
+	
+	/* Remember the element for all other clients except its owner, who will not ask for its geometry: */
+	OrphanedElement orphan;
+	orphan.orphanTime=clock.peekTime();
+	for(ClientIDSet::Iterator cIt=clients.begin();!cIt.isFinished();++cIt)
+		if(cIt->getSource()!=ownerId&&std::find(waitingClients.begin(),waitingClients.end(),cIt->getSource())==waitingClients.end())
+			orphan.clients.push_back(cIt->getSource());
+	if(!orphan.clients.empty())
+		orphanedElements.setEntry(OrphanedElementMap::Entry(elementId,orphan));
+	else
+		orphanedElements.removeEntry(elementId);
+	
+	/* Send empty geometry to all waiting clients: */
+	GeometryMsg emptyGeometry;
+	emptyGeometry.elementId=elementId;
+	sendPendingDownloads(elementId,emptyGeometry);
+	}
+
+void SharedVisualizationServer::expireOrphanedElements(void)
+	{
+	/* Collect all elements that have been orphaned for too long: */
+	double expireTime=clock.peekTime()-orphanTimeout;
+	std::vector<ElementID> expiredElementIds;
+	for(OrphanedElementMap::Iterator oeIt=orphanedElements.begin();!oeIt.isFinished();++oeIt)
+		if(oeIt->getDest().orphanTime<expireTime)
+			expiredElementIds.push_back(oeIt->getSource());
+	
+	/* Forget the expired elements: */
+	for(std::vector<ElementID>::iterator eIt=expiredElementIds.begin();eIt!=expiredElementIds.end();++eIt)
+		orphanedElements.removeEntry(*eIt);
+	}
+
+MessageContinuation* SharedVisualizationServer::uploadGeometryRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation)
+	{
+	/* Access the base client state object: */
+	Server::Client* client=server->getClient(clientId);
+	
+	/* Check if this is the start of a new message: */
+	if(continuation==0)
+		{
+		/* Prepare to read the upload geometry request message: */
+		continuation=protocolTypes.prepareReading(clientMessageTypes[UploadGeometryRequest],new UploadGeometryRequestMsg);
+		uploadingClients.setEntry(ClientIDSet::Entry(clientId));
+		}
+	
+	/* Continue reading the upload geometry request message and check whether it's complete: */
+	if(protocolTypes.continueReading(client->getSocket(),continuation))
+		{
+		/* Extract the upload geometry request message: */
+		UploadGeometryRequestMsg* msg=protocolTypes.getReadObject<UploadGeometryRequestMsg>(continuation);
+		uploadingClients.removeEntry(clientId);
+		expireOrphanedElements();
+		
+		/* Replace any previously uploaded geometry for the same element: */
+		GeometryMap::Iterator gIt=geometries.findEntry(msg->elementId);
+		if(!gIt.isFinished())
+			{
+			delete gIt->getDest().geometry;
+			geometries.removeEntry(gIt);
+			}
+		
+		/* Check if the geometry is small enough to be stored: */
+		if(msg->geometry.size()<=maxGeometrySize)
+			{
+			geometries.setEntry(GeometryMap::Entry(msg->elementId,StoredGeometry(clientId,msg)));
+			orphanedElements.removeEntry(msg->elementId);
+			
+			/* Forward the geometry to all clients that requested it before it arrived: */
+			sendPendingDownloads(msg->elementId,*msg);
+			}
+		else
+			{
+			/* Reject the geometry and let all other clients extract the element themselves: */
+			ElementID elementId=msg->elementId;
+			delete msg;
+			orphanElement(elementId,clientId);
+			}
+		
+		/* Delete the continuation object; the geometry map keeps the message: */
+		delete continuation;
+		continuation=0;
+		}
+	
+	return continuation;
+	}
+
+MessageContinuation* SharedVisualizationServer::downloadGeometryRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation)
+	{
+	/* Access the base client state object and its TCP socket: */
+	Server::Client* client=server->getClient(clientId);
+	NonBlockSocket& socket=client->getSocket();
+	
+	/* Read the ID of the requested element: */
+	ElementID elementId=socket.read<ElementID>();
+	
+	/* Check if the element's geometry has already been uploaded: */
+	expireOrphanedElements();
+	GeometryMap::Iterator gIt=geometries.findEntry(elementId);
+	OrphanedElementMap::Iterator oeIt=orphanedElements.findEntry(elementId);
+	if(!gIt.isFinished())
+		{
+		/* Send the element's geometry to the client: */
+		sendClientMessage(DownloadGeometryReply,gIt->getDest().geometry,client);
+		}
+	else if(!oeIt.isFinished())
+		{
+		/* Send empty geometry to the client, as the element's geometry will never arrive: */
+		GeometryMsg emptyGeometry;
+		emptyGeometry.elementId=elementId;
+		sendClientMessage(DownloadGeometryReply,&emptyGeometry,client);
+		
+		/* Forget the orphaned element once all clients have been told: */
+		ClientIDList& orphanClients=oeIt->getDest().clients;
+		ClientIDList::iterator cIt=std::find(orphanClients.begin(),orphanClients.end(),clientId);
+		if(cIt!=orphanClients.end())
+			orphanClients.erase(cIt);
+		if(orphanClients.empty())
+			orphanedElements.removeEntry(oeIt);
+		}
+	else
+		{
+		/* Remember to send the element's geometry to the client once it arrives: */
+		PendingDownloadMap::Iterator pdIt=pendingDownloads.findEntry(elementId);
+		if(pdIt.isFinished())
+			{
+			pendingDownloads.setEntry(PendingDownloadMap::Entry(elementId,ClientIDList()));
+			pdIt=pendingDownloads.findEntry(elementId);
+			}
+		pdIt->getDest().push_back(clientId);
+		}
+	
+	/* Done with message: */
+	return 0;
+	}
+
+MessageContinuation* SharedVisualizationServer::dropGeometryRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation)
+	{
+	/* Access the base client state object and its TCP socket: */
+	Server::Client* client=server->getClient(clientId);
+	NonBlockSocket& socket=client->getSocket();
+	
+	/* Read the ID of the dropped element: */
+	ElementID elementId=socket.read<ElementID>();
+	
+	/* Release the element's geometry: */
+	GeometryMap::Iterator gIt=geometries.findEntry(elementId);
+	if(!gIt.isFinished())
+		{
+		delete gIt->getDest().geometry;
+		geometries.removeEntry(gIt);
+		}
+	orphanedElements.removeEntry(elementId);
+	
+	/* Send empty geometry to all clients still waiting for the element's geometry: */
+	GeometryMsg emptyGeometry;
+	emptyGeometry.elementId=elementId;
+	sendPendingDownloads(elementId,emptyGeometry);
+	
+	/* Done with message: */
+	return 0;
+	}
+
 SharedVisualizationServer::SharedVisualizationServer(Server* sServer)
 	:PluginServer(sServer),
 	 numScalarVariables(0),colorMaps(0),
-	 numVectorVariables(0)
+	 numVectorVariables(0),
+	 geometries(17),pendingDownloads(17),clients(17),uploadingClients(17),orphanedElements(17)
 	{
 	}
 
@@ -98,6 +290,10 @@ SharedVisualizationServer::~SharedVisualizationServer(void)
 	for(unsigned int i=0;i<numScalarVariables;++i)
 		delete[] colorMaps[i];
 	delete[] colorMaps;
+	
+	/* Release all uploaded element geometry: */
+	for(GeometryMap::Iterator gIt=geometries.begin();!gIt.isFinished();++gIt)
+		delete gIt->getDest().geometry;
 	}
 
 const char* SharedVisualizationServer::getName(void) const
@@ -127,6 +323,9 @@ void SharedVisualizationServer::setMessageBases(unsigned int newClientMessageBas
 	
 	/* Register message handlers: */
 	server->setMessageHandler(clientMessageBase+ConnectRequest,Server::wrapMethod<SharedVisualizationServer,&SharedVisualizationServer::connectRequestCallback>,this,getClientMsgSize(ConnectRequest));
+	server->setMessageHandler(clientMessageBase+UploadGeometryRequest,Server::wrapMethod<SharedVisualizationServer,&SharedVisualizationServer::uploadGeometryRequestCallback>,this,getClientMsgSize(UploadGeometryRequest));
+	server->setMessageHandler(clientMessageBase+DownloadGeometryRequest,Server::wrapMethod<SharedVisualizationServer,&SharedVisualizationServer::downloadGeometryRequestCallback>,this,getClientMsgSize(DownloadGeometryRequest));
+	server->setMessageHandler(clientMessageBase+DropGeometryRequest,Server::wrapMethod<SharedVisualizationServer,&SharedVisualizationServer::dropGeometryRequestCallback>,this,getClientMsgSize(DropGeometryRequest));
 	}
 
 void SharedVisualizationServer::start(void)
@@ -135,10 +334,80 @@ void SharedVisualizationServer::start(void)
 
 void SharedVisualizationServer::clientConnected(unsigned int clientId)
 	{
+	/* Add the client to the set of connected clients: */
+	clients.setEntry(ClientIDSet::Entry(clientId));
 	}
 
 void SharedVisualizationServer::clientDisconnected(unsigned int clientId)
 	{
+	/* Remove the client from the set of connected clients: */
+	clients.removeEntry(clientId);
+	
+	/* Remove the client from all lists of clients waiting for element geometry, and remove lists that become empty: */
+	std::vector<ElementID> emptyElementIds;
+	for(PendingDownloadMap::Iterator pdIt=pendingDownloads.begin();!pdIt.isFinished();++pdIt)
+		{
+		ClientIDList& waitingClients=pdIt->getDest();
+		ClientIDList::iterator cIt=std::find(waitingClients.begin(),waitingClients.end(),clientId);
+		if(cIt!=waitingClients.end())
+			waitingClients.erase(cIt);
+		if(waitingClients.empty())
+			emptyElementIds.push_back(pdIt->getSource());
+		}
+	for(std::vector<ElementID>::iterator eIt=emptyElementIds.begin();eIt!=emptyElementIds.end();++eIt)
+		pendingDownloads.removeEntry(*eIt);
+	
+	/* Remove the client from all orphaned elements, and forget elements that no remaining client will ask for: */
+	emptyElementIds.clear();
+	for(OrphanedElementMap::Iterator oeIt=orphanedElements.begin();!oeIt.isFinished();++oeIt)
+		{
+		ClientIDList& orphanClients=oeIt->getDest().clients;
+		ClientIDList::iterator cIt=std::find(orphanClients.begin(),orphanClients.end(),clientId);
+		if(cIt!=orphanClients.end())
+			orphanClients.erase(cIt);
+		if(orphanClients.empty())
+			emptyElementIds.push_back(oeIt->getSource());
+		}
+	for(std::vector<ElementID>::iterator eIt=emptyElementIds.begin();eIt!=emptyElementIds.end();++eIt)
+		orphanedElements.removeEntry(*eIt);
+	expireOrphanedElements();
+	
+	/* Check if the client disconnected in the middle of uploading element geometry: */
+	if(uploadingClients.isEntry(clientId))
+		{
+		uploadingClients.removeEntry(clientId);
+		
+		/*******************************************************************
+		Send empty geometry to all clients still waiting for element
+		geometry, so that they extract the elements themselves. Geometry is
+		uploaded right after its element is created, meaning pending
+		downloads usually wait for the interrupted upload, but the server
+		cannot tell which element an unfinished upload belongs to.
+		*******************************************************************/
+		
+		std::vector<ElementID> pendingElementIds;
+		for(PendingDownloadMap::Iterator pdIt=pendingDownloads.begin();!pdIt.isFinished();++pdIt)
+			pendingElementIds.push_back(pdIt->getSource());
+		for(std::vector<ElementID>::iterator eIt=pendingElementIds.begin();eIt!=pendingElementIds.end();++eIt)
+			{
+			GeometryMsg emptyGeometry;
+			emptyGeometry.elementId=*eIt;
+			sendPendingDownloads(*eIt,emptyGeometry);
+			}
+		}
+	
+	/* Release all geometry uploaded by the client, and remember that it will not be uploaded again: */
+	std::vector<ElementID> ownedElementIds;
+	for(GeometryMap::Iterator gIt=geometries.begin();!gIt.isFinished();++gIt)
+		if(gIt->getDest().ownerId==clientId)
+			ownedElementIds.push_back(gIt->getSource());
+	for(std::vector<ElementID>::iterator eIt=ownedElementIds.begin();eIt!=ownedElementIds.end();++eIt)
+		{
+		GeometryMap::Iterator gIt=geometries.findEntry(*eIt);
+		delete gIt->getDest().geometry;
+		geometries.removeEntry(gIt);
+		orphanElement(*eIt,clientId);
+		}
 	}
 
 /***********************
@@ -2,7 +2,7 @@
 SharedVisualizationServer - Server for collaborative data exploration in
 spatially distributed VR environments, implemented as a plug-in of the
 Vrui remote collaboration infrastructure.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -24,6 +24,10 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef SHAREDVISUALIZATIONSERVER_INCLUDED
 #define SHAREDVISUALIZATIONSERVER_INCLUDED
 
+#include <vector>
+#include <Misc/StandardHashFunction.h>
+#include <Misc/HashTable.h>
+#include <Misc/Timer.h>
 #include <Collaboration2/MessageBuffer.h>
 #include <Collaboration2/MessageWriter.h>
 #include <Collaboration2/Server.h>
@@ -43,11 +47,50 @@ namespace Plugins {
 
 class SharedVisualizationServer:public PluginServer,public SharedVisualizationProtocol
 	{
-	/* Elements: */
+	/* Embedded classes: */
 	private:
+	struct StoredGeometry // Structure for uploaded element geometry
+		{
+		/* Elements: */
+		public:
+		unsigned int ownerId; // ID of the client that uploaded the geometry
+		GeometryMsg* geometry; // The uploaded geometry
+		
+		/* Constructors and destructors: */
+		StoredGeometry(unsigned int sOwnerId,GeometryMsg* sGeometry)
+			:ownerId(sOwnerId),geometry(sGeometry)
+			{
+			}
+		};
+	
+	typedef Misc::HashTable<ElementID,StoredGeometry> GeometryMap; // Type for hash tables mapping element IDs to uploaded element geometry
+	typedef Misc::HashTable<unsigned int,void> ClientIDSet; // Type for sets of client IDs
+	typedef std::vector<unsigned int> ClientIDList; // Type for lists of client IDs
+	typedef Misc::HashTable<ElementID,ClientIDList> PendingDownloadMap; // Type for hash tables mapping element IDs to lists of clients waiting for the element's geometry
+	
+	struct OrphanedElement // Structure for elements whose geometry will never be uploaded
+		{
+		/* Elements: */
+		public:
+		double orphanTime; // Server clock time at which the element was orphaned
+		ClientIDList clients; // List of clients that have not yet been told that the element's geometry will never arrive
+		};
+	
+	typedef Misc::HashTable<ElementID,OrphanedElement> OrphanedElementMap; // Type for hash tables mapping element IDs to orphaned elements
+	
+	static const size_t maxGeometrySize=size_t(256)<<20; // Maximum size of a single element's uploaded geometry in bytes
+	static const double orphanTimeout; // Time in seconds after which an orphaned element is forgotten even if not all clients asked for it
+	
+	/* Elements: */
 	unsigned int numScalarVariables; // Number of scalar variables in the current dataset
 	ColorMap** colorMaps; // Array of the current color map for each of the dataset's scalar variables, or 0 if the color map has not yet been defined
 	unsigned int numVectorVariables; // Number of vector variables in the current dataset
+	GeometryMap geometries; // Map of element geometry uploaded by the clients that extracted the elements
+	PendingDownloadMap pendingDownloads; // Map of clients that requested element geometry before it was uploaded
+	ClientIDSet clients; // Set of currently connected clients
+	ClientIDSet uploadingClients; // Set of clients that are in the middle of uploading element geometry
+	OrphanedElementMap orphanedElements; // Map of elements whose geometry was released when the client that uploaded it disconnected, or was rejected
+	Misc::Timer clock; // Free-running clock to expire orphaned elements
 	
 	/* Private methods: */
 	size_t getClientMsgSize(unsigned int messageId) const // Returns the minimum size of a client protocol message
@@ -66,6 +109,12 @@ class SharedVisualizationServer:public PluginServer,public SharedVisualizationPr
 		client->queueMessage(message.getBuffer());
 		}
 	MessageContinuation* connectRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation);
+	void sendPendingDownloads(ElementID elementId,const GeometryMsg& geometry); // Sends the given element geometry to all clients waiting for it
+	void orphanElement(ElementID elementId,unsigned int ownerId); // Marks the given element as orphaned and sends empty geometry to all clients waiting for it
+	void expireOrphanedElements(void); // Forgets orphaned elements that have been orphaned for longer than the timeout
+	MessageContinuation* uploadGeometryRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation);
+	MessageContinuation* downloadGeometryRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation);
+	MessageContinuation* dropGeometryRequestCallback(unsigned int messageId,unsigned int clientId,MessageContinuation* continuation);
 	
 	/* Constructors and destructors: */
 	public:
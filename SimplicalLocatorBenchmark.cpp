@@ -0,0 +1,236 @@
+/***********************************************************************
+SimplicalLocatorBenchmark - Utility to measure the throughput of point
+location in tetrahedral meshes with and without cached per-cell
+barycentric transformations.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/Timer.h>
+#include <Math/Math.h>
+
+#include <Templatized/ScalarExtractor.h>
+#include <Templatized/Simplical.h>
+
+typedef Visualization::Templatized::Simplical<float,3,float> DataSet;
+typedef DataSet::Scalar Scalar;
+typedef DataSet::Point Point;
+typedef Visualization::Templatized::ScalarExtractor<float,float> ScalarExtractor;
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline Scalar randomScalar(unsigned int& seed) // Returns a pseudo-random number in [0, 1]
+	{
+	seed=seed*1103515245U+12345U;
+	return Scalar((seed>>8)&0xffffU)/Scalar(65535);
+	}
+
+inline Scalar linearFunction(const Point& p) // Returns the value of a linear function, which is reproduced exactly by barycentric interpolation
+	{
+	return p[0]+Scalar(2)*p[1]+Scalar(3)*p[2];
+	}
+
+struct TraceResult // Structure to report the results of a tracing run
+	{
+	/* Elements: */
+	public:
+	unsigned int numLocates; // Number of point location requests
+	unsigned int numFound; // Number of successful point location requests
+	double maxError; // Maximum interpolation error of a linear function at located points
+	double time; // Time spent locating points and evaluating the function in seconds
+	};
+
+TraceResult trace(const DataSet& dataSet,unsigned int numCells,unsigned int numPaths,unsigned int numSteps,Scalar stepSize)
+	{
+	TraceResult result;
+	result.numLocates=0;
+	result.numFound=0;
+	result.maxError=0.0;
+	ScalarExtractor extractor;
+	Scalar domainSize=Scalar(numCells);
+	unsigned int seed=2;
+	Misc::Timer timer;
+	for(unsigned int path=0;path<numPaths;++path)
+		{
+		/* Start the path at a random position and in a random direction: */
+		Point p;
+		Scalar dir[3];
+		for(int i=0;i<3;++i)
+			{
+			p[i]=(randomScalar(seed)*Scalar(0.9)+Scalar(0.05))*domainSize;
+			dir[i]=(randomScalar(seed)-Scalar(0.5))*stepSize;
+			}
+		
+		/* Trace the path through the mesh like a streamline, using the previous cell as starting point: */
+		DataSet::Locator locator=dataSet.getLocator();
+		bool traceHint=false;
+		for(unsigned int step=0;step<numSteps;++step)
+			{
+			++result.numLocates;
+			if(locator.locatePoint(p,traceHint))
+				{
+				++result.numFound;
+				double error=Math::abs(double(locator.calcValue(extractor))-double(linearFunction(p)));
+				if(result.maxError<error)
+					result.maxError=error;
+				traceHint=true;
+				}
+			else
+				traceHint=false;
+			
+			/* Advance the path and reflect it off the domain boundaries: */
+			for(int i=0;i<3;++i)
+				{
+				p[i]+=dir[i];
+				if(p[i]<Scalar(0)||p[i]>domainSize)
+					{
+					dir[i]=-dir[i];
+					p[i]+=Scalar(2)*dir[i];
+					}
+				}
+			}
+		}
+	timer.elapse();
+	result.time=timer.getTime();
+	
+	return result;
+	}
+
+}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	unsigned int numCells=64;
+	Scalar jitter(0.2);
+	unsigned int numPaths=1000;
+	unsigned int numSteps=1000;
+	Scalar stepSize(0.25);
+	for(int i=1;i<argc;++i)
+		{
+		if(strcasecmp(argv[i],"-numCells")==0&&i+1<argc)
+			numCells=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-jitter")==0&&i+1<argc)
+			jitter=Scalar(atof(argv[++i]));
+		else if(strcasecmp(argv[i],"-numPaths")==0&&i+1<argc)
+			numPaths=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-numSteps")==0&&i+1<argc)
+			numSteps=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-stepSize")==0&&i+1<argc)
+			stepSize=Scalar(atof(argv[++i]));
+		else
+			{
+			std::cerr<<"Usage: "<<argv[0]<<" [-numCells <cells per axis>] [-jitter <cell size fraction>] [-numPaths <num>] [-numSteps <num>] [-stepSize <cell size fraction>]"<<std::endl;
+			return 1;
+			}
+		}
+	if(numCells<1||numPaths<1||numSteps<1||jitter<Scalar(0)||jitter>=Scalar(0.25)||!(stepSize>Scalar(0)))
+		{
+		std::cerr<<"Invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a grid of unit-sized cubes with jittered interior vertices: */
+	DataSet dataSet;
+	unsigned int numVertices=numCells+1;
+	DataSet::GridVertexIterator* vertices=new DataSet::GridVertexIterator[numVertices*numVertices*numVertices];
+	DataSet::GridVertexIterator* vPtr=vertices;
+	unsigned int seed=1;
+	for(unsigned int z=0;z<numVertices;++z)
+		for(unsigned int y=0;y<numVertices;++y)
+			for(unsigned int x=0;x<numVertices;++x,++vPtr)
+				{
+				unsigned int c[3]={x,y,z};
+				Point p;
+				for(int i=0;i<3;++i)
+					{
+					p[i]=Scalar(c[i]);
+					if(c[i]>0&&c[i]<numCells)
+						p[i]+=(randomScalar(seed)-Scalar(0.5))*Scalar(2)*jitter;
+					}
+				*vPtr=dataSet.addVertex(p,linearFunction(p));
+				}
+	
+	/* Split each cube into six tetrahedra sharing the cube's main diagonal, which results in a conforming tetrahedral mesh: */
+	static const int permutations[6][3]={{0,1,2},{0,2,1},{1,0,2},{1,2,0},{2,0,1},{2,1,0}};
+	unsigned int vertexStrides[3]={1,numVertices,numVertices*numVertices};
+	for(unsigned int z=0;z<numCells;++z)
+		for(unsigned int y=0;y<numCells;++y)
+			for(unsigned int x=0;x<numCells;++x)
+				{
+				unsigned int base=(z*numVertices+y)*numVertices+x;
+				for(int t=0;t<6;++t)
+					{
+					DataSet::GridVertexIterator cellVertices[4];
+					unsigned int vertexIndex=base;
+					cellVertices[0]=vertices[vertexIndex];
+					for(int i=0;i<3;++i)
+						{
+						vertexIndex+=vertexStrides[permutations[t][i]];
+						cellVertices[i+1]=vertices[vertexIndex];
+						}
+					dataSet.addCell(cellVertices);
+					}
+				}
+	delete[] vertices;
+	
+	/* Finalize the mesh without cached transformations, and measure point location: */
+	std::cout<<"Cells: "<<dataSet.getTotalNumCells()<<" tetrahedra, paths: "<<numPaths<<", steps per path: "<<numSteps<<std::endl;
+	TraceResult results[2];
+	try
+		{
+		dataSet.setCacheTransforms(false);
+		Misc::Timer finalizeTimer;
+		dataSet.finalizeGrid();
+		finalizeTimer.elapse();
+		std::cout<<"Grid finalization: "<<finalizeTimer.getTime()*1000.0<<" ms"<<std::endl;
+		results[0]=trace(dataSet,numCells,numPaths,numSteps,stepSize);
+		
+		/* Cache the cells' barycentric transformations, and measure point location again: */
+		Misc::Timer cacheTimer;
+		dataSet.setCacheTransforms(true);
+		cacheTimer.elapse();
+		std::cout<<"Transformation cache: "<<dataSet.getTransformCacheSize()/1024<<" KB, built in "<<cacheTimer.getTime()*1000.0<<" ms"<<std::endl;
+		results[1]=trace(dataSet,numCells,numPaths,numSteps,stepSize);
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"Unable to locate points due to exception "<<err.what()<<std::endl;
+		return 1;
+		}
+	
+	/* Print the benchmark results: */
+	static const char* runNames[2]={"Without cache","With cache"};
+	for(int run=0;run<2;++run)
+		{
+		const TraceResult& r=results[run];
+		std::cout<<runNames[run]<<": "<<r.numFound<<'/'<<r.numLocates<<" points located in "<<r.time*1000.0<<" ms, ";
+		std::cout<<double(r.numLocates)/r.time*1.0e-6<<" Mlocates/s, max. error "<<r.maxError<<std::endl;
+		}
+	std::cout<<"Speed-up: "<<results[0].time/results[1].time<<std::endl;
+	
+	return 0;
+	}
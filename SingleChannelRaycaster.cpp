@@ -1,7 +1,7 @@
 /***********************************************************************
 SingleChannelRaycaster - Class for volume renderers with a single scalar
 channel.
-Copyright (c) 2007-2023 Oliver Kreylos
+Copyright (c) 2007-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,7 +25,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Config.h>
 
 #include <string>
+#include <vector>
 #include <iostream>
+#include <Misc/Utility.h>
 #include <GL/gl.h>
 #include <GL/GLContextData.h>
 #include <GL/Extensions/GLARBMultitexture.h>
@@ -38,23 +40,52 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 Methods of class SingleChannelRaycaster::DataItem:
 *************************************************/
 
-SingleChannelRaycaster::DataItem::DataItem(void)
-	:haveFloatTextures(GLARBTextureFloat::isSupported()),
+SingleChannelRaycaster::DataItem::DataItem(const OccupancyGrid& occupancyGrid,const BrickedVolume* brickedVolume)
+	:Raycaster::DataItem(occupancyGrid),
+	 haveFloatTextures(GLARBTextureFloat::isSupported()),
 	 volumeTextureID(0),volumeTextureVersion(0),
 	 colorMapTextureID(0),
-	 volumeSamplerLoc(-1),colorMapSamplerLoc(-1)
+	 brickCache(0),atlasSize(0,0,0),pageTableTextureID(0),brickBuffer(0),
+	 volumeSamplerLoc(-1),colorMapSamplerLoc(-1),
+	 volumeSizeLoc(-1),voxelMaxLoc(-1),brickSizeLoc(-1),
+	 pageTableSamplerLoc(-1),pageTableSizeLoc(-1),atlasSizeLoc(-1),
+	 quantizedPageTableLoc(-1),slotSizeLoc(-1)
 	{
 	/* Initialize all required OpenGL extensions: */
 	GLARBMultitexture::initExtension();
 	if(haveFloatTextures)
 		GLARBTextureFloat::initExtension();
 	GLEXTTexture3D::initExtension();
-
+	
 	/* Create the volume texture object: */
 	glGenTextures(1,&volumeTextureID);
 	
 	/* Create the color map texture object: */
 	glGenTextures(1,&colorMapTextureID);
+	
+	if(brickedVolume!=0)
+		{
+		/* Determine the number of atlas slots that fit into the largest supported 3D texture: */
+		GLint max3DTextureSize;
+		glGetIntegerv(GL_MAX_3D_TEXTURE_SIZE_EXT,&max3DTextureSize);
+		unsigned int slotSize=brickedVolume->getSlotSize();
+		static const unsigned int maxNumSlots[3]={16,16,8};
+		BrickedVolume::Size3 numSlots;
+		for(int i=0;i<3;++i)
+			{
+			numSlots[i]=Misc::min(maxNumSlots[i],(unsigned int)(max3DTextureSize)/slotSize);
+			if(numSlots[i]<1)
+				numSlots[i]=1;
+			atlasSize[i]=numSlots[i]*slotSize;
+			}
+		
+		/* Create the brick cache and the brick upload buffer: */
+		brickCache=new BrickedVolume::Cache(*brickedVolume,numSlots);
+		brickBuffer=new Voxel[size_t(slotSize)*size_t(slotSize)*size_t(slotSize)];
+		
+		/* Create the page table texture object: */
+		glGenTextures(1,&pageTableTextureID);
+		}
 	}
 
 SingleChannelRaycaster::DataItem::~DataItem(void)
@@ -64,6 +95,12 @@ SingleChannelRaycaster::DataItem::~DataItem(void)
 	
 	/* Destroy the color map texture object: */
 	glDeleteTextures(1,&colorMapTextureID);
+	
+	/* Destroy the brick cache and page table texture object: */
+	delete brickCache;
+	delete[] brickBuffer;
+	if(pageTableTextureID!=0)
+		glDeleteTextures(1,&pageTableTextureID);
 	}
 
 /***************************************
@@ -78,16 +115,35 @@ void SingleChannelRaycaster::initDataItem(Raycaster::DataItem* dataItem) const
 	/* Get a pointer to the data item: */
 	DataItem* myDataItem=static_cast<DataItem*>(dataItem);
 	
-	/* Create the data volume texture: */
+	/* Create the data volume texture, or the brick atlas texture if the volume is bricked: */
 	glBindTexture(GL_TEXTURE_3D_EXT,myDataItem->volumeTextureID);
 	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_MAG_FILTER,GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_S,GL_CLAMP);
 	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_T,GL_CLAMP);
 	glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_R_EXT,GL_CLAMP);
-	glTexImage3DEXT(GL_TEXTURE_3D_EXT,0,GL_INTENSITY,myDataItem->textureSize,0,GL_LUMINANCE,GL_UNSIGNED_BYTE,0);
+	if(myDataItem->brickCache!=0)
+		glTexImage3DEXT(GL_TEXTURE_3D_EXT,0,GL_INTENSITY16,myDataItem->atlasSize,0,GL_LUMINANCE,GL_UNSIGNED_SHORT,0);
+	else
+		glTexImage3DEXT(GL_TEXTURE_3D_EXT,0,GL_INTENSITY16,myDataItem->textureSize,0,GL_LUMINANCE,GL_UNSIGNED_SHORT,0);
 	glBindTexture(GL_TEXTURE_3D_EXT,0);
 	
+	if(myDataItem->brickCache!=0)
+		{
+		/* Create the page table texture, which must be looked up without interpolation, and is quantized to 8 bits without floating-point textures: */
+		glBindTexture(GL_TEXTURE_3D_EXT,myDataItem->pageTableTextureID);
+		glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_S,GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_T,GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_3D_EXT,GL_TEXTURE_WRAP_R_EXT,GL_CLAMP_TO_EDGE);
+		if(myDataItem->haveFloatTextures)
+			glTexImage3DEXT(GL_TEXTURE_3D_EXT,0,GL_RGBA32F_ARB,brickedVolume->getNumBricks(0),0,GL_RGBA,GL_FLOAT,0);
+		else
+			glTexImage3DEXT(GL_TEXTURE_3D_EXT,0,GL_RGBA8,brickedVolume->getNumBricks(0),0,GL_RGBA,GL_UNSIGNED_BYTE,0);
+		glBindTexture(GL_TEXTURE_3D_EXT,0);
+		}
+	
 	/* Create the color map texture: */
 	glBindTexture(GL_TEXTURE_1D,myDataItem->colorMapTextureID);
 	glTexParameteri(GL_TEXTURE_1D,GL_TEXTURE_MIN_FILTER,GL_LINEAR);
@@ -107,6 +163,17 @@ void SingleChannelRaycaster::initShader(Raycaster::DataItem* dataItem) const
 	/* Get the shader's uniform locations: */
 	myDataItem->volumeSamplerLoc=myDataItem->shader.getUniformLocation("volumeSampler");
 	myDataItem->colorMapSamplerLoc=myDataItem->shader.getUniformLocation("colorMapSampler");
+	if(myDataItem->brickCache!=0)
+		{
+		myDataItem->volumeSizeLoc=myDataItem->shader.getUniformLocation("volumeSize");
+		myDataItem->voxelMaxLoc=myDataItem->shader.getUniformLocation("voxelMax");
+		myDataItem->brickSizeLoc=myDataItem->shader.getUniformLocation("brickSize");
+		myDataItem->pageTableSamplerLoc=myDataItem->shader.getUniformLocation("pageTableSampler");
+		myDataItem->pageTableSizeLoc=myDataItem->shader.getUniformLocation("pageTableSize");
+		myDataItem->atlasSizeLoc=myDataItem->shader.getUniformLocation("atlasSize");
+		myDataItem->quantizedPageTableLoc=myDataItem->shader.getUniformLocation("quantizedPageTable");
+		myDataItem->slotSizeLoc=myDataItem->shader.getUniformLocation("slotSize");
+		}
 	}
 
 void SingleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const Raycaster::PTransform& mv,SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const
@@ -118,63 +185,138 @@ void SingleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 	DataItem* myDataItem=static_cast<DataItem*>(dataItem);
 	
 	/* Bind the volume texture: */
-	glActiveTextureARB(GL_TEXTURE1_ARB);
+	glActiveTextureARB(GL_TEXTURE2_ARB);
 	glBindTexture(GL_TEXTURE_3D_EXT,myDataItem->volumeTextureID);
-	glUniform1iARB(myDataItem->volumeSamplerLoc,1);
+	glUniform1iARB(myDataItem->volumeSamplerLoc,2);
+	glPixelStorei(GL_UNPACK_ALIGNMENT,1);
 	
-	/* Check if the volume texture needs to be updated: */
-	if(myDataItem->volumeTextureVersion!=dataVersion)
+	if(myDataItem->brickCache!=0)
+		{
+		/* Calculate the eye position in full-resolution voxel coordinates: */
+		Point eye=renderState.getEyePos();
+		BrickedVolume::Scalar voxelEye[3];
+		for(int i=0;i<3;++i)
+			voxelEye[i]=(eye[i]*myDataItem->mcScale[i]+myDataItem->mcOffset[i])*Scalar(myDataItem->textureSize[i])-Scalar(0.5);
+		
+		/* Select the set of bricks to render from the current eye position: */
+		BrickedVolume::Cache& cache=*myDataItem->brickCache;
+		brickedVolume->select(cache,voxelEye,lodError,cache.getNumSlots().volume());
+		
+		/* Upload all newly selected bricks into their atlas slots: */
+		const std::vector<BrickedVolume::Upload>& uploads=cache.getUploads();
+		GLsizei slotSize=GLsizei(brickedVolume->getSlotSize());
+		for(std::vector<BrickedVolume::Upload>::const_iterator uIt=uploads.begin();uIt!=uploads.end();++uIt)
+			{
+			brickedVolume->extractBrick(uIt->brick,myDataItem->brickBuffer);
+			glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,GLint(uIt->slot[0])*slotSize,GLint(uIt->slot[1])*slotSize,GLint(uIt->slot[2])*slotSize,slotSize,slotSize,slotSize,GL_LUMINANCE,GL_UNSIGNED_SHORT,myDataItem->brickBuffer);
+			}
+		
+		/* Bind the page table texture: */
+		glActiveTextureARB(GL_TEXTURE4_ARB);
+		glBindTexture(GL_TEXTURE_3D_EXT,myDataItem->pageTableTextureID);
+		glUniform1iARB(myDataItem->pageTableSamplerLoc,4);
+		
+		/* Upload the page table if the brick selection changed: */
+		if(!uploads.empty()||myDataItem->volumeTextureVersion!=dataVersion)
+			{
+			if(myDataItem->haveFloatTextures)
+				glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,brickedVolume->getNumBricks(0),GL_RGBA,GL_FLOAT,cache.getPageTable());
+			else
+				glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,brickedVolume->getNumBricks(0),GL_RGBA,GL_UNSIGNED_BYTE,cache.getQuantizedPageTable());
+			myDataItem->volumeTextureVersion=dataVersion;
+			}
+		
+		/* Set the brick lookup parameters: */
+		glUniform3fARB(myDataItem->volumeSizeLoc,GLfloat(myDataItem->textureSize[0]),GLfloat(myDataItem->textureSize[1]),GLfloat(myDataItem->textureSize[2]));
+		glUniform3fARB(myDataItem->voxelMaxLoc,GLfloat(dataSize[0]-1),GLfloat(dataSize[1]-1),GLfloat(dataSize[2]-1));
+		glUniform1fARB(myDataItem->brickSizeLoc,GLfloat(brickedVolume->getBrickSize()));
+		const BrickedVolume::Size3& numBricks=brickedVolume->getNumBricks(0);
+		glUniform3fARB(myDataItem->pageTableSizeLoc,GLfloat(numBricks[0]),GLfloat(numBricks[1]),GLfloat(numBricks[2]));
+		glUniform3fARB(myDataItem->atlasSizeLoc,GLfloat(myDataItem->atlasSize[0]),GLfloat(myDataItem->atlasSize[1]),GLfloat(myDataItem->atlasSize[2]));
+		glUniform1iARB(myDataItem->quantizedPageTableLoc,myDataItem->haveFloatTextures?0:1);
+		glUniform1fARB(myDataItem->slotSizeLoc,GLfloat(slotSize));
+		}
+	else if(myDataItem->volumeTextureVersion!=dataVersion)
 		{
 		/* Upload the new volume data: */
-		glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,dataSize,GL_LUMINANCE,GL_UNSIGNED_BYTE,data);
+		glTexSubImage3DEXT(GL_TEXTURE_3D_EXT,0,dataSize,GL_LUMINANCE,GL_UNSIGNED_SHORT,data);
 		
 		/* Mark the volume texture as up-to-date: */
 		myDataItem->volumeTextureVersion=dataVersion;
 		}
 	
 	/* Bind the color map texture: */
-	glActiveTextureARB(GL_TEXTURE2_ARB);
+	glActiveTextureARB(GL_TEXTURE3_ARB);
 	glBindTexture(GL_TEXTURE_1D,myDataItem->colorMapTextureID);
-	glUniform1iARB(myDataItem->colorMapSamplerLoc,2);
+	glUniform1iARB(myDataItem->colorMapSamplerLoc,3);
 	
 	/* Create the stepsize-adjusted colormap with pre-multiplied alpha: */
 	GLColorMap adjustedColorMap(*colorMap);
 	adjustedColorMap.changeTransparency(stepSize*transparencyGamma);
 	adjustedColorMap.premultiplyAlpha();
-	glTexImage1D(GL_TEXTURE_1D,0,myDataItem->haveFloatTextures?GL_RGBA32F_ARB:GL_RGBA,256,0,GL_RGBA,GL_FLOAT,adjustedColorMap.getColors());
+	glTexImage1D(GL_TEXTURE_1D,0,myDataItem->haveFloatTextures?GL_RGBA32F_ARB:GL_RGBA,adjustedColorMap.getNumEntries(),0,GL_RGBA,GL_FLOAT,adjustedColorMap.getColors());
 	}
 
 void SingleChannelRaycaster::unbindShader(SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const
 	{
+	/* Get a pointer to the data item: */
+	DataItem* myDataItem=static_cast<DataItem*>(dataItem);
+	
+	/* Unbind the page table texture: */
+	if(myDataItem->brickCache!=0)
+		{
+		glActiveTextureARB(GL_TEXTURE4_ARB);
+		glBindTexture(GL_TEXTURE_3D_EXT,0);
+		}
+	
 	/* Unbind the color map texture: */
-	glActiveTextureARB(GL_TEXTURE2_ARB);
+	glActiveTextureARB(GL_TEXTURE3_ARB);
 	glBindTexture(GL_TEXTURE_1D,0);
 	
 	/* Bind the volume texture: */
-	glActiveTextureARB(GL_TEXTURE1_ARB);
+	glActiveTextureARB(GL_TEXTURE2_ARB);
 	glBindTexture(GL_TEXTURE_3D,0);
 	
 	/* Call the base class method: */
 	Raycaster::unbindShader(renderState,dataItem);
 	}
 
+bool SingleChannelRaycaster::classifyOccupancy(Raycaster::DataItem* dataItem) const
+	{
+	/* Leave all bricks occupied if there is no color map: */
+	if(colorMap==0)
+		return false;
+	
+	/* Classify the volume's bricks against the color map's opacities (transparency gamma does not affect which entries are fully transparent): */
+	const float* opacities[1];
+	opacities[0]=colorMap->getColors()[0].getRgba()+3;
+	int numOpacities[1];
+	numOpacities[0]=colorMap->getNumEntries();
+	return occupancyGrid.classify(dataItem->occupancy,opacities,numOpacities,4);
+	}
+
 SingleChannelRaycaster::SingleChannelRaycaster(const Raycaster::Size3& sDataSize,const Raycaster::Box& sDomain)
-	:Raycaster(sDataSize,sDomain),
+	:Raycaster(sDataSize,sDomain,1),
 	 data(new Voxel[dataSize.volume()]),dataVersion(0),
+	 brickedVolume(0),lodError(0.002f),
 	 colorMap(0),transparencyGamma(1.0f)
 	{
+	/* Represent the volume as a multiresolution brick hierarchy if it is too large for a single texture: */
+	if(dataSize[0]>maxUnbrickedSize||dataSize[1]>maxUnbrickedSize||dataSize[2]>maxUnbrickedSize)
+		brickedVolume=new BrickedVolume(dataSize,32);
 	}
 
 SingleChannelRaycaster::~SingleChannelRaycaster(void)
 	{
-	/* Delete the volume dataset: */
+	/* Delete the volume dataset and its brick hierarchy: */
 	delete[] data;
+	delete brickedVolume;
 	}
 
 void SingleChannelRaycaster::initContext(GLContextData& contextData) const
 	{
 	/* Create a new data item: */
-	DataItem* dataItem=new DataItem;
+	DataItem* dataItem=new DataItem(occupancyGrid,brickedVolume);
 	contextData.addDataItem(this,dataItem);
 	
 	/* Initialize the data item: */
@@ -187,7 +329,7 @@ void SingleChannelRaycaster::initContext(GLContextData& contextData) const
 		vertexShaderName.append("/SingleChannelRaycaster.vs");
 		dataItem->shader.compileVertexShader(vertexShaderName.c_str());
 		std::string fragmentShaderName=VISUALIZATION_CONFIG_SHADERDIR;
-		fragmentShaderName.append("/SingleChannelRaycaster.fs");
+		fragmentShaderName.append(brickedVolume!=0?"/SingleChannelBrickedRaycaster.fs":"/SingleChannelRaycaster.fs");
 		dataItem->shader.compileFragmentShader(fragmentShaderName.c_str());
 		dataItem->shader.linkShader();
 		
@@ -211,6 +353,18 @@ void SingleChannelRaycaster::updateData(void)
 	{
 	/* Bump up the data version number: */
 	++dataVersion;
+	
+	/* Update the value ranges of all bricks for empty-space skipping: */
+	occupancyGrid.updateRanges(0,data,dataStrides);
+	
+	/* Recalculate the brick hierarchy: */
+	if(brickedVolume!=0)
+		brickedVolume->setData(data,dataStrides);
+	}
+
+void SingleChannelRaycaster::setLodError(Raycaster::Scalar newLodError)
+	{
+	lodError=newLodError;
 	}
 
 void SingleChannelRaycaster::setColorMap(const GLColorMap* newColorMap)
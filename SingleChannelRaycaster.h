@@ -1,7 +1,7 @@
 /***********************************************************************
 SingleChannelRaycaster - Class for volume renderers with a single scalar
 channel.
-Copyright (c) 2007-2023 Oliver Kreylos
+Copyright (c) 2007-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -27,12 +27,13 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/GLColorMap.h>
 
 #include <Raycaster.h>
+#include <BrickedVolume.h>
 
 class SingleChannelRaycaster:public Raycaster
 	{
 	/* Embedded classes: */
 	protected:
-	typedef GLubyte Voxel; // Type for voxel data
+	typedef GLushort Voxel; // Type for voxel data
 	
 	struct DataItem:public Raycaster::DataItem
 		{
@@ -40,22 +41,38 @@ class SingleChannelRaycaster:public Raycaster
 		public:
 		bool haveFloatTextures; // Flag whether the local OpenGL supports floating-point textures
 		
-		GLuint volumeTextureID; // Texture object ID for volume data texture
+		GLuint volumeTextureID; // Texture object ID for volume data texture, or for the brick atlas texture if the volume is bricked
 		unsigned int volumeTextureVersion; // Version number of volume data texture
 		GLuint colorMapTextureID; // Texture object ID for stepsize-adjusted color map texture
 		
+		BrickedVolume::Cache* brickCache; // Cache of bricks resident in the brick atlas texture, or null if the volume is not bricked
+		Size3 atlasSize; // Size of the brick atlas texture in voxels
+		GLuint pageTableTextureID; // Texture object ID for the page table mapping full-resolution bricks to atlas slots
+		Voxel* brickBuffer; // Buffer to extract bricks for upload into the brick atlas texture
+		
 		int volumeSamplerLoc; // Location of the volume data texture sampler
 		int colorMapSamplerLoc; // Location of the color map texture sampler
+		int volumeSizeLoc; // Location of the size of the volume in voxels
+		int voxelMaxLoc; // Location of the maximum voxel coordinate
+		int brickSizeLoc; // Location of the number of voxel cells per brick
+		int pageTableSamplerLoc; // Location of the page table texture sampler
+		int pageTableSizeLoc; // Location of the page table texture size
+		int atlasSizeLoc; // Location of the brick atlas texture size
+		int quantizedPageTableLoc; // Location of the flag whether the page table texture holds quantized slot indices and levels
+		int slotSizeLoc; // Location of the number of voxels per atlas slot
 		
 		/* Constructors and destructors: */
-		DataItem(void);
+		DataItem(const OccupancyGrid& occupancyGrid,const BrickedVolume* brickedVolume);
 		virtual ~DataItem(void);
 		};
 	
 	/* Elements: */
 	protected:
+	static const unsigned int maxUnbrickedSize=512; // Maximum volume size along any dimension to be rendered from a single texture
 	Voxel* data; // Pointer to the volume dataset
 	unsigned int dataVersion; // Version number of the volume dataset to track changes
+	BrickedVolume* brickedVolume; // Multiresolution brick hierarchy for volumes that are too large for a single texture, or null
+	Scalar lodError; // Maximum projected size of a voxel in radians before higher-resolution bricks are selected
 	const GLColorMap* colorMap; // Pointer to the color map
 	GLfloat transparencyGamma; // Adjustment factor for color map's overall opacity
 	
@@ -65,6 +82,7 @@ class SingleChannelRaycaster:public Raycaster
 	virtual void initShader(Raycaster::DataItem* dataItem) const;
 	virtual void bindShader(const PTransform& pmv,const PTransform& mv,SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const;
 	virtual void unbindShader(SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const;
+	virtual bool classifyOccupancy(Raycaster::DataItem* dataItem) const;
 	
 	/* Constructors and destructors: */
 	public:
@@ -87,6 +105,15 @@ class SingleChannelRaycaster:public Raycaster
 		return data;
 		}
 	virtual void updateData(void); // Notifies the raycaster that the volume dataset has changed
+	bool isBricked(void) const // Returns true if the volume is rendered from a brick atlas
+		{
+		return brickedVolume!=0;
+		}
+	Scalar getLodError(void) const // Returns the maximum projected voxel size for brick selection
+		{
+		return lodError;
+		}
+	void setLodError(Scalar newLodError); // Sets the maximum projected voxel size for brick selection
 	const GLColorMap* getColorMap(void) const // Returns the raycaster's color map
 		{
 		return colorMap;
@@ -0,0 +1,397 @@
+/***********************************************************************
+SoftwareRaycaster - Class to render single-channel volumes on the CPU
+using multiple threads, for render nodes without OpenGL 2.0 support.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <SoftwareRaycaster.h>
+
+#include <vector>
+#include <Misc/Timer.h>
+#include <Threads/Mutex.h>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Vector.h>
+#include <GL/GLColorMap.h>
+
+#include <ParallelTasks.h>
+
+/**************************************************
+Declaration of struct SoftwareRaycaster::RenderJob:
+**************************************************/
+
+struct SoftwareRaycaster::RenderJob
+	{
+	/* Elements: */
+	public:
+	const SoftwareRaycaster* raycaster; // The raycaster executing the job
+	PTransform clipToModel; // Transformation from clip space to model space
+	std::vector<Plane> planes; // Outward-facing planes of the convex rendering domain
+	Size2 imageSize; // Size of the rendered image
+	const float* depthBuffer; // Window-space ray termination depths, or null
+	float* image; // The rendered RGBA image
+	unsigned int numTiles[2]; // Number of tiles along each image dimension
+	int numColors; // Number of entries in the color map, at least two
+	std::vector<float> colors; // Step-size adjusted color map with pre-multiplied alpha
+	Scalar dcScale[3]; // Scale factors from model space to data space
+	Threads::Mutex tileMutex; // Mutex protecting the next tile index
+	unsigned int nextTile; // Index of the next tile to render
+	std::vector<RenderStatistics> threadStats; // Per-thread render statistics
+	};
+
+namespace {
+
+/****************
+Helper functions:
+****************/
+
+inline float sampleVoxel(const SoftwareRaycaster::Voxel* data,const ptrdiff_t strides[3],const SoftwareRaycaster::Size3& size,const SoftwareRaycaster::Scalar dc[3])
+	{
+	/* Find the cell containing the sample position and the interpolation weights: */
+	ptrdiff_t offset=0;
+	float w[3];
+	ptrdiff_t s[3];
+	for(int i=0;i<3;++i)
+		{
+		float c=Math::clamp(dc[i],0.0f,float(size[i]-1));
+		unsigned int ci=(unsigned int)(c);
+		if(ci>size[i]-2)
+			ci=size[i]-2;
+		w[i]=c-float(ci);
+		offset+=ptrdiff_t(ci)*strides[i];
+		s[i]=strides[i];
+		}
+	const SoftwareRaycaster::Voxel* v=data+offset;
+	
+	/* Interpolate trilinearly along x, then y, then z: */
+	float v00=float(v[0])*(1.0f-w[0])+float(v[s[0]])*w[0];
+	float v10=float(v[s[1]])*(1.0f-w[0])+float(v[s[1]+s[0]])*w[0];
+	float v01=float(v[s[2]])*(1.0f-w[0])+float(v[s[2]+s[0]])*w[0];
+	float v11=float(v[s[2]+s[1]])*(1.0f-w[0])+float(v[s[2]+s[1]+s[0]])*w[0];
+	float v0=v00*(1.0f-w[1])+v10*w[1];
+	float v1=v01*(1.0f-w[1])+v11*w[1];
+	return v0*(1.0f-w[2])+v1*w[2];
+	}
+
+}
+
+/**********************************
+Methods of class SoftwareRaycaster:
+**********************************/
+
+void* SoftwareRaycaster::renderThreadFunction(SoftwareRaycaster::RenderJob* job)
+	{
+	/* Accumulate this thread's statistics locally: */
+	RenderStatistics stats;
+	stats.numRays=0;
+	stats.numSamples=0;
+	stats.numSkippedSteps=0;
+	stats.renderTime=0.0;
+	
+	/* Render tiles until all tiles are taken: */
+	unsigned int totalNumTiles=job->numTiles[0]*job->numTiles[1];
+	while(true)
+		{
+		unsigned int tileIndex;
+		{
+		Threads::Mutex::Lock tileLock(job->tileMutex);
+		tileIndex=job->nextTile;
+		if(tileIndex<totalNumTiles)
+			++job->nextTile;
+		}
+		if(tileIndex>=totalNumTiles)
+			break;
+		
+		job->raycaster->renderTile(*job,tileIndex,stats);
+		}
+	
+	/* Store the thread's statistics: */
+	{
+	Threads::Mutex::Lock tileLock(job->tileMutex);
+	job->threadStats.push_back(stats);
+	}
+	
+	return 0;
+	}
+
+void SoftwareRaycaster::renderTile(SoftwareRaycaster::RenderJob& job,unsigned int tileIndex,SoftwareRaycaster::RenderStatistics& stats) const
+	{
+	typedef Geometry::Vector<Scalar,3> Vector;
+	
+	/* Calculate the tile's pixel range: */
+	unsigned int x0=(tileIndex%job.numTiles[0])*tileSize;
+	unsigned int y0=(tileIndex/job.numTiles[0])*tileSize;
+	unsigned int x1=Math::min(x0+tileSize,job.imageSize[0]);
+	unsigned int y1=Math::min(y0+tileSize,job.imageSize[1]);
+	
+	Scalar step=stepSize*cellSize;
+	unsigned int brickSize=occupancyGrid.getBrickSize();
+	const Size3& numBricks=occupancyGrid.getNumBricks();
+	const unsigned char* occ=occupancy.getOccupancy();
+	const float* colors=&job.colors[0];
+	float colorScale=float(job.numColors)/65535.0f;
+	float maxColorIndex=float(job.numColors-1);
+	
+	for(unsigned int y=y0;y<y1;++y)
+		{
+		Scalar ny=(Scalar(y)+Scalar(0.5))*Scalar(2)/Scalar(job.imageSize[1])-Scalar(1);
+		for(unsigned int x=x0;x<x1;++x)
+			{
+			size_t pixelIndex=size_t(y)*job.imageSize[0]+x;
+			float* pixel=job.image+pixelIndex*4;
+			float accum[4]={0.0f,0.0f,0.0f,0.0f};
+			
+			/* Calculate the pixel's ray in model space from the near plane to the ray termination depth: */
+			Scalar nx=(Scalar(x)+Scalar(0.5))*Scalar(2)/Scalar(job.imageSize[0])-Scalar(1);
+			Scalar termDepth=job.depthBuffer!=0?Scalar(job.depthBuffer[pixelIndex])*Scalar(2)-Scalar(1):Scalar(1);
+			Point start=job.clipToModel.transform(Point(nx,ny,Scalar(-1)));
+			Point end=job.clipToModel.transform(Point(nx,ny,termDepth));
+			Vector dir=end-start;
+			Scalar lambdaMax=Geometry::mag(dir);
+			++stats.numRays;
+			if(lambdaMax>Scalar(0))
+				{
+				dir/=lambdaMax;
+				
+				/* Clip the ray against the rendering domain: */
+				Scalar lambdaMin(0);
+				for(std::vector<Plane>::const_iterator pIt=job.planes.begin();pIt!=job.planes.end()&&lambdaMin<lambdaMax;++pIt)
+					{
+					Scalar denom=pIt->getNormal()*dir;
+					Scalar num=pIt->getOffset()-pIt->getNormal()*start;
+					if(denom>Scalar(0))
+						lambdaMax=Math::min(lambdaMax,num/denom);
+					else if(denom<Scalar(0))
+						lambdaMin=Math::max(lambdaMin,num/denom);
+					else if(num<Scalar(0))
+						lambdaMax=lambdaMin;
+					}
+				
+				if(lambdaMin<lambdaMax)
+					{
+					/* Move the ray starting position forward to an integer multiple of the step size: */
+					Scalar lambda=Math::ceil(lambdaMin/step);
+					Scalar lambdaEnd=lambdaMax/step;
+					
+					/* Convert the ray to data space in units of steps: */
+					Scalar dc[3],dcDir[3],bcStepsPerBrick[3];
+					for(int i=0;i<3;++i)
+						{
+						dc[i]=(start[i]+dir[i]*lambda*step-domain.min[i])*job.dcScale[i];
+						dcDir[i]=dir[i]*step*job.dcScale[i];
+						bcStepsPerBrick[i]=Scalar(brickSize)/Math::max(Math::abs(dcDir[i]),Scalar(1.0e-6));
+						}
+					
+					/* Cast the ray and accumulate opacities and colors: */
+					while(lambda<=lambdaEnd)
+						{
+						/* Find the brick containing the current sample position: */
+						size_t brickIndex=0;
+						unsigned int brick[3];
+						for(int i=2;i>=0;--i)
+							{
+							Scalar bc=dc[i]/Scalar(brickSize);
+							brick[i]=bc>Scalar(0)?Math::min((unsigned int)(bc),numBricks[i]-1):0U;
+							brickIndex=brickIndex*numBricks[i]+brick[i];
+							}
+						
+						/* Check if the brick is fully transparent under the current color map: */
+						if(occ[brickIndex]==0)
+							{
+							/* Skip to the first sample position beyond the brick's exit face: */
+							Scalar minExitDist(Math::Constants<Scalar>::max);
+							for(int i=0;i<3;++i)
+								{
+								Scalar bc=dc[i]/Scalar(brickSize)-Scalar(brick[i]);
+								Scalar exitDist=(dcDir[i]>=Scalar(0)?Scalar(1)-bc:bc)*bcStepsPerBrick[i];
+								minExitDist=Math::min(minExitDist,exitDist);
+								}
+							Scalar numSkipSteps=Math::max(Math::floor(minExitDist)+Scalar(1),Scalar(1));
+							for(int i=0;i<3;++i)
+								dc[i]+=dcDir[i]*numSkipSteps;
+							lambda+=numSkipSteps;
+							stats.numSkippedSteps+=size_t(numSkipSteps);
+							continue;
+							}
+						
+						/* Look up the sample's color from the color map with linear interpolation: */
+						float cm=sampleVoxel(data,dataStrides,dataSize,dc)*colorScale-0.5f;
+						cm=Math::clamp(cm,0.0f,maxColorIndex);
+						int ci=Math::min(int(cm),job.numColors-2);
+						float cw=cm-float(ci);
+						const float* c0=colors+ci*4;
+						
+						/* Accumulate color and opacity four channels at a time: */
+						float weight=1.0f-accum[3];
+						for(int i=0;i<4;++i)
+							accum[i]+=(c0[i]*(1.0f-cw)+c0[4+i]*cw)*weight;
+						++stats.numSamples;
+						
+						/* Bail out when opacity hits 1.0: */
+						if(accum[3]>=1.0f-1.0f/256.0f)
+							break;
+						
+						/* Advance the sample position: */
+						for(int i=0;i<3;++i)
+							dc[i]+=dcDir[i];
+						lambda+=Scalar(1);
+						}
+					}
+				}
+			
+			/* Store the pixel: */
+			for(int i=0;i<4;++i)
+				pixel[i]=accum[i];
+			}
+		}
+	}
+
+SoftwareRaycaster::SoftwareRaycaster(const SoftwareRaycaster::Size3& sDataSize,const SoftwareRaycaster::Box& sDomain)
+	:dataSize(sDataSize),
+	 data(0),
+	 domain(sDomain),cellSize(0),
+	 occupancyGrid(dataSize,8,1),
+	 occupancy(occupancyGrid),
+	 stepSize(1),
+	 colorMap(0),transparencyGamma(1.0f),
+	 numThreads(1),tileSize(32)
+	{
+	/* Calculate the default data strides and cell size: */
+	ptrdiff_t stride=1;
+	for(int i=0;i<3;++i)
+		{
+		dataStrides[i]=stride;
+		stride*=ptrdiff_t(dataSize[i]);
+		cellSize+=Math::sqr((domain.max[i]-domain.min[i])/Scalar(dataSize[i]-1));
+		}
+	cellSize=Math::sqrt(cellSize);
+	}
+
+SoftwareRaycaster::~SoftwareRaycaster(void)
+	{
+	}
+
+void SoftwareRaycaster::setData(const SoftwareRaycaster::Voxel* newData,const ptrdiff_t newDataStrides[3])
+	{
+	data=newData;
+	for(int i=0;i<3;++i)
+		dataStrides[i]=newDataStrides[i];
+	
+	/* Update the value ranges of all bricks for empty-space skipping: */
+	occupancyGrid.updateRanges(0,data,dataStrides);
+	}
+
+void SoftwareRaycaster::setStepSize(SoftwareRaycaster::Scalar newStepSize)
+	{
+	stepSize=newStepSize;
+	}
+
+void SoftwareRaycaster::setColorMap(const GLColorMap* newColorMap)
+	{
+	colorMap=newColorMap;
+	}
+
+void SoftwareRaycaster::setTransparencyGamma(float newTransparencyGamma)
+	{
+	transparencyGamma=newTransparencyGamma;
+	}
+
+void SoftwareRaycaster::setNumThreads(unsigned int newNumThreads)
+	{
+	numThreads=newNumThreads>0?newNumThreads:1;
+	}
+
+void SoftwareRaycaster::setTileSize(unsigned int newTileSize)
+	{
+	tileSize=newTileSize>0?newTileSize:1;
+	}
+
+SoftwareRaycaster::RenderStatistics SoftwareRaycaster::render(const SoftwareRaycaster::PTransform& pmv,const Polyhedron<SoftwareRaycaster::Scalar>* clippedDomain,const SoftwareRaycaster::Size2& imageSize,const float* depthBuffer,float* image)
+	{
+	Misc::Timer renderTimer;
+	RenderStatistics result;
+	result.numRays=0;
+	result.numSamples=0;
+	result.numSkippedSteps=0;
+	
+	/* Render a fully transparent image if there is no data or color map: */
+	if(data==0||colorMap==0)
+		{
+		size_t numValues=imageSize.volume()*4;
+		for(size_t i=0;i<numValues;++i)
+			image[i]=0.0f;
+		renderTimer.elapse();
+		result.renderTime=renderTimer.getTime();
+		return result;
+		}
+	
+	/* Set up the render job: */
+	RenderJob job;
+	job.raycaster=this;
+	job.clipToModel=Geometry::invert(pmv);
+	if(clippedDomain!=0)
+		clippedDomain->getFacePlanes(job.planes);
+	else
+		Polyhedron<Scalar>(domain.min,domain.max).getFacePlanes(job.planes);
+	job.imageSize=imageSize;
+	job.depthBuffer=depthBuffer;
+	job.image=image;
+	for(int i=0;i<2;++i)
+		job.numTiles[i]=(imageSize[i]+tileSize-1)/tileSize;
+	for(int i=0;i<3;++i)
+		job.dcScale[i]=Scalar(dataSize[i]-1)/(domain.max[i]-domain.min[i]);
+	job.nextTile=0;
+	
+	/* Create the stepsize-adjusted colormap with pre-multiplied alpha, exactly like the GPU raycaster: */
+	GLColorMap adjustedColorMap(*colorMap);
+	adjustedColorMap.changeTransparency(stepSize*transparencyGamma);
+	adjustedColorMap.premultiplyAlpha();
+	const float* cPtr=adjustedColorMap.getColors()[0].getRgba();
+	int numEntries=adjustedColorMap.getNumEntries();
+	job.colors.assign(cPtr,cPtr+numEntries*4);
+	if(numEntries<2)
+		{
+		/* Duplicate a single entry to simplify interpolation: */
+		job.colors.insert(job.colors.end(),cPtr,cPtr+4);
+		numEntries=2;
+		}
+	job.numColors=numEntries;
+	
+	/* Classify the volume's bricks against the color map's opacities: */
+	const float* opacities[1];
+	opacities[0]=colorMap->getColors()[0].getRgba()+3;
+	int numOpacities[1];
+	numOpacities[0]=colorMap->getNumEntries();
+	occupancyGrid.classify(occupancy,opacities,numOpacities,4);
+	
+	/* Render all tiles in parallel, with the calling thread doing its share of the work: */
+	ParallelTasks::runSharedTask(&job,numThreads,renderThreadFunction);
+	
+	/* Combine the per-thread statistics: */
+	for(std::vector<RenderStatistics>::iterator tsIt=job.threadStats.begin();tsIt!=job.threadStats.end();++tsIt)
+		{
+		result.numRays+=tsIt->numRays;
+		result.numSamples+=tsIt->numSamples;
+		result.numSkippedSteps+=tsIt->numSkippedSteps;
+		}
+	renderTimer.elapse();
+	result.renderTime=renderTimer.getTime();
+	
+	return result;
+	}
@@ -0,0 +1,136 @@
+/***********************************************************************
+SoftwareRaycaster - Class to render single-channel volumes on the CPU
+using multiple threads, for render nodes without OpenGL 2.0 support.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef SOFTWARERAYCASTER_INCLUDED
+#define SOFTWARERAYCASTER_INCLUDED
+
+#include <stddef.h>
+#include <Misc/Size.h>
+#include <Geometry/Point.h>
+#include <Geometry/Box.h>
+#include <Geometry/Plane.h>
+#include <Geometry/ProjectiveTransformation.h>
+
+#include <Polyhedron.h>
+#include <OccupancyGrid.h>
+
+/* Forward declarations: */
+class GLColorMap;
+
+class SoftwareRaycaster
+	{
+	/* Embedded classes: */
+	public:
+	typedef float Scalar;
+	typedef Misc::Size<2> Size2; // Type for 2D image sizes
+	typedef Misc::Size<3> Size3; // Type for 3D image sizes
+	typedef Geometry::Point<Scalar,3> Point;
+	typedef Geometry::Box<Scalar,3> Box;
+	typedef Geometry::Plane<Scalar,3> Plane;
+	typedef Geometry::ProjectiveTransformation<Scalar,3> PTransform;
+	typedef unsigned short Voxel; // Type for voxel data, compatible with SingleChannelRaycaster
+	
+	struct RenderStatistics // Structure reporting the work done by a render call
+		{
+		/* Elements: */
+		public:
+		size_t numRays; // Number of rays cast
+		size_t numSamples; // Number of volume samples taken along all rays
+		size_t numSkippedSteps; // Number of sampling steps skipped over empty bricks
+		double renderTime; // Wall-clock time of the render call in seconds
+		
+		/* Methods: */
+		double getRaysPerSecond(void) const // Returns the ray throughput of the render call
+			{
+			return renderTime>0.0?double(numRays)/renderTime:0.0;
+			}
+		};
+	
+	private:
+	struct RenderJob; // Structure describing a render call shared by all rendering threads
+	
+	/* Elements: */
+	Size3 dataSize; // Size of volume data
+	ptrdiff_t dataStrides[3]; // Volume data strides in x, y, z dimensions
+	const Voxel* data; // Pointer to the volume data, owned by the caller
+	Box domain; // The volume renderer's domain box in model space
+	Scalar cellSize; // The data set's cell size
+	OccupancyGrid occupancyGrid; // Per-brick value ranges of the volume data for empty-space skipping
+	OccupancyGrid::Classification occupancy; // Classification of the volume's bricks against the current color map
+	Scalar stepSize; // The ray casting step size in cell size units
+	const GLColorMap* colorMap; // Pointer to the color map
+	float transparencyGamma; // Adjustment factor for color map's overall opacity
+	unsigned int numThreads; // Number of threads used for rendering
+	unsigned int tileSize; // Width and height of image tiles handed to rendering threads
+	
+	/* Private methods: */
+	static void* renderThreadFunction(RenderJob* job); // Renders image tiles until the job is done
+	void renderTile(RenderJob& job,unsigned int tileIndex,RenderStatistics& stats) const; // Renders a single image tile
+	
+	/* Constructors and destructors: */
+	public:
+	SoftwareRaycaster(const Size3& sDataSize,const Box& sDomain); // Creates a raycaster for the given data and domain sizes
+	private:
+	SoftwareRaycaster(const SoftwareRaycaster& source); // Prohibit copy constructor
+	SoftwareRaycaster& operator=(const SoftwareRaycaster& source); // Prohibit assignment operator
+	public:
+	~SoftwareRaycaster(void);
+	
+	/* Methods: */
+	const Size3& getDataSize(void) const // Returns the raycaster's data size
+		{
+		return dataSize;
+		}
+	const Box& getDomain(void) const // Returns the raycaster's domain box in model space
+		{
+		return domain;
+		}
+	Scalar getCellSize(void) const // Returns the data's average cell size
+		{
+		return cellSize;
+		}
+	void setData(const Voxel* newData,const ptrdiff_t newDataStrides[3]); // Sets the volume data to render; must be called again whenever the data changes
+	Scalar getStepSize(void) const // Returns the raycaster's step size in cell size units
+		{
+		return stepSize;
+		}
+	void setStepSize(Scalar newStepSize); // Sets the raycaster's step size in cell size units
+	const GLColorMap* getColorMap(void) const // Returns the raycaster's color map
+		{
+		return colorMap;
+		}
+	void setColorMap(const GLColorMap* newColorMap); // Sets the raycaster's color map
+	float getTransparencyGamma(void) const // Returns the opacity adjustment factor
+		{
+		return transparencyGamma;
+		}
+	void setTransparencyGamma(float newTransparencyGamma); // Sets the opacity adjustment factor
+	unsigned int getNumThreads(void) const // Returns the number of rendering threads
+		{
+		return numThreads;
+		}
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of rendering threads
+	void setTileSize(unsigned int newTileSize); // Sets the size of image tiles handed to rendering threads
+	RenderStatistics render(const PTransform& pmv,const Polyhedron<Scalar>* clippedDomain,const Size2& imageSize,const float* depthBuffer,float* image); // Renders the volume as seen through the given model-to-clip transformation into the given RGBA image with pre-multiplied alpha, in bottom-up row order; rays are clipped against the given convex domain, or the domain box if null, and terminated at the window-space depths in the given depth buffer, or the far plane if null
+	};
+
+#endif
@@ -0,0 +1,285 @@
+/***********************************************************************
+SoftwareRaycasterBenchmark - Utility to measure the throughput of the
+software raycaster in rays per second on a synthetic volume, and to
+render reference images on machines without OpenGL.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <iostream>
+#include <vector>
+#include <Math/Math.h>
+#include <Math/Constants.h>
+#include <Geometry/Matrix.h>
+#include <GL/GLColorMap.h>
+
+#include <OccupancyGrid.h>
+#include <SoftwareRaycaster.h>
+
+typedef SoftwareRaycaster::Scalar Scalar;
+typedef SoftwareRaycaster::Point Point;
+typedef SoftwareRaycaster::PTransform PTransform;
+
+PTransform calcViewTransform(const SoftwareRaycaster::Box& domain,Scalar angle,Scalar aspect)
+	{
+	/* Place the eye on a circle around the domain's center, looking at the center: */
+	Point center=Geometry::mid(domain.min,domain.max);
+	Scalar radius(0);
+	for(int i=0;i<3;++i)
+		radius+=Math::sqr(domain.max[i]-domain.min[i]);
+	radius=Math::sqrt(radius)*Scalar(0.5);
+	Scalar eyeDist=radius*Scalar(2.5);
+	Scalar c=Math::cos(angle);
+	Scalar s=Math::sin(angle);
+	
+	/* Build the viewing matrix, rotating model space around the z axis and looking along the y axis: */
+	PTransform::Matrix view=PTransform::Matrix::one;
+	view(0,0)=c;
+	view(0,1)=s;
+	view(0,3)=-(c*center[0]+s*center[1]);
+	view(1,0)=Scalar(0);
+	view(1,1)=Scalar(0);
+	view(1,2)=Scalar(1);
+	view(1,3)=-center[2];
+	view(2,0)=s;
+	view(2,1)=-c;
+	view(2,2)=Scalar(0);
+	view(2,3)=-(s*center[0]-c*center[1])-eyeDist;
+	
+	/* Build a perspective projection matrix enclosing the domain's bounding sphere: */
+	Scalar near=eyeDist-radius;
+	Scalar far=eyeDist+radius;
+	Scalar halfHeight=radius*near/Math::sqrt(Math::sqr(eyeDist)-Math::sqr(radius));
+	PTransform::Matrix proj=PTransform::Matrix::zero;
+	proj(0,0)=near/(halfHeight*aspect);
+	proj(1,1)=near/halfHeight;
+	proj(2,2)=-(far+near)/(far-near);
+	proj(2,3)=-Scalar(2)*far*near/(far-near);
+	proj(3,2)=Scalar(-1);
+	
+	return PTransform(proj*view);
+	}
+
+void savePPM(const char* fileName,const SoftwareRaycaster::Size2& imageSize,const float* image)
+	{
+	/* Write the image composited over black, top row first: */
+	FILE* file=fopen(fileName,"wb");
+	if(file==0)
+		{
+		std::cerr<<"Unable to write image file "<<fileName<<std::endl;
+		return;
+		}
+	fprintf(file,"P6\n%u %u\n255\n",imageSize[0],imageSize[1]);
+	for(unsigned int y=imageSize[1];y>0;--y)
+		{
+		const float* pPtr=image+size_t(y-1)*imageSize[0]*4;
+		for(unsigned int x=0;x<imageSize[0];++x,pPtr+=4)
+			for(int i=0;i<3;++i)
+				fputc(int(Math::clamp(pPtr[i],0.0f,1.0f)*255.0f+0.5f),file);
+		}
+	fclose(file);
+	}
+
+bool checkEmptyBricks(const OccupancyGrid& grid,const OccupancyGrid::Classification& classification,const SoftwareRaycaster::Voxel* data,const ptrdiff_t dataStrides[3],const std::vector<float>& opacities)
+	{
+	/* Check that every brick classified as empty only contains values mapping to transparent color map entries: */
+	const OccupancyGrid::Size3& dataSize=grid.getDataSize();
+	const OccupancyGrid::Size3& numBricks=grid.getNumBricks();
+	unsigned int brickSize=grid.getBrickSize();
+	int numEntries=int(opacities.size());
+	size_t brickIndex=0;
+	for(unsigned int bz=0;bz<numBricks[2];++bz)
+		for(unsigned int by=0;by<numBricks[1];++by)
+			for(unsigned int bx=0;bx<numBricks[0];++bx,++brickIndex)
+				if(!classification.isOccupied(brickIndex))
+					{
+					/* Find the range of voxel values touched by samples inside the brick: */
+					unsigned int b[3]={bx,by,bz};
+					unsigned int v0[3],v1[3];
+					for(int i=0;i<3;++i)
+						{
+						v0[i]=b[i]*brickSize;
+						v1[i]=Math::min(v0[i]+brickSize,dataSize[i]-1);
+						}
+					unsigned int min=65535U;
+					unsigned int max=0U;
+					for(unsigned int z=v0[2];z<=v1[2];++z)
+						for(unsigned int y=v0[1];y<=v1[1];++y)
+							for(unsigned int x=v0[0];x<=v1[0];++x)
+								{
+								unsigned int value=data[x*dataStrides[0]+y*dataStrides[1]+z*dataStrides[2]];
+								min=Math::min(min,value);
+								max=Math::max(max,value);
+								}
+					
+					/* Check all color map entries between which the brick's values are interpolated: */
+					int first=Math::max(int(Math::floor(float(min)/65535.0f*float(numEntries)-0.5f)),0);
+					int last=Math::min(int(Math::ceil(float(max)/65535.0f*float(numEntries)-0.5f)),numEntries-1);
+					for(int i=first;i<=last;++i)
+						if(opacities[i]>0.0f)
+							return false;
+					}
+	
+	return true;
+	}
+
+bool checkClassification(const SoftwareRaycaster::Size3& dataSize,const SoftwareRaycaster::Voxel* data,const ptrdiff_t dataStrides[3],const GLColorMap& colorMap)
+	{
+	/* Create an occupancy grid for the volume like the raycasters do: */
+	OccupancyGrid grid(dataSize,8,1);
+	grid.updateRanges(0,data,dataStrides);
+	
+	/* Extract the color map's opacities: */
+	int numEntries=colorMap.getNumEntries();
+	std::vector<float> opacities(numEntries);
+	for(int i=0;i<numEntries;++i)
+		opacities[i]=colorMap.getColors()[i][3];
+	
+	/* Classify incrementally against the color map, a version with its lower half made transparent, and the color map again: */
+	bool ok=true;
+	OccupancyGrid::Classification incremental(grid);
+	for(int pass=0;pass<3;++pass)
+		{
+		std::vector<float> passOpacities=opacities;
+		if(pass==1)
+			for(int i=0;i<numEntries/2;++i)
+				passOpacities[i]=0.0f;
+		const float* passTables[1]={&passOpacities[0]};
+		grid.classify(incremental,passTables,&numEntries,1);
+		
+		/* Compare against a classification from scratch: */
+		OccupancyGrid::Classification full(grid);
+		grid.classify(full,passTables,&numEntries,1);
+		size_t numBricks=grid.getNumBricks().volume();
+		bool passOk=memcmp(incremental.getOccupancy(),full.getOccupancy(),numBricks)==0;
+		
+		/* Check that no brick containing visible values was classified as empty: */
+		passOk=checkEmptyBricks(grid,full,data,dataStrides,passOpacities)&&passOk;
+		
+		std::cout<<"Brick classification pass "<<pass<<": "<<full.getNumOccupied()<<" of "<<numBricks<<" bricks occupied, "<<(passOk?"OK":"FAILED")<<std::endl;
+		ok=ok&&passOk;
+		}
+	
+	return ok;
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	unsigned int volumeSize=256;
+	SoftwareRaycaster::Size2 imageSize(1024,768);
+	unsigned int numThreads=1;
+	unsigned int numFrames=36;
+	Scalar stepSize(0.5);
+	const char* imageFileName=0;
+	for(int i=1;i<argc;++i)
+		{
+		if(strcasecmp(argv[i],"-volumeSize")==0&&i+1<argc)
+			volumeSize=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-imageSize")==0&&i+2<argc)
+			{
+			imageSize[0]=atoi(argv[++i]);
+			imageSize[1]=atoi(argv[++i]);
+			}
+		else if(strcasecmp(argv[i],"-numThreads")==0&&i+1<argc)
+			numThreads=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-numFrames")==0&&i+1<argc)
+			numFrames=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-stepSize")==0&&i+1<argc)
+			stepSize=Scalar(atof(argv[++i]));
+		else if(strcasecmp(argv[i],"-saveImage")==0&&i+1<argc)
+			imageFileName=argv[++i];
+		else
+			{
+			std::cerr<<"Usage: "<<argv[0]<<" [-volumeSize <size>] [-imageSize <width> <height>] [-numThreads <num>] [-numFrames <num>] [-stepSize <cell fraction>] [-saveImage <PPM file name>]"<<std::endl;
+			return 1;
+			}
+		}
+	if(volumeSize<2||numFrames<1||imageSize[0]<1||imageSize[1]<1)
+		{
+		std::cerr<<"Invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a synthetic volume of nested spherical shells with some empty space in the corners: */
+	SoftwareRaycaster::Size3 dataSize(volumeSize,volumeSize,volumeSize);
+	SoftwareRaycaster::Voxel* data=new SoftwareRaycaster::Voxel[dataSize.volume()];
+	ptrdiff_t dataStrides[3]={1,ptrdiff_t(volumeSize),ptrdiff_t(volumeSize)*ptrdiff_t(volumeSize)};
+	SoftwareRaycaster::Voxel* vPtr=data;
+	for(unsigned int z=0;z<volumeSize;++z)
+		for(unsigned int y=0;y<volumeSize;++y)
+			for(unsigned int x=0;x<volumeSize;++x,++vPtr)
+				{
+				Scalar p[3]={Scalar(x),Scalar(y),Scalar(z)};
+				Scalar r2(0);
+				for(int i=0;i<3;++i)
+					r2+=Math::sqr(p[i]*Scalar(2)/Scalar(volumeSize-1)-Scalar(1));
+				Scalar r=Math::sqrt(r2);
+				Scalar value=r<Scalar(1)?Scalar(0.5)+Scalar(0.5)*Math::cos(r*Scalar(6)*Math::Constants<Scalar>::pi):Scalar(0);
+				*vPtr=SoftwareRaycaster::Voxel(value*Scalar(65535)+Scalar(0.5));
+				}
+	
+	/* Create the raycaster: */
+	SoftwareRaycaster::Box domain(Point(-1,-1,-1),Point(1,1,1));
+	SoftwareRaycaster raycaster(dataSize,domain);
+	raycaster.setData(data,dataStrides);
+	GLColorMap colorMap(GLColorMap::RAINBOW|GLColorMap::RAMP_ALPHA,1.0f,1.0f,0.0,1.0);
+	
+	/* Check the brick classification used for empty-space skipping: */
+	bool ok=checkClassification(dataSize,data,dataStrides,colorMap);
+	
+	raycaster.setColorMap(&colorMap);
+	raycaster.setStepSize(stepSize);
+	raycaster.setNumThreads(numThreads);
+	
+	/* Render the volume from viewpoints around a circle: */
+	float* image=new float[imageSize.volume()*4];
+	SoftwareRaycaster::RenderStatistics total;
+	total.numRays=0;
+	total.numSamples=0;
+	total.numSkippedSteps=0;
+	total.renderTime=0.0;
+	for(unsigned int frame=0;frame<numFrames;++frame)
+		{
+		Scalar angle=Scalar(2)*Math::Constants<Scalar>::pi*Scalar(frame)/Scalar(numFrames);
+		PTransform pmv=calcViewTransform(domain,angle,Scalar(imageSize[0])/Scalar(imageSize[1]));
+		SoftwareRaycaster::RenderStatistics stats=raycaster.render(pmv,0,imageSize,0,image);
+		total.numRays+=stats.numRays;
+		total.numSamples+=stats.numSamples;
+		total.numSkippedSteps+=stats.numSkippedSteps;
+		total.renderTime+=stats.renderTime;
+		}
+	
+	/* Print the benchmark results: */
+	std::cout<<"Volume size: "<<volumeSize<<"^3, image size: "<<imageSize[0]<<'x'<<imageSize[1]<<", threads: "<<numThreads<<", frames: "<<numFrames<<std::endl;
+	std::cout<<"Total render time: "<<total.renderTime*1000.0<<" ms, "<<total.renderTime*1000.0/double(numFrames)<<" ms per frame"<<std::endl;
+	std::cout<<"Throughput: "<<total.getRaysPerSecond()*1.0e-6<<" Mrays/s, "<<(total.renderTime>0.0?double(total.numSamples)/total.renderTime*1.0e-6:0.0)<<" Msamples/s"<<std::endl;
+	std::cout<<"Samples per ray: "<<double(total.numSamples)/double(total.numRays)<<", skipped steps per ray: "<<double(total.numSkippedSteps)/double(total.numRays)<<std::endl;
+	
+	/* Save the last rendered image if requested: */
+	if(imageFileName!=0)
+		savePPM(imageFileName,imageSize,image);
+	
+	delete[] image;
+	delete[] data;
+	
+	return ok?0:1;
+	}
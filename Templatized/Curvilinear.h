@@ -1,7 +1,7 @@
 /***********************************************************************
 Curvilinear - Base class for vertex-centered curvilinear data sets
 containing arbitrary value types (scalars, vectors, tensors, etc.).
-Copyright (c) 2004-2022 Oliver Kreylos
+Copyright (c) 2004-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -32,6 +32,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Tesseract.h>
+#include <Templatized/HypercubicCellGeometry.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
 
@@ -62,6 +63,7 @@ class Curvilinear
 	
 	/* Definition of the data set's cell topology: */
 	typedef Tesseract<dimensionParam> CellTopology; // Policy class to select appropriate cell algorithms
+	typedef HypercubicCellGeometry<dimensionParam> CellGeometry; // Type for cached affine approximations of cells
 	
 	/* Definition of the data set's value space: */
 	typedef ValueParam Value; // Data set's value type
@@ -253,6 +255,7 @@ class Curvilinear
 		CellPosition cellPos; // Local coordinates of last located point inside its cell
 		Scalar epsilon,epsilon2; // Accuracy threshold of point location algorithm
 		bool canTrace; // Flag if the locator can trace on the next locatePoint call
+		size_t numNewtonRaphsonSteps; // Number of Newton-Raphson steps performed by this locator since its creation or the last reset
 		
 		/* Private methods: */
 		bool traverse(int stepDimension,int stepDirection); // Moves the locator into a neighboring cell and estimates the new local cell position
@@ -266,6 +269,14 @@ class Curvilinear
 		/* Methods: */
 		public:
 		void setEpsilon(Scalar newEpsilon); // Sets a new accuracy threshold in local cell dimension
+		size_t getNumNewtonRaphsonSteps(void) const // Returns the number of Newton-Raphson steps performed since the locator's creation or the last reset
+			{
+			return numNewtonRaphsonSteps;
+			}
+		void resetNumNewtonRaphsonSteps(void) // Resets the Newton-Raphson step counter
+			{
+			numNewtonRaphsonSteps=0;
+			}
 		CellID getCellID(void) const // Returns the ID of the cell containing the last located point
 			{
 			return Cell::getID();
@@ -299,9 +310,13 @@ class Curvilinear
 	Scalar avgCellRadius; // Average "radius" of all cells
 	Scalar maxCellRadius2; // Squared maximum "radius" of any cell (used as trivial reject threshold during point location)
 	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
+	bool cacheCellGeometries; // Flag whether to cache each cell's affine approximation to speed up point location
+	CellGeometry* cellGeometries; // Array of cached cell affine approximations in cell index order, or null
 	
 	/* Private methods: */
 	void initStructure(void);
+	void createCellGeometries(void); // Calculates and caches the affine approximations of all cells
+	void destroyCellGeometries(void); // Releases all cached affine approximations
 	template <class ScalarExtractorParam>
 	Vector calcVertexGradient(const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
 	
@@ -364,6 +379,19 @@ class Curvilinear
 		return locatorEpsilon;
 		}
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	bool getCacheCellGeometries(void) const // Returns true if cells' affine approximations are cached
+		{
+		return cacheCellGeometries;
+		}
+	void setCacheCellGeometries(bool newCacheCellGeometries); // Enables or disables caching of cells' affine approximations, trading memory for faster point location
+	size_t getCellGeometryCacheSize(void) const // Returns the amount of memory used by cached cell affine approximations in bytes
+		{
+		return cellGeometries!=0?numCells.calcIncrement(-1)*sizeof(CellGeometry):0;
+		}
+	const CellGeometry* getCellGeometry(const Cell& cell) const // Returns the cached affine approximation of the given cell, or null
+		{
+		return cellGeometries!=0?cellGeometries+numCells.calcOffset(cell.index):0;
+		}
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
@@ -0,0 +1,160 @@
+/***********************************************************************
+FlyingEdgesIsosurfaceExtractor - Class to extract complete isosurfaces
+from Cartesian data sets in separable passes over grid rows, without
+per-edge hashing and using multiple threads.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_FLYINGEDGESISOSURFACEEXTRACTOR_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_FLYINGEDGESISOSURFACEEXTRACTOR_INCLUDED
+
+#include <stddef.h>
+#include <Threads/MutexCond.h>
+#include <Templatized/IndexedTriangleSet.h>
+#include <Templatized/FlyingEdgesTraits.h>
+
+/* Forward declarations: */
+namespace Threads {
+class Thread;
+}
+namespace Visualization {
+namespace Abstract {
+class Algorithm;
+}
+namespace Templatized {
+template <class CellTopologyParam>
+class IsosurfaceCaseTable;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam,class ScalarExtractorParam,class VertexParam>
+class FlyingEdgesIsosurfaceExtractor
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of the data set the isosurface extractor works on
+	typedef typename DataSet::Scalar Scalar; // Scalar type of the data set's domain
+	typedef typename DataSet::Point Point; // Type for points in the data set's domain
+	typedef typename DataSet::Vector Vector; // Type for vectors in the data set's domain
+	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
+	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
+	typedef IndexedTriangleSet<VertexParam> Isosurface; // Type of isosurface representation
+	
+	private:
+	typedef typename DataSet::Index GridIndex; // Type for vertex indices in the data set's grid
+	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
+	typedef IsosurfaceCaseTable<CellTopology> CaseTable; // Type of isosurface case table
+	typedef typename Isosurface::Vertex Vertex; // Type of vertices stored in isosurface
+	typedef typename Isosurface::Index Index; // Type for vertex indices
+	typedef void (FlyingEdgesIsosurfaceExtractor::*PassMethod)(size_t firstRow,size_t lastRow); // Type for methods processing a range of grid rows in one extraction pass
+	struct Task; // Structure identifying a worker thread processing its share of each batch of grid rows
+	
+	/* Elements: */
+	const DataSet& dataSet; // The data set from which isosurfaces are extracted
+	const ScalarExtractor& scalarExtractor; // The scalar extractor
+	unsigned int numThreads; // Number of threads used to process grid rows
+	int numCaseTriangles[256]; // Number of triangles generated by each isosurface case
+	
+	/* Transient extraction state: */
+	bool smooth; // Flag whether the current isosurface has smooth shared vertices or flat per-triangle vertices
+	VScalar isovalue; // The current isovalue
+	size_t numVertices[3]; // Number of grid vertices along each axis; grid rows run along the last axis
+	size_t numRows; // Total number of grid rows
+	ptrdiff_t vertexStrides[3]; // Linear index strides of the grid vertex array along each axis
+	ptrdiff_t vertexOffsets[8]; // Linear index offsets of a cell's vertices from the cell's base vertex
+	ptrdiff_t edgeVertexOffsets[12]; // Linear index offsets of a cell's edges' base vertices from the cell's base vertex
+	ptrdiff_t edgeRowOffsets[12]; // Offsets of the grid rows containing a cell's edges' base vertices from the cell's grid row
+	unsigned char* vertexClasses; // Array of flags whether each grid vertex is on or above the isovalue
+	size_t* rowNumCrossings; // Number of intersected edges owned by each grid row, for each of the three edge directions
+	size_t* rowVertexBases; // Index of the first isosurface vertex generated for each grid row
+	size_t* rowTriangleBases; // Index of the first isosurface triangle generated for each grid row
+	Vertex* vertices; // Array of generated isosurface vertices
+	Index* triangleIndices; // Array of generated isosurface vertex index triples
+	
+	/* Worker thread state: */
+	Threads::MutexCond batchCond; // Condition variable to hand batches of grid rows to the worker threads and to signal their completion
+	PassMethod batchPass; // Pass method to run on the current batch
+	size_t batchFirstRow,batchLastRow; // Range of grid rows in the current batch
+	unsigned int batchIndex; // Running index of the current batch; incremented when a new batch is handed out
+	unsigned int numBusyWorkers; // Number of worker threads still processing their share of the current batch
+	bool shutdownWorkers; // Flag to shut down the worker threads at the end of an extraction
+	
+	/* Private methods: */
+	static void* workerThreadFunction(Task* task); // Processes the worker thread's share of each batch of grid rows until the worker threads are shut down
+	void calcTaskRows(unsigned int taskIndex,size_t& firstRow,size_t& lastRow) const // Returns the range of grid rows of the current batch processed by the given task
+		{
+		firstRow=batchFirstRow+((batchLastRow-batchFirstRow)*taskIndex)/numThreads;
+		lastRow=batchFirstRow+((batchLastRow-batchFirstRow)*(taskIndex+1))/numThreads;
+		}
+	VScalar getValue(size_t vertexIndex) const // Returns the scalar value of the grid vertex of the given linear index
+		{
+		return FlyingEdgesTraits<DataSet>::getValue(dataSet,scalarExtractor,vertexIndex);
+		}
+	bool isCrossed(size_t vertexIndex,int direction) const // Returns true if the edge starting at the given grid vertex and running along the given direction is intersected by the isosurface
+		{
+		return vertexClasses[vertexIndex]!=vertexClasses[vertexIndex+vertexStrides[direction]];
+		}
+	int calcCaseIndex(size_t cellBaseIndex) const // Returns the isosurface case index of the cell of the given base vertex
+		{
+		int caseIndex=0x0;
+		for(int i=0;i<8;++i)
+			if(vertexClasses[cellBaseIndex+vertexOffsets[i]])
+				caseIndex|=1<<i;
+		return caseIndex;
+		}
+	Point calcEdgePosition(const size_t cellIndex[3],int edgeIndex,Scalar weight) const; // Returns an interpolated point along the given edge of the cell of the given grid index
+	Vector calcVertexGradient(const size_t vertexIndex[3]) const; // Returns the gradient at the grid vertex of the given grid index
+	void classifyRows(size_t firstRow,size_t lastRow); // Classifies grid vertices and counts intersected edges along the row direction
+	void countRows(size_t firstRow,size_t lastRow); // Counts intersected edges across grid rows and triangles in cell rows
+	void generateRows(size_t firstRow,size_t lastRow); // Generates isosurface vertices and triangles
+	void runPass(PassMethod pass,Visualization::Abstract::Algorithm* algorithm,float percentBegin,float percentEnd); // Runs an extraction pass over all grid rows in batches shared between the worker threads and the calling thread, and updates the busy dialog after each batch
+	void stopWorkers(Threads::Thread* workers,unsigned int numWorkers); // Shuts down and joins the given worker threads
+	void releaseArrays(void); // Deletes the extraction's intermediate and result arrays
+	
+	/* Constructors and destructors: */
+	public:
+	FlyingEdgesIsosurfaceExtractor(const DataSet& sDataSet,const ScalarExtractor& sScalarExtractor); // Creates an isosurface extractor for the given data set and scalar extractor
+	private:
+	FlyingEdgesIsosurfaceExtractor(const FlyingEdgesIsosurfaceExtractor& source); // Prohibit copy constructor
+	FlyingEdgesIsosurfaceExtractor& operator=(const FlyingEdgesIsosurfaceExtractor& source); // Prohibit assignment operator
+	public:
+	~FlyingEdgesIsosurfaceExtractor(void);
+	
+	/* Methods: */
+	unsigned int getNumThreads(void) const // Returns the number of threads used to process grid rows
+		{
+		return numThreads;
+		}
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads used to process grid rows
+	void extractIsosurface(bool newSmooth,VScalar newIsovalue,Isosurface& isosurface,Visualization::Abstract::Algorithm* algorithm); // Appends the complete isosurface for the given isovalue to the given triangle set; requires a subsequent flush()
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_FLYINGEDGESISOSURFACEEXTRACTOR_IMPLEMENTATION
+#include <Templatized/FlyingEdgesIsosurfaceExtractor.icpp>
+#endif
+
+#endif
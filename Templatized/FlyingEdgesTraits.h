@@ -0,0 +1,60 @@
+/***********************************************************************
+FlyingEdgesTraits - Traits class to select a structured-grid isosurface
+extractor for data set types that support one.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_FLYINGEDGESTRAITS_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_FLYINGEDGESTRAITS_INCLUDED
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Abstract {
+class Algorithm;
+}
+namespace Templatized {
+template <class VertexParam>
+class IndexedTriangleSet;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class DataSetParam>
+class FlyingEdgesTraits // Generic traits class for data sets that do not support structured-grid isosurface extraction
+	{
+	/* Embedded classes: */
+	public:
+	typedef DataSetParam DataSet; // Type of data sets described by the traits class
+	
+	/* Methods: */
+	template <class ScalarExtractorParam,class VertexParam>
+	static bool extractIsosurface(const DataSet& dataSet,const ScalarExtractorParam& scalarExtractor,bool smooth,typename ScalarExtractorParam::Scalar isovalue,IndexedTriangleSet<VertexParam>& isosurface,Visualization::Abstract::Algorithm* algorithm) // Extracts the complete isosurface into the given triangle set; returns false if the data set type is not supported
+		{
+		return false;
+		}
+	};
+
+}
+
+}
+
+#endif
@@ -0,0 +1,86 @@
+/***********************************************************************
+FlyingEdgesTraitsCartesian - Specialized flying edges traits classes for
+Cartesian data sets.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#ifndef VISUALIZATION_TEMPLATIZED_FLYINGEDGESTRAITSCARTESIAN_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_FLYINGEDGESTRAITSCARTESIAN_INCLUDED
+
+#include <stddef.h>
+
+#include <Templatized/FlyingEdgesTraits.h>
+
+/* Forward declarations: */
+namespace Visualization {
+namespace Templatized {
+template <class ScalarParam,int dimensionParam,class ValueParam>
+class Cartesian;
+template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+class SlicedCartesian;
+}
+}
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ScalarParam,class ValueParam>
+class FlyingEdgesTraits<Cartesian<ScalarParam,3,ValueParam> >
+	{
+	/* Embedded classes: */
+	public:
+	typedef Cartesian<ScalarParam,3,ValueParam> DataSet; // Type of data sets described by the traits class
+	
+	/* Methods: */
+	template <class ScalarExtractorParam>
+	static typename ScalarExtractorParam::Scalar getValue(const DataSet& dataSet,const ScalarExtractorParam& scalarExtractor,size_t linearIndex) // Returns the scalar value of the vertex of the given linear index
+		{
+		return scalarExtractor.getValue(dataSet.getVertices().getArray()[linearIndex]);
+		}
+	template <class ScalarExtractorParam,class VertexParam>
+	static bool extractIsosurface(const DataSet& dataSet,const ScalarExtractorParam& scalarExtractor,bool smooth,typename ScalarExtractorParam::Scalar isovalue,IndexedTriangleSet<VertexParam>& isosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts the complete isosurface into the given triangle set
+	};
+
+template <class ScalarParam,class ValueScalarParam>
+class FlyingEdgesTraits<SlicedCartesian<ScalarParam,3,ValueScalarParam> >
+	{
+	/* Embedded classes: */
+	public:
+	typedef SlicedCartesian<ScalarParam,3,ValueScalarParam> DataSet; // Type of data sets described by the traits class
+	
+	/* Methods: */
+	template <class ScalarExtractorParam>
+	static typename ScalarExtractorParam::Scalar getValue(const DataSet& dataSet,const ScalarExtractorParam& scalarExtractor,size_t linearIndex) // Returns the scalar value of the vertex of the given linear index
+		{
+		return scalarExtractor.getValue(ptrdiff_t(linearIndex));
+		}
+	template <class ScalarExtractorParam,class VertexParam>
+	static bool extractIsosurface(const DataSet& dataSet,const ScalarExtractorParam& scalarExtractor,bool smooth,typename ScalarExtractorParam::Scalar isovalue,IndexedTriangleSet<VertexParam>& isosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts the complete isosurface into the given triangle set
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_FLYINGEDGESTRAITSCARTESIAN_IMPLEMENTATION
+#include <Templatized/FlyingEdgesTraitsCartesian.icpp>
+#endif
+
+#endif
@@ -0,0 +1,81 @@
+/***********************************************************************
+HypercubicCellGeometry - Helper class to cache a compact affine
+approximation of a hypercubic cell's multilinear mapping, to speed up
+cell location in curvilinear data sets.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef VISUALIZATION_TEMPLATIZED_HYPERCUBICCELLGEOMETRY_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_HYPERCUBICCELLGEOMETRY_INCLUDED
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <int dimensionParam>
+class HypercubicCellGeometry
+	{
+	/* Embedded classes: */
+	public:
+	static const int dimension=dimensionParam; // Dimension of the cell's domain
+	static const int numVertices=1<<dimensionParam; // Number of vertices of the cell
+	
+	/* Elements: */
+	private:
+	float inverse[dimensionParam][dimensionParam]; // Inverse of the cell's Jacobian matrix at its center
+	float centerOffset[dimensionParam]; // Position of the cell's center relative to its base vertex
+	float residual2; // Squared upper bound on the distance between the cell's multilinear mapping and its affine approximation inside the cell
+	
+	/* Methods: */
+	public:
+	template <class CellParam>
+	bool calculate(const CellParam& cell); // Calculates the affine approximation of the given cell; returns false and falls back to the cell's center if the cell is degenerate
+	float getResidual2(void) const // Returns the squared upper bound on the affine approximation's error in domain space
+		{
+		return residual2;
+		}
+	template <class PointParam,class CellPositionParam>
+	void estimateCellPosition(const PointParam& baseVertex,const PointParam& position,CellPositionParam& cellPos) const // Estimates the local cell coordinates of the given position, given the position of the cell's base vertex
+		{
+		/* Calculate the position relative to the cell's center: */
+		float d[dimensionParam];
+		for(int i=0;i<dimensionParam;++i)
+			d[i]=float(position[i]-baseVertex[i])-centerOffset[i];
+		
+		/* Apply the inverse Jacobian: */
+		for(int i=0;i<dimensionParam;++i)
+			{
+			float c=0.5f;
+			for(int j=0;j<dimensionParam;++j)
+				c+=inverse[i][j]*d[j];
+			cellPos[i]=c;
+			}
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_HYPERCUBICCELLGEOMETRY_IMPLEMENTATION
+#include <Templatized/HypercubicCellGeometry.icpp>
+#endif
+
+#endif
@@ -1,7 +1,7 @@
 /***********************************************************************
 HypercubicLocator - Helper class to perform cell location in data sets
 consisting of hypercubic cells.
-Copyright (c) 2010-2011 Oliver Kreylos
+Copyright (c) 2010-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -38,6 +38,7 @@ class HypercubicLocator
 	typedef typename DataSet::Point Point; // Type for points in data set's domain
 	typedef typename DataSet::Vector Vector; // Type for vectors in data set's domain
 	typedef typename DataSet::CellTopology CellTopology; // Data set's cell topology
+	typedef typename DataSet::CellGeometry CellGeometry; // Data set's type for cached cell affine approximations
 	typedef typename DataSet::CellID CellID; // Data set's cell ID type
 	typedef typename DataSet::Cell Cell; // Data set's cell type
 	typedef typename DataSet::Locator Locator; // Data set's locator type
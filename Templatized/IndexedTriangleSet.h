@@ -1,7 +1,7 @@
 /***********************************************************************
 IndexedTriangleSet - Class to represent surfaces as sets of triangles
 sharing vertices.
-Copyright (c) 2006-2023 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,10 +23,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_INDEXEDTRIANGLESET_INCLUDED
 
+#include <Misc/SizedTypes.h>
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
 /* Forward declarations: */
+namespace IO {
+class File;
+}
 namespace Cluster {
 class MulticastPipe;
 }
@@ -113,6 +117,14 @@ class IndexedTriangleSet:public GLObject
 	/* Private methods: */
 	void addNewVertexChunk(void); // Adds a new chunk to the vertex buffer
 	void addNewIndexChunk(void); // Adds a new chunk to the index buffer
+	static Misc::UInt64 encodeIndex(Index index,Index previous) // Returns the zig-zag code of the difference between a vertex index and the previous vertex index
+		{
+		return index>=previous?Misc::UInt64(index-previous)<<1:(Misc::UInt64(previous-index)<<1)-1U;
+		}
+	static Index decodeIndex(Misc::UInt64 code,Index previous) // Returns the vertex index encoded by the given zig-zag code relative to the previous vertex index
+		{
+		return (code&0x1U)!=0U?previous-Index((code+1U)>>1):previous+Index(code>>1);
+		}
 	
 	/* Constructors and destructors: */
 	public:
@@ -165,6 +177,12 @@ class IndexedTriangleSet:public GLObject
 		}
 	void receive(void); // Receives triangle set data via multicast pipe until next flush() point
 	void flush(void); // Sends pending triangle set data across the multicast pipe and terminates receive() method on slaves
+	size_t calcEncodedSize(void) const; // Returns the size of the triangle set's compact binary encoding in bytes
+	void write(IO::File& file) const; // Writes the triangle set to the given binary file using a compact encoding
+	void read(IO::File& file); // Appends a compactly-encoded triangle set read from the given binary file; sends full chunks across the multicast pipe, but requires a subsequent flush()
+	void append(const IndexedTriangleSet& source); // Appends all vertices and triangles of the given triangle set; sends full chunks across the multicast pipe, but requires a subsequent flush()
+	void appendTriangles(const IndexedTriangleSet& source,Index baseIndex); // Appends the triangles of the given triangle set with vertex indices offset by the given base index; requires a subsequent flush()
+	void append(size_t numNewVertices,const Vertex* newVertices,size_t numNewTriangles,const Index* newTriangleIndices); // Appends the given arrays of vertices and triangles, with vertex indices relative to the first new vertex; sends full chunks across the multicast pipe, but requires a subsequent flush()
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
 		{
 		return numVertices;
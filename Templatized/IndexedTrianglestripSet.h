@@ -1,7 +1,7 @@
 /***********************************************************************
 IndexedTrianglestripSet - Class to represent surfaces as sets of
 triangle strips sharing vertices.
-Copyright (c) 2007-2011 Oliver Kreylos
+Copyright (c) 2007-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -26,6 +26,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <GL/gl.h>
 #include <GL/GLObject.h>
 
+/* Forward declarations: */
+namespace Cluster {
+class MulticastPipe;
+}
+namespace SceneGraph {
+class GLRenderState;
+}
+
 namespace Visualization {
 
 namespace Templatized {
@@ -102,6 +110,7 @@ class IndexedTrianglestripSet:public GLObject
 	
 	/* Elements: */
 	private:
+	Cluster::MulticastPipe* pipe; // Pipe to stream triangle strip set data in a cluster environment (owned by caller)
 	unsigned int version; // Version number of the triangle strip set (incremented on each clear operation)
 	size_t numVertices; // Number of vertices in the set
 	size_t numIndices; // Number of vertex indices in the set
@@ -112,6 +121,9 @@ class IndexedTrianglestripSet:public GLObject
 	IndexChunk* indexTail; // Pointer to last index buffer chunk
 	StripChunk* stripHead; // Pointer to first strip buffer chunk
 	StripChunk* stripTail; // Pointer to last strip buffer chunk
+	size_t tailNumSentVertices; // Number of vertices in the last vertex buffer chunk that were already sent across the pipe
+	size_t tailNumSentIndices; // Number of vertex indices in the last index buffer chunk that were already sent across the pipe
+	size_t tailNumSentStrips; // Number of strip lengths in the last strip buffer chunk that were already sent across the pipe
 	size_t numVerticesLeft; // Number of vertices left in last vertex buffer chunk
 	size_t numIndicesLeft; // Number of vertex indices left in last index buffer chunk
 	size_t numStripsLeft; // Number of strips left in last strip buffer chunk
@@ -121,13 +133,14 @@ class IndexedTrianglestripSet:public GLObject
 	GLsizei* nextStrip; // Pointer to next strip length to be stored
 	
 	/* Private methods: */
+	void sendPendingData(void); // Sends all vertices, vertex indices, and strip lengths in the last buffer chunks that were not yet sent across the pipe
 	void addNewVertexChunk(void); // Adds a new chunk to the vertex buffer
 	void addNewIndexChunk(void); // Adds a new chunk to the index buffer
 	void addNewStripChunk(void); // Adds a new chunk to the strip buffer
 	
 	/* Constructors and destructors: */
 	public:
-	IndexedTrianglestripSet(void); // Creates empty triangle strip set
+	IndexedTrianglestripSet(Cluster::MulticastPipe* sPipe); // Creates empty triangle strip set for given multicast pipe (or 0 in single-machine environment)
 	private:
 	IndexedTrianglestripSet(const IndexedTrianglestripSet& source); // Prohibit copy constructor
 	IndexedTrianglestripSet& operator=(const IndexedTrianglestripSet& source); // Prohibit assignment operator
@@ -203,6 +216,8 @@ class IndexedTrianglestripSet:public GLObject
 		--numStripsLeft;
 		currentStripLength=0;
 		}
+	void receive(void); // Receives triangle strip set data via multicast pipe until next flush() point
+	void flush(void); // Sends pending triangle strip set data across the multicast pipe and terminates receive() method on slaves
 	size_t getNumVertices(void) const // Returns number of vertices currently in buffer
 		{
 		return numVertices;
@@ -215,7 +230,7 @@ class IndexedTrianglestripSet:public GLObject
 		{
 		return numStrips;
 		}
-	void glRenderAction(GLContextData& contextData) const; // Renders all triangle strips in the buffer
+	void glRenderAction(SceneGraph::GLRenderState& renderState) const; // Renders all triangle strips in the buffer
 	};
 
 }
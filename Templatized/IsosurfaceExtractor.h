@@ -1,7 +1,7 @@
 /***********************************************************************
 IsosurfaceExtractor - Generic class to extract isosurfaces from data
 sets.
-Copyright (c) 2005-2011 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 
 #include <Misc/OneTimeQueue.h>
 
+#include <Templatized/RegionOfInterest.h>
+
 /* Forward declarations: */
 namespace Visualization {
 namespace Abstract {
@@ -54,6 +56,7 @@ class IsosurfaceExtractor
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef IsosurfaceParam Isosurface; // Type of isosurface representation
+	typedef RegionOfInterest<Scalar,dimension> ROI; // Type for regions of interest restricting extraction
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
 		{
@@ -72,6 +75,7 @@ class IsosurfaceExtractor
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
+	ROI regionOfInterest; // Region of the data set's domain to which extraction is restricted
 	ExtractionMode extractionMode; // Surface extraction mode
 	
 	/* Isosurface extraction state: */
@@ -114,6 +118,14 @@ class IsosurfaceExtractor
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
 		}
+	const ROI& getRegionOfInterest(void) const // Returns the region of interest
+		{
+		return regionOfInterest;
+		}
+	void setRegionOfInterest(const ROI& newRegionOfInterest) // Restricts subsequent extraction to the given region of interest
+		{
+		regionOfInterest=newRegionOfInterest;
+		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
 	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
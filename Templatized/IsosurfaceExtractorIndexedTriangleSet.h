@@ -1,7 +1,7 @@
 /***********************************************************************
 IsosurfaceExtractorIndexedTriangleSet - Specialized version of
 IsosurfaceExtractor class for indexed triangle sets.
-Copyright (c) 2006-2011 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/HashTable.h>
 #include <Misc/OneTimeQueue.h>
 #include <Templatized/IndexedTriangleSet.h>
+#include <Templatized/RegionOfInterest.h>
 #include <Templatized/IsosurfaceExtractor.h>
 
 /* Forward declarations: */
@@ -57,6 +58,7 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef IndexedTriangleSet<VertexParam> Isosurface; // Type of isosurface representation
+	typedef RegionOfInterest<Scalar,dimension> ROI; // Type for regions of interest restricting extraction
 	
 	enum ExtractionMode // Enumerated type for isosurface extraction modes
 		{
@@ -73,11 +75,13 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	typedef typename Isosurface::Vertex Vertex; // Type of vertices stored in isosurface
 	typedef typename Isosurface::Index Index; // Type for vertex indices
 	typedef Misc::HashTable<EdgeID,Index,EdgeID> VertexIndexHasher; // Hash table to map edge IDs to vertex indices in the isosurface
+	typedef Misc::HashTable<CellID,void,CellID> CellSet; // Hash table to record sets of cells
 	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
+	ROI regionOfInterest; // Region of the data set's domain to which extraction is restricted
 	ExtractionMode extractionMode; // Surface extraction mode
 	
 	/* Isosurface extraction state: */
@@ -86,6 +90,15 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 	VertexIndexHasher vertexIndices; // Hasher mapping edge IDs to vertex indices in the isosurface
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
 	
+	/* State of the most recent incrementally extracted seeded isosurface, to reuse it for subsequent seed requests: */
+	CellSet seededCells; // Set of intersected cells that contributed fragments to the seeded isosurface
+	bool seededComplete; // Flag whether the seeded isosurface was extracted completely
+	const DataSet* seededDataSet; // Data set from which the seeded isosurface was extracted
+	ROI seededRegionOfInterest; // Region of interest to which the seeded isosurface was restricted
+	ExtractionMode seededExtractionMode; // Extraction mode of the seeded isosurface
+	VScalar seededIsovalue; // Isovalue of the seeded isosurface
+	VScalar isovalueTolerance; // Largest difference between a new seed's isovalue and the seeded isosurface's isovalue at which the seeded isosurface is reused
+	
 	/* Private methods: */
 	int extractFlatIsosurfaceFragment(const Cell& cell); // Extracts a flat-shaded isosurface fragment from a cell and stores it in the current isosurface representation
 	int extractSmoothIsosurfaceFragment(const Cell& cell); // Extracts a gradient-shaded isosurface fragment from a cell and stores it in the current isosurface representation
@@ -121,10 +134,22 @@ class IsosurfaceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<V
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
 		}
+	const ROI& getRegionOfInterest(void) const // Returns the region of interest
+		{
+		return regionOfInterest;
+		}
+	void setRegionOfInterest(const ROI& newRegionOfInterest) // Restricts subsequent extraction to the given region of interest
+		{
+		regionOfInterest=newRegionOfInterest;
+		}
 	void setExtractionMode(ExtractionMode newExtractionMode); // Sets the current isosurface extraction mode
+	void setIsovalueTolerance(VScalar newIsovalueTolerance) // Sets the largest isovalue difference at which the previous seeded isosurface is reused
+		{
+		isovalueTolerance=newIsovalueTolerance;
+		}
 	void extractIsosurface(VScalar newIsovalue,Isosurface& newIsosurface,Visualization::Abstract::Algorithm* algorithm); // Extracts a global isosurface for the given isovalue and stores it in the given isosurface
 	void extractSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Extracts a seeded isosurface for the given isovalue from the given cell and stores it in the given isosurface
-	void startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface); // Starts extracting a seeded isosurface for the given isovalue from the given cell
+	bool startSeededIsosurface(const Locator& seedLocator,Isosurface& newIsosurface,const Isosurface* previousIsosurface =0); // Starts extracting a seeded isosurface for the given isovalue from the given cell; copies the given previous result of the most recent complete seeded extraction instead if the seed cell lies on it at an isovalue within the isovalue tolerance, and returns true in that case
 	template <class ContinueFunctorParam>
 	bool continueSeededIsosurface(const ContinueFunctorParam& cf); // Continues extracting a seeded isosurface while the continue functor returns true; returns true if the isosurface is finished
 	void finishSeededIsosurface(void); // Cleans up after creating a seeded isosurface
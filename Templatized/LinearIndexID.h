@@ -1,7 +1,7 @@
 /***********************************************************************
 LinearIndexID - Helper class to use unsigned integers as IDs for data
 set objects such as vertices, edges, and cells.
-Copyright (c) 2006-2007 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -27,11 +27,12 @@ namespace Visualization {
 
 namespace Templatized {
 
-class LinearIndexID
+template <class IndexParam>
+class SizedLinearIndexID
 	{
 	/* Embedded classes: */
 	public:
-	typedef unsigned int Index; // Type for linear indices
+	typedef IndexParam Index; // Type for linear indices
 	
 	/* Elements: */
 	private:
@@ -39,11 +40,11 @@ class LinearIndexID
 	
 	/* Constructors and destructors: */
 	public:
-	LinearIndexID(void) // Constructs invalid ID
+	SizedLinearIndexID(void) // Constructs invalid ID
 		:index(~Index(0))
 		{
 		}
-	LinearIndexID(Index sIndex)
+	SizedLinearIndexID(Index sIndex)
 		:index(sIndex)
 		{
 		}
@@ -57,20 +58,22 @@ class LinearIndexID
 		{
 		return index;
 		}
-	friend bool operator==(const LinearIndexID& li1,const LinearIndexID& li2)
+	friend bool operator==(const SizedLinearIndexID& li1,const SizedLinearIndexID& li2)
 		{
 		return li1.index==li2.index;
 		}
-	friend bool operator!=(const LinearIndexID& li1,const LinearIndexID& li2)
+	friend bool operator!=(const SizedLinearIndexID& li1,const SizedLinearIndexID& li2)
 		{
 		return li1.index!=li2.index;
 		}
-	static size_t hash(const LinearIndexID& li,size_t tableSize)
+	static size_t hash(const SizedLinearIndexID& li,size_t tableSize)
 		{
 		return size_t(li.index)%tableSize;
 		}
 	};
 
+typedef SizedLinearIndexID<unsigned int> LinearIndexID; // Default ID type using 32-bit indices
+
 }
 
 }
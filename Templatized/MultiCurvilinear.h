@@ -2,7 +2,7 @@
 MultiCurvilinear - Base class for vertex-centered multi-block
 curvilinear data sets containing arbitrary value types (scalars,
 vectors, tensors, etc.).
-Copyright (c) 2007-2022 Oliver Kreylos
+Copyright (c) 2007-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -33,6 +33,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/Tesseract.h>
+#include <Templatized/HypercubicCellGeometry.h>
 #include <Templatized/LinearIndexID.h>
 #include <Templatized/IteratorWrapper.h>
 
@@ -63,6 +64,7 @@ class MultiCurvilinear
 	
 	/* Definition of the data set's cell topology: */
 	typedef Tesseract<dimensionParam> CellTopology; // Policy class to select appropriate cell algorithms
+	typedef HypercubicCellGeometry<dimensionParam> CellGeometry; // Type for cached affine approximations of cells
 	
 	/* Definition of the data set's value space: */
 	typedef ValueParam Value; // Data set's value type
@@ -106,6 +108,7 @@ class MultiCurvilinear
 		int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
 		Index numCells; // Number of cells in data set in each dimension
 		int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
+		const CellGeometry* cellGeometries; // Pointer to the grid's cached cell affine approximations in cell index order, or null
 		
 		/* Constructors and destructors: */
 		private:
@@ -341,6 +344,7 @@ class MultiCurvilinear
 		CellPosition cellPos; // Local coordinates of last located point inside its cell
 		Scalar epsilon,epsilon2; // Accuracy threshold of point location algorithm
 		bool canTrace; // Flag if the locator can trace on the next locatePoint call
+		size_t numNewtonRaphsonSteps; // Number of Newton-Raphson steps performed by this locator since its creation or the last reset
 		
 		/* Private methods: */
 		bool traverse(int stepDimension,int stepDirection); // Moves the locator into a neighboring cell and estimates the new local cell position
@@ -354,6 +358,14 @@ class MultiCurvilinear
 		/* Methods: */
 		public:
 		void setEpsilon(Scalar newEpsilon); // Sets a new accuracy threshold in local cell dimension
+		size_t getNumNewtonRaphsonSteps(void) const // Returns the number of Newton-Raphson steps performed since the locator's creation or the last reset
+			{
+			return numNewtonRaphsonSteps;
+			}
+		void resetNumNewtonRaphsonSteps(void) // Resets the Newton-Raphson step counter
+			{
+			numNewtonRaphsonSteps=0;
+			}
 		CellID getCellID(void) const // Returns the ID of the cell containing the last located point
 			{
 			return Cell::getID();
@@ -390,9 +402,13 @@ class MultiCurvilinear
 	Scalar avgCellRadius; // Average "radius" of all cells
 	Scalar maxCellRadius2; // Squared maximum "radius" of any cell in any grid (used as trivial reject threshold during point location)
 	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
+	bool cacheCellGeometries; // Flag whether to cache each cell's affine approximation to speed up point location
+	CellGeometry* cellGeometries; // Array of cached cell affine approximations of all grids in cell iteration order, or null
 	
 	/* Private methods: */
 	void initStructure(void);
+	void createCellGeometries(void); // Calculates and caches the affine approximations of all cells
+	void destroyCellGeometries(void); // Releases all cached affine approximations
 	template <class ScalarExtractorParam>
 	Vector calcVertexGradient(int gridIndex,const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
 	void storeGridConnector(const Cell& cell,int faceIndex,const CellID& otherCell); // Stores a connection between a cell face and another cell during grid finalization
@@ -432,6 +448,20 @@ class MultiCurvilinear
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
 	bool isBoundaryFace(int gridIndex,int faceIndex) const; // Returns true if the given face of the given grid is entirely on the boundary of the data set
 	bool isInteriorFace(int gridIndex,int faceIndex) const; // Returns true if the given face of the given grid is entirely in the interior of the data set
+	bool getCacheCellGeometries(void) const // Returns true if cells' affine approximations are cached
+		{
+		return cacheCellGeometries;
+		}
+	void setCacheCellGeometries(bool newCacheCellGeometries); // Enables or disables caching of cells' affine approximations, trading memory for faster point location
+	size_t getCellGeometryCacheSize(void) const // Returns the amount of memory used by cached cell affine approximations in bytes
+		{
+		return cellGeometries!=0?totalNumCells*sizeof(CellGeometry):0;
+		}
+	const CellGeometry* getCellGeometry(const Cell& cell) const // Returns the cached affine approximation of the given cell, or null
+		{
+		const Grid& grid=grids[cell.gridIndex];
+		return grid.cellGeometries!=0?grid.cellGeometries+grid.numCells.calcOffset(cell.index):0;
+		}
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
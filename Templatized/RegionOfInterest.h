@@ -0,0 +1,121 @@
+/***********************************************************************
+RegionOfInterest - Class to describe regions of a data set's domain to
+which extraction of visualization elements is restricted, as the
+intersection of an optional axis-aligned box and any number of
+half-spaces.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef VISUALIZATION_TEMPLATIZED_REGIONOFINTEREST_INCLUDED
+#define VISUALIZATION_TEMPLATIZED_REGIONOFINTEREST_INCLUDED
+
+#include <stddef.h>
+#include <vector>
+#include <Geometry/Point.h>
+#include <Geometry/Box.h>
+#include <Geometry/Plane.h>
+
+namespace Visualization {
+
+namespace Templatized {
+
+template <class ScalarParam,int dimensionParam>
+class RegionOfInterest
+	{
+	/* Embedded classes: */
+	public:
+	typedef ScalarParam Scalar; // Scalar type of the region's domain
+	static const int dimension=dimensionParam; // Dimension of the region's domain
+	typedef Geometry::Point<Scalar,dimension> Point; // Type for points in the region's domain
+	typedef Geometry::Box<Scalar,dimension> Box; // Type for axis-aligned boxes in the region's domain
+	typedef Geometry::Plane<Scalar,dimension> Plane; // Type for planes bounding half-spaces; a half-space contains all points on or in front of its plane, like an OpenGL clipping plane
+	
+	private:
+	static const int maxNumCellVertices=1<<dimension; // Maximum number of vertices of any supported cell type
+	
+	/* Elements: */
+	bool haveBox; // Flag whether the region is bounded by an axis-aligned box
+	Box box; // Axis-aligned box bounding the region
+	std::vector<Plane> halfSpaces; // List of planes of half-spaces bounding the region
+	
+	/* Private methods: */
+	bool isHullCulled(int numPoints,const Point points[]) const; // Returns true if the convex hull of the given points is entirely outside the region
+	
+	/* Constructors and destructors: */
+	public:
+	RegionOfInterest(void); // Creates an unconstrained region covering the entire domain
+	template <class SourceScalarParam>
+	RegionOfInterest(const RegionOfInterest<SourceScalarParam,dimensionParam>& source); // Converts a region of a different scalar type
+	
+	/* Methods: */
+	bool isConstrained(void) const // Returns true if the region does not cover the entire domain
+		{
+		return haveBox||!halfSpaces.empty();
+		}
+	bool hasBox(void) const // Returns true if the region is bounded by an axis-aligned box
+		{
+		return haveBox;
+		}
+	const Box& getBox(void) const // Returns the axis-aligned box bounding the region
+		{
+		return box;
+		}
+	size_t getNumHalfSpaces(void) const // Returns the number of half-spaces bounding the region
+		{
+		return halfSpaces.size();
+		}
+	const Plane& getHalfSpace(size_t index) const // Returns the plane of the half-space of the given index
+		{
+		return halfSpaces[index];
+		}
+	bool operator==(const RegionOfInterest& other) const; // Returns true if the two regions are bounded by identical boxes and half-spaces
+	bool operator!=(const RegionOfInterest& other) const // Returns true if the two regions differ
+		{
+		return !operator==(other);
+		}
+	template <class ContainerParam>
+	void getComponents(ContainerParam& components) const; // Appends a flat encoding of the region's box flag, box, and half-space planes to the given container
+	template <class IteratorParam>
+	void setComponents(IteratorParam componentsBegin,IteratorParam componentsEnd); // Sets the region from a flat encoding created by getComponents, or to the entire domain if the encoding is empty; throws an exception if the encoding is malformed
+	void clear(void); // Resets the region to cover the entire domain
+	void setBox(const Box& newBox); // Bounds the region by the given axis-aligned box
+	void addHalfSpace(const Plane& plane); // Bounds the region by the half-space in front of the given plane
+	bool contains(const Point& point) const; // Returns true if the given point is inside the region
+	bool contains(const Box& otherBox) const; // Returns true if the given box is entirely inside the region
+	bool isCulled(const Box& otherBox) const; // Returns true if the given box is entirely outside the region
+	template <class CellParam>
+	bool isCulled(const CellParam& cell,int numCellVertices) const // Returns true if the given cell with the given number of vertices is entirely outside the region
+		{
+		Point cellVertices[maxNumCellVertices];
+		for(int i=0;i<numCellVertices;++i)
+			cellVertices[i]=cell.getVertexPosition(i);
+		return isHullCulled(numCellVertices,cellVertices);
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_TEMPLATIZED_REGIONOFINTEREST_IMPLEMENTATION
+#include <Templatized/RegionOfInterest.icpp>
+#endif
+
+#endif
@@ -2,7 +2,7 @@
 Simplical - Base class for vertex-centered simplical (unstructured)
 data sets containing arbitrary value types (scalars, vectors, tensors,
 etc.).
-Copyright (c) 2004-2022 Oliver Kreylos
+Copyright (c) 2004-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -128,12 +128,20 @@ class Simplical
 		};
 	
 	private:
+	struct BarycentricTransform // Structure for cached transformations from domain space to a cell's barycentric coordinates
+		{
+		/* Elements: */
+		public:
+		float inverse[dimensionParam][dimensionParam]; // Inverse of the matrix whose columns are the cell's edge vectors from its first vertex
+		};
+	
 	struct GridCell // Structure for simplical grid cells
 		{
 		/* Elements: */
 		public:
 		GridVertex* vertices[CellTopology::numVertices]; // Array of pointers to cell's vertices
 		GridCell* neighbours[CellTopology::numFaces]; // Array of pointers to neighbouring cells
+		const BarycentricTransform* transform; // Pointer to the cell's cached barycentric transformation, or null if the cell does not have one
 		GridCell* succ; // Pointer to next grid cell in data set
 		
 		/* Constructors and destructors: */
@@ -392,6 +400,7 @@ class Simplical
 	private:
 	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
 	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
+	struct TransformTask; // Structure describing a range of cells whose barycentric transformations to calculate in a background thread
 	
 	friend class Vertex;
 	friend class Cell;
@@ -412,9 +421,16 @@ class Simplical
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
 	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
+	bool cacheTransforms; // Flag whether to cache each cell's barycentric transformation to speed up point location
+	size_t numTransforms; // Number of cached barycentric transformations
+	BarycentricTransform* transforms; // Array of cached barycentric transformations, or null if transformations are not cached
 	
 	/* Private methods: */
 	void connectCells(void); // Creates simplical mesh from unconnected simplices by connecting shared faces
+	static bool calcTransform(const GridCell* cell,BarycentricTransform& transform); // Calculates the barycentric transformation of the given cell; returns false if the cell is degenerate
+	static void* transformThreadFunction(TransformTask* task); // Calculates barycentric transformations for a range of cells
+	void createTransforms(void); // Calculates and caches the barycentric transformations of all cells using multiple threads
+	void destroyTransforms(void); // Releases all cached barycentric transformations
 	
 	/* Constructors and destructors: */
 	public:
@@ -436,6 +452,15 @@ class Simplical
 		}
 	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	bool getCacheTransforms(void) const // Returns true if cells' barycentric transformations are cached
+		{
+		return cacheTransforms;
+		}
+	void setCacheTransforms(bool newCacheTransforms); // Enables or disables caching of cells' barycentric transformations, trading memory for faster point location
+	size_t getTransformCacheSize(void) const // Returns the amount of memory used by cached barycentric transformations in bytes
+		{
+		return numTransforms*sizeof(BarycentricTransform);
+		}
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
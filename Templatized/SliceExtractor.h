@@ -1,6 +1,6 @@
 /***********************************************************************
 SliceExtractor - Generic class to extract slices from data sets.
-Copyright (c) 2005-2011 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,6 +25,8 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Misc/OneTimeQueue.h>
 #include <Geometry/Plane.h>
 
+#include <Templatized/RegionOfInterest.h>
+
 /* Forward declarations: */
 namespace Visualization {
 namespace Templatized {
@@ -52,6 +54,7 @@ class SliceExtractor
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef SliceParam Slice; // Type of slice representation
+	typedef RegionOfInterest<Scalar,dimension> ROI; // Type for regions of interest restricting extraction
 	
 	private:
 	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
@@ -65,6 +68,7 @@ class SliceExtractor
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
+	ROI regionOfInterest; // Region of the data set's domain to which extraction is restricted
 	
 	/* Slice extraction state: */
 	Plane slicePlane; // The current slicing plane
@@ -101,6 +105,14 @@ class SliceExtractor
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
 		}
+	const ROI& getRegionOfInterest(void) const // Returns the region of interest
+		{
+		return regionOfInterest;
+		}
+	void setRegionOfInterest(const ROI& newRegionOfInterest) // Restricts subsequent extraction to the given region of interest
+		{
+		regionOfInterest=newRegionOfInterest;
+		}
 	void extractSlice(const Plane& newSlicePlane,Slice& newSlice); // Extracts a global slice for the given plane and stores it in the given slice
 	void extractSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Extracts a seeded slice for the given plane from the given cell and stores it in the given slice
 	void startSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Starts extracting a seeded slice for the given plane from the given cell
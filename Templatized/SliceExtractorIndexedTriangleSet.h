@@ -1,7 +1,7 @@
 /***********************************************************************
 SliceExtractorIndexedTriangleSet - Specialized version of SliceExtractor
 class for indexed triangle sets.
-Copyright (c) 2006-2011 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,10 +23,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEEXTRACTORINDEXEDTRIANGLESET_INCLUDED
 
+#include <vector>
 #include <Misc/HashTable.h>
 #include <Misc/OneTimeQueue.h>
 #include <Geometry/Plane.h>
 #include <Templatized/IndexedTriangleSet.h>
+#include <Templatized/RegionOfInterest.h>
 #include <Templatized/SliceExtractor.h>
 
 /* Forward declarations: */
@@ -56,6 +58,7 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef IndexedTriangleSet<VertexParam> Slice; // Type of slice representation
+	typedef RegionOfInterest<Scalar,dimension> ROI; // Type for regions of interest restricting extraction
 	
 	private:
 	typedef typename DataSet::CellTopology CellTopology; // Topology of the data set's cells
@@ -68,10 +71,27 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 	typedef typename Slice::Index Index; // Type for vertex indices
 	typedef Misc::HashTable<EdgeID,Index,EdgeID> VertexIndexHasher; // Hash table to map edge IDs to vertex indices in the slice
 	
+	struct SeededCell // Structure describing a cell visited while extracting a seeded slice
+		{
+		/* Elements: */
+		public:
+		CellID cellID; // ID of the cell
+		int caseIndex; // Slice case index of the cell
+		};
+	
+	struct SeededVertex // Structure describing the edge on which a seeded slice's vertex was created
+		{
+		/* Elements: */
+		public:
+		size_t cellIndex; // Index of the cell containing the edge in the visited cell list
+		int edge; // Index of the edge in its cell
+		};
+	
 	/* Elements: */
 	private:
 	const DataSet* dataSet; // Data set the isosurface extractor works on
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
+	ROI regionOfInterest; // Region of the data set's domain to which extraction is restricted
 	
 	/* Slice extraction state: */
 	Plane slicePlane; // The current slicing plane
@@ -79,8 +99,19 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 	VertexIndexHasher vertexIndices; // Hasher mapping edge IDs to vertex indices in the slice
 	CellQueue cellQueue; // Queue of cells waiting for fragment extraction
 	
+	/* State of the most recent incrementally extracted seeded slice, to patch it for subsequent seed requests: */
+	bool recordSeeded; // Flag whether extracted fragments are currently recorded in the seeded slice state
+	std::vector<SeededCell> seededCells; // List of cells visited while extracting the seeded slice, in extraction order
+	std::vector<SeededVertex> seededVertices; // List of edges on which the seeded slice's vertices were created, in vertex order
+	bool seededComplete; // Flag whether the seeded slice was extracted completely
+	const DataSet* seededDataSet; // Data set from which the seeded slice was extracted
+	ROI seededRegionOfInterest; // Region of interest to which the seeded slice was restricted
+	
 	/* Private methods: */
+	int calcCaseIndex(const Cell& cell,Scalar cvos[CellTopology::numVertices]) const; // Calculates the offsets of a cell's vertices from the current slicing plane and returns the cell's slice case index
+	void calcEdgeVertex(const Cell& cell,int edge,const Scalar cvos[CellTopology::numVertices],Vertex& vertex) const; // Calculates the slice vertex on the given edge of the given cell
 	int extractSliceFragment(const Cell& cell); // Extracts a slice fragment from a cell and stores it in the current slice representation
+	bool patchSeededSlice(const Locator& seedLocator,const Slice& previousSlice); // Creates the current slice by moving the vertices of the previous seeded slice along their edges if the current plane does not change any visited cell's case; returns true on success
 	
 	/* Constructors and destructors: */
 	public:
@@ -109,9 +140,17 @@ class SliceExtractor<DataSetParam,ScalarExtractorParam,IndexedTriangleSet<Vertex
 		dataSet=newDataSet;
 		scalarExtractor=newScalarExtractor;
 		}
+	const ROI& getRegionOfInterest(void) const // Returns the region of interest
+		{
+		return regionOfInterest;
+		}
+	void setRegionOfInterest(const ROI& newRegionOfInterest) // Restricts subsequent extraction to the given region of interest
+		{
+		regionOfInterest=newRegionOfInterest;
+		}
 	void extractSlice(const Plane& newSlicePlane,Slice& newSlice); // Extracts a global slice for the given plane and stores it in the given slice
 	void extractSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Extracts a seeded slice for the given plane from the given cell and stores it in the given slice
-	void startSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice); // Starts extracting a seeded slice for the given plane from the given cell
+	bool startSeededSlice(const Locator& seedLocator,const Plane& newSlicePlane,Slice& newSlice,const Slice* previousSlice =0); // Starts extracting a seeded slice for the given plane from the given cell; patches the given previous result of the most recent complete seeded extraction instead if the plane moved without crossing any of its cells' vertices, and returns true in that case
 	template <class ContinueFunctorParam>
 	bool continueSeededSlice(const ContinueFunctorParam& cf); // Continues extracting a seeded slice while the continue functor returns true; returns true if the slice is finished
 	void finishSeededSlice(void); // Cleans up after creating a seeded slice
@@ -2,7 +2,7 @@
 SlicedHypercubic - Base class for vertex-centered unstructured
 hypercubic data sets containing multiple scalar-valued slices.
 etc.).
-Copyright (c) 2009-2022 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -44,7 +44,7 @@ namespace Visualization {
 
 namespace Templatized {
 
-template <class ScalarParam,int dimensionParam,class ValueScalarParam>
+template <class ScalarParam,int dimensionParam,class ValueScalarParam,class IndexParam =unsigned int>
 class SlicedHypercubic
 	{
 	/* Embedded classes: */
@@ -65,11 +65,12 @@ class SlicedHypercubic
 	typedef SlicedDataValue<ValueScalar> Value; // Data set's compound value type
 	
 	/* First batch of data set interface classes: */
-	typedef LinearIndexID VertexID; // ID type for vertices
-	typedef VertexID::Index VertexIndex; // Index type for vertices
+	typedef IndexParam Index; // Index type for vertices and cells; 32-bit indices halve the size of the grid's topology, but limit grids to 2^32-1 vertices and cells
+	typedef SizedLinearIndexID<Index> VertexID; // ID type for vertices
+	typedef Index VertexIndex; // Index type for vertices
 	typedef Misc::UnorderedTuple<VertexIndex,2> EdgeID; // ID type for cell edges
-	typedef LinearIndexID CellID; // ID type for cells
-	typedef CellID::Index CellIndex; // Index type for cells
+	typedef SizedLinearIndexID<Index> CellID; // ID type for cells
+	typedef Index CellIndex; // Index type for cells
 	
 	/* Low-level definitions of data set storage: */
 	private:
@@ -356,6 +357,12 @@ class SlicedHypercubic
 		}
 	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
 	
+	static size_t getMaxNumElements(void) // Returns the maximum number of vertices or cells representable by the data set's index type
+		{
+		return size_t(~Index(0));
+		}
+	size_t getMemorySize(void) const; // Returns the total number of bytes allocated for the data set's vertices, cells, value slices, and cell locator
+	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
 		{
@@ -2,7 +2,7 @@
 SlicedHypercubicRenderer - Class to render sliced unstructured
 hypercubic data sets. Implemented as a specialization of the generic
 DataSetRenderer class.
-Copyright (c) 2009-2011 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -34,12 +34,12 @@ namespace Visualization {
 
 namespace Templatized {
 
-template <class ScalarParam,int dimensionParam,class ValueParam>
-class DataSetRenderer<SlicedHypercubic<ScalarParam,dimensionParam,ValueParam> >
+template <class ScalarParam,int dimensionParam,class ValueParam,class IndexParam>
+class DataSetRenderer<SlicedHypercubic<ScalarParam,dimensionParam,ValueParam,IndexParam> >
 	{
 	/* Embedded classes: */
 	public:
-	typedef SlicedHypercubic<ScalarParam,dimensionParam,ValueParam> DataSet; // Type of rendered data set
+	typedef SlicedHypercubic<ScalarParam,dimensionParam,ValueParam,IndexParam> DataSet; // Type of rendered data set
 	typedef typename DataSet::Scalar Scalar; // Scalar type of data set's domain
 	static const int dimension=dimensionParam; // Dimension of data set's domain
 	typedef typename DataSet::Point Point; // Type for points in data set's domain
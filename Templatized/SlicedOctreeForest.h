@@ -3,7 +3,7 @@ SlicedOctreeForest - Base class for multi-resolution vertex-centered
 data sets defined on a forest of octrees containing arbitrary numbers of
 independent scalar fields, combined into vector and/or tensor fields
 using special value extractors.
-Copyright (c) 2021-2022 Oliver Kreylos
+Copyright (c) 2021-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,13 +25,15 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_TEMPLATIZED_SLICEDOCTREEFOREST_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_SLICEDOCTREEFOREST_INCLUDED
 
-#include <Misc/Array.h>
+#include <stddef.h>
+#include <vector>
+#include <Misc/SizedTypes.h>
+#include <Misc/ArrayIndex.h>
+#include <Misc/HashTable.h>
 #include <Geometry/ComponentArray.h>
 #include <Geometry/Point.h>
 #include <Geometry/Vector.h>
 #include <Geometry/Box.h>
-#include <Geometry/ValuedPoint.h>
-#include <Geometry/ArrayKdTree.h>
 
 #include <Templatized/SlicedDataValue.h>
 #include <Templatized/Tesseract.h>
@@ -53,6 +55,7 @@ class SlicedOctreeForest
 	static const int dimension=3; // Dimension of data set's domain
 	typedef Geometry::Point<Scalar,3> Point; // Type for points in data set's domain
 	typedef Geometry::Vector<Scalar,3> Vector; // Type for vectors in data set's domain
+	typedef Geometry::ComponentArray<Scalar,3> Size; // Type for sizes in data set's domain
 	typedef Geometry::Box<Scalar,3> Box; // Type for axis-aligned boxes in data set's domain
 	
 	/* Definition of the data set's cell topology: */
@@ -63,6 +66,8 @@ class SlicedOctreeForest
 	typedef SlicedDataValue<ValueScalar> Value; // Data set's compound value type
 	
 	/* Low-level definitions of data set storage: */
+	typedef Misc::ArrayIndex<3> Index; // Index type for the grid of octree roots, and for cells and vertices on a single refinement level
+	
 	private:
 	struct Node // Structure for octree nodes
 		{
@@ -70,10 +75,11 @@ class SlicedOctreeForest
 		public:
 		Node* children; // Pointer to array of eight child nodes, or 0 for leaf nodes
 		unsigned int vertexIndices[8]; // Array containing the value array indices of a leaf node's eight vertices
+		unsigned int cellIndex; // Index of a leaf node in the data set's cell list
 		
 		/* Constructors and destructors: */
 		Node(void) // Creates a leaf node with unassigned vertex indices
-			:children(0)
+			:children(0),cellIndex(~0U)
 			{
 			for(int i=0;i<8;++i)
 				vertexIndices[i]=~0U; // All 1s indicates invalid vertex index
@@ -84,69 +90,101 @@ class SlicedOctreeForest
 			}
 		};
 	
+	struct LatticeIndex // Structure to identify vertices and cells by their integer coordinates on the finest refinement level
+		{
+		/* Elements: */
+		public:
+		unsigned int index[3]; // Integer coordinates
+		
+		/* Constructors and destructors: */
+		LatticeIndex(void)
+			{
+			}
+		LatticeIndex(unsigned int i0,unsigned int i1,unsigned int i2)
+			{
+			index[0]=i0;
+			index[1]=i1;
+			index[2]=i2;
+			}
+		
+		/* Methods: */
+		unsigned int operator[](int i) const
+			{
+			return index[i];
+			}
+		unsigned int& operator[](int i)
+			{
+			return index[i];
+			}
+		friend bool operator==(const LatticeIndex& li1,const LatticeIndex& li2)
+			{
+			return li1.index[0]==li2.index[0]&&li1.index[1]==li2.index[1]&&li1.index[2]==li2.index[2];
+			}
+		friend bool operator!=(const LatticeIndex& li1,const LatticeIndex& li2)
+			{
+			return li1.index[0]!=li2.index[0]||li1.index[1]!=li2.index[1]||li1.index[2]!=li2.index[2];
+			}
+		static size_t hash(const LatticeIndex& li,size_t tableSize)
+			{
+			return ((size_t(li.index[2])*size_t(2654435761U)+size_t(li.index[1]))*size_t(2246822519U)+size_t(li.index[0]))%tableSize;
+			}
+		};
 	
+	struct Leaf // Structure describing a leaf node of the octree forest, i.e., a cell
+		{
+		/* Elements: */
+		public:
+		const Node* node; // Pointer to the leaf node
+		int level; // Refinement level of the leaf node; root nodes have level 0
+		LatticeIndex origin; // Lattice coordinates of the leaf node's base vertex
+		unsigned int size; // Size of the leaf node in lattice units
+		};
 	
+	struct Constraint // Structure to express the value of a hanging vertex as a bilinear interpolation of the vertices of a coarser cell face
+		{
+		/* Elements: */
+		public:
+		unsigned int vertexIndices[4]; // Indices of the face's four vertices in (0, 0), (1, 0), (0, 1), (1, 1) order
+		Scalar weights[2]; // Local coordinates of the hanging vertex inside the face
+		};
 	
-	public:
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	
-	typedef Misc::ArrayIndex<3> Index; // Index type for data set storage (grids and value slices)
-	typedef Misc::Array<Point,3> GridArray; // Array type for grids
-	typedef Misc::Array<ValueScalar,3> ValueArray; // Array type for value slices
+	typedef Misc::HashTable<LatticeIndex,unsigned int,LatticeIndex> VertexMap; // Type for hash tables mapping lattice coordinates to vertex indices
 	
 	/* Data set interface classes: */
+	public:
 	typedef LinearIndexID VertexID;
 	
 	class Vertex // Class to represent and iterate through vertices
 		{
-		friend class SlicedCurvilinear;
+		friend class SlicedOctreeForest;
 		
 		/* Elements: */
 		private:
-		const SlicedCurvilinear* ds; // Pointer to data set containing the vertex
-		Index index; // Array index of vertex in data set storage (grid and data slices)
+		const SlicedOctreeForest* ds; // Pointer to data set containing the vertex
+		unsigned int index; // Index of vertex in vertex list
 		
 		/* Constructors and destructors: */
 		public:
 		Vertex(void) // Creates an invalid vertex
-			:ds(0)
+			:ds(0),index(~0U)
 			{
 			}
 		private:
-		Vertex(const SlicedCurvilinear* sDs,const Index& sIndex)
+		Vertex(const SlicedOctreeForest* sDs,unsigned int sIndex)
 			:ds(sDs),index(sIndex)
 			{
 			}
 		
 		/* Methods: */
 		public:
-		const Point& getPosition(void) const // Returns vertex' position in domain
+		Point getPosition(void) const // Returns vertex' position in domain
 			{
-			return ds->grid(index);
+			return ds->getVertexPosition(index);
 			}
 		template <class ValueExtractorParam>
 		typename ValueExtractorParam::DestValue getValue(const ValueExtractorParam& extractor) const // Returns vertex' value based on given extractor
 			{
-			return extractor.getValue(ds->numVertices.calcOffset(index));
+			return ds->calcVertexValue(index,extractor);
 			}
 		template <class ScalarExtractorParam>
 		Vector calcGradient(const ScalarExtractorParam& extractor) const // Returns gradient at the vertex, based on given scalar extractor
@@ -155,7 +193,7 @@ class SlicedOctreeForest
 			}
 		VertexID getID(void) const // Returns vertex' ID
 			{
-			return VertexID(VertexID::Index(ds->numVertices.calcOffset(index)));
+			return VertexID(index);
 			}
 		
 		/* Iterator methods: */
@@ -169,14 +207,14 @@ class SlicedOctreeForest
 			}
 		Vertex& operator++(void) // Pre-increment operator
 			{
-			index.preInc(ds->numVertices);
+			++index;
 			return *this;
 			}
 		};
 	
 	typedef IteratorWrapper<Vertex> VertexIterator; // Class to iterate through vertices
 	
-	typedef LinearIndexID EdgeID; // Class to identify cell edges
+	typedef SizedLinearIndexID<Misc::UInt64> EdgeID; // Class to identify cell edges; 64-bit as edge IDs combine vertex index, direction, and refinement level
 	
 	typedef LinearIndexID CellID; // Class to identify cells
 	
@@ -184,28 +222,27 @@ class SlicedOctreeForest
 	
 	class Cell // Class to represent and iterate through cells
 		{
-		friend class SlicedCurvilinear;
+		friend class SlicedOctreeForest;
 		friend class Locator;
 		
 		/* Elements: */
 		private:
-		const SlicedCurvilinear* ds; // Pointer to the data set containing the cell
-		Index index; // Array index of cell's base vertex in data set storage
-		ptrdiff_t baseVertexIndex; // Linear index of cell's base vertex in data set storage (grid and value slices)
+		const SlicedOctreeForest* ds; // Pointer to the data set containing the cell
+		unsigned int index; // Index of the cell in the data set's leaf list
 		
 		/* Constructors and destructors: */
 		public:
 		Cell(void) // Creates an invalid cell
-			:ds(0),baseVertexIndex(-1)
+			:ds(0),index(~0U)
 			{
 			}
 		private:
-		Cell(const SlicedCurvilinear* sDs)
-			:ds(sDs),baseVertexIndex(-1)
+		Cell(const SlicedOctreeForest* sDs) // Creates an invalid cell in the given data set
+			:ds(sDs),index(~0U)
 			{
 			}
-		Cell(const SlicedCurvilinear* sDs,const Index& sIndex)
-			:ds(sDs),index(sIndex),baseVertexIndex(ds->numVertices.calcOffset(index))
+		Cell(const SlicedOctreeForest* sDs,unsigned int sIndex) // Elementwise constructor
+			:ds(sDs),index(sIndex)
 			{
 			}
 		
@@ -213,47 +250,56 @@ class SlicedOctreeForest
 		public:
 		bool isValid(void) const // Returns true if the cell is valid
 			{
-			return baseVertexIndex!=-1;
+			return index!=~0U;
+			}
+		int getLevel(void) const // Returns the cell's refinement level
+			{
+			return ds->leaves[index].level;
 			}
 		VertexID getVertexID(int vertexIndex) const // Returns ID of given vertex of the cell
 			{
-			return VertexID(VertexID::Index(baseVertexIndex+ds->vertexOffsets[vertexIndex]));
+			return VertexID(ds->leaves[index].node->vertexIndices[vertexIndex]);
 			}
-		Vertex getVertex(int vertexIndex) const; // Returns given vertex of the cell
-		const Point& getVertexPosition(int vertexIndex) const // Returns position of given vertex of the cell
+		Vertex getVertex(int vertexIndex) const // Returns the given vertex of the cell
 			{
-			return ds->grid.getArray()[baseVertexIndex+ds->vertexOffsets[vertexIndex]];
+			return Vertex(ds,ds->leaves[index].node->vertexIndices[vertexIndex]);
+			}
+		Point getVertexPosition(int vertexIndex) const // Returns position of given vertex of the cell
+			{
+			return ds->getVertexPosition(ds->leaves[index].node->vertexIndices[vertexIndex]);
 			}
 		template <class ValueExtractorParam>
 		typename ValueExtractorParam::DestValue getVertexValue(int vertexIndex,const ValueExtractorParam& extractor) const // Returns value of given vertex of the cell, based on given extractor
 			{
-			return extractor.getValue(baseVertexIndex+ds->vertexOffsets[vertexIndex]);
+			return ds->calcVertexValue(ds->leaves[index].node->vertexIndices[vertexIndex],extractor);
 			}
 		template <class ScalarExtractorParam>
-		Vector calcVertexGradient(int vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at given vertex of the cell, based on given scalar extractor
+		Vector calcVertexGradient(int vertexIndex,const ScalarExtractorParam& extractor) const // Returns gradient at given vertex of the cell, based on given scalar extractor
+			{
+			return ds->calcVertexGradient(ds->leaves[index].node->vertexIndices[vertexIndex],extractor);
+			}
 		EdgeID getEdgeID(int edgeIndex) const; // Returns ID of given edge of the cell
 		Point calcEdgePosition(int edgeIndex,Scalar weight) const; // Returns an interpolated point along the given edge
 		CellID getID(void) const // Returns cell's ID
 			{
-			return CellID(CellID::Index(baseVertexIndex));
+			return CellID(index);
 			}
-		CellID getNeighbourID(int neighbourIndex) const; // Returns ID of neighbour across the given face of the cell
+		CellID getNeighbourID(int neighbourIndex) const; // Returns ID of a neighbour across the given face of the cell
 		template <class QueueParam>
-		void enqueueNeighbourIDs(int neighbourIndex,QueueParam& queue) const; // Adds IDs of neighbours across the given face of the cell to the given queue
+		void enqueueNeighbourIDs(int neighbourIndex,QueueParam& queue) const; // Adds IDs of all neighbours across the given face of the cell to the given queue
 		
 		/* Iterator methods: */
 		friend bool operator==(const Cell& cell1,const Cell& cell2)
 			{
-			return cell1.baseVertexIndex==cell2.baseVertexIndex;
+			return cell1.index==cell2.index&&cell1.ds==cell2.ds;
 			}
 		friend bool operator!=(const Cell& cell1,const Cell& cell2)
 			{
-			return cell1.baseVertexIndex!=cell2.baseVertexIndex;
+			return cell1.index!=cell2.index||cell1.ds!=cell2.ds;
 			}
 		Cell& operator++(void) // Pre-increment operator
 			{
-			index.preInc(ds->numCells);
-			baseVertexIndex=ds->grid.calcLinearIndex(index);
+			++index;
 			return *this;
 			}
 		};
@@ -262,32 +308,29 @@ class SlicedOctreeForest
 	
 	class Locator:private Cell // Class responsible for evaluating a data set at a given position
 		{
-		friend class SlicedCurvilinear;
+		friend class SlicedOctreeForest;
 		
 		/* Embedded classes: */
 		private:
-		typedef Geometry::ComponentArray<Scalar,dimensionParam> CellPosition; // Type for local cell coordinates
+		typedef Geometry::ComponentArray<Scalar,3> CellPosition; // Type for local cell coordinates
 		
 		/* Elements: */
 		using Cell::ds;
 		using Cell::index;
-		using Cell::baseVertexIndex;
 		CellPosition cellPos; // Local coordinates of last located point inside its cell
-		Scalar epsilon,epsilon2; // Accuracy threshold of point location algorithm
-		bool canTrace; // Flag if the locator can trace on the next locatePoint call
-		
-		/* Private methods: */
-		bool newtonRaphsonStep(const Point& position); // Performs one Newton-Raphson step while tracing the given position
 		
 		/* Constructors and destructors: */
 		public:
 		Locator(void); // Creates invalid locator
 		private:
-		Locator(const SlicedCurvilinear* sDs,Scalar sEpsilon); // Creates non-localized locator associated with given data set
+		Locator(const SlicedOctreeForest* sDs); // Creates non-localized locator associated with given data set
 		
 		/* Methods: */
 		public:
-		void setEpsilon(Scalar newEpsilon); // Sets a new accuracy threshold in local cell dimension
+		void setEpsilon(Scalar) // Sets a new accuracy threshold in local cell dimension
+			{
+			/* Not needed for octree forest data sets */
+			}
 		CellID getCellID(void) const // Returns the ID of the cell containing the last located point
 			{
 			return Cell::getID();
@@ -299,114 +342,110 @@ class SlicedOctreeForest
 		Vector calcGradient(const ScalarExtractorParam& extractor) const; // Calculates gradient at last located position
 		};
 	
-	private:
-	typedef Geometry::ValuedPoint<Point,CellID> CellCenter; // Data type to associate a cell's center point and its ID
-	typedef Geometry::ArrayKdTree<CellCenter> CellCenterTree; // Data type for kd-trees to locate closest cell centers
-	
 	friend class Vertex;
 	friend class Cell;
 	friend class Locator;
 	
 	/* Elements: */
 	private:
-	Index numVertices; // Number of vertices in data set in each dimension
-	GridArray grid; // Array defining data set's grid
-	int numSlices; // Number of scalar value slices in data set
-	ValueArray* slices; // Array of arrays defining data set's value slices
-	int vertexStrides[dimension]; // Array of pointer stride values in the vertex array
-	Index numCells; // Number of cells in data set in each dimension
-	int vertexOffsets[CellTopology::numVertices]; // Array of pointer offsets from a cell's base vertex to all cell vertices
-	CellCenterTree cellCenterTree; // Kd-tree containing cell centers
+	Index numRoots; // Number of octree roots in each dimension
+	Point origin; // Position of the forest's base vertex
+	Size rootCellSize; // Size of the octree roots' cells in each dimension
+	Node* roots; // Array of octree root nodes
+	int maxLevel; // Highest refinement level of any leaf node
+	LatticeIndex latticeSize; // Size of the forest in lattice units on the finest refinement level
+	Size latticeCellSize; // Size of a lattice cell on the finest refinement level
+	std::vector<Leaf> leaves; // List of the forest's leaf nodes, i.e., the data set's cells
+	std::vector<LatticeIndex> vertexLatticeIndices; // Lattice coordinates of all vertices
+	VertexMap vertexMap; // Hash table mapping lattice coordinates to vertex indices
+	std::vector<unsigned int> vertexConstraints; // Index of each vertex' constraint in the constraint list, or ~0U for unconstrained vertices
+	std::vector<Constraint> constraints; // List of constraints for hanging vertices
 	VertexIterator firstVertex,lastVertex; // Bounds of vertex list
 	CellIterator firstCell,lastCell; // Bounds of cell list
 	Box domainBox; // Bounding box of all vertices
-	Scalar avgCellRadius; // Average "radius" of all cells
-	Scalar maxCellRadius2; // Squared maximum "radius" of any cell (used as trivial reject threshold during point location)
-	Scalar locatorEpsilon; // Default accuracy threshold for locators working on this data set
+	Scalar averageCellSize; // Average size of all cells
+	int numSlices; // Number of scalar value slices in the data set
+	ValueScalar** slices; // Array of vertex value slices
 	
 	/* Private methods: */
-	void initStructure(void);
+	void deleteSlices(void); // Deletes all value slices
+	unsigned int addVertex(const LatticeIndex& vertexLatticeIndex); // Returns the index of the vertex at the given lattice coordinates; creates a new vertex if there is none
+	void collectLeaves(Node* node,int level,const LatticeIndex& nodeOrigin); // Adds all leaf nodes of the given subtree to the leaf list
+	const Node* findNode(const LatticeIndex& latticeIndex,int maxDepth,int& level,LatticeIndex& nodeOrigin) const; // Returns the deepest node containing the given lattice cell whose level is not larger than the given maximum depth
+	unsigned int findLeaf(const LatticeIndex& latticeIndex) const; // Returns the index of the leaf node containing the given lattice cell
+	template <class QueueParam>
+	void enqueueFaceLeaves(const Node* node,int direction,int side,QueueParam& queue) const; // Adds all leaves of the given subtree touching the subtree's given face to the given queue
 	template <class ScalarExtractorParam>
-	Vector calcVertexGradient(const Index& vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
+	Vector calcCellGradient(const Leaf& leaf,const Scalar localPos[3],const ScalarExtractorParam& extractor) const; // Returns the gradient of the given cell's trilinear interpolant at the given local cell position
 	
 	/* Constructors and destructors: */
 	public:
-	SlicedCurvilinear(void); // Creates an "empty" data set
-	SlicedCurvilinear(const Index& sNumVertices,int sNumSlices,const Point* sVertexPositions =0); // Creates a data set with the given number of vertices and slices; copies vertex positions if pointer is not null
-	~SlicedCurvilinear(void);
+	SlicedOctreeForest(void); // Creates an "empty" data set
+	SlicedOctreeForest(const Index& sNumRoots,const Point& sOrigin,const Size& sRootCellSize); // Creates a data set of the given number of unrefined octree roots and root cell size
+	~SlicedOctreeForest(void); // Destroys the data set
 	
 	/* Data set construction methods: */
-	void setGrid(const Index& sNumVertices,const Point* sVertexPositions =0); // Creates a data set with the given number of vertices; copies vertex positions if pointer is not null
-	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies slice values from given array if pointer is not null; returns index of new slice
+	void setForest(const Index& sNumRoots,const Point& sOrigin,const Size& sRootCellSize); // Sets the number of unrefined octree roots and root cell size; deletes all previous data
+	void refineCell(int level,const Index& cellIndex); // Splits the cell of the given index on the given refinement level into eight children; refines the cell's ancestors as needed
+	void finalizeGrid(void); // Creates vertices, cells, and hanging vertex constraints after all cells have been refined; must be called before slices are added
+	int addSlice(const ValueScalar* sSliceValues =0); // Adds another slice to the data set; copies vertex data if pointer is not null
 	
 	/* Low-level data access methods: */
-	const Index& getNumVertices(void) const // Returns number of vertices in the data set
+	const Index& getNumRoots(void) const // Returns the number of octree roots in each dimension
 		{
-		return numVertices;
+		return numRoots;
 		}
-	const GridArray& getGrid(void) const // Returns the data set's grid
+	const Point& getOrigin(void) const // Returns the position of the forest's base vertex
 		{
-		return grid;
+		return origin;
 		}
-	GridArray& getGrid(void) // Ditto
+	const Size& getRootCellSize(void) const // Returns the size of the octree roots' cells
 		{
-		return grid;
+		return rootCellSize;
 		}
-	const Point& getVertexPosition(const Index& vertexIndex) const // Returns a vertex' position
+	int getMaxLevel(void) const // Returns the highest refinement level of any cell
 		{
-		return grid(vertexIndex);
+		return maxLevel;
 		}
-	Point& getVertexPosition(const Index& vertexIndex) // Ditto
+	unsigned int findVertex(int level,const Index& vertexIndex) const; // Returns the index of the vertex of the given index on the given refinement level, or ~0U if there is no such vertex
+	Point getVertexPosition(unsigned int vertexIndex) const; // Returns a vertex' position
+	bool isHangingVertex(unsigned int vertexIndex) const // Returns true if the given vertex' value is constrained by a coarser neighbouring cell
 		{
-		return grid(vertexIndex);
+		return vertexConstraints[vertexIndex]!=~0U;
 		}
-	int getNumSlices(void) const // Returns the number of value slices in the data set
+	int getNumSlices(void) const
 		{
 		return numSlices;
 		}
-	const ValueArray& getSlice(int sliceIndex) const // Returns one of the data set's value slices
-		{
-		return slices[sliceIndex];
-		}
-	ValueArray& getSlice(int sliceIndex) // Ditto
-		{
-		return slices[sliceIndex];
-		}
 	const ValueScalar* getSliceArray(int sliceIndex) const // Returns one of the data set's value slices as a C array
 		{
-		return slices[sliceIndex].getArray();
+		return slices[sliceIndex];
 		}
 	ValueScalar* getSliceArray(int sliceIndex) // Ditto
 		{
-		return slices[sliceIndex].getArray();
-		}
-	ValueScalar getVertexValue(int sliceIndex,const Index& vertexIndex) const // Returns a vertex' data value from one slice
-		{
-		return slices[sliceIndex](vertexIndex);
-		}
-	ValueScalar& getVertexValue(int sliceIndex,const Index& vertexIndex) // Ditto
-		{
-		return slices[sliceIndex](vertexIndex);
+		return slices[sliceIndex];
 		}
-	const Index& getNumCells(void) const // Returns number of cells in grid
+	ValueScalar getVertexValue(int sliceIndex,unsigned int vertexIndex) const // Returns a vertex' data value inside a slice
 		{
-		return numCells;
+		return slices[sliceIndex][vertexIndex];
 		}
-	void finalizeGrid(void); // Recalculates derived grid information after grid structure change
-	Scalar getLocatorEpsilon(void) const // Returns the current default accuracy threshold for locators working on this data set
+	ValueScalar& getVertexValue(int sliceIndex,unsigned int vertexIndex) // Ditto
 		{
-		return locatorEpsilon;
+		return slices[sliceIndex][vertexIndex];
 		}
-	void setLocatorEpsilon(Scalar newLocatorEpsilon); // Sets the default accuracy threshold for locators working on this data set
+	template <class ValueExtractorParam>
+	typename ValueExtractorParam::DestValue calcVertexValue(unsigned int vertexIndex,const ValueExtractorParam& extractor) const; // Returns a vertex' value based on the given extractor; interpolates the values of hanging vertices from their constraining cell faces
+	template <class ScalarExtractorParam>
+	Vector calcVertexGradient(unsigned int vertexIndex,const ScalarExtractorParam& extractor) const; // Returns gradient at a vertex based on the given scalar extractor
 	
 	/* Methods implementing the data set interface: */
 	size_t getTotalNumVertices(void) const // Returns total number of vertices in the data set
 		{
-		return numVertices.calcIncrement(-1);
+		return vertexLatticeIndices.size();
 		}
 	Vertex getVertex(const VertexID& vertexID) const // Returns vertex of given valid ID
 		{
-		return Vertex(this,numVertices.calcIndex(vertexID.getIndex()));
+		return Vertex(this,vertexID.getIndex());
 		}
 	const VertexIterator& beginVertices(void) const // Returns iterator to first vertex in the data set
 		{
@@ -418,11 +457,11 @@ class SlicedOctreeForest
 		}
 	size_t getTotalNumCells(void) const // Returns total number of cells in the data set
 		{
-		return numCells.calcIncrement(-1);
+		return leaves.size();
 		}
 	Cell getCell(const CellID& cellID) const // Return cell of given valid ID
 		{
-		return Cell(this,numVertices.calcIndex(cellID.getIndex()));
+		return Cell(this,cellID.getIndex());
 		}
 	const CellIterator& beginCells(void) const // Returns iterator to first cell in the data set
 		{
@@ -438,11 +477,11 @@ class SlicedOctreeForest
 		}
 	Scalar calcAverageCellSize(void) const // Calculates an estimate of the average cell size in the data set
 		{
-		return avgCellRadius*Scalar(2);
+		return averageCellSize;
 		}
 	Locator getLocator(void) const // Returns an unlocalized locator for the data set
 		{
-		return Locator(this,locatorEpsilon);
+		return Locator(this);
 		}
 	};
 
@@ -450,8 +489,8 @@ class SlicedOctreeForest
 
 }
 
-#ifndef VISUALIZATION_TEMPLATIZED_SLICEDCURVILINEAR_IMPLEMENTATION
-#include <Templatized/SlicedCurvilinear.icpp>
+#ifndef VISUALIZATION_TEMPLATIZED_SLICEDOCTREEFOREST_IMPLEMENTATION
+#include <Templatized/SlicedOctreeForest.icpp>
 #endif
 
 #endif
@@ -1,7 +1,8 @@
 /***********************************************************************
 StreamsurfaceExtractor - Class to extract stream surfaces from data
-sets.
-Copyright (c) 2006-2011 Oliver Kreylos
+sets by advecting an advancing front of particles that is adaptively
+refined and coarsened to keep adjacent particles evenly spaced.
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -20,9 +21,12 @@ with the 3D Data Visualizer; if not, write to the Free Software
 Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 ***********************************************************************/
 
+
 #ifndef VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_INCLUDED
 #define VISUALIZATION_TEMPLATIZED_STREAMSURFACEEXTRACTOR_INCLUDED
 
+#include <vector>
+
 namespace Visualization {
 
 namespace Templatized {
@@ -38,46 +42,70 @@ class StreamsurfaceExtractor
 	typedef typename DataSet::Point Point; // Type for points in the data set's domain
 	typedef typename DataSet::Vector Vector; // Type for vectors in the data set's domain
 	typedef typename DataSet::Locator Locator; // Type of data set locators
-	typedef VectorExtractorParam VectorExtractor; // Type to extract vector values from a data set (to trace the streamlines)
+	typedef VectorExtractorParam VectorExtractor; // Type to extract vector values from a data set (to trace the stream surface)
 	typedef typename VectorExtractor::Vector VVector; // Value type of vector extractor
-	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set (to color the streamlines)
+	typedef ScalarExtractorParam ScalarExtractor; // Type to extract scalar values from a data set (to color the stream surface)
 	typedef typename ScalarExtractor::Scalar VScalar; // Value type of scalar extractor
 	typedef StreamsurfaceParam Streamsurface; // Type of stream surface representation
 	
 	private:
 	typedef typename Streamsurface::Vertex Vertex; // Type of vertices stored in stream surface
+	typedef typename Streamsurface::Index Index; // Type of vertex indices stored in stream surface
+	
+	struct Particle // Structure for particles on the stream surface's advancing front
+		{
+		/* Elements: */
+		public:
+		Point pos; // Particle's current position
+		Locator locator; // Data set locator following the particle
+		Vector vec; // Vector value at the particle's current position
+		VScalar scalar; // Scalar value at the particle's current position
+		bool valid; // Flag if the particle's current position is inside the data set's domain
+		bool connectSucc; // Flag whether the particle is connected to the next particle on the front
+		unsigned int parent; // Index of the particle on the previous front from which this particle was advected, or after which it was inserted
+		Index vertexIndex; // Index of the stream surface vertex representing the particle's current position
+		};
+	
+	typedef std::vector<Particle> Front; // Type for advancing fronts
 	
-	struct Streamline // Structure storing the current state of one streamline defining the surface
+	struct AdvectTask // Structure describing a range of particles to advect in a background thread
 		{
 		/* Elements: */
 		public:
-		Point pos0; // Tracing position at beginning of iteration step
-		Locator locator; // Data set locator for current tracing position
-		VScalar scalar0; // Associated scalar value at the initial position
-		Vector vec0; // Vector value at the initial position
-		Point pos1; // Tracing position at end of iteration step
-		Scalar arclength; // Accumulated arc length of the streamline including the initial position
-		typename Streamsurface::Index index; // Index of most recently created vertex
-		Streamline* pred; // Pointer to previous streamline in the surface
-		Streamline* succ; // Pointer to next streamline in the surface
-		bool connectPred; // Flag whether this streamline is connected to the previous one
-		bool connectSucc; // Flag whether this streamline is connected to the next one
+		const StreamsurfaceExtractor* extractor; // Pointer to the stream surface extractor
+		Particle* first; // Beginning of the range of particles
+		Particle* last; // End of the range of particles
+		Scalar timeStep; // Integration time step
+		bool evaluate; // Flag whether the particles need to be evaluated at their initial positions before being advected
 		};
 	
 	/* Elements: */
 	private:
-	const DataSet* dataSet; // Data set the isosurface extractor works on
+	const DataSet* dataSet; // Data set the stream surface extractor works on
 	VectorExtractor vectorExtractor; // Vector extractor working on data set
 	ScalarExtractor scalarExtractor; // Scalar extractor working on data set
-	Scalar stepSize; // Fixed step size for streamline integration
+	Scalar spacing; // Target distance between adjacent particles on the front, and between subsequent fronts
+	Scalar minSpacing,maxSpacing; // Distances between adjacent particles below which particles are removed from, or above which particles are inserted into, the front
+	Scalar maxBendAngle; // Maximum angle between adjacent front segments before the front is refined
+	Scalar minBendCos; // Cosine of the maximum bend angle
+	unsigned int maxFrontSize; // Maximum number of particles on the front
+	unsigned int numThreads; // Number of threads used to advect particles
 	
-	/* Streamline extraction state: */
-	Streamline* streamlineHead; // Pointer to one of the streamlines defining the surface
+	/* Stream surface extraction state: */
+	Front front; // The current advancing front
+	bool closed; // Flag whether the current front is a closed loop
 	Streamsurface* streamsurface; // Pointer to the stream surface representation
 	
 	/* Private methods: */
-	bool stepStreamline(Streamline& s); // Advances the given streamline by one step
-	bool stepStreamsurface(void); // Advances all current streamline positions by one step and adds a new layer to the stream surface
+	bool evaluateParticle(Particle& p) const; // Locates the given particle and evaluates the vector and scalar fields at its position; returns false if the particle left the domain
+	bool advectParticle(Particle& p,Scalar timeStep) const; // Advances the given particle by one fourth-order Runge-Kutta step; returns false if the particle left the domain
+	static void* advectThreadFunction(AdvectTask* task); // Advects a range of particles
+	void advectParticles(Particle* first,Particle* last,Scalar timeStep,bool evaluate) const; // Advects a range of particles using multiple threads if there are enough of them; evaluates particles at their initial positions first if flag is true
+	void compactFront(Front& newFront); // Removes invalid and isolated particles from the given front, and turns a broken closed front into an open one
+	void storeFront(Front& newFront); // Creates stream surface vertices for all particles on the given front
+	void stitchRun(const Front& oldFront,size_t oldFirst,size_t numOld,const Front& newFront,size_t newFirst,size_t numNew); // Creates a triangle strip connecting the given ranges of particles on the given old and new fronts, wrapping around at the ends of the fronts
+	void stitchFronts(const Front& oldFront,const Front& newFront); // Creates triangle strips connecting the given old front and the given new front advected from it
+	bool stepStreamsurface(void); // Advances the front by one step and adds a new band of triangle strips to the stream surface; returns false if the stream surface is finished
 	
 	/* Constructors and destructors: */
 	public:
@@ -109,20 +137,41 @@ class StreamsurfaceExtractor
 		{
 		return scalarExtractor;
 		}
-	Scalar getStepSize(void) const // Returns the integration step size
+	Scalar getSpacing(void) const // Returns the target particle spacing
+		{
+		return spacing;
+		}
+	Scalar getMaxBendAngle(void) const // Returns the maximum front bend angle in radians
+		{
+		return maxBendAngle;
+		}
+	unsigned int getMaxFrontSize(void) const // Returns the maximum number of particles on the front
+		{
+		return maxFrontSize;
+		}
+	unsigned int getNumThreads(void) const // Returns the number of threads used to advect particles
+		{
+		return numThreads;
+		}
+	size_t getFrontSize(void) const // Returns the number of particles on the current front
 		{
-		return stepSize;
+		return front.size();
 		}
-	void setStepSize(Scalar newStepSize); // Sets the integration step size
-	int getNumStreamlines(void) const // Returns the number of streamlines extracted in parallel
+	void update(const DataSet* newDataSet,const VectorExtractor& newVectorExtractor,const ScalarExtractor& newScalarExtractor) // Sets a new data set and scalar / vector extractors for subsequent stream surface extraction
 		{
-		return numStreamlines;
+		dataSet=newDataSet;
+		vectorExtractor=newVectorExtractor;
+		scalarExtractor=newScalarExtractor;
 		}
-	void setNumStreamlines(int newNumStreamlines); // Sets the number of streamlines extracted in parallel
-	void setClosed(bool newClosed); // Sets if the stream surface is open or a closed tube
-	void initializeStreamline(int index,const Point& startPoint,const Locator& startLocator); // Initializes one streamline
-	void extractStreamsurface(Streamsurface& newStreamsurface); // Extracts stream surface for the previously initialized positions and locators
-	void startStreamsurface(Streamsurface& newStreamsurface); // Starts extracting stream surface for the previously initialized positions and locators
+	void setSpacing(Scalar newSpacing); // Sets the target particle spacing
+	void setMaxBendAngle(Scalar newMaxBendAngle); // Sets the maximum front bend angle in radians
+	void setMaxFrontSize(unsigned int newMaxFrontSize); // Sets the maximum number of particles on the front
+	void setNumThreads(unsigned int newNumThreads); // Sets the number of threads used to advect particles; 0 uses all available CPUs
+	void clearSeedCurve(void); // Removes all particles from the seed curve
+	void addSeedParticle(const Point& seedPoint,const Locator& seedLocator); // Appends a particle to the seed curve
+	void setClosed(bool newClosed); // Sets whether the seed curve is a closed loop
+	void extractStreamsurface(Streamsurface& newStreamsurface); // Extracts stream surface for the previously defined seed curve
+	void startStreamsurface(Streamsurface& newStreamsurface); // Starts extracting stream surface for the previously defined seed curve
 	template <class ContinueFunctorParam>
 	bool continueStreamsurface(const ContinueFunctorParam& cf); // Continues extracting stream surface while the continue functor returns true; returns true if the stream surface is finished
 	void finishStreamsurface(void); // Cleans up after creating stream surface
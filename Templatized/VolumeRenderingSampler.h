@@ -60,7 +60,7 @@ class VolumeRenderingSampler
 	
 	/* Constructors and destructors: */
 	public:
-	VolumeRenderingSampler(const DataSet& sDataSet); // Creates a sampler for the given data set
+	VolumeRenderingSampler(const DataSet& sDataSet,unsigned int maxSamplerSize =512); // Creates a sampler for the given data set, whose resulting volume does not exceed the given size along any dimension
 	
 	/* Methods: */
 	const Size3& getSamplerSize(void) const // Returns the size of the resulting Cartesian volume
@@ -66,7 +66,7 @@ class VolumeRenderingSampler<Cartesian<ScalarParam,3,ValueParam> >
 	
 	/* Constructors and destructors: */
 	public:
-	VolumeRenderingSampler(const DataSet& sDataSet); // Creates a sampler for the given data set
+	VolumeRenderingSampler(const DataSet& sDataSet,unsigned int maxSamplerSize =512); // Creates a sampler for the given data set; Cartesian data sets are always sampled at their native size
 	
 	/* Methods: */
 	const Size3& getSamplerSize(void) const // Returns the size of the Cartesian volume
@@ -96,7 +96,7 @@ class VolumeRenderingSampler<SlicedCartesian<ScalarParam,3,ValueScalarParam> >
 	
 	/* Constructors and destructors: */
 	public:
-	VolumeRenderingSampler(const DataSet& sDataSet); // Creates a sampler for the given data set
+	VolumeRenderingSampler(const DataSet& sDataSet,unsigned int maxSamplerSize =512); // Creates a sampler for the given data set; Cartesian data sets are always sampled at their native size
 	
 	/* Methods: */
 	const Size3& getSamplerSize(void) const // Returns the size of the Cartesian volume
@@ -0,0 +1,252 @@
+/***********************************************************************
+Tracer - Class to record timed zones of code executed by the main and
+extraction threads into per-thread lock-free ring buffers, and to export
+them as Chrome trace event files for inspection in chrome://tracing or
+Perfetto.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#include <Tracer.h>
+
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <vector>
+#include <Misc/File.h>
+#include <Threads/Mutex.h>
+
+/********************************
+Embedded classes of class Tracer:
+********************************/
+
+class Tracer::ThreadBuffer
+	{
+	/* Elements: */
+	public:
+	ThreadBuffer* succ; // Pointer to the next thread buffer in the registry
+	unsigned int threadId; // Unique ID of the thread owning this buffer
+	char threadName[64]; // Name of the thread owning this buffer
+	bool retired; // Flag whether the thread owning this buffer has terminated
+	Misc::UInt64 numEvents; // Total number of events written into the buffer; only modified by the owning thread
+	Event events[bufferSize]; // Ring buffer of the most recent events
+	
+	/* Constructors and destructors: */
+	ThreadBuffer(void)
+		:succ(0),threadId(0),retired(false),numEvents(0)
+		{
+		threadName[0]='\0';
+		}
+	};
+
+namespace {
+
+/**************
+Helper classes:
+**************/
+
+class TracerRegistry // Class to manage the set of all thread buffers
+	{
+	/* Elements: */
+	public:
+	static const unsigned int maxNumRetiredBuffers=8; // Maximum number of buffers of terminated threads to retain for export
+	Threads::Mutex mutex; // Mutex serializing access to the registry, but not to the buffers' contents
+	pthread_key_t bufferKey; // Key to retrieve a thread's buffer from thread-local storage
+	Tracer::ThreadBuffer* head; // Head of the list of thread buffers
+	Tracer::ThreadBuffer* tail; // Tail of the list of thread buffers
+	unsigned int nextThreadId; // ID to assign to the next registered thread
+	unsigned int numRetiredBuffers; // Number of buffers whose threads have terminated
+	
+	/* Constructors and destructors: */
+	TracerRegistry(void)
+		:head(0),tail(0),nextThreadId(1),numRetiredBuffers(0)
+		{
+		pthread_key_create(&bufferKey,&TracerRegistry::retireBuffer);
+		}
+	~TracerRegistry(void)
+		{
+		pthread_key_delete(bufferKey);
+		while(head!=0)
+			{
+			Tracer::ThreadBuffer* succ=head->succ;
+			delete head;
+			head=succ;
+			}
+		}
+	
+	/* Methods: */
+	static void retireBuffer(void* buffer); // Marks a thread buffer as retired when its owning thread terminates
+	};
+
+/***************************************
+Static elements of class TracerRegistry:
+***************************************/
+
+TracerRegistry registry;
+
+/*******************************
+Methods of class TracerRegistry:
+*******************************/
+
+void TracerRegistry::retireBuffer(void* buffer)
+	{
+	Threads::Mutex::Lock registryLock(registry.mutex);
+	static_cast<Tracer::ThreadBuffer*>(buffer)->retired=true;
+	++registry.numRetiredBuffers;
+	}
+
+}
+
+/*******************************
+Static elements of class Tracer:
+*******************************/
+
+bool Tracer::enabled=VISUALIZATION_CONFIG_USE_TRACING!=0;
+
+/***********************
+Methods of class Tracer:
+***********************/
+
+Tracer::ThreadBuffer* Tracer::getThreadBuffer(void)
+	{
+	/* Check if the calling thread already has a buffer: */
+	ThreadBuffer* buffer=static_cast<ThreadBuffer*>(pthread_getspecific(registry.bufferKey));
+	if(buffer==0)
+		{
+		Threads::Mutex::Lock registryLock(registry.mutex);
+		
+		if(registry.numRetiredBuffers>TracerRegistry::maxNumRetiredBuffers)
+			{
+			/* Recycle the oldest retired buffer: */
+			ThreadBuffer* pred=0;
+			for(buffer=registry.head;!buffer->retired;pred=buffer,buffer=buffer->succ)
+				;
+			if(pred!=0)
+				pred->succ=buffer->succ;
+			else
+				registry.head=buffer->succ;
+			if(registry.tail==buffer)
+				registry.tail=pred;
+			--registry.numRetiredBuffers;
+			
+			/* Reset the buffer: */
+			buffer->succ=0;
+			buffer->threadName[0]='\0';
+			buffer->retired=false;
+			buffer->numEvents=0;
+			}
+		else
+			buffer=new ThreadBuffer;
+		
+		/* Append the buffer to the registry: */
+		buffer->threadId=registry.nextThreadId++;
+		snprintf(buffer->threadName,sizeof(buffer->threadName),"Thread %u",buffer->threadId);
+		if(registry.tail!=0)
+			registry.tail->succ=buffer;
+		else
+			registry.head=buffer;
+		registry.tail=buffer;
+		
+		pthread_setspecific(registry.bufferKey,buffer);
+		}
+	
+	return buffer;
+	}
+
+void Tracer::setEnabled(bool newEnabled)
+	{
+	enabled=newEnabled;
+	}
+
+Misc::UInt64 Tracer::getTime(void)
+	{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC,&now);
+	return Misc::UInt64(now.tv_sec)*1000000000U+Misc::UInt64(now.tv_nsec);
+	}
+
+void Tracer::setThreadName(const char* newThreadName)
+	{
+	ThreadBuffer* buffer=getThreadBuffer();
+	Threads::Mutex::Lock registryLock(registry.mutex);
+	strncpy(buffer->threadName,newThreadName,sizeof(buffer->threadName)-1);
+	buffer->threadName[sizeof(buffer->threadName)-1]='\0';
+	}
+
+void Tracer::record(const char* name,Misc::UInt64 start,Misc::UInt64 end)
+	{
+	ThreadBuffer* buffer=getThreadBuffer();
+	
+	/* Write the event into the next ring buffer slot: */
+	Misc::UInt64 numEvents=buffer->numEvents;
+	Event& event=buffer->events[numEvents&(bufferSize-1)];
+	event.name=name;
+	event.start=start;
+	event.duration=end-start;
+	
+	/* Publish the event to exporting threads: */
+	__atomic_store_n(&buffer->numEvents,numEvents+1,__ATOMIC_RELEASE);
+	}
+
+void Tracer::saveChromeTrace(const char* traceFileName)
+	{
+	/* Open the trace file: */
+	Misc::File traceFile(traceFileName,"wt");
+	traceFile.puts("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	
+	Threads::Mutex::Lock registryLock(registry.mutex);
+	
+	/* Copy the retained events of all thread buffers: */
+	std::vector<std::pair<const ThreadBuffer*,Event> > events;
+	Misc::UInt64 timeBase=~Misc::UInt64(0);
+	for(const ThreadBuffer* bPtr=registry.head;bPtr!=0;bPtr=bPtr->succ)
+		{
+		/* Skip the oldest part of the ring buffer, which might be overwritten by the owning thread while it is being copied: */
+		Misc::UInt64 end=__atomic_load_n(&bPtr->numEvents,__ATOMIC_ACQUIRE);
+		Misc::UInt64 begin=0;
+		if(end>bufferSize-bufferSize/16)
+			begin=end-(bufferSize-bufferSize/16);
+		for(Misc::UInt64 i=begin;i<end;++i)
+			{
+			const Event& event=bPtr->events[i&(bufferSize-1)];
+			events.push_back(std::make_pair(bPtr,event));
+			if(timeBase>event.start)
+				timeBase=event.start;
+			}
+		}
+	
+	/* Write thread name metadata events: */
+	char line[256];
+	bool first=true;
+	for(const ThreadBuffer* bPtr=registry.head;bPtr!=0;bPtr=bPtr->succ,first=false)
+		{
+		snprintf(line,sizeof(line),"%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",first?"":",\n",bPtr->threadId,bPtr->threadName);
+		traceFile.puts(line);
+		}
+	
+	/* Write complete events with microsecond timestamps relative to the earliest event: */
+	for(std::vector<std::pair<const ThreadBuffer*,Event> >::iterator eIt=events.begin();eIt!=events.end();++eIt,first=false)
+		{
+		snprintf(line,sizeof(line),"%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",first?"":",\n",eIt->second.name,eIt->first->threadId,double(eIt->second.start-timeBase)*1.0e-3,double(eIt->second.duration)*1.0e-3);
+		traceFile.puts(line);
+		}
+	
+	traceFile.puts("\n]}\n");
+	}
@@ -0,0 +1,105 @@
+/***********************************************************************
+Tracer - Class to record timed zones of code executed by the main and
+extraction threads into per-thread lock-free ring buffers, and to export
+them as Chrome trace event files for inspection in chrome://tracing or
+Perfetto.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef TRACER_INCLUDED
+#define TRACER_INCLUDED
+
+#include <Config.h>
+
+#include <Misc/SizedTypes.h>
+
+class Tracer
+	{
+	/* Embedded classes: */
+	public:
+	struct Event // Structure describing a completed zone
+		{
+		/* Elements: */
+		public:
+		const char* name; // Name of the zone; must be a string with static storage duration
+		Misc::UInt64 start; // Zone start time in nanoseconds
+		Misc::UInt64 duration; // Zone duration in nanoseconds
+		};
+	
+	class ThreadBuffer; // Class for per-thread event ring buffers
+	
+	/* Elements: */
+	static const unsigned int bufferSize=1U<<14; // Number of most recent events retained for each thread; must be a power of two
+	private:
+	static bool enabled; // Flag whether zones are currently being recorded
+	
+	/* Private methods: */
+	static ThreadBuffer* getThreadBuffer(void); // Returns the calling thread's event buffer; creates a new buffer on first call
+	
+	/* Methods: */
+	public:
+	static bool isEnabled(void) // Returns true if zones are currently being recorded
+		{
+		return enabled;
+		}
+	static void setEnabled(bool newEnabled); // Enables or disables recording of zones
+	static Misc::UInt64 getTime(void); // Returns the current monotonic time in nanoseconds
+	static void setThreadName(const char* newThreadName); // Sets the name under which the calling thread's events will be exported
+	static void record(const char* name,Misc::UInt64 start,Misc::UInt64 end); // Records a completed zone for the calling thread
+	static void saveChromeTrace(const char* traceFileName); // Writes the events currently retained in all threads' buffers to a Chrome trace event JSON file of the given name
+	};
+
+class TraceZone // Class to record the lifetime of an enclosing scope as a zone
+	{
+	/* Elements: */
+	private:
+	const char* name; // Name of the zone
+	Misc::UInt64 start; // Zone start time in nanoseconds, or zero if recording was disabled when the zone was entered
+	
+	/* Constructors and destructors: */
+	public:
+	TraceZone(const char* sName) // Enters a zone of the given name
+		:name(sName),
+		 start(Tracer::isEnabled()?Tracer::getTime():0)
+		{
+		}
+	private:
+	TraceZone(const TraceZone& source); // Prohibit copy constructor
+	TraceZone& operator=(const TraceZone& source); // Prohibit assignment operator
+	public:
+	~TraceZone(void) // Leaves the zone and records it
+		{
+		if(start!=0)
+			Tracer::record(name,start,Tracer::getTime());
+		}
+	};
+
+/* Macros to instrument code; they expand to nothing unless tracing support was selected at configuration time: */
+#if VISUALIZATION_CONFIG_USE_TRACING
+#define VISUALIZATION_TRACE_CONCAT_HELPER(a,b) a##b
+#define VISUALIZATION_TRACE_CONCAT(a,b) VISUALIZATION_TRACE_CONCAT_HELPER(a,b)
+#define VISUALIZATION_TRACE_ZONE(name) TraceZone VISUALIZATION_TRACE_CONCAT(traceZone,__LINE__)(name)
+#define VISUALIZATION_TRACE_THREAD_NAME(name) Tracer::setThreadName(name)
+#else
+#define VISUALIZATION_TRACE_ZONE(name)
+#define VISUALIZATION_TRACE_THREAD_NAME(name)
+#endif
+
+#endif
@@ -1,7 +1,7 @@
 /***********************************************************************
 TripleChannelRaycaster - Class for volume renderers with three
 independent scalar channels.
-Copyright (c) 2009-2023 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -38,8 +38,9 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 Methods of class TripleChannelRaycaster::DataItem:
 *************************************************/
 
-TripleChannelRaycaster::DataItem::DataItem(void)
-	:haveFloatTextures(GLARBTextureFloat::isSupported()),
+TripleChannelRaycaster::DataItem::DataItem(const OccupancyGrid& occupancyGrid)
+	:Raycaster::DataItem(occupancyGrid),
+	 haveFloatTextures(GLARBTextureFloat::isSupported()),
 	 volumeTextureID(0),volumeTextureVersion(0),
 	 volumeSamplerLoc(-1),channelEnabledsLoc(-1),colorMapSamplersLoc(-1)
 	{
@@ -124,9 +125,9 @@ void TripleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 	DataItem* myDataItem=static_cast<DataItem*>(dataItem);
 	
 	/* Bind the volume texture: */
-	glActiveTextureARB(GL_TEXTURE1_ARB);
+	glActiveTextureARB(GL_TEXTURE2_ARB);
 	glBindTexture(GL_TEXTURE_3D_EXT,myDataItem->volumeTextureID);
-	glUniform1iARB(myDataItem->volumeSamplerLoc,1);
+	glUniform1iARB(myDataItem->volumeSamplerLoc,2);
 	
 	/* Check if the volume texture needs to be updated: */
 	if(myDataItem->volumeTextureVersion!=dataVersion)
@@ -145,15 +146,15 @@ void TripleChannelRaycaster::bindShader(const Raycaster::PTransform& pmv,const R
 		{
 		channelEnabledsValues[channel]=channelEnableds[channel]?1:0;
 		
-		glActiveTextureARB(GL_TEXTURE2_ARB+channel);
+		glActiveTextureARB(GL_TEXTURE3_ARB+channel);
 		glBindTexture(GL_TEXTURE_1D,myDataItem->colorMapTextureIDs[channel]);
-		colorMapSamplers[channel]=2+channel;
+		colorMapSamplers[channel]=3+channel;
 
 		/* Create the stepsize-adjusted colormap with pre-multiplied alpha: */
 		GLColorMap adjustedColorMap(*colorMaps[channel]);
 		adjustedColorMap.changeTransparency(stepSize*transparencyGammas[channel]);
 		adjustedColorMap.premultiplyAlpha();
-		glTexImage1D(GL_TEXTURE_1D,0,myDataItem->haveFloatTextures?GL_RGBA32F_ARB:GL_RGBA,256,0,GL_RGBA,GL_FLOAT,adjustedColorMap.getColors());
+		glTexImage1D(GL_TEXTURE_1D,0,myDataItem->haveFloatTextures?GL_RGBA32F_ARB:GL_RGBA,adjustedColorMap.getNumEntries(),0,GL_RGBA,GL_FLOAT,adjustedColorMap.getColors());
 		}
 	glUniform1ivARB(myDataItem->channelEnabledsLoc,3,channelEnabledsValues);
 	glUniform1ivARB(myDataItem->colorMapSamplersLoc,3,colorMapSamplers);
@@ -164,20 +165,34 @@ void TripleChannelRaycaster::unbindShader(SceneGraph::GLRenderState& renderState
 	/* Unbind the color map textures: */
 	for(int channel=0;channel<3;++channel)
 		{
-		glActiveTextureARB(GL_TEXTURE2_ARB+channel);
+		glActiveTextureARB(GL_TEXTURE3_ARB+channel);
 		glBindTexture(GL_TEXTURE_1D,0);
 		}
 	
 	/* Bind the volume texture: */
-	glActiveTextureARB(GL_TEXTURE1_ARB);
+	glActiveTextureARB(GL_TEXTURE2_ARB);
 	glBindTexture(GL_TEXTURE_3D_EXT,0);
 	
 	/* Call the base class method: */
 	Raycaster::unbindShader(renderState,dataItem);
 	}
 
+bool TripleChannelRaycaster::classifyOccupancy(Raycaster::DataItem* dataItem) const
+	{
+	/* Classify the volume's bricks against the opacities of all enabled channels' color maps: */
+	const float* opacities[3];
+	int numOpacities[3];
+	for(int channel=0;channel<3;++channel)
+		{
+		bool enabled=channelEnableds[channel]&&colorMaps[channel]!=0;
+		opacities[channel]=enabled?colorMaps[channel]->getColors()[0].getRgba()+3:0;
+		numOpacities[channel]=enabled?colorMaps[channel]->getNumEntries():0;
+		}
+	return occupancyGrid.classify(dataItem->occupancy,opacities,numOpacities,4);
+	}
+
 TripleChannelRaycaster::TripleChannelRaycaster(const Raycaster::Size3& sDataSize,const Raycaster::Box& sDomain)
-	:Raycaster(sDataSize,sDomain),
+	:Raycaster(sDataSize,sDomain,3),
 	 data(new Voxel[dataSize.volume()*3]),dataVersion(0)
 	{
 	/* Multiply the data stride values with the number of channels: */
@@ -202,7 +217,7 @@ TripleChannelRaycaster::~TripleChannelRaycaster(void)
 void TripleChannelRaycaster::initContext(GLContextData& contextData) const
 	{
 	/* Create a new data item: */
-	DataItem* dataItem=new DataItem;
+	DataItem* dataItem=new DataItem(occupancyGrid);
 	contextData.addDataItem(this,dataItem);
 	
 	/* Initialize the data item: */
@@ -239,6 +254,10 @@ void TripleChannelRaycaster::updateData(void)
 	{
 	/* Bump up the data version number: */
 	++dataVersion;
+	
+	/* Update the value ranges of all bricks in all channels for empty-space skipping: */
+	for(int channel=0;channel<3;++channel)
+		occupancyGrid.updateRanges(channel,data+channel,dataStrides);
 	}
 
 void TripleChannelRaycaster::setChannelEnabled(int channel,bool newChannelEnabled)
@@ -50,7 +50,7 @@ class TripleChannelRaycaster:public Raycaster
 		int colorMapSamplersLoc; // Location of the three color map texture samplers
 		
 		/* Constructors and destructors: */
-		DataItem(void);
+		DataItem(const OccupancyGrid& occupancyGrid);
 		virtual ~DataItem(void);
 		};
 	
@@ -68,6 +68,7 @@ class TripleChannelRaycaster:public Raycaster
 	virtual void initShader(Raycaster::DataItem* dataItem) const;
 	virtual void bindShader(const PTransform& pmv,const PTransform& mv,SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const;
 	virtual void unbindShader(SceneGraph::GLRenderState& renderState,Raycaster::DataItem* dataItem) const;
+	virtual bool classifyOccupancy(Raycaster::DataItem* dataItem) const;
 	
 	/* Constructors and destructors: */
 	public:
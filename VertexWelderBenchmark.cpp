@@ -0,0 +1,166 @@
+/***********************************************************************
+VertexWelderBenchmark - Utility to measure the throughput of the vertex
+welder on synthetic unstructured hexahedral meshes where each cell
+stores its own copies of its eight corner vertices.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdexcept>
+#include <iostream>
+#include <Misc/Timer.h>
+
+#include <Concrete/VertexWelder.h>
+
+typedef Visualization::Concrete::VertexWelder<float,unsigned int> VertexWelder;
+typedef VertexWelder::Scalar Scalar;
+typedef VertexWelder::Index Index;
+
+bool checkTolerance(VertexWelder& welder,Scalar tolerance)
+	{
+	/*********************************************************************
+	Create pairs of vertices offset by slightly less or slightly more than
+	the tolerance along one axis or along all three axes, spaced far
+	enough apart that no two pairs can be welded. Pairs just inside the
+	tolerance must be welded, and pairs just outside must not be.
+	*********************************************************************/
+	
+	static const Scalar offsets[2]={Scalar(0.9),Scalar(1.1)};
+	static const int axisMasks[4]={0x1,0x2,0x4,0x7};
+	Scalar vertexComponents[2*4*2*3];
+	Scalar* vcPtr=vertexComponents;
+	for(int o=0;o<2;++o)
+		for(int a=0;a<4;++a)
+			{
+			Scalar base=Scalar((o*4+a)*16)*tolerance;
+			for(int i=0;i<3;++i,++vcPtr)
+				*vcPtr=base;
+			for(int i=0;i<3;++i,++vcPtr)
+				*vcPtr=(axisMasks[a]&(0x1<<i))!=0?base+offsets[o]*tolerance:base;
+			}
+	
+	/* Weld the vertex pairs and check the results: */
+	welder.weld(2*4*2,vertexComponents,tolerance);
+	bool result=true;
+	for(int o=0;o<2;++o)
+		for(int a=0;a<4;++a)
+			{
+			Index v0=Index((o*4+a)*2);
+			bool welded=welder.getWeldedVertexIndex(v0)==welder.getWeldedVertexIndex(v0+1);
+			if(welded!=(o==0))
+				{
+				std::cout<<"Tolerance check failed: vertices offset by "<<offsets[o]<<" times the tolerance along axis mask "<<axisMasks[a]<<(welded?" were welded":" were not welded")<<std::endl;
+				result=false;
+				}
+			}
+	
+	return result;
+	}
+
+int main(int argc,char* argv[])
+	{
+	/* Parse the command line: */
+	unsigned int numCells=232;
+	unsigned int numThreads=0;
+	Scalar tolerance(1.0e-3);
+	Scalar jitter(0.4);
+	unsigned int numRuns=1;
+	for(int i=1;i<argc;++i)
+		{
+		if(strcasecmp(argv[i],"-numCells")==0&&i+1<argc)
+			numCells=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-numThreads")==0&&i+1<argc)
+			numThreads=atoi(argv[++i]);
+		else if(strcasecmp(argv[i],"-tolerance")==0&&i+1<argc)
+			tolerance=Scalar(atof(argv[++i]));
+		else if(strcasecmp(argv[i],"-jitter")==0&&i+1<argc)
+			jitter=Scalar(atof(argv[++i]));
+		else if(strcasecmp(argv[i],"-numRuns")==0&&i+1<argc)
+			numRuns=atoi(argv[++i]);
+		else
+			{
+			std::cerr<<"Usage: "<<argv[0]<<" [-numCells <cells per axis>] [-numThreads <num>] [-tolerance <distance>] [-jitter <tolerance fraction>] [-numRuns <num>]"<<std::endl;
+			return 1;
+			}
+		}
+	if(numCells<1||numRuns<1||!(tolerance>Scalar(0))||jitter<Scalar(0))
+		{
+		std::cerr<<"Invalid benchmark parameters"<<std::endl;
+		return 1;
+		}
+	
+	/* Create a mesh of unit-sized cells where each cell stores its own jittered copies of its corner vertices, as written by many simulation codes: */
+	Index numVertices=Index(numCells)*Index(numCells)*Index(numCells)*8U;
+	Scalar* vertexComponents=new Scalar[size_t(numVertices)*3];
+	Scalar* vcPtr=vertexComponents;
+	unsigned int seed=1;
+	for(unsigned int z=0;z<numCells;++z)
+		for(unsigned int y=0;y<numCells;++y)
+			for(unsigned int x=0;x<numCells;++x)
+				for(int corner=0;corner<8;++corner)
+					{
+					unsigned int c[3]={x+(corner&0x1),y+((corner>>1)&0x1),z+((corner>>2)&0x1)};
+					for(int i=0;i<3;++i,++vcPtr)
+						{
+						/* Offset the vertex by a pseudo-random amount less than half the jitter range along each axis: */
+						seed=seed*1103515245U+12345U;
+						Scalar offset=(Scalar((seed>>8)&0xffffU)/Scalar(65535)-Scalar(0.5))*jitter*tolerance;
+						*vcPtr=Scalar(c[i])+offset;
+						}
+					}
+	
+	/* Weld the mesh's vertices: */
+	VertexWelder welder;
+	if(numThreads>0)
+		welder.setNumThreads(numThreads);
+	double totalTime=0.0;
+	bool toleranceOk=false;
+	try
+		{
+		/* Check that the welder respects the tolerance exactly: */
+		toleranceOk=checkTolerance(welder,tolerance);
+		
+		for(unsigned int run=0;run<numRuns;++run)
+			{
+			Misc::Timer weldTimer;
+			welder.weld(numVertices,vertexComponents,tolerance);
+			weldTimer.elapse();
+			totalTime+=weldTimer.getTime();
+			}
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"Unable to weld vertices due to exception "<<err.what()<<std::endl;
+		delete[] vertexComponents;
+		return 1;
+		}
+	
+	/* Print the benchmark results: */
+	Index expectedNumVertices=Index(numCells+1)*Index(numCells+1)*Index(numCells+1);
+	std::cout<<"Cells: "<<numCells<<"^3, vertices: "<<numVertices<<", threads: "<<welder.getNumThreads()<<", runs: "<<numRuns<<std::endl;
+	std::cout<<"Welded vertices: "<<welder.getNumWeldedVertices()<<" (expected "<<expectedNumVertices<<')'<<std::endl;
+	std::cout<<"Tolerance check: "<<(toleranceOk?"passed":"failed")<<std::endl;
+	std::cout<<"Welding time: "<<totalTime*1000.0/double(numRuns)<<" ms per run"<<std::endl;
+	std::cout<<"Throughput: "<<double(numVertices)*double(numRuns)/totalTime*1.0e-6<<" Mvertices/s"<<std::endl;
+	
+	delete[] vertexComponents;
+	
+	return toleranceOk&&welder.getNumWeldedVertices()==expectedNumVertices?0:1;
+	}
@@ -1,7 +1,7 @@
 /***********************************************************************
 Visualizer - Test application for the new visualization component
 framework.
-Copyright (c) 2005-2024 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -23,14 +23,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "Visualizer.h"
 
 #include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
+#include <signal.h>
 #include <stdexcept>
 #include <vector>
 #include <iostream>
 #include <string>
 #include <Misc/StdError.h>
-#include <Misc/Timer.h>
-#include <Misc/StandardMarshallers.h>
 #include <Misc/FileNameExtensions.h>
 #include <Misc/CreateNumberedFileName.h>
 #include <Misc/MessageLogger.h>
@@ -63,17 +63,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Vrui/CoordinateManager.h>
 #include <Vrui/SceneGraphManager.h>
 
+#include <Abstract/DataSet.h>
 #include <Abstract/DataSetRenderer.h>
 #include <Abstract/CoordinateTransformer.h>
 #include <Abstract/VariableManager.h>
 #include <Abstract/Parameters.h>
-#include <Abstract/BinaryParametersSink.h>
-#include <Abstract/BinaryParametersSource.h>
-#include <Abstract/FileParametersSource.h>
 #include <Abstract/ConfigurationFileParametersSource.h>
 #include <Abstract/Algorithm.h>
 #include <Abstract/Element.h>
 #include <Abstract/Module.h>
+#include <Templatized/RegionOfInterest.h>
 
 #include "CuttingPlane.h"
 #include "BaseLocator.h"
@@ -82,10 +81,46 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include "VectorEvaluationLocator.h"
 #include "ExtractorLocator.h"
 #include "ElementList.h"
+#include "ElementLoader.h"
+#include "Tracer.h"
 #if VISUALIZATION_CONFIG_USE_COLLABORATION
 #include "SharedVisualizationClient.h"
 #endif
 
+#if VISUALIZATION_CONFIG_USE_TRACING
+
+namespace {
+
+/*************************************
+Helper functions for timeline tracing:
+*************************************/
+
+volatile sig_atomic_t saveTraceRequested=0; // Flag set by the signal handler to request saving a timeline trace in the next frame
+
+void saveTraceSignalHandler(int)
+	{
+	saveTraceRequested=1;
+	}
+
+void saveTrace(void)
+	{
+	try
+		{
+		/* Save the trace to a new numbered trace file: */
+		char traceFileNameBuffer[256];
+		Tracer::saveChromeTrace(Misc::createNumberedFileName("Trace.json",4,traceFileNameBuffer));
+		std::cout<<"Saved timeline trace to "<<traceFileNameBuffer<<std::endl;
+		}
+	catch(const std::runtime_error& err)
+		{
+		std::cerr<<"Unable to save timeline trace due to exception "<<err.what()<<std::endl;
+		}
+	}
+
+}
+
+#endif
+
 /***************************
 Methods of class Visualizer:
 ***************************/
@@ -244,6 +279,13 @@ GLMotif::PopupMenu* Visualizer::createElementsMenu(void)
 	GLMotif::Button* saveElementsButton=new GLMotif::Button("SaveElementsButton",elementsMenu,"Save Visualization Elements");
 	saveElementsButton->getSelectCallbacks().add(this,&Visualizer::saveElementsCallback);
 	
+	GLMotif::Button* saveElementArchiveButton=new GLMotif::Button("SaveElementArchiveButton",elementsMenu,"Save Visualization Element Archive");
+	saveElementArchiveButton->getSelectCallbacks().add(this,&Visualizer::saveElementArchiveCallback);
+	
+	GLMotif::ToggleButton* clipExtractionToggle=new GLMotif::ToggleButton("ClipExtractionToggle",elementsMenu,"Clip Extraction to Cutting Planes");
+	clipExtractionToggle->setToggle(clipExtraction);
+	clipExtractionToggle->getValueChangedCallbacks().add(this,&Visualizer::clipExtractionCallback);
+	
 	new GLMotif::Separator("ClearElementsSeparator",elementsMenu,GLMotif::Separator::HORIZONTAL,0.0f,GLMotif::Separator::LOWERED);
 	
 	GLMotif::Button* clearElementsButton=new GLMotif::Button("ClearElementsButton",elementsMenu,"Clear Visualization Elements");
@@ -356,242 +398,29 @@ GLMotif::PopupMenu* Visualizer::createMainMenu(void)
 	GLMotif::CascadeButton* colorCascade=new GLMotif::CascadeButton("ColorCascade",mainMenu,"Color Maps");
 	colorCascade->setPopup(createColorMenu());
 	
+	#if VISUALIZATION_CONFIG_USE_TRACING
+	GLMotif::Button* saveTraceButton=new GLMotif::Button("SaveTraceButton",mainMenu,"Save Timeline Trace");
+	saveTraceButton->getSelectCallbacks().add(this,&Visualizer::saveTraceCallback);
+	
+	#endif
 	mainMenu->manageChild();
 	
 	return mainMenuPopup;
 	}
 
-void Visualizer::loadElements(const char* elementFileName,bool ascii)
+void Visualizer::setRegionOfInterest(Algorithm* algorithm) const
 	{
-	/* Open a pipe for cluster communication: */
-	Cluster::MulticastPipe* pipe=Vrui::openPipe();
-	
-	if(pipe==0||pipe->isMaster())
-		{
-		/* Create a data sink to send element parameters to the cluster: */
-		Visualization::Abstract::BinaryParametersSink sink(variableManager,*pipe,true);
-		
-		if(ascii)
-			{
-			/* Open the element file: */
-			IO::ValueSource elementFile(IO::openFile(elementFileName));
-			elementFile.setPunctuation("");
-			elementFile.setQuotes("\"");
-			elementFile.skipWs();
-			
-			/* Read all elements from the file: */
-			while(!elementFile.eof())
-				{
-				/* Read the next algorithm name: */
-				std::string algorithmName=elementFile.readLine();
-				elementFile.skipWs();
-				
-				if(pipe!=0)
-					{
-					/* Send the algorithm name to the cluster: */
-					Misc::Marshaller<std::string>::write(algorithmName,*pipe);
-					pipe->flush(); // Redundant!!!
-					}
-				
-				/* Create an extractor for the given name: */
-				Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
-				Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
-				
-				/* Extract an element using the given extractor: */
-				if(algorithm!=0)
-					{
-					std::cout<<"Creating "<<algorithmName<<"..."<<std::flush;
-					Misc::Timer extractionTimer;
-					
-					try
-						{
-						/* Read the element's extraction parameters from the file: */
-						Visualization::Abstract::FileParametersSource source(variableManager,elementFile);
-						Parameters* parameters=algorithm->cloneParameters();
-						parameters->read(source);
-						
-						if(pipe!=0)
-							{
-							/* Send the extraction parameters to the cluster: */
-							pipe->write<int>(1);
-							parameters->write(sink);
-							pipe->flush();
-							}
-						
-						/* Extract the element: */
-						Element* element=algorithm->createElement(parameters);
-						
-						/* Store the element: */
-						elementList->addElement(algorithm,element);
-						}
-					catch(const std::runtime_error& err)
-						{
-						if(pipe!=0)
-							{
-							/* Tell the cluster there was a problem: */
-							pipe->write<int>(0);
-							pipe->flush();
-							}
-						
-						std::cout<<"Cancelled due to exception "<<err.what()<<"...";
-						}
-					
-					/* Destroy the extractor: */
-					delete algorithm;
-					
-					extractionTimer.elapse();
-					std::cout<<" done in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
-					}
-				else
-					{
-					std::cout<<"Ignoring unknown algorithm "<<algorithmName<<std::endl;
-					delete algorithmPipe;
-					}
-				}
-			}
-		else
-			{
-			/* Open the element file and create a data source to read from it: */
-			IO::FilePtr elementFile(IO::openFile(elementFileName));
-			elementFile->setEndianness(Misc::LittleEndian);
-			Visualization::Abstract::BinaryParametersSource source(variableManager,*elementFile,false);
-			
-			/* Read all elements from the file: */
-			while(!elementFile->eof())
-				{
-				/* Read the next algorithm name: */
-				std::string algorithmName=Misc::Marshaller<std::string>::read(*elementFile);
-				
-				if(pipe!=0)
-					{
-					/* Send the algorithm name to the cluster: */
-					Misc::Marshaller<std::string>::write(algorithmName,*pipe);
-					}
-				
-				/* Create an extractor for the given name: */
-				Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
-				Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
-				
-				/* Extract an element using the given extractor: */
-				if(algorithm!=0)
-					{
-					std::cout<<"Creating "<<algorithmName<<"..."<<std::flush;
-					Misc::Timer extractionTimer;
-					
-					try
-						{
-						/* Read the element's extraction parameters from the file: */
-						Parameters* parameters=algorithm->cloneParameters();
-						parameters->read(source);
-						
-						if(pipe!=0)
-							{
-							/* Send the extraction parameters to the cluster: */
-							pipe->write<int>(1);
-							parameters->write(sink);
-							pipe->flush();
-							}
-						
-						/* Extract the element: */
-						Element* element=algorithm->createElement(parameters);
-						
-						/* Store the element: */
-						elementList->addElement(algorithm,element);
-						}
-					catch(const std::runtime_error& err)
-						{
-						if(pipe!=0)
-							{
-							/* Tell the cluster there was a problem: */
-							pipe->write<int>(0);
-							pipe->flush();
-							}
-						
-						std::cout<<"Cancelled due to exception "<<err.what()<<"...";
-						}
-					
-					/* Destroy the extractor: */
-					delete algorithm;
-					
-					extractionTimer.elapse();
-					std::cout<<" done in "<<extractionTimer.getTime()*1000.0<<" ms"<<std::endl;
-					}
-				else
-					{
-					std::cout<<"Ignoring unknown algorithm "<<algorithmName<<std::endl;
-					delete algorithmPipe;
-					}
-				}
-			}
-		
-		if(pipe!=0)
-			{
-			/* Send an empty algorithm name to signal end-of-file to the cluster: */
-			Misc::Marshaller<std::string>::write("",*pipe);
-			pipe->flush();
-			}
-		}
-	else
-		{
-		std::cout<<"Ready to receive elements"<<std::endl;
-
-		/* Create a data source to read elements' parameters: */
-		Visualization::Abstract::BinaryParametersSource source(variableManager,*pipe,true);
-		
-		/* Receive all visualization elements from the head node: */
-		while(true)
-			{
-			/* Receive the algorithm name from the head node: */
-			std::cout<<"Reading algorithm name"<<std::endl;
-			std::string algorithmName=Misc::Marshaller<std::string>::read(*pipe);
-			if(algorithmName.empty()) // Check for end-of-file indicator
-				break;
-			
-			// DEBUGGING
-			std::cout<<"Received algorithm "<<algorithmName<<std::endl;
-			
-			/* Create an extractor for the given name: */
-			Cluster::MulticastPipe* algorithmPipe=Vrui::openPipe();
-			Algorithm* algorithm=module->getAlgorithm(algorithmName.c_str(),variableManager,algorithmPipe);
-			
-			/* Extract an element using the given extractor: */
-			if(algorithm!=0)
-				{
-				/* Check if there are valid parameters: */
-				if(pipe->read<int>()!=0)
-					{
-					std::cout<<"Receiving parameters"<<std::endl;
-					
-					/* Receive the extraction parameters: */
-					Parameters* parameters=algorithm->cloneParameters();
-					parameters->read(source);
-					
-					std::cout<<"Receiving element"<<std::endl;
-					/* Receive the element: */
-					Element* element=algorithm->startSlaveElement(parameters);
-					algorithm->continueSlaveElement();
-					
-					std::cout<<"Done"<<std::endl;
-
-					/* Store the element: */
-					elementList->addElement(algorithm,element);
-					}
-				
-				/* Destroy the extractor: */
-				delete algorithm;
-				}
-			else
-				delete algorithmPipe;
-			}
-
-		std::cout<<"Done"<<std::endl;
-		}
-	
-	if(pipe!=0)
-		{
-		/* Close the communication pipe: */
-		delete pipe;
-		}
+	/* Assemble the region of interest from the extraction box and the front sides of all active cutting planes: */
+	DataSet::RegionOfInterest regionOfInterest;
+	if(haveExtractionBox)
+		regionOfInterest.setBox(DataSet::Box(extractionBox));
+	if(clipExtraction)
+		for(size_t i=0;i<numCuttingPlanes;++i)
+			if(cuttingPlanes[i].active)
+				regionOfInterest.addHalfSpace(DataSet::RegionOfInterest::Plane(cuttingPlanes[i].plane));
+	
+	/* Pass the region of interest to the algorithm: */
+	algorithm->setRegionOfInterest(regionOfInterest);
 	}
 
 Visualizer::Visualizer(int& argc,char**& argv)
@@ -606,7 +435,9 @@ Visualizer::Visualizer(int& argc,char**& argv)
 	 sharedVisualizationClient(0),
 	 #endif
 	 numCuttingPlanes(0),cuttingPlanes(0),
-	 elementList(0),
+	 haveExtractionBox(false),extractionBox(Geometry::Box<Vrui::Scalar,3>::full),clipExtraction(false),
+	 maxSeedLatency(0.05),predictSeeds(true),
+	 elementList(0),elementLoader(0),
 	 algorithm(0),
 	 mainMenu(0),
 	 inLoadPalette(false),inLoadElements(false)
@@ -617,6 +448,8 @@ Visualizer::Visualizer(int& argc,char**& argv)
 	std::vector<std::string> dataSetArgs;
 	const char* argColorMapName=0;
 	std::vector<const char*> loadFileNames;
+	const char* geometrySharingModeName=0;
+	double maxTrackingRate=0.0;
 	for(int i=1;i<argc;++i)
 		{
 		if(argv[i][0]=='-')
@@ -643,6 +476,59 @@ Visualizer::Visualizer(int& argc,char**& argv)
 				else
 					std::cerr<<"Missing palette file name after -palette"<<std::endl;
 				}
+			else if(strcasecmp(argv[i]+1,"extractionBox")==0)
+				{
+				if(i+6<argc)
+					{
+					/* Restrict extraction of visualization elements to the given box: */
+					for(int j=0;j<3;++j)
+						extractionBox.min[j]=Vrui::Scalar(atof(argv[i+1+j]));
+					for(int j=0;j<3;++j)
+						extractionBox.max[j]=Vrui::Scalar(atof(argv[i+4+j]));
+					haveExtractionBox=true;
+					}
+				else
+					std::cerr<<"Missing box corners after -extractionBox"<<std::endl;
+				i+=6;
+				}
+			else if(strcasecmp(argv[i]+1,"shareGeometry")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the geometry sharing policy for a shared visualization session later: */
+					geometrySharingModeName=argv[i];
+					}
+				else
+					std::cerr<<"Missing geometry sharing mode after -shareGeometry"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"trackingRate")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the maximum rate of in-progress tool interaction updates for a shared visualization session later: */
+					maxTrackingRate=atof(argv[i]);
+					}
+				else
+					std::cerr<<"Missing update rate after -trackingRate"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"maxSeedLatency")==0)
+				{
+				++i;
+				if(i<argc)
+					{
+					/* Set the latency bound for dragging locators: */
+					maxSeedLatency=atof(argv[i]);
+					}
+				else
+					std::cerr<<"Missing latency after -maxSeedLatency"<<std::endl;
+				}
+			else if(strcasecmp(argv[i]+1,"noSeedPrediction")==0)
+				{
+				/* Disable motion extrapolation for dragging locators: */
+				predictSeeds=false;
+				}
 			else if(strcasecmp(argv[i]+1,"load")==0)
 				{
 				++i;
@@ -804,6 +690,9 @@ Visualizer::Visualizer(int& argc,char**& argv)
 	elementList->getElementListDialog()->setCloseButton(true);
 	elementList->getElementListDialog()->getCloseCallbacks().add(this,&Visualizer::elementListClosedCallback);
 	
+	/* Create the element loader: */
+	elementLoader=new ElementLoader(module,variableManager,elementList);
+	
 	#if VISUALIZATION_CONFIG_USE_COLLABORATION
 	
 	/* Check whether to connect to a shared visualization session: */
@@ -814,12 +703,37 @@ Visualizer::Visualizer(int& argc,char**& argv)
 		sharedVisualizationClient=new Collab::Plugins::SharedVisualizationClient(client,variableManager,module,elementList);
 		client->addPluginProtocol(sharedVisualizationClient);
 		
+		/* Set the policy to share the geometry of locally extracted elements with other clients: */
+		if(geometrySharingModeName!=0)
+			{
+			if(strcasecmp(geometrySharingModeName,"never")==0)
+				sharedVisualizationClient->setGeometrySharingMode(Collab::Plugins::SharedVisualizationClient::NEVER_SHARE);
+			else if(strcasecmp(geometrySharingModeName,"always")==0)
+				sharedVisualizationClient->setGeometrySharingMode(Collab::Plugins::SharedVisualizationClient::ALWAYS_SHARE);
+			else if(strcasecmp(geometrySharingModeName,"auto")==0)
+				sharedVisualizationClient->setGeometrySharingMode(Collab::Plugins::SharedVisualizationClient::AUTO_SHARE);
+			else
+				std::cerr<<"Ignoring unknown geometry sharing mode "<<geometrySharingModeName<<std::endl;
+			}
+		
+		/* Set the maximum rate at which in-progress tool interactions are shared with other clients: */
+		if(maxTrackingRate>0.0)
+			sharedVisualizationClient->setMaxTrackingRate(maxTrackingRate);
+		
 		/* Let the element list know of the shared visualization client: */
 		elementList->setSharedVisualizationClient(sharedVisualizationClient);
 		}
 	
 	#endif
 	
+	#if VISUALIZATION_CONFIG_USE_TRACING
+	
+	/* Save a timeline trace whenever the process receives SIGUSR1: */
+	if(Vrui::isHeadNode())
+		signal(SIGUSR1,saveTraceSignalHandler);
+	
+	#endif
+	
 	/* Load all element files listed on the command line: */
 	for(std::vector<const char*>::const_iterator lfnIt=loadFileNames.begin();lfnIt!=loadFileNames.end();++lfnIt)
 		{
@@ -827,12 +741,17 @@ Visualizer::Visualizer(int& argc,char**& argv)
 		if(Misc::hasCaseExtension(*lfnIt,".asciielem"))
 			{
 			/* Load an ASCII elements file: */
-			loadElements(*lfnIt,true);
+			elementLoader->loadElements(*lfnIt,ElementLoader::ASCII_ELEMENTS);
 			}
 		else if(Misc::hasCaseExtension(*lfnIt,".binelem"))
 			{
 			/* Load a binary elements file: */
-			loadElements(*lfnIt,false);
+			elementLoader->loadElements(*lfnIt,ElementLoader::BINARY_ELEMENTS);
+			}
+		else if(Misc::hasCaseExtension(*lfnIt,".archelem"))
+			{
+			/* Load an element archive: */
+			elementLoader->loadElements(*lfnIt,ElementLoader::ELEMENT_ARCHIVE);
 			}
 		}
 	}
@@ -841,7 +760,8 @@ Visualizer::~Visualizer(void)
 	{
 	delete mainMenu;
 	
-	/* Delete all finished visualization elements: */
+	/* Delete the element loader and all finished visualization elements: */
+	delete elementLoader;
 	delete elementList;
 	
 	/* Remove all remaining locators from Vrui's central scene graph: */
@@ -994,6 +914,27 @@ void Visualizer::prepareMainLoop(void)
 
 void Visualizer::frame(void)
 	{
+	/* Show the palette editor's histogram once it has been calculated in the background: */
+	variableManager->frame();
+	
+	#if VISUALIZATION_CONFIG_USE_COLLABORATION
+	
+	/* Process element geometry and in-progress tool interactions shared through the shared visualization server: */
+	if(sharedVisualizationClient!=0)
+		sharedVisualizationClient->frame();
+	
+	#endif
+	
+	#if VISUALIZATION_CONFIG_USE_TRACING
+	
+	/* Save a timeline trace if requested by a signal: */
+	if(saveTraceRequested)
+		{
+		saveTraceRequested=0;
+		saveTrace();
+		}
+	
+	#endif
 	}
 
 void Visualizer::display(GLContextData& contextData) const
@@ -1192,7 +1133,7 @@ void Visualizer::loadElementsCallback(Misc::CallbackData*)
 	if(!inLoadElements)
 		{
 		/* Create a file selection dialog to select an element file: */
-		GLMotif::FileSelectionDialog* fsDialog=new GLMotif::FileSelectionDialog(Vrui::getWidgetManager(),"Load Visualization Elements...",IO::openDirectory("."),".asciielem;.binelem");
+		GLMotif::FileSelectionDialog* fsDialog=new GLMotif::FileSelectionDialog(Vrui::getWidgetManager(),"Load Visualization Elements...",IO::openDirectory("."),".asciielem;.binelem;.archelem");
 		fsDialog->getOKCallbacks().add(this,&Visualizer::loadElementsOKCallback);
 		fsDialog->getCancelCallbacks().add(this,&Visualizer::loadElementsCancelCallback);
 		Vrui::popupPrimaryWidget(fsDialog);
@@ -1208,12 +1149,17 @@ void Visualizer::loadElementsOKCallback(GLMotif::FileSelectionDialog::OKCallback
 		if(Misc::hasCaseExtension(cbData->selectedFileName,".asciielem"))
 			{
 			/* Load the ASCII elements file: */
-			loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),true);
+			elementLoader->loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),ElementLoader::ASCII_ELEMENTS);
 			}
 		else if(Misc::hasCaseExtension(cbData->selectedFileName,".binelem"))
 			{
 			/* Load the binary elements file: */
-			loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),false);
+			elementLoader->loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),ElementLoader::BINARY_ELEMENTS);
+			}
+		else if(Misc::hasCaseExtension(cbData->selectedFileName,".archelem"))
+			{
+			/* Load the element archive: */
+			elementLoader->loadElements(cbData->selectedDirectory->getPath(cbData->selectedFileName).c_str(),ElementLoader::ELEMENT_ARCHIVE);
 			}
 		}
 	catch(const std::runtime_error& err)
@@ -1255,10 +1201,46 @@ void Visualizer::saveElementsCallback(Misc::CallbackData*)
 		}
 	}
 
+void Visualizer::saveElementArchiveCallback(Misc::CallbackData*)
+	{
+	if(Vrui::isHeadNode())
+		{
+		/* Create the element archive: */
+		char archiveFileNameBuffer[256];
+		Misc::createNumberedFileName("SavedElements.archelem",4,archiveFileNameBuffer);
+		
+		try
+			{
+			/* Save the visible elements and their geometry to the element archive: */
+			elementList->saveElementArchive(archiveFileNameBuffer,variableManager);
+			}
+		catch(const std::runtime_error& err)
+			{
+			Misc::sourcedUserError(__PRETTY_FUNCTION__,"Cannot save element archive %s due to exception %s",archiveFileNameBuffer,err.what());
+			}
+		}
+	}
+
 void Visualizer::clearElementsCallback(Misc::CallbackData*)
 	{
 	/* Delete all finished visualization elements: */
 	elementList->clear();
 	}
 
+void Visualizer::clipExtractionCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData)
+	{
+	/* Enable or disable clipping of subsequently extracted visualization elements: */
+	clipExtraction=cbData->set;
+	}
+
+#if VISUALIZATION_CONFIG_USE_TRACING
+
+void Visualizer::saveTraceCallback(Misc::CallbackData*)
+	{
+	if(Vrui::isHeadNode())
+		saveTrace();
+	}
+
+#endif
+
 VRUI_APPLICATION_RUN(Visualizer)
@@ -1,7 +1,7 @@
 /***********************************************************************
 Visualizer - Test application for the new visualization component
 framework.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -28,6 +28,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <string>
 #include <vector>
 #include <Misc/Autopointer.h>
+#include <Geometry/Box.h>
 #include <Plugins/FactoryManager.h>
 #include <GLMotif/Menu.h>
 #include <GLMotif/ToggleButton.h>
@@ -64,6 +65,7 @@ class Module;
 struct CuttingPlane;
 class BaseLocator;
 class ElementList;
+class ElementLoader;
 #if VISUALIZATION_CONFIG_USE_COLLABORATION
 namespace Collab {
 namespace Plugins {
@@ -123,8 +125,14 @@ class Visualizer:public Vrui::Application
 	#endif
 	size_t numCuttingPlanes; // Maximum number of cutting planes supported
 	CuttingPlane* cuttingPlanes; // Array of available cutting planes
+	bool haveExtractionBox; // Flag whether extraction of visualization elements is restricted to an axis-aligned box
+	Geometry::Box<Vrui::Scalar,3> extractionBox; // Axis-aligned box in model coordinates to which extraction of visualization elements is restricted
+	bool clipExtraction; // Flag whether extraction of visualization elements is restricted to the front sides of all active cutting planes
+	double maxSeedLatency; // Desired upper bound for the time from moving a dragging locator to seeing its first preview in seconds
+	bool predictSeeds; // Flag whether dragging locators extrapolate their motion to compensate for extraction latency
 	BaseLocatorList baseLocators; // List of active locators
 	ElementList* elementList; // List of previously extracted visualization elements
+	ElementLoader* elementLoader; // Loader for visualization elements from element files
 	int algorithm; // The currently selected algorithm
 	GLMotif::PopupMenu* mainMenu; // The main menu widget
 	GLMotif::ToggleButton* showColorBarToggle; // Toggle button to show the color bar
@@ -146,7 +154,7 @@ class Visualizer:public Vrui::Application
 	GLMotif::PopupMenu* createStandardSaturationPalettesMenu(void);
 	GLMotif::PopupMenu* createColorMenu(void);
 	GLMotif::PopupMenu* createMainMenu(void);
-	void loadElements(const char* elementFileName,bool ascii); // Loads all visualization elements defined in the given file
+	void setRegionOfInterest(Algorithm* algorithm) const; // Restricts the given algorithm's next extraction to the current extraction box and active cutting planes
 	
 	/* Constructors and destructors: */
 	public:
@@ -182,7 +190,12 @@ class Visualizer:public Vrui::Application
 	void loadElementsOKCallback(GLMotif::FileSelectionDialog::OKCallbackData* cbData);
 	void loadElementsCancelCallback(GLMotif::FileSelectionDialog::CancelCallbackData* cbData);
 	void saveElementsCallback(Misc::CallbackData* cbData);
+	void saveElementArchiveCallback(Misc::CallbackData* cbData);
 	void clearElementsCallback(Misc::CallbackData* cbData);
+	void clipExtractionCallback(GLMotif::ToggleButton::ValueChangedCallbackData* cbData);
+	#if VISUALIZATION_CONFIG_USE_TRACING
+	void saveTraceCallback(Misc::CallbackData* cbData);
+	#endif
 	};
 
 #endif
@@ -1,7 +1,7 @@
 /***********************************************************************
 ArrowRakeExtractor - Wrapper class extract rakes of arrows from vector
 fields.
-Copyright (c) 2008-2023 Oliver Kreylos
+Copyright (c) 2008-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -116,6 +116,11 @@ class ArrowRakeExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool getSeedPoint(Visualization::Abstract::Parameters::SeedPoint& result) const
+			{
+			result=Visualization::Abstract::Parameters::SeedPoint(base);
+			return true;
+			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
 		#if VISUALIZATION_CONFIG_USE_COLLABORATION
@@ -1,7 +1,7 @@
 /***********************************************************************
 CartesianIncludes - Includes header files required by visualization
 modules representing Cartesian data sets.
-Copyright (c) 2006-2007 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -29,5 +29,6 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Templatized/SliceCaseTableTesseract.h>
 #include <Templatized/IsosurfaceCaseTableTesseract.h>
 #include <Templatized/VolumeRenderingSamplerCartesian.h>
+#include <Templatized/FlyingEdgesTraitsCartesian.h>
 
 #endif
@@ -1,7 +1,7 @@
 /***********************************************************************
 DataSet - Wrapper class to map from the abstract data set interface to
 its templatized data set implementation.
-Copyright (c) 2005-2011 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -150,10 +150,12 @@ class DataSet:public Visualization::Abstract::DataSet
 	virtual const char* getScalarVariableName(int scalarVariableIndex) const;
 	virtual Visualization::Abstract::ScalarExtractor* getScalarExtractor(int scalarVariableIndex) const;
 	virtual DestScalarRange calcScalarValueRange(const Visualization::Abstract::ScalarExtractor* scalarExtractor) const;
+	virtual Visualization::Abstract::ValueStatistics calcScalarValueStatistics(const Visualization::Abstract::ScalarExtractor* scalarExtractor,const DestScalarRange& histogramRange,unsigned int numBins,const volatile bool* cancel =0) const;
 	virtual int getNumVectorVariables(void) const;
 	virtual const char* getVectorVariableName(int vectorVariableIndex) const;
 	virtual Visualization::Abstract::VectorExtractor* getVectorExtractor(int vectorVariableIndex) const;
 	virtual DestScalarRange calcVectorValueMagnitudeRange(const Visualization::Abstract::VectorExtractor* vectorExtractor) const;
+	virtual Visualization::Abstract::ValueStatistics calcVectorValueMagnitudeStatistics(const Visualization::Abstract::VectorExtractor* vectorExtractor,const DestScalarRange& histogramRange,unsigned int numBins,const volatile bool* cancel =0) const;
 	virtual BaseLocator* getLocator(void) const
 		{
 		return new Locator(ds);
@@ -2,7 +2,7 @@
 GlobalIsosurfaceExtractor - Wrapper class to map from the abstract
 visualization algorithm interface to a templatized isosurface extractor
 implementation.
-Copyright (c) 2006-2023 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -31,6 +31,7 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #include <Abstract/DataSet.h>
 #include <Abstract/Parameters.h>
 #include <Abstract/Algorithm.h>
+#include <Templatized/RegionOfInterest.h>
 
 #include <Wrappers/Isosurface.h>
 
@@ -85,6 +86,7 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		int scalarVariableIndex; // Index of the scalar variable to color the isosurface
 		bool smoothShading; // Flag to enable smooth shading by calculating scalar field gradients at each vertex position
 		VScalar isovalue; // The isosurface's isovalue
+		Visualization::Abstract::DataSet::RegionOfInterest regionOfInterest; // Region of the data set's domain to which extraction is restricted
 		
 		/* Constructors and destructors: */
 		public:
@@ -144,7 +146,9 @@ class GlobalIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return new Parameters(parameters);
 		}
+	virtual void setRegionOfInterest(const Visualization::Abstract::DataSet::RegionOfInterest& regionOfInterest);
 	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& geometryFile);
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	
 	/* New methods: */
@@ -0,0 +1,85 @@
+/***********************************************************************
+IndexWidthModule - Wrapper class to combine two templatized data set
+representations differing only in the width of their vertex and cell
+indices into a single polymorphic visualization module.
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+
+#ifndef VISUALIZATION_WRAPPERS_INDEXWIDTHMODULE_INCLUDED
+#define VISUALIZATION_WRAPPERS_INDEXWIDTHMODULE_INCLUDED
+
+#include <Wrappers/Module.h>
+
+namespace Visualization {
+
+namespace Wrappers {
+
+template <class DSParam,class DataValueParam,class LargeDSParam,class LargeDataValueParam>
+class IndexWidthModule:public Module<DSParam,DataValueParam> // Module whose load method creates data sets with compact indices by default, and data sets with wide indices if the compact indices would overflow
+	{
+	/* Embedded classes: */
+	public:
+	typedef Module<DSParam,DataValueParam> Base; // Base class for data sets using compact indices
+	typedef Module<LargeDSParam,LargeDataValueParam> LargeBase; // Module class for data sets using wide indices
+	typedef typename Base::DataSet DataSet; // Data set class using compact indices
+	typedef typename LargeBase::DataSet LargeDataSet; // Data set class using wide indices
+	
+	private:
+	class LargeModule:public LargeBase // Helper class to create renderers and algorithms for data sets using wide indices
+		{
+		/* Constructors and destructors: */
+		public:
+		LargeModule(const char* sClassName)
+			:LargeBase(sClassName)
+			{
+			}
+		
+		/* Methods from Abstract::Module: */
+		virtual Visualization::Abstract::DataSet* load(const std::vector<std::string>& args,Cluster::MulticastPipe* pipe) const;
+		};
+	
+	/* Elements: */
+	LargeModule largeModule; // Helper module for data sets using wide indices
+	
+	/* Constructors and destructors: */
+	public:
+	IndexWidthModule(const char* sClassName);
+	
+	/* Methods from Abstract::Module: */
+	virtual Visualization::Abstract::DataSetRenderer* getRenderer(const Visualization::Abstract::DataSet* dataSet) const;
+	virtual Visualization::Abstract::Algorithm* getScalarAlgorithm(int scalarAlgorithmIndex,Visualization::Abstract::VariableManager* variableManager,Cluster::MulticastPipe* pipe) const;
+	virtual Visualization::Abstract::Algorithm* getVectorAlgorithm(int vectorAlgorithmIndex,Visualization::Abstract::VariableManager* variableManager,Cluster::MulticastPipe* pipe) const;
+	
+	/* New methods: */
+	static bool isLarge(const Visualization::Abstract::DataSet* dataSet) // Returns true if the given data set uses wide indices
+		{
+		return dynamic_cast<const LargeDataSet*>(dataSet)!=0;
+		}
+	};
+
+}
+
+}
+
+#ifndef VISUALIZATION_WRAPPERS_INDEXWIDTHMODULE_IMPLEMENTATION
+#include <Wrappers/IndexWidthModule.icpp>
+#endif
+
+#endif
@@ -2,7 +2,7 @@
 Isosurface - Wrapper class for isosurfaces as visualization elements.
 Part of the wrapper layer of the templatized visualization
 components.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -80,8 +80,14 @@ class Isosurface:public Visualization::Abstract::Element
 	/* Methods from class Visualization::Abstract::Element: */
 	virtual std::string getName(void) const;
 	virtual size_t getSize(void) const;
+	virtual size_t getGeometrySize(void) const;
+	virtual void writeGeometry(IO::File& file) const;
 	
 	/* New methods: */
+	void setIsovalue(VScalar newIsovalue) // Sets the isosurface's isovalue
+		{
+		isovalue=newIsovalue;
+		}
 	Surface& getSurface(void) // Returns the surface representation
 		{
 		return surface;
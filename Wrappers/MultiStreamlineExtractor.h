@@ -2,7 +2,7 @@
 MultiStreamlineExtractor - Wrapper class to map from the abstract
 visualization algorithm interface to a templatized multi-streamline
 extractor implementation.
-Copyright (c) 2006-2023 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -118,6 +118,11 @@ class MultiStreamlineExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool getSeedPoint(Visualization::Abstract::Parameters::SeedPoint& result) const
+			{
+			result=Visualization::Abstract::Parameters::SeedPoint(base);
+			return true;
+			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
 		#if VISUALIZATION_CONFIG_USE_COLLABORATION
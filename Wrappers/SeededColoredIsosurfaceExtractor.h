@@ -2,7 +2,7 @@
 SeededColoredIsosurfaceExtractor - Wrapper class to map from the
 abstract visualization algorithm interface to a templatized colored
 isosurface extractor implementation.
-Copyright (c) 2008-2023 Oliver Kreylos
+Copyright (c) 2008-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -118,6 +118,11 @@ class SeededColoredIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool getSeedPoint(Visualization::Abstract::Parameters::SeedPoint& result) const
+			{
+			result=Visualization::Abstract::Parameters::SeedPoint(seedPoint);
+			return true;
+			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
 		#if VISUALIZATION_CONFIG_USE_COLLABORATION
@@ -2,7 +2,7 @@
 SeededIsosurfaceExtractor - Wrapper class to map from the abstract
 visualization algorithm interface to a templatized isosurface extractor
 implementation.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,12 +25,14 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_WRAPPERS_SEEDEDISOSURFACEEXTRACTOR_INCLUDED
 
 #include <Misc/Autopointer.h>
+#include <Threads/Mutex.h>
 #include <GLMotif/RadioBox.h>
 #include <GLMotif/TextFieldSlider.h>
 
 #include <Abstract/DataSet.h>
 #include <Abstract/Parameters.h>
 #include <Abstract/Algorithm.h>
+#include <Templatized/RegionOfInterest.h>
 
 #include <Wrappers/Isosurface.h>
 
@@ -95,6 +97,7 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		Point seedPoint; // Point from which the isosurface was seeded
 		DSL dsl; // Templatized data set locator following the seed point
 		bool locatorValid; // Flag if the locator has been properly initialized, and is inside the data set's domain
+		Visualization::Abstract::DataSet::RegionOfInterest regionOfInterest; // Region of the data set's domain to which extraction is restricted
 		
 		/* Constructors and destructors: */
 		public:
@@ -113,6 +116,11 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool getSeedPoint(Visualization::Abstract::Parameters::SeedPoint& result) const
+			{
+			result=Visualization::Abstract::Parameters::SeedPoint(seedPoint);
+			return true;
+			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
 		#if VISUALIZATION_CONFIG_USE_COLLABORATION
@@ -130,6 +138,10 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	Parameters parameters; // The isosurface extraction parameters used by this extractor
 	ISE ise; // The templatized isosurface extractor
 	IsosurfacePointer currentIsosurface; // The currently extracted isosurface visualization element
+	bool currentComplete; // Flag whether the currently extracted isosurface was extracted completely
+	bool currentReused; // Flag whether the currently extracted isosurface was created from the previous isosurface
+	Threads::Mutex previousMutex; // Mutex protecting the previous isosurface, which is released from the main thread when it is removed from the element list
+	IsosurfacePointer previousIsosurface; // The most recent completely extracted isosurface visualization element, to be reused by subsequent seed requests
 	
 	/* UI components: */
 	GLMotif::TextFieldSlider* maxNumTrianglesSlider; // Slider to adjust maximum number of extracted triangles
@@ -139,6 +151,8 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 	/* Private methods: */
 	static const DS* getDs(const Visualization::Abstract::DataSet* sDataSet);
 	static const SE& getSe(const Visualization::Abstract::ScalarExtractor* sScalarExtractor);
+	void setPreviousIsosurface(Isosurface* newPreviousIsosurface); // Replaces the isosurface kept for reuse by subsequent seed requests
+	void previousIsosurfaceRemovedCallback(Misc::CallbackData* cbData); // Releases the previous isosurface when it is removed from the element list
 	
 	/* Constructors and destructors: */
 	public:
@@ -158,6 +172,10 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return true;
 		}
+	virtual bool hasElementReuse(void) const
+		{
+		return true;
+		}
 	virtual GLMotif::Widget* createSettingsDialog(GLMotif::WidgetManager* widgetManager);
 	virtual void readParameters(Visualization::Abstract::ParametersSource& source);
 	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
@@ -165,10 +183,13 @@ class SeededIsosurfaceExtractor:public Visualization::Abstract::Algorithm
 		return new Parameters(parameters);
 		}
 	virtual void setSeedLocator(const Visualization::Abstract::DataSet::Locator* seedLocator);
+	virtual void setRegionOfInterest(const Visualization::Abstract::DataSet::RegionOfInterest& regionOfInterest);
 	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& geometryFile);
 	virtual Visualization::Abstract::Element* startElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual bool continueElement(const Realtime::AlarmTimer& alarm);
 	virtual void finishElement(void);
+	virtual bool isElementReused(void) const;
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
 	
@@ -2,7 +2,7 @@
 SeededSliceExtractor - Wrapper class to map from the abstract
 visualization algorithm interface to a templatized slice extractor
 implementation.
-Copyright (c) 2005-2023 Oliver Kreylos
+Copyright (c) 2005-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,10 +25,12 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #define VISUALIZATION_WRAPPERS_SEEDEDSLICEEXTRACTOR_INCLUDED
 
 #include <Misc/Autopointer.h>
+#include <Threads/Mutex.h>
 
 #include <Abstract/DataSet.h>
 #include <Abstract/Parameters.h>
 #include <Abstract/Algorithm.h>
+#include <Templatized/RegionOfInterest.h>
 
 #include <Wrappers/Slice.h>
 
@@ -88,6 +90,7 @@ class SeededSliceExtractor:public Visualization::Abstract::Algorithm
 		Point seedPoint; // Point from which the slice was seeded
 		DSL dsl; // Templatized data set locator following the seed point
 		bool locatorValid; // Flag if the locator has been properly initialized, and is inside the data set's domain
+		Visualization::Abstract::DataSet::RegionOfInterest regionOfInterest; // Region of the data set's domain to which extraction is restricted
 		
 		/* Constructors and destructors: */
 		public:
@@ -106,6 +109,11 @@ class SeededSliceExtractor:public Visualization::Abstract::Algorithm
 			{
 			return new Parameters(*this);
 			}
+		virtual bool getSeedPoint(Visualization::Abstract::Parameters::SeedPoint& result) const
+			{
+			result=Visualization::Abstract::Parameters::SeedPoint(seedPoint);
+			return true;
+			}
 		virtual void write(Visualization::Abstract::ParametersSink& sink) const;
 		virtual void read(Visualization::Abstract::ParametersSource& source);
 		#if VISUALIZATION_CONFIG_USE_COLLABORATION
@@ -123,10 +131,16 @@ class SeededSliceExtractor:public Visualization::Abstract::Algorithm
 	Parameters parameters; // The slice extraction parameters used by this extractor
 	SLE sle; // The templatized slice extractor
 	SlicePointer currentSlice; // The currently extracted slice visualization element
+	bool currentComplete; // Flag whether the currently extracted slice was extracted completely
+	bool currentReused; // Flag whether the currently extracted slice was created from the previous slice
+	Threads::Mutex previousMutex; // Mutex protecting the previous slice, which is released from the main thread when it is removed from the element list
+	SlicePointer previousSlice; // The most recent completely extracted slice visualization element, to be patched for subsequent seed requests
 	
 	/* Private methods: */
 	static const DS* getDs(const Visualization::Abstract::DataSet* sDataSet);
 	static const SE& getSe(const Visualization::Abstract::ScalarExtractor* sScalarExtractor);
+	void setPreviousSlice(Slice* newPreviousSlice); // Replaces the slice kept for reuse by subsequent seed requests
+	void previousSliceRemovedCallback(Misc::CallbackData* cbData); // Releases the previous slice when it is removed from the element list
 	
 	/* Constructors and destructors: */
 	public:
@@ -146,16 +160,23 @@ class SeededSliceExtractor:public Visualization::Abstract::Algorithm
 		{
 		return true;
 		}
+	virtual bool hasElementReuse(void) const
+		{
+		return true;
+		}
 	virtual void readParameters(Visualization::Abstract::ParametersSource& source);
 	virtual Visualization::Abstract::Parameters* cloneParameters(void) const
 		{
 		return new Parameters(parameters);
 		}
 	virtual void setSeedLocator(const Visualization::Abstract::DataSet::Locator* seedLocator);
+	virtual void setRegionOfInterest(const Visualization::Abstract::DataSet::RegionOfInterest& regionOfInterest);
 	virtual Visualization::Abstract::Element* createElement(Visualization::Abstract::Parameters* extractParameters);
+	virtual Visualization::Abstract::Element* readElement(Visualization::Abstract::Parameters* extractParameters,IO::File& geometryFile);
 	virtual Visualization::Abstract::Element* startElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual bool continueElement(const Realtime::AlarmTimer& alarm);
 	virtual void finishElement(void);
+	virtual bool isElementReused(void) const;
 	virtual Visualization::Abstract::Element* startSlaveElement(Visualization::Abstract::Parameters* extractParameters);
 	virtual void continueSlaveElement(void);
 	
@@ -3,7 +3,7 @@ Streamsurface - Wrapper class for surfaces spanned by multiple
 streamlines as visualization elements.
 Part of the wrapper layer of the templatized visualization
 components.
-Copyright (c) 2006-2011 Oliver Kreylos
+Copyright (c) 2006-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,14 +25,16 @@ Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 #ifndef VISUALIZATION_WRAPPERS_STREAMSURFACE_INCLUDED
 #define VISUALIZATION_WRAPPERS_STREAMSURFACE_INCLUDED
 
-#define GLVERTEX_NONSTANDARD_TEMPLATES
-#include <GL/GLVertex.h>
+#include <GL/GLVertex.icpp>
 
+#include <Config.h>
 #include <Abstract/Element.h>
 #include <Templatized/IndexedTrianglestripSet.h>
 
 /* Forward declarations: */
-class GLColorMap;
+#if VISUALIZATION_CONFIG_USE_SHADERS
+class TwoSided1DTexturedSurfaceShader;
+#endif
 
 namespace Visualization {
 
@@ -49,38 +51,45 @@ class Streamsurface:public Visualization::Abstract::Element
 	typedef typename DS::Scalar Scalar; // Scalar type of data set's domain
 	static const int dimension=DS::dimension; // Dimension of data set's domain
 	typedef typename DataSetWrapper::VScalar VScalar; // Scalar type of scalar extractor
-	typedef GLVertex<Scalar,1,void,0,Scalar,Scalar,dimension> Vertex; // Data type for stream surface vertices
+	typedef GLVertex<VScalar,1,void,0,Scalar,Scalar,dimension> Vertex; // Data type for stream surface vertices
 	typedef Visualization::Templatized::IndexedTrianglestripSet<Vertex> Surface; // Data structure to represent stream surfaces
 	
 	/* Elements: */
 	private:
-	const GLColorMap* colorMap; // Color map for auxiliary streamline vertex values
+	int scalarVariableIndex; // Index of the scalar variable used to color the stream surface
+	#if VISUALIZATION_CONFIG_USE_SHADERS
+	TwoSided1DTexturedSurfaceShader* shader; // Shader for the stream surface
+	#endif
 	Surface surface; // Stream surface representation
 	
 	/* Constructors and destructors: */
 	public:
-	Streamsurface(const GLColorMap* sColorMap); // Creates an empty stream surface for the given color map
+	Streamsurface(Visualization::Abstract::VariableManager* sVariableManager,Visualization::Abstract::Parameters* sParameters,int sScalarVariableIndex,Cluster::MulticastPipe* pipe); // Creates an empty stream surface for the given parameters
 	private:
 	Streamsurface(const Streamsurface& source); // Prohibit copy constructor
 	Streamsurface& operator=(const Streamsurface& source); // Prohibit assignment operator
 	public:
 	virtual ~Streamsurface(void);
 	
-	/* Methods: */
-	const GLColorMap* getColorMap(void) const // Returns the color map
-		{
-		return colorMap;
-		}
-	Surface& getSurface(void) // Returns the stream surface representations
+	/* Methods from class SceneGraph::Node: */
+	virtual const char* getClassName(void) const;
+	
+	/* Methods from class SceneGraph::GraphNode: */
+	virtual void glRenderAction(SceneGraph::GLRenderState& renderState) const;
+	
+	/* Methods from class Visualization::Abstract::Element: */
+	virtual std::string getName(void) const;
+	virtual size_t getSize(void) const;
+	
+	/* New methods: */
+	Surface& getSurface(void) // Returns the stream surface representation
 		{
 		return surface;
 		}
-	size_t getElementSize(void) const // Returns the number of vertex layers in the stream surface
+	size_t getElementSize(void) const // Returns the number of vertices in the stream surface
 		{
-		return surface.getNumStrips()+1;
+		return surface.getNumVertices();
 		}
-	virtual std::string getName(void) const;
-	virtual void glRenderAction(GLContextData& contextData) const;
 	};
 
 }
@@ -0,0 +1,142 @@
+/***********************************************************************
+Fragment shader for GPU-based single-channel raycasting of bricked
+multiresolution volumes
+Copyright (c) 2026 Oliver Kreylos
+
+This file is part of the 3D Data Visualizer (Visualizer).
+
+The 3D Data Visualizer is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License as published
+by the Free Software Foundation; either version 2 of the License, or (at
+your option) any later version.
+
+The 3D Data Visualizer is distributed in the hope that it will be
+useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with the 3D Data Visualizer; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+***********************************************************************/
+
+uniform vec3 mcScale;
+uniform sampler2D depthSampler;
+uniform mat4 depthMatrix;
+uniform vec2 depthSize;
+uniform vec3 eyePosition;
+uniform float stepSize;
+uniform vec3 bcScale;
+uniform vec3 bcOffset;
+uniform sampler3D occupancySampler;
+uniform vec3 occupancySize;
+uniform vec3 occupancyTextureSize;
+uniform sampler3D volumeSampler;
+uniform vec3 volumeSize;
+uniform vec3 voxelMax;
+uniform float brickSize;
+uniform sampler3D pageTableSampler;
+uniform vec3 pageTableSize;
+uniform bool quantizedPageTable;
+uniform float slotSize;
+uniform vec3 atlasSize;
+uniform sampler1D colorMapSampler;
+
+varying vec3 mcPosition;
+varying vec3 dcPosition;
+
+float sampleVolume(vec3 samplePos)
+	{
+	/* Convert the sample position to full-resolution voxel coordinates: */
+	vec3 v0=clamp(samplePos*volumeSize-vec3(0.5),vec3(0.0),voxelMax);
+	
+	/* Look up the page table entry of the full-resolution brick containing the sample position: */
+	vec3 brick=clamp(floor(v0/brickSize),vec3(0.0),pageTableSize-vec3(1.0));
+	vec4 entry=texture3D(pageTableSampler,(brick+vec3(0.5))/pageTableSize);
+	if(quantizedPageTable)
+		{
+		/* Reconstruct the atlas texel offset and voxel scale factor from the quantized atlas slot index and resolution level: */
+		entry=floor(entry*255.0+vec4(0.5));
+		float scale=exp2(-entry.w);
+		entry=vec4(entry.xyz*slotSize-floor(brick*scale)*brickSize+vec3(0.5),scale);
+		}
+	
+	/* Sample the resident brick from the brick atlas: */
+	return texture3D(volumeSampler,(v0*entry.w+entry.xyz)/atlasSize).a;
+	}
+
+void main()
+	{
+	/* Calculate the ray direction in model coordinates: */
+	vec3 mcDir=mcPosition-eyePosition;
+	
+	/* Get the distance from the eye to the ray starting point: */
+	float eyeDist=length(mcDir);
+	
+	/* Normalize and multiply the ray direction with the current step size: */
+	mcDir=normalize(mcDir);
+	mcDir*=stepSize;
+	eyeDist/=stepSize;
+	
+	/* Get the fragment's ray termination depth from the depth texture: */
+	float termDepth=2.0*texture2D(depthSampler,gl_FragCoord.xy/depthSize).x-1.0;
+	
+	/* Calculate the maximum number of steps based on the termination depth: */
+	vec4 cc1=depthMatrix*vec4(mcPosition,1.0);
+	vec4 cc2=depthMatrix*vec4(mcDir,0.0);
+	float lambdaMax=-(termDepth*cc1.w-cc1.z)/(termDepth*cc2.w-cc2.z);
+	
+	/* Convert the ray direction to data coordinates and brick coordinates: */
+	vec3 dcDir=mcDir*mcScale;
+	vec3 bcDir=dcDir*bcScale;
+	
+	/* Calculate the number of steps needed to cross a unit brick along each axis: */
+	vec3 bcStepsPerBrick=1.0/max(abs(bcDir),vec3(1.0e-6));
+	
+	/* Cast the ray and accumulate opacities and colors: */
+	vec4 accum=vec4(0.0,0.0,0.0,0.0);
+	
+	/* Move the ray starting position forward to an integer multiple of the step size: */
+	vec3 samplePos=dcPosition;
+	float lambda=ceil(eyeDist)-eyeDist;
+	if(lambda<lambdaMax)
+		{
+		samplePos+=dcDir*lambda;
+		for(int i=0;i<1500;++i)
+			{
+			/* Find the brick containing the current sample position: */
+			vec3 bc=samplePos*bcScale+bcOffset;
+			vec3 brick=clamp(floor(bc),vec3(0.0),occupancySize-vec3(1.0));
+			
+			/* Check if the brick is fully transparent under the current transfer function: */
+			if(texture3D(occupancySampler,(brick+vec3(0.5))/occupancyTextureSize).a==0.0)
+				{
+				/* Skip to the first sample position beyond the brick's exit face: */
+				vec3 exitDist=mix(bc-brick,brick+vec3(1.0)-bc,step(0.0,bcDir))*bcStepsPerBrick;
+				float numSkipSteps=max(floor(min(exitDist.x,min(exitDist.y,exitDist.z)))+1.0,1.0);
+				samplePos+=dcDir*numSkipSteps;
+				lambda+=numSkipSteps;
+				if(lambda>=lambdaMax)
+					break;
+				continue;
+				}
+			
+			/* Get the volume data value at the current sample position: */
+			vec4 vol=texture1D(colorMapSampler,sampleVolume(samplePos));
+			
+			/* Accumulate color and opacity: */
+			accum+=vol*(1.0-accum.a);
+			
+			/* Bail out when opacity hits 1.0: */
+			if(accum.a>=1.0-1.0/256.0||lambda>=lambdaMax)
+				break;
+			
+			/* Advance the sample position: */
+			samplePos+=dcDir;
+			lambda+=1.0;
+			}
+		}
+	
+	/* Assign the final color value: */
+	gl_FragColor=accum;
+	}
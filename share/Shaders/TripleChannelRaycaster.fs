@@ -1,6 +1,6 @@
 /***********************************************************************
 Fragment shader for GPU-based triple-channel raycasting
-Copyright (c) 2009-2010 Oliver Kreylos
+Copyright (c) 2009-2026 Oliver Kreylos
 
 This file is part of the 3D Data Visualizer (Visualizer).
 
@@ -25,6 +25,11 @@ uniform mat4 depthMatrix;
 uniform vec2 depthSize;
 uniform vec3 eyePosition;
 uniform float stepSize;
+uniform vec3 bcScale;
+uniform vec3 bcOffset;
+uniform sampler3D occupancySampler;
+uniform vec3 occupancySize;
+uniform vec3 occupancyTextureSize;
 uniform sampler3D volumeSampler;
 uniform bool channelEnableds[3];
 uniform sampler1D colorMapSamplers[3];
@@ -53,8 +58,12 @@ void main()
 	vec4 cc2=depthMatrix*vec4(mcDir,0.0);
 	float lambdaMax=-(termDepth*cc1.w-cc1.z)/(termDepth*cc2.w-cc2.z);
 	
-	/* Convert the ray direction to data coordinates: */
+	/* Convert the ray direction to data coordinates and brick coordinates: */
 	vec3 dcDir=mcDir*mcScale;
+	vec3 bcDir=dcDir*bcScale;
+	
+	/* Calculate the number of steps needed to cross a unit brick along each axis: */
+	vec3 bcStepsPerBrick=1.0/max(abs(bcDir),vec3(1.0e-6));
 	
 	/* Cast the ray and accumulate opacities and colors: */
 	vec4 accum=vec4(0.0,0.0,0.0,0.0);
@@ -67,6 +76,23 @@ void main()
 		samplePos+=dcDir*lambda;
 		for(int i=0;i<1500;++i)
 			{
+			/* Find the brick containing the current sample position: */
+			vec3 bc=samplePos*bcScale+bcOffset;
+			vec3 brick=clamp(floor(bc),vec3(0.0),occupancySize-vec3(1.0));
+			
+			/* Check if the brick is fully transparent under the current transfer function: */
+			if(texture3D(occupancySampler,(brick+vec3(0.5))/occupancyTextureSize).a==0.0)
+				{
+				/* Skip to the first sample position beyond the brick's exit face: */
+				vec3 exitDist=mix(bc-brick,brick+vec3(1.0)-bc,step(0.0,bcDir))*bcStepsPerBrick;
+				float numSkipSteps=max(floor(min(exitDist.x,min(exitDist.y,exitDist.z)))+1.0,1.0);
+				samplePos+=dcDir*numSkipSteps;
+				lambda+=numSkipSteps;
+				if(lambda>=lambdaMax)
+					break;
+				continue;
+				}
+			
 			/* Get the volume data value at the current sample position: */
 			vec3 data=texture3D(volumeSampler,samplePos);
 			